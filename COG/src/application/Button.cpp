@@ -1,4 +1,5 @@
 #include "Button.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/InterfaceShader.h"
 #include "utilities/Tools.h"
 #include "managers/InputManager.h"
@@ -73,6 +74,18 @@ void Button::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the button to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void Button::Submit(FramePacket& packet)
+{
+	if (m_isActive) {
+		if (!m_isHovered)	{ m_idle.Submit(packet, m_transform.GetRenderMatrix()); }
+		else				{ m_hover.Submit(packet, m_transform.GetRenderMatrix()); }
+	}
+}
+
+
 /*******************************************************************************************************************
 	A function that updates the button
 *******************************************************************************************************************/
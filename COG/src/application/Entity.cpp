@@ -1,4 +1,5 @@
 #include "Entity.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/EntityShader.h"
 #include "utilities/Tools.h"
 #include "managers/ReaderManager.h"
@@ -59,6 +60,15 @@ void Entity::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the entity to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void Entity::Submit(FramePacket& packet)
+{
+	if (m_isActive) { packet.AddMesh(&m_model, &m_material, m_transform.GetRenderMatrix()); }
+}
+
+
 /*******************************************************************************************************************
 	A static function that creates an entity instance based on data from a file
 *******************************************************************************************************************/
@@ -27,6 +27,8 @@
 #include "physics/Transform.h"
 #include "graphics/shaders/Shader.h"
 
+struct FramePacket;
+
 class GameObject {
 
 	friend class cereal::access;
@@ -48,6 +50,7 @@ public:
 public:
 	virtual void Update() = 0;
 	virtual void Render(Shader* shader) = 0;
+	virtual void Submit(FramePacket& packet) {}
 
 public:
 	Transform* GetTransform();
@@ -25,6 +25,8 @@
 #include "physics/Transform.h"
 #include "graphics/shaders/Shader.h"
 
+struct FramePacket;
+
 class Interface {
 
 	friend class cereal::access;
@@ -45,6 +47,7 @@ public:
 public:
 	virtual void Render(Shader* shader) = 0;
 	virtual void Update() = 0;
+	virtual void Submit(FramePacket& packet) {}
 
 public:
 	bool IsActive() const;
@@ -1,4 +1,5 @@
 #include "Inventory.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/InterfaceShader.h"
 #include "utilities/Tools.h"
 #include "managers/InputManager.h"
@@ -51,6 +52,17 @@ void Inventory::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the inventory (and every item within it) to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void Inventory::Submit(FramePacket& packet)
+{
+	m_sprite.Submit(packet, m_transform.GetRenderMatrix());
+
+	for (auto item : m_items) { item->Submit(packet); }
+}
+
+
 /*******************************************************************************************************************
 	A function that finds an object within the inventory (not currently being used)
 *******************************************************************************************************************/
@@ -31,6 +31,7 @@ public:
 public:
 	virtual void Update() override;
 	virtual void Render(Shader* shader) override;
+	virtual void Submit(FramePacket& packet) override;
 
 public:
 	void Add(const std::string& tag);
@@ -1,4 +1,5 @@
 #include "InventoryItem.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/InterfaceShader.h"
 #include "utilities/Tools.h"
 
@@ -59,6 +60,17 @@ void InventoryItem::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the item (and its icon) to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void InventoryItem::Submit(FramePacket& packet)
+{
+	m_icon.icon.Submit(packet, m_icon.transform.GetRenderMatrix());
+
+	if (m_isActive) { m_sprite.Submit(packet, m_transform.GetRenderMatrix()); }
+}
+
+
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
@@ -42,6 +42,7 @@ public:
 public:
 	virtual void Update()				override;
 	virtual void Render(Shader* shader) override;
+	virtual void Submit(FramePacket& packet) override;
 
 public:
 	Icon*		GetIcon();
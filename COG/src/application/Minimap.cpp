@@ -1,4 +1,5 @@
 #include "Minimap.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/InterfaceShader.h"
 #include "utilities/Tools.h"
 
@@ -53,6 +54,16 @@ void Minimap::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the minimap to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void Minimap::Submit(FramePacket& packet)
+{
+	//--- The render target's texture is drawn into by the render thread itself, before the interface is drawn
+	if (Texture* texture = m_renderTarget.GetColorTexture()) { packet.AddSprite(texture, &m_quad, m_transform.GetRenderMatrix()); }
+}
+
+
 /*******************************************************************************************************************
 	A function that updates the minimap
 *******************************************************************************************************************/
@@ -29,6 +29,7 @@ public:
 
 public:
 	virtual void Render(Shader* shader) override;
+	virtual void Submit(FramePacket& packet) override;
 	virtual void Update()				override;
 
 public:
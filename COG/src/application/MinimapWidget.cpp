@@ -1,4 +1,5 @@
 #include "MinimapWidget.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/InterfaceShader.h"
 #include "utilities/Tools.h"
 #include "managers/InputManager.h"
@@ -72,6 +73,16 @@ void MinimapWidget::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the minimap widget to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void MinimapWidget::Submit(FramePacket& packet)
+{
+	Widget::Submit(packet);
+	if (Widget::IsActive()) { m_minimap.Submit(packet); }
+}
+
+
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
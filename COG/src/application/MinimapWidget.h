@@ -28,6 +28,7 @@ public:
 public:
 	virtual void Update()				override;
 	virtual void Render(Shader* shader) override;
+	virtual void Submit(FramePacket& packet) override;
 
 public:
 	static MinimapWidget* Create(const std::string& tag);
@@ -1,4 +1,5 @@
 #include "Player.h"
+#include "graphics/FramePacket.h"
 #include "managers/InputManager.h"
 #include "managers/ReaderManager.h"
 #include "utilities/Tools.h"
@@ -184,6 +185,15 @@ void Player::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the player's interface (the inventory) to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void Player::Submit(FramePacket& packet)
+{
+	if (m_displayInventory) { m_inventory.Submit(packet); }
+}
+
+
 /*******************************************************************************************************************
 	Function that enables the player to pickup a game object and adds it to the players inventory
 *******************************************************************************************************************/
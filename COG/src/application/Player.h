@@ -32,6 +32,7 @@ public:
 public:
 	virtual void Update() override;
 	virtual void Render(Shader* shader) override;
+	virtual void Submit(FramePacket& packet) override;
 
 public:
 	static Player* Create(const std::string& tag);
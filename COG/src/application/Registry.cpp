@@ -0,0 +1,209 @@
+#include "Registry.h"
+#include "utilities/Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+Registry::Registry()
+	:	m_count(0)
+{
+	//--- Archetype 0 is the empty archetype, where new entities start
+	GetArchetype(0);
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+Registry::~Registry()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that creates an entity with no components and returns its handle
+*******************************************************************************************************************/
+Registry::Handle Registry::Create()
+{
+	unsigned int index;
+
+	//--- Re-use the slot of a destroyed entity if we have one, its generation tells the old and new handles apart
+	if (!m_freeIndices.empty())	{ index = m_freeIndices.back(); m_freeIndices.pop_back(); }
+	else						{ index = (unsigned int)m_records.size(); m_records.push_back({ 0, 0, 0, false }); }
+
+	Record& record		= m_records[index];
+	Archetype& empty	= *m_archetypes[0];
+
+	record.archetype	= 0;
+	record.row			= (unsigned int)empty.handles.size();
+	record.isAlive		= true;
+
+	empty.handles.push_back({ index, record.generation });
+	m_count++;
+
+	return { index, record.generation };
+}
+
+
+/*******************************************************************************************************************
+	Function that destroys an entity and all of its components. The handle is no longer alive afterwards
+*******************************************************************************************************************/
+void Registry::Destroy(Handle handle)
+{
+	if (!IsAlive(handle)) { return; }
+
+	Record& record			= m_records[handle.index];
+	Archetype& archetype	= *m_archetypes[record.archetype];
+
+	for (auto& column : archetype.columns) {
+		if (column) { column->Remove(record.row); }
+	}
+
+	RemoveRow(archetype, record.row);
+
+	record.isAlive = false;
+	record.generation++;
+
+	m_freeIndices.push_back(handle.index);
+	m_count--;
+}
+
+
+/*******************************************************************************************************************
+	Function that destroys every entity. Archetypes are kept, as the same ones will most likely be needed again
+*******************************************************************************************************************/
+void Registry::Clear()
+{
+	for (auto& archetype : m_archetypes) {
+		while (!archetype->handles.empty()) { Destroy(archetype->handles.back()); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that moves an entity's components over to another archetype, dropping any the new one doesn't have
+*******************************************************************************************************************/
+void Registry::MoveEntity(Handle handle, unsigned int archetype)
+{
+	Record& record			= m_records[handle.index];
+	Archetype& source		= *m_archetypes[record.archetype];
+	Archetype& destination	= *m_archetypes[archetype];
+
+	for (unsigned int ID = 0; ID < s_maxComponents; ID++) {
+
+		if (!source.columns[ID]) { continue; }
+		if (destination.columns[ID]) { source.columns[ID]->MoveTo(record.row, destination.columns[ID].get()); }
+
+		source.columns[ID]->Remove(record.row);
+	}
+
+	RemoveRow(source, record.row);
+
+	record.archetype	= archetype;
+	record.row			= (unsigned int)destination.handles.size();
+
+	destination.handles.push_back(handle);
+}
+
+
+/*******************************************************************************************************************
+	Function that removes a row's handle from an archetype, the same way the columns do (swap with the last and pop)
+*******************************************************************************************************************/
+void Registry::RemoveRow(Archetype& archetype, unsigned int row)
+{
+	//--- The last entity now lives in the removed entity's row, so its record has to point at its new row
+	if (row + 1 < archetype.handles.size()) {
+		archetype.handles[row] = archetype.handles.back();
+		m_records[archetype.handles[row].index].row = row;
+	}
+
+	archetype.handles.pop_back();
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the archetype for a set of components, creating it if it doesn't exist yet
+*******************************************************************************************************************/
+unsigned int Registry::GetArchetype(uint32_t signature)
+{
+	auto iterator = m_archetypeIndices.find(signature);
+
+	if (iterator != m_archetypeIndices.end()) { return iterator->second; }
+
+	//--- NOTE
+	// The columns are filled in by whoever asked for the archetype, as only they know the component types.
+	// An archetype reached by adding a component copies the other column types from the archetype it came from.
+	//---
+	std::unique_ptr<Archetype> archetype(new Archetype());
+
+	archetype->signature = signature;
+	archetype->columns.resize(s_maxComponents);
+	archetype->addEdges.assign(s_maxComponents, -1);
+	archetype->removeEdges.assign(s_maxComponents, -1);
+
+	m_archetypes.push_back(std::move(archetype));
+
+	return m_archetypeIndices[signature] = (unsigned int)m_archetypes.size() - 1;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the archetype an entity ends up in when adding or removing a single component
+*******************************************************************************************************************/
+unsigned int Registry::GetNextArchetype(unsigned int archetype, unsigned int ID, bool isAdding)
+{
+	std::vector<int>& edges = isAdding ? m_archetypes[archetype]->addEdges : m_archetypes[archetype]->removeEdges;
+
+	if (edges[ID] >= 0) { return (unsigned int)edges[ID]; }
+
+	uint32_t signature	= isAdding ? (m_archetypes[archetype]->signature | (1u << ID)) : (m_archetypes[archetype]->signature & ~(1u << ID));
+	unsigned int next	= GetArchetype(signature);
+
+	Archetype& source		= *m_archetypes[archetype];
+	Archetype& destination	= *m_archetypes[next];
+
+	//--- Give a newly created archetype the same kind of columns as the one we came from
+	for (unsigned int i = 0; i < s_maxComponents; i++) {
+		if (!destination.columns[i] && source.columns[i] && (signature & (1u << i))) { destination.columns[i].reset(source.columns[i]->CreateEmpty()); }
+	}
+
+	//--- Adding to one side is removing from the other, so both edges can be remembered at once
+	if (isAdding)	{ source.addEdges[ID] = next; destination.removeEdges[ID] = archetype; }
+	else			{ source.removeEdges[ID] = next; destination.addEdges[ID] = archetype; }
+
+	return next;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+bool Registry::IsAlive(Handle handle) const
+{
+	return handle.index < m_records.size() && m_records[handle.index].isAlive && m_records[handle.index].generation == handle.generation;
+}
+
+unsigned int Registry::GetCount() const				{ return m_count; }
+unsigned int Registry::GetArchetypeCount() const	{ return (unsigned int)m_archetypes.size(); }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+unsigned int Registry::s_componentCount			= 0;
+const unsigned int Registry::s_maxComponents	= 32;
+
+unsigned int Registry::CreateComponentID()
+{
+	//--- NOTE
+	// Handing out a 33rd ID would shift past the end of the signature and index past every archetype's columns, so
+	// the type gets an ID of s_maxComponents instead - IsRegistered() fails for it, and nothing ever stores it.
+	//---
+	if (s_componentCount >= s_maxComponents) {
+		COG_LOG("[REGISTRY] Too many component types, the maximum is: ", s_maxComponents, LOG_ERROR);
+		return s_maxComponents;
+	}
+
+	return s_componentCount++;
+}
\ No newline at end of file
@@ -0,0 +1,382 @@
+#pragma once
+
+/*******************************************************************************************************************
+	Registry.h, Registry.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Entity component storage grouped by archetype. An entity is just a handle - its data lives in components (any
+	movable type, e.g. Transform, Material, Model, Light), and every entity with the same set of components shares an
+	archetype, which keeps each component type in its own contiguous array.
+
+	[Features]
+	Systems iterate straight over the component arrays of every matching archetype - no pointer chasing, no virtual
+	Update()/Render() calls and no Downcast per object.
+	Stable handles - an index plus a generation, so a handle to a destroyed entity is never mistaken for a new one.
+	Archetypes remember which archetype adding or removing each component leads to, so changing an entity's
+	components doesn't need a lookup after the first time.
+	Up to 32 component types, each entity's set of components is a bit mask (like the broad phase layers) - a 33rd
+	type is logged as an error and never stored (Add() and Get() return nullptr, ForEach() skips it), rather than
+	quietly overflowing the mask.
+
+	[Upcoming]
+	Moving PlayState's entities over from std::vector<Entity*>, along with the systems to update and render them.
+	Nothing in the game uses the registry yet - culling, picking and the broad phase all still take Entity*.
+
+	[Side Notes]
+	Adding or removing components (or creating and destroying entities) moves data around, so pointers and references
+	returned by Get(), Add() or passed into ForEach() are only valid until the next one of those - don't do them
+	from inside ForEach(), gather the handles and do them afterwards.
+	Creating an entity with all of its components at once (Create(a, b, c)) puts it straight into its archetype,
+	rather than moving it through one archetype per component. Each component type can only be given once.
+
+*******************************************************************************************************************/
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "utilities/Log.h"
+
+class Registry {
+
+public:
+	struct Handle {
+		unsigned int index;
+		unsigned int generation;
+
+		bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+		bool operator!=(const Handle& other) const { return !(*this == other); }
+	};
+
+private:
+	//--- An array of one component type. Archetypes only know the base class, the systems know the real type
+	class ColumnBase {
+
+	public:
+		virtual ~ColumnBase() {}
+
+	public:
+		virtual ColumnBase*	CreateEmpty() const = 0;
+		virtual void		MoveTo(unsigned int row, ColumnBase* other) = 0;
+		virtual void		Remove(unsigned int row) = 0;
+	};
+
+	template <typename T>
+	class Column : public ColumnBase {
+
+	public:
+		virtual ColumnBase* CreateEmpty() const override { return new Column<T>(); }
+
+		virtual void MoveTo(unsigned int row, ColumnBase* other) override
+		{
+			static_cast<Column<T>*>(other)->values.push_back(std::move(values[row]));
+		}
+
+		//--- Swap with the last component and pop, so the array stays packed
+		virtual void Remove(unsigned int row) override
+		{
+			if (row + 1 < values.size()) { values[row] = std::move(values.back()); }
+			values.pop_back();
+		}
+
+	public:
+		std::vector<T> values;
+	};
+
+	//--- Columns are indexed by component ID, and are empty for the components this archetype doesn't have
+	struct Archetype {
+		uint32_t									signature;
+		std::vector<std::unique_ptr<ColumnBase>>	columns;
+		std::vector<Handle>							handles;
+		std::vector<int>							addEdges;
+		std::vector<int>							removeEdges;
+	};
+
+	struct Record {
+		unsigned int	archetype;
+		unsigned int	row;
+		unsigned int	generation;
+		bool			isAlive;
+	};
+
+public:
+	Registry();
+	~Registry();
+
+public:
+	Handle	Create();
+	void	Destroy(Handle handle);
+	void	Clear();
+	bool	IsAlive(Handle handle) const;
+
+public:
+	template <typename... Components>	Handle				Create(Components&&... components);
+	template <typename T>				std::decay_t<T>*	Add(Handle handle, T&& component);
+	template <typename T>				void				Remove(Handle handle);
+	template <typename T>				T*					Get(Handle handle);
+	template <typename T>				bool				Has(Handle handle) const;
+
+public:
+	template <typename... Components, typename Function> void ForEach(Function function, uint32_t excluded = 0);
+	template <typename... Components, typename Function> void ForEachSpan(Function function, uint32_t excluded = 0);
+
+public:
+	template <typename... Components> static uint32_t GetSignature();
+
+public:
+	unsigned int GetCount() const;
+	unsigned int GetArchetypeCount() const;
+
+private:
+	Registry(const Registry&)				= delete;
+	Registry& operator=(const Registry&)	= delete;
+
+private:
+	unsigned int	GetArchetype(uint32_t signature);
+	unsigned int	GetNextArchetype(unsigned int archetype, unsigned int ID, bool isAdding);
+	void			MoveEntity(Handle handle, unsigned int archetype);
+	void			RemoveRow(Archetype& archetype, unsigned int row);
+
+private:
+	template <typename T> static unsigned int	GetComponentID();
+	template <typename... Components> static bool	IsRegistered();
+	template <typename T> static std::vector<T>&	GetValues(Archetype& archetype);
+	template <typename T> static void			CreateColumn(Archetype& archetype);
+
+private:
+	template <typename T, typename... Types> static constexpr unsigned int	GetTypeCount();
+	template <typename... Components> static constexpr bool				AreUnique();
+
+private:
+	static unsigned int CreateComponentID();
+
+private:
+	std::vector<std::unique_ptr<Archetype>>		m_archetypes;
+	std::unordered_map<uint32_t, unsigned int>	m_archetypeIndices;
+	std::vector<Record>							m_records;
+	std::vector<unsigned int>					m_freeIndices;
+	unsigned int								m_count;
+
+private:
+	static unsigned int			s_componentCount;
+	static const unsigned int	s_maxComponents;
+};
+
+
+/*******************************************************************************************************************
+	Function that creates an entity with all of its components, straight into the archetype it belongs in
+*******************************************************************************************************************/
+template <typename... Components>
+Registry::Handle Registry::Create(Components&&... components)
+{
+	static_assert(AreUnique<std::decay_t<Components>...>(), "Registry::Create() was given the same component type more than once");
+
+	Handle handle = Create();
+
+	if (!IsRegistered<std::decay_t<Components>...>()) {
+		COG_LOG("[REGISTRY] Creating an entity with a component type past the maximum, it has no components: ", handle.index, LOG_ERROR);
+		return handle;
+	}
+
+	unsigned int index		= GetArchetype(GetSignature<std::decay_t<Components>...>());
+	Archetype& archetype	= *m_archetypes[index];
+
+	(CreateColumn<std::decay_t<Components>>(archetype), ...);
+	(GetValues<std::decay_t<Components>>(archetype).push_back(std::forward<Components>(components)), ...);
+
+	//--- A new entity has no components, so this just moves its handle over to the new archetype
+	MoveEntity(handle, index);
+
+	return handle;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a component to an entity (or replaces it, if the entity already has one) and returns it, or
+	nullptr if the entity has been destroyed
+*******************************************************************************************************************/
+template <typename T>
+std::decay_t<T>* Registry::Add(Handle handle, T&& component)
+{
+	typedef std::decay_t<T> Type;
+
+	if (!IsAlive(handle)) {
+		COG_LOG("[REGISTRY] Adding a component to an entity that has been destroyed: ", handle.index, LOG_ERROR); return nullptr;
+	}
+
+	if (!IsRegistered<Type>()) {
+		COG_LOG("[REGISTRY] Adding a component type past the maximum: ", handle.index, LOG_ERROR); return nullptr;
+	}
+
+	unsigned int ID		= GetComponentID<Type>();
+	Record& record		= m_records[handle.index];
+	Archetype& source	= *m_archetypes[record.archetype];
+
+	if (source.signature & (1u << ID)) {
+		GetValues<Type>(source)[record.row] = std::forward<T>(component);
+		return &GetValues<Type>(source)[record.row];
+	}
+
+	unsigned int next		= GetNextArchetype(record.archetype, ID, true);
+	Archetype& destination	= *m_archetypes[next];
+
+	CreateColumn<Type>(destination);
+	GetValues<Type>(destination).push_back(std::forward<T>(component));
+
+	MoveEntity(handle, next);
+
+	return &GetValues<Type>(destination)[record.row];
+}
+
+
+/*******************************************************************************************************************
+	Function that removes a component from an entity, if it has one
+*******************************************************************************************************************/
+template <typename T>
+void Registry::Remove(Handle handle)
+{
+	if (!IsAlive(handle)) {
+		COG_LOG("[REGISTRY] Removing a component from an entity that has been destroyed: ", handle.index, LOG_ERROR); return;
+	}
+
+	if (!IsRegistered<T>()) { return; }
+
+	unsigned int ID	= GetComponentID<T>();
+	Record& record	= m_records[handle.index];
+
+	if (m_archetypes[record.archetype]->signature & (1u << ID)) { MoveEntity(handle, GetNextArchetype(record.archetype, ID, false)); }
+}
+
+
+/*******************************************************************************************************************
+	Function that returns an entity's component, or nullptr if it doesn't have one (or has been destroyed)
+*******************************************************************************************************************/
+template <typename T>
+T* Registry::Get(Handle handle)
+{
+	if (!IsAlive(handle) || !IsRegistered<T>()) { return nullptr; }
+
+	const Record& record	= m_records[handle.index];
+	Archetype& archetype	= *m_archetypes[record.archetype];
+
+	return (archetype.signature & (1u << GetComponentID<T>())) ? &GetValues<T>(archetype)[record.row] : nullptr;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks if an entity has a component
+*******************************************************************************************************************/
+template <typename T>
+bool Registry::Has(Handle handle) const
+{
+	return IsAlive(handle) && IsRegistered<T>() && (m_archetypes[m_records[handle.index].archetype]->signature & (1u << GetComponentID<T>()));
+}
+
+
+/*******************************************************************************************************************
+	Function that calls a function for every entity that has all of the components (and none of the excluded ones),
+	passing in a reference to each of its components, e.g. ForEach<Transform, Model>([](Transform& t, Model& m) {})
+*******************************************************************************************************************/
+template <typename... Components, typename Function>
+void Registry::ForEach(Function function, uint32_t excluded)
+{
+	ForEachSpan<Components...>([&function](unsigned int count, const Handle*, Components*... components) {
+		for (unsigned int i = 0; i < count; i++) { function(components[i]...); }
+	}, excluded);
+}
+
+
+/*******************************************************************************************************************
+	Function that calls a function once per matching archetype, passing in how many entities it has, their handles
+	and a pointer to the start of each component array - for systems that want to work on whole arrays at once
+*******************************************************************************************************************/
+template <typename... Components, typename Function>
+void Registry::ForEachSpan(Function function, uint32_t excluded)
+{
+	if (!IsRegistered<Components...>()) { return; }
+
+	uint32_t signature = GetSignature<Components...>();
+
+	for (auto& archetype : m_archetypes) {
+
+		if ((archetype->signature & signature) != signature || (archetype->signature & excluded)) { continue; }
+		if (archetype->handles.empty()) { continue; }
+
+		function((unsigned int)archetype->handles.size(), archetype->handles.data(), GetValues<Components>(*archetype).data()...);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the bit mask of a set of components, e.g. to exclude them from ForEach() - a type past the
+	maximum has no bit, so it's left out
+*******************************************************************************************************************/
+template <typename... Components>
+uint32_t Registry::GetSignature()
+{
+	return (0u | ... | (IsRegistered<Components>() ? (1u << GetComponentID<Components>()) : 0u));
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the ID of a component type - IDs are handed out the first time a type is used
+*******************************************************************************************************************/
+template <typename T>
+unsigned int Registry::GetComponentID()
+{
+	static const unsigned int ID = CreateComponentID();
+	return ID;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks every component type has a valid ID (there was room for it when it was first used)
+*******************************************************************************************************************/
+template <typename... Components>
+bool Registry::IsRegistered()
+{
+	return ((GetComponentID<Components>() < s_maxComponents) && ...);
+}
+
+
+/*******************************************************************************************************************
+	Function that returns how many times a type appears in a list of types
+*******************************************************************************************************************/
+template <typename T, typename... Types>
+constexpr unsigned int Registry::GetTypeCount()
+{
+	return (0u + ... + (std::is_same<T, Types>::value ? 1u : 0u));
+}
+
+
+/*******************************************************************************************************************
+	Function that checks no component type appears more than once in a list of component types
+*******************************************************************************************************************/
+template <typename... Components>
+constexpr bool Registry::AreUnique()
+{
+	return ((GetTypeCount<Components, Components...>() == 1) && ...);
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the array of one component type within an archetype
+*******************************************************************************************************************/
+template <typename T>
+std::vector<T>& Registry::GetValues(Archetype& archetype)
+{
+	return static_cast<Column<T>*>(archetype.columns[GetComponentID<T>()].get())->values;
+}
+
+
+/*******************************************************************************************************************
+	Function that gives an archetype an array for a component type, if it doesn't already have one
+*******************************************************************************************************************/
+template <typename T>
+void Registry::CreateColumn(Archetype& archetype)
+{
+	auto& column = archetype.columns[GetComponentID<T>()];
+	if (!column) { column.reset(new Column<T>()); }
+}
\ No newline at end of file
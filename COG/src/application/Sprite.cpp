@@ -1,4 +1,5 @@
 #include "Sprite.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/Shader.h"
 
 /*******************************************************************************************************************
@@ -63,6 +64,15 @@ void Sprite::Render()
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the sprite to a frame packet, drawn with the given world matrix
+*******************************************************************************************************************/
+void Sprite::Submit(FramePacket& packet, const glm::mat4& world)
+{
+	packet.AddSprite(&m_texture, &m_quad, world);
+}
+
+
 /*******************************************************************************************************************
 	A function that updates a sprite
 *******************************************************************************************************************/
@@ -20,6 +20,8 @@
 #include "graphics/Texture.h"
 #include "application/Quad.h"
 
+struct FramePacket;
+
 class Sprite {
 
 	friend class cereal::access;
@@ -46,6 +48,7 @@ public:
 
 public:
 	void Render();
+	void Submit(FramePacket& packet, const glm::mat4& world);
 	void Update(float frame);
 
 public:
@@ -1,13 +1,13 @@
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+#include <algorithm>
 #include "Terrain.h"
 #include "utilities/Log.h"
-#include "utilities/Maths.h"
 #include "graphics/shaders/TerrainShader.h"
 #include "managers/ResourceManager.h"
 #include "utilities/Tools.h"
+#include "application/TerrainBaker.h"
 #include "managers/ReaderManager.h"
 #include "managers/InterfaceManager.h"
+#include "managers/GameManager.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set all default values of variables
@@ -18,7 +18,9 @@ Terrain::Terrain()
 		m_height(0),
 		m_level(15.0f),
 		m_minimapMode(false),
-		m_bounds({ { -70.0f, 0.0f, -208.0f }, { 70.0f, 0.0f, -45.0f} })
+		m_bounds({ { -70.0f, 0.0f, -208.0f }, { 70.0f, 0.0f, -45.0f} }),
+		m_vertexBufferSize(0),
+		m_peakMemoryUsage({ 0, 0, 0, 0, 0, 0, 0 })
 {
 	
 }
@@ -43,22 +45,11 @@ bool Terrain::SaveRawHeightMapData(const std::string& tag, const Transform& tran
 	m_bounds = bounds;
 	m_level = level;
 	m_heightMapFilename = heightMapFilename;
+	m_peakMemoryUsage = { 0, 0, 0, 0, 0, 0, 0 };
 
-	//--- Generate the heightmap for the terrain
+	//--- Generate the heightmap, level it out and calculate the normals and grid for the terrain
 	if (!GenerateRawHeightMap()) { return false; }
 
-	//--- Level out the heightmap so that the height of the terrain is not too high
-	LevelHeightMap();
-
-	//--- Calculate normals for terrain lighting (make sure this is done after leveling the terrain)
-	CalculateNormals();
-
-	//--- Calculate the terrain grid length
-	m_grid.length = (float)(m_heights.size() - 1);
-
-	//--- Determine the grids square size. Will always be 1 in this case
-	m_grid.square = (float)(m_width - 1) / m_grid.length;
-
 	//--- Flip the blend map texture
 	m_textures.GetBlendMap()->SetMirrored(true);
 	
@@ -84,6 +75,8 @@ bool Terrain::SaveTerrainViaDialog(const std::string& tag, const Transform& tran
 *******************************************************************************************************************/
 bool Terrain::LoadTerrainBinary(const std::string& tag)
 {
+	m_peakMemoryUsage = { 0, 0, 0, 0, 0, 0, 0 };
+
 	if (!File::Instance()->Load("Assets\\Terrain\\Binaries\\" + tag + ".bin",
 		m_tag, m_transform, m_heightMapFilename, m_width, m_height, m_level, m_minimapMode, m_textures, m_normals, m_bounds, m_grid, m_map, m_heights))
 	{
@@ -103,6 +96,8 @@ bool Terrain::LoadTerrainBinary(const std::string& tag)
 *******************************************************************************************************************/
 bool Terrain::LoadTerrainBinaryFromDialog()
 {
+	m_peakMemoryUsage = { 0, 0, 0, 0, 0, 0, 0 };
+
 	if (!File::Instance()->OpenDialog(m_tag, m_transform, m_heightMapFilename, m_width, m_height, m_level, m_minimapMode, m_textures, m_normals, m_bounds, m_grid, m_map, m_heights))
 	{
 		return false;
@@ -139,206 +134,113 @@ float Terrain::GetHeight(float xPosition, float zPosition, float offset)
 	float x	= xPosition - m_transform.GetPosition().x;
 	float z	= -zPosition - m_transform.GetPosition().z;
 
-	//--- Determine which grid square the object is in
-	m_grid.x = (int)std::floor(x / m_grid.square);
-	m_grid.z = (int)std::floor(z / m_grid.square);
-
-	//--- Make sure the object coordinates are within a valid grid square on the terrain, if not return the height as 0
-	if (m_grid.x >= m_grid.length || m_grid.z >= m_grid.length || m_grid.x < 0 || m_grid.z < 0)
-	{
-		return 0.0f;
-	}
-
-	//--- Find out where on the grid square the object is located.
-	//--- Get the x and z distance of object from top left corner of the grid square by using % operator,
-	//--- and then divide the result by the grid square size, which will give us an x and z coordinate between 0 and 1.
-	glm::vec3 object = glm::vec3(0.0f);
-	object.x = (std::fmod(x, m_grid.square)) / m_grid.square;
-	object.z = (std::fmod(z, m_grid.square)) / m_grid.square;
-	
-	//--- The grid square is made up of 2 triangles, so figure out which triangle within the grid square the object is standing on
-	if (object.x <= (1 - object.z)) {
-
-		//--- If the object is in the left triangle, use Barycentric interpolation
-		//--- to figure out the height of the terrain where the object is located
-		object.y = maths::Barycentric(	glm::vec3(0, m_heights[m_grid.x][m_grid.z], 0),
-										glm::vec3(1, m_heights[m_grid.x + 1][m_grid.z], 0),
-										glm::vec3(0, m_heights[m_grid.x][m_grid.z + 1], 1),
-										glm::vec2(object.x, object.z));
-	}
-	else {
-
-		//--- If the object is in the right triangle, use Barycentric interpolation 
-		//--- to figure out the height of the terrain where the object is located
-		object.y = maths::Barycentric(	glm::vec3(1, m_heights[m_grid.x + 1][m_grid.z], 0),
-										glm::vec3(1, m_heights[m_grid.x + 1][m_grid.z + 1], 1),
-										glm::vec3(0, m_heights[m_grid.x][m_grid.z + 1], 1),
-										glm::vec2(object.x, object.z));
-	}
-	
-	//--- Finally, return the calculated height, plus any additional offset provided
-	//--- (add an offset for when you want objects to have an additional height, still relative to the terrain height, e.g birds!)
-	return object.y + offset;
+	//--- Then find the height of the grid square at this position
+	return TerrainBaker::GetHeight(m_heights, m_grid, x, z, offset);
 }
 
 
 /*******************************************************************************************************************
-	Function that loads in a grayscale heightmap image
-	References:
-	http://www.rastertek.com/tertut02.html
+	Function that builds a coarse mesh of the terrain (one vertex every 'step' grid squares) for occlusion culling
 *******************************************************************************************************************/
-bool Terrain::GenerateRawHeightMap()
+void Terrain::GetOccluderMesh(unsigned int step, std::vector<glm::vec3>& vertices, std::vector<unsigned int>& indices) const
 {
+	vertices.clear();
+	indices.clear();
+
+	if (m_heights.size() < 2 || step == 0) { return; }
+
 	//--- NOTE
-	// I use stb_image as I find it more lightweight than SDL for loading in simple heightmaps
+	// An occluder must never stick out above the real surface, or it would hide objects we can actually see.
+	// So each coarse vertex takes the lowest height of every coarse square touching it - that way every coarse
+	// triangle is below the lowest point of its own square, and so below the terrain everywhere.
+	// The grid is mapped back into world space the opposite way to GetHeight().
 	//---
+	int size	= (int)m_heights.size();
+	int squares	= (size - 1 + (int)step - 1) / (int)step;
 
-	std::string fileLocation	= "Assets\\Terrain\\Heightmaps\\" + m_heightMapFilename + ".png";
-	unsigned char* imageData	= nullptr;
-	int bytesPerPixel			= s_rgbOffset;
-	
-	//--- Load in the heightmap file. Image must be flipped vertically, otherwise pixel data will be read in incorrectly.
-	stbi_set_flip_vertically_on_load(true);
-	
-	//--- Note we pass in 3 as the bytesPerPixel (channel value) - we want to read only RBG values.
-	//--- If we wanted transparency we would change this to 4.
-	imageData = stbi_load(fileLocation.c_str(), &m_width, &m_height, &bytesPerPixel, bytesPerPixel);
-	
-	//--- Check the file loaded correctly.
-	if (!imageData) { 
-		COG_LOG("[TERRAIN] Problem loading heightmap file: ", fileLocation.c_str(), LOG_ERROR); 
-		GUI::Instance()->Popup("Heightmap file doesn't exist", "The heightmap file: " + fileLocation + " doesn't exist.");
-		return false;
-	}
-	
-	//--- Make sure the heightmap file has power of 2 dimensions, e.g. 128x128, 256x256, 512x512, etc.
-	if ((m_width & (m_width - 1)) != 0 || (m_height & (m_height - 1)) != 0) {
-		COG_LOG("[TERRAIN] Heightmap file is not power of 2 dimensions: ", fileLocation.c_str(), LOG_ERROR);
-		GUI::Instance()->Popup("Heightmap file is not power of 2 dimensions", "The heightmap file: " + fileLocation + " must be power of 2 e.g. 256 x 256 pixels.");
-		return false;
-	}
-
-	COG_LOG("[TERRAIN] Heightmap file loaded successfully: ", fileLocation.c_str(), LOG_SUCCESS);
+	vertices.reserve((squares + 1) * (squares + 1));
+	indices.reserve(squares * squares * 6);
 
-	//--- Create the structure to hold the height map data
-	m_map.resize((m_width) * (m_height));
-	
-	//--- Create the structure to hold the height data for terrain collision checks & normal calculations
-	m_heights.resize(m_width);
-	
-	//--- Temporary variables to aid us in storing the data correctly
-	unsigned char height	= 0;
-	int rgb					= 0;
-	int index				= 0;
+	for (int row = 0; row <= squares; row++) {
+		for (int column = 0; column <= squares; column++) {
 
-	//--- Loop through the heightmap pixels
-	for (int row = 0; row < m_height; row++) {
-		for (int column = 0; column < m_width; column++) {
+			int firstX	= std::max((column - 1) * (int)step, 0);
+			int lastX	= std::min((column + 1) * (int)step, size - 1);
+			int firstZ	= std::max((row - 1) * (int)step, 0);
+			int lastZ	= std::min((row + 1) * (int)step, size - 1);
 
-			//--- Set the height variable to the RGB pixel value read in from the heightmap file
-			height = imageData[rgb];
-	
-			//--- Create the structure to hold the height data for terrain collision checks & normal calculations
-			m_heights[column].resize(m_width);
-	
-			//--- Store the height of the terrain at this point into the heights container
-			//--- so we can access it later to determine collision and normals
-			m_heights[column][row] = height;
-	
-			//--- Move through the heightmap file and increment the index each time
-			index = (m_height * row) + column;
+			float height = m_heights[firstX][firstZ];
 
-			//--- Finally, set the heightmap data to the values calculated; y being the pixel data read
-			//--- in from the heightmap image, and x and z being the incrementation of our nested for loops (0 - width, 0 - height)
-			m_map[index].position.x = (float)column;
-			m_map[index].position.y = (float)height;
-			m_map[index].position.z = (float)row;
+			for (int x = firstX; x <= lastX; x++) {
+				for (int z = firstZ; z <= lastZ; z++) { height = std::min(height, m_heights[x][z]); }
+			}
 
-			m_map[index].textureCoord.s = (float)column;
-			m_map[index].textureCoord.t = (float)row;
+			float x = std::min(column * (int)step, size - 1) * m_grid.square;
+			float z = std::min(row * (int)step, size - 1) * m_grid.square;
 
-			//--- We only need to read in the 'r' (red) value, as RGB will be the same colour values, 
-			//--- due to it being a grayscale image. So, we increment by 3, skipping the green and blue colour values.
-			rgb += bytesPerPixel;
+			vertices.push_back(glm::vec3(x + m_transform.GetPosition().x, height, -(z + m_transform.GetPosition().z)));
 		}
 	}
 
-	//--- Delete the image data now we have it stored in our containers
-	if (imageData) {
-		stbi_image_free(imageData);
-	}
+	for (int row = 0; row < squares; row++) {
+		for (int column = 0; column < squares; column++) {
 
-	//--- NOTE 
-	// m_map struct could also have an 'a' float that we could use to store the alpha value,
-	// then do some fancy stuff with transparency later! (floating terrain/cliffs/black holes!)
-	// Also note that we don't currently store the terrain anywhere once it has been loaded in
-	// Every time a new game state is made, the terrain height map is loaded and the heightmap data is re-generated
-	// In future, we probably want to store this data somewhere in memory so we can just reference previous
-	// heightmap data, rather that loading it every time. Or, we could have a game object cache/object pool of some sort
-	//---
+			unsigned int bottomLeft = row * (squares + 1) + column;
+			unsigned int topLeft	= bottomLeft + (squares + 1);
 
-	return true;
+			indices.insert(indices.end(), { bottomLeft, bottomLeft + 1, topLeft, bottomLeft + 1, topLeft + 1, topLeft });
+		}
+	}
 }
 
 
 /*******************************************************************************************************************
-	Function that calculates terrain normals, using finite difference method 
-	References:
-	https://en.wikipedia.org/wiki/Finite_difference_method
-	https://www.youtube.com/watch?v=O9v6olrHPwI&list=PLRIWtICgwaX0u7Rf9zkZhLoLuZVfUksDP&index=21
+	Function that bakes the terrain geometry from a heightmap file - or re-uses a pre-baked file, if one exists
 *******************************************************************************************************************/
-void Terrain::CalculateNormals()
+bool Terrain::GenerateRawHeightMap()
 {
-	int index = 0;
-
-	//--- Neighbouring vertices - left, right, bottom and top
-	struct { float l, r, b, t; } neighbours = { 0 };
-	
-	for (int row = 0; row < m_height; row++) {
-		for (int column = 0; column < m_width; column++) {
+	//--- NOTE
+	// The heightmap stages (loading, leveling and normals) live in TerrainBaker, so they can be shared with the
+	// COGBake command-line tool. If the asset pipeline has already baked this heightmap at the same level, from the
+	// same heightmap files, we just load the result, otherwise we bake it here, spread over the job system's workers.
+	//---
 
-			index = (m_height * row) + column;
+	TerrainBaker baker(TerrainBaker::GetMaxThreads(), Game::Instance()->GetJobSystem());
+	std::string bakedLocation	= "Assets\\Terrain\\Baked\\" + m_heightMapFilename + ".bake";
+	std::string sourceLocation	= "Assets\\Terrain\\Heightmaps\\" + m_heightMapFilename;
 
-			//--- We calculate the height of all 4 neighbouring vertices
-			neighbours.l = FindHeightAtPoint(column - 1, row);
-			neighbours.r = FindHeightAtPoint(column + 1, row);
-			neighbours.b = FindHeightAtPoint(column, row - 1);
-			neighbours.t = FindHeightAtPoint(column, row + 1);
+	//--- A missing, corrupt, out of date or stale baked file is never fatal, we just bake the heightmap again
+	bool isLoaded = baker.Load(bakedLocation);
+	if (!isLoaded) { COG_LOG("[TERRAIN] No usable pre-baked heightmap file: ", baker.GetError().c_str(), LOG_WARN); }
 
-			//--- Then create the normal from the data generated above
-			glm::vec3 normal = glm::normalize(glm::vec3(neighbours.l - neighbours.r, 2.0f, neighbours.b - neighbours.t));
-			
-			m_map[index].normal = normal;
-		}
+	if (isLoaded && baker.GetGeometry().level == m_level && baker.GetGeometry().sourceStamp == TerrainBaker::GetSourceStamp(sourceLocation)) {
+		COG_LOG("[TERRAIN] Pre-baked heightmap file loaded successfully: ", bakedLocation.c_str(), LOG_SUCCESS);
+	}
+	else if (!baker.Bake(m_heightMapFilename, sourceLocation, m_level)) {
+		COG_LOG("[TERRAIN] Problem loading heightmap file: ", baker.GetError().c_str(), LOG_ERROR);
+		GUI::Instance()->Popup("Heightmap file could not be loaded", "The heightmap file: " + baker.GetError() + ". Heightmaps must be power of 2 e.g. 256 x 256 pixels.");
+		return false;
+	}
+	else {
+		COG_LOG("[TERRAIN] Heightmap file baked successfully: ", m_heightMapFilename.c_str(), LOG_SUCCESS);
 	}
-}
-
 
-/*******************************************************************************************************************
-	Function that returns the height of the terrain at a specific point
-*******************************************************************************************************************/
-float Terrain::FindHeightAtPoint(int column, int row)
-{
-	if (column < 0)			{ column = 0; }
-	if (row < 0)			{ row = 0; }
-	if (column >= m_width)	{ column = (m_width - 1); }
-	if (row >= m_height)	{ row = (m_height - 1); }
+	//--- Take ownership of the baked data, rather than copying it
+	TerrainBaker::Geometry& geometry = baker.GetGeometry();
 
-	return m_heights[column][row];
-}
+	m_width		= geometry.width;
+	m_height	= geometry.height;
+	m_grid		= geometry.grid;
+	m_map		= std::move(geometry.map);
+	m_heights	= std::move(geometry.heights);
 
+	//--- The heightmap file samples were in memory alongside the map and heights while they were being baked
+	MemoryUsage usage	= GetMemoryUsage();
+	usage.heightMapFile	= baker.GetStats().heightMapSize;
+	usage.total			+= usage.heightMapFile;
+	RecordPeakMemoryUsage(usage);
 
-/*******************************************************************************************************************
-	Function that levels out a heightmap (shrinks/expands the height/width/depth of terrain)
-*******************************************************************************************************************/
-void Terrain::LevelHeightMap()
-{
-	for (int row = 0; row < m_height; row++) {
-		for (int column = 0; column < m_width; column++) {
-			m_map[(m_height * row) + column].position.y	/= m_level;
-			m_heights[column][row]						/= m_level;
-		}
-	}
+	return true;
 }
 
 
@@ -347,121 +249,10 @@ void Terrain::LevelHeightMap()
 *******************************************************************************************************************/
 bool Terrain::GenerateTerrain()
 {
-	//--- We do -1 to make the width and height of terrain an odd number, necessary for accurate placement of vertex data
-	int offsetHeight	= (m_height - 1);
-	int offsetWidth		= (m_width - 1);
-
-	//--- Calculate number of vertices in terrain mesh (6 points/vertices to make 1 face - 2 x triangles, 3 points per triangle)
-	unsigned int vertexCount = (offsetHeight) * (offsetWidth) * s_vertexCount;
-
-	//--- Resize vector to the size of the vertex count
-	std::vector<VertexBuffer::PackedVertex> vertices(vertexCount);
-
-	unsigned int index	= 0;
-	
-	//--- Vertex positions for each vertex - bottom left, bottom right, top left and top right
-	struct { int bottomLeft, bottomRight, topLeft, topRight; } vertex = { 0 };
-
-	//--- Temporary variables for tangent and bitangent calculations
-	struct { glm::vec3 first, second; } deltaPosition = {};
-	struct { glm::vec2 first, second; } deltaTexCoord = {};
-	
-	float denominator	= 0.0f;
-	
-	glm::vec3 tangent	= glm::vec3(0.0f);
-	glm::vec3 bitangent = glm::vec3(0.0f);
-
-	//--- Loop through the terrain and place vertices in relevant positions, adding the data to the vertices vector
-	for (int row = 0; row < offsetHeight; row++) {
-		for (int column = 0; column < offsetWidth; column++) {
-			
-			//--- Calculate the vertex positions on the screen
-			vertex.bottomLeft	= (m_height * row) + column;
-			vertex.bottomRight	= (m_height * row) + (column + 1);
-			vertex.topLeft		= (m_height * (row + 1)) + column;
-			vertex.topRight		= (m_height * (row + 1)) + (column + 1);
-
-			//--- Ugly maths formula's to get the tangent and bitangent of the terrain for normal mapping.
-			//--- References: 
-			//--- http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-13-normal-mapping/
-			//--- https://learnopengl.com/Advanced-Lighting/Normal-Mapping
-			//--- This could be made a lot cleaner in future - but I kept it simple so that we can see how the terrain is generated
-			
-			//--- First Triangle
-			deltaPosition.first		= m_map[vertex.topLeft].position - m_map[vertex.topRight].position;
-			deltaPosition.second	= m_map[vertex.bottomLeft].position - m_map[vertex.topRight].position;
-			deltaTexCoord.first		= m_map[vertex.topLeft].textureCoord - m_map[vertex.topRight].textureCoord;
-			deltaTexCoord.second	= m_map[vertex.bottomLeft].textureCoord - m_map[vertex.topRight].textureCoord;
-
-			denominator	= 1.0f / (deltaTexCoord.first.x * deltaTexCoord.second.y - deltaTexCoord.second.x * deltaTexCoord.first.y);
-			tangent		= denominator * (deltaTexCoord.second.y * deltaPosition.first - deltaTexCoord.first.y * deltaPosition.second);
-			bitangent	= denominator * (-deltaTexCoord.second.x * deltaPosition.first + deltaTexCoord.first.x * deltaPosition.second);
-			
-			glm::normalize(tangent);
-			glm::normalize(bitangent);
-
-			vertices[index].position		= m_map[vertex.topRight].position;
-			vertices[index].textureCoord	= m_map[vertex.topRight].textureCoord;
-			vertices[index].normal			= m_map[vertex.topRight].normal;
-			vertices[index].tangent			= tangent;
-			vertices[index].bitangent		= bitangent;
-			index++;
-
-			vertices[index].position		= m_map[vertex.topLeft].position;
-			vertices[index].textureCoord	= m_map[vertex.topLeft].textureCoord;
-			vertices[index].normal			= m_map[vertex.topLeft].normal;
-			vertices[index].tangent			= tangent;
-			vertices[index].bitangent		= bitangent;
-			index++;
-
-			vertices[index].position		= m_map[vertex.bottomLeft].position;
-			vertices[index].textureCoord	= m_map[vertex.bottomLeft].textureCoord;
-			vertices[index].normal			= m_map[vertex.bottomLeft].normal;
-			vertices[index].tangent			= tangent;
-			vertices[index].bitangent		= bitangent;
-			index++;
-
-			//--- Second Triangle
-			deltaPosition.first		= m_map[vertex.bottomRight].position - m_map[vertex.bottomLeft].position;
-			deltaPosition.second	= m_map[vertex.topRight].position - m_map[vertex.bottomLeft].position;
-			deltaTexCoord.first		= m_map[vertex.bottomRight].textureCoord - m_map[vertex.bottomLeft].textureCoord;
-			deltaTexCoord.second	= m_map[vertex.topRight].textureCoord - m_map[vertex.bottomLeft].textureCoord;
-
-			denominator = 1.0f / (deltaTexCoord.first.x * deltaTexCoord.second.y - deltaTexCoord.second.x * deltaTexCoord.first.y);
-			tangent		= denominator * (deltaTexCoord.second.y * deltaPosition.first - deltaTexCoord.first.y * deltaPosition.second);
-			bitangent	= denominator * (-deltaTexCoord.second.x * deltaPosition.first + deltaTexCoord.first.x * deltaPosition.second);
-			
-			glm::normalize(tangent);
-			glm::normalize(bitangent);
-
-			vertices[index].position		= m_map[vertex.bottomLeft].position;
-			vertices[index].textureCoord	= m_map[vertex.bottomLeft].textureCoord;
-			vertices[index].normal			= m_map[vertex.bottomLeft].normal;
-			vertices[index].tangent			= tangent;
-			vertices[index].bitangent		= bitangent;
-			index++;
-
-			vertices[index].position		= m_map[vertex.bottomRight].position;
-			vertices[index].textureCoord	= m_map[vertex.bottomRight].textureCoord;
-			vertices[index].normal			= m_map[vertex.bottomRight].normal;
-			vertices[index].tangent			= tangent;
-			vertices[index].bitangent		= bitangent;
-			index++;
-
-			vertices[index].position		= m_map[vertex.topRight].position;
-			vertices[index].textureCoord	= m_map[vertex.topRight].textureCoord;
-			vertices[index].normal			= m_map[vertex.topRight].normal;
-			vertices[index].tangent			= tangent;
-			vertices[index].bitangent		= bitangent;
-			index++;
-		}
-	}
-
+	std::vector<VertexBuffer::PackedVertex> vertices;
+	TerrainBaker::GenerateVertices(m_width, m_height, m_map, vertices, TerrainBaker::GetMaxThreads(), Game::Instance()->GetJobSystem());
 
 	//--- NOTE
-	// The above generation of vertex data was previously encapsulated into one function
-	// However I have since wrote it out in its plainest form to make it easier to see what is happening
-	// The code looks ugly imo! But it is easier to understand this way, for those who haven't used heightmaps before
 	// Hint: Render the terrain in wireframe mode to see some magic happening ;)
 	//---
 
@@ -470,10 +261,58 @@ bool Terrain::GenerateTerrain()
 		Resource::Instance()->GetPackedVBO(m_tag)->Push(vertices, false);
 	Resource::Instance()->GetVAO(m_tag)->Unbind();
 
+	m_vertexBufferSize = vertices.size() * sizeof(VertexBuffer::PackedVertex);
+
+	//--- The vertex vector is freed when we leave this function, so this is the only time it is in memory
+	MemoryUsage usage	= GetMemoryUsage();
+	usage.vertices		= vertices.capacity() * sizeof(VertexBuffer::PackedVertex);
+	usage.total			+= usage.vertices;
+	RecordPeakMemoryUsage(usage);
+
 	return true;
 }
 
 
+/*******************************************************************************************************************
+	Function that returns the memory currently used by each part of the terrain
+*******************************************************************************************************************/
+Terrain::MemoryUsage Terrain::GetMemoryUsage() const
+{
+	//--- NOTE
+	// CPU sizes use the vector capacities (what was actually allocated), not the sizes. Heap bookkeeping isn't
+	// included. The texture sizes are asked from OpenGL, so shared textures are counted by every terrain using them.
+	//---
+
+	MemoryUsage usage = { 0, 0, 0, 0, 0, 0, 0 };
+
+	usage.map		= m_map.capacity() * sizeof(HeightMap);
+	usage.heights	= m_heights.capacity() * sizeof(std::vector<float>);
+
+	for (const auto& row : m_heights) { usage.heights += row.capacity() * sizeof(float); }
+
+	usage.vertexBuffer	= m_vertexBufferSize;
+	usage.textures		= m_textures.GetMemoryUsage() + m_normals.GetMemoryUsage();
+	usage.total			= usage.map + usage.heights + usage.vertexBuffer + usage.textures;
+
+	return usage;
+}
+
+
+/*******************************************************************************************************************
+	Function that keeps the largest size seen for each part of the terrain, and the largest total seen at once
+*******************************************************************************************************************/
+void Terrain::RecordPeakMemoryUsage(const MemoryUsage& usage)
+{
+	m_peakMemoryUsage.heightMapFile	= std::max(m_peakMemoryUsage.heightMapFile, usage.heightMapFile);
+	m_peakMemoryUsage.map			= std::max(m_peakMemoryUsage.map, usage.map);
+	m_peakMemoryUsage.heights		= std::max(m_peakMemoryUsage.heights, usage.heights);
+	m_peakMemoryUsage.vertices		= std::max(m_peakMemoryUsage.vertices, usage.vertices);
+	m_peakMemoryUsage.vertexBuffer	= std::max(m_peakMemoryUsage.vertexBuffer, usage.vertexBuffer);
+	m_peakMemoryUsage.textures		= std::max(m_peakMemoryUsage.textures, usage.textures);
+	m_peakMemoryUsage.total			= std::max(m_peakMemoryUsage.total, usage.total);
+}
+
+
 /*******************************************************************************************************************
 	Function that updates the terrain providing any changes have happened
 *******************************************************************************************************************/
@@ -487,10 +326,20 @@ void Terrain::Update()
 	Function that renders the terrain to the screen
 *******************************************************************************************************************/
 void Terrain::Render(Shader* shader)
+{
+	Render(shader, m_minimapMode);
+}
+
+
+/*******************************************************************************************************************
+	Function that renders the terrain to the screen in the given minimap mode, without changing the terrain's own
+	(so the render thread never writes to the terrain)
+*******************************************************************************************************************/
+void Terrain::Render(Shader* shader, bool minimapMode)
 {
 	if (TerrainShader* terrainShader = Downcast<TerrainShader>(shader)) {
 
-		terrainShader->SetInstanceData(&m_transform, m_textures.GetBlendMap(), m_minimapMode);
+		terrainShader->SetInstanceData(&m_transform, m_textures.GetBlendMap(), minimapMode);
 
 		m_textures.Bind();
 		m_normals.Bind();
@@ -512,12 +361,12 @@ Terrain::WorldBounds* Terrain::GetBounds()		{ return &m_bounds; }
 bool Terrain::IsMinimapEnabled()				{ return m_minimapMode; }
 void Terrain::SetMinimapMode(bool minimapMode)	{ m_minimapMode = minimapMode; }
 
+const Terrain::MemoryUsage& Terrain::GetPeakMemoryUsage() const	{ return m_peakMemoryUsage; }
+
 
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
-const unsigned int Terrain::s_rgbOffset		= 3;
-const unsigned int Terrain::s_vertexCount	= 6;
 const unsigned int Terrain::s_maxTextures	= 5;
 const unsigned int Terrain::s_maxNormalMaps	= 4;
 
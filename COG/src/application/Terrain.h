@@ -3,7 +3,7 @@
 /*******************************************************************************************************************
 	Terrain.h, Terrain.cpp
 	Created by Kim Kane
-	Last updated: 17/03/2018
+	Last updated: 18/10/2026
 
 	Terrain class that loads in pixel data from a heightmap file, allowing open-world multi-height terrain generation.
 	
@@ -15,11 +15,13 @@
 	2D grid implementation, useful for trigger points/spawn locations/grid collisions.
 	Normal generation using finite difference method (good for lighting!)
 	Tangent and bitangent support for normal mapping.
+	Raw 16-bit/32-bit heightmaps and 16-bit PNG heightmaps (memory mapped/decoded via HeightMapLoader, in a single pass).
+	Heightmap baking is done by TerrainBaker (multi-threaded), and pre-baked files from the COGBake tool are used if they exist.
+	Memory usage per component (heightmap, heights, vertices, vertex buffer and textures), at steady state and at peak.
 
 	[Upcoming]
 	Indexed rendering of terrain mesh.
 	Terrain will be a complete mesh in future using a PackedVertex struct like every other mesh.
-	Tangents and bitangents will be calculated elsewhere.
 	OBJ parser allowing us to save the terrain mesh we generated to an obj file & then load in binary form (faster load times).
 	Terrain will be cached in memory - allowing re-use of an already generated heightmap.
 
@@ -28,6 +30,8 @@
 	An alpha channel is not necessary (unless you want to mimic holes or semi-transparent illusions in your terrain).
 	Due to this, I use PNG files for the heightmap, but ignore the alpha channel.
 	In future, if we decided to have transparency, this would be simple to implement.
+	If a raw .r16/.raw (little-endian 16-bit) or .r32 (little-endian float) file exists with the same name, it is used instead
+	of the PNG. Heights are always scaled to the 0 - 255 range, so the level value works the same for every format.
 
 	This class is a forever on-going project of mine (I will need it for my dissertation)
 	and it will continue being updated constantly. It is impossible to do the work in the time frame 
@@ -38,6 +42,7 @@
 #include <string>
 #include <vector>
 #include "application/GameObject.h"
+#include "application/TerrainBaker.h"
 #include "graphics/TexturePack.h"
 
 class Terrain : public GameObject {
@@ -64,29 +69,8 @@ class Terrain : public GameObject {
 	}
 
 private:
-	struct HeightMap {
-		glm::vec3 position;
-		glm::vec2 textureCoord;
-		glm::vec3 normal;
-
-		template <class Archive>
-		void Serialize(Archive& archive)
-		{
-			archive(COG_NVP(position), COG_NVP(textureCoord), COG_NVP(normal));
-		}
-	};
-
-	struct TerrainGrid {
-		int x, z;
-		float length;
-		float square;
-
-		template <class Archive>
-		void Serialize(Archive& archive)
-		{
-			archive(COG_NVP(x), COG_NVP(z), COG_NVP(length), COG_NVP(square));
-		}
-	};
+	typedef TerrainBaker::HeightMap		HeightMap;
+	typedef TerrainBaker::TerrainGrid	TerrainGrid;
 
 	struct WorldBounds {
 		glm::vec3 minimum, maximum;
@@ -98,6 +82,14 @@ private:
 		}
 	};
 
+public:
+	//--- Sizes are in bytes. At steady state the heightmap file and vertices are always 0, as they only exist
+	//--- while the terrain is being built. For the peak, each component is its own peak and the total is the
+	//--- most memory that was in use at any one time (which is less than the sum, as the stages don't overlap)
+	struct MemoryUsage {
+		size_t heightMapFile, map, heights, vertices, vertexBuffer, textures, total;
+	};
+
 public:
 	Terrain();
 	virtual ~Terrain();
@@ -105,6 +97,7 @@ public:
 public:
 	virtual void Update()				override;
 	virtual void Render(Shader* shader) override;
+	void Render(Shader* shader, bool minimapMode);
 	
 public:
 	bool SaveRawHeightMapData(const std::string& tag, const Transform& transform, const TexturePack& textures, const TexturePack& normals,
@@ -115,6 +108,7 @@ public:
 
 public:
 	float			GetHeight(float xPosition, float zPosition, float offset = 0.0f);
+	void			GetOccluderMesh(unsigned int step, std::vector<glm::vec3>& vertices, std::vector<unsigned int>& indices) const;
 	TerrainGrid*	GetGrid();
 	WorldBounds*	GetBounds();
 	TexturePack*	GetDiffuseTexturePack() { return &m_textures; }
@@ -125,20 +119,20 @@ public:
 	void SetMinimapMode(bool minimapMode);
 	bool IsMinimapEnabled();
 
+public:
+	MemoryUsage			GetMemoryUsage() const;
+	const MemoryUsage&	GetPeakMemoryUsage() const;
+
 public:
 	static const unsigned int GetMaxTextures();
 	static const unsigned int GetMaxNormalMaps();
 	
 private:
 	bool GenerateRawHeightMap();
-	void LevelHeightMap();
-	void CalculateNormals();
 	bool GenerateTerrain();
 	bool PushDataToGPU();
+	void RecordPeakMemoryUsage(const MemoryUsage& usage);
 
-private:
-	float FindHeightAtPoint(int column, int row);
-	
 private:
 	std::string m_heightMapFilename;
 	int		m_width, m_height;
@@ -155,9 +149,11 @@ private:
 	std::vector<HeightMap>			m_map;
 	std::vector<std::vector<float>> m_heights;
 
+private:
+	size_t		m_vertexBufferSize;
+	MemoryUsage	m_peakMemoryUsage;
+
 private:
 	static const unsigned int s_maxTextures;
 	static const unsigned int s_maxNormalMaps;
-	static const unsigned int s_rgbOffset;
-	static const unsigned int s_vertexCount;
 };
\ No newline at end of file
@@ -0,0 +1,439 @@
+#include "TerrainBaker.h"
+#include <cmath>
+#include <fstream>
+#include "utilities/HeightMapLoader.h"
+#include "utilities/Maths.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+TerrainBaker::TerrainBaker(unsigned int threadCount, JobSystem* jobSystem)
+	:	m_geometry({ "", 0, 0, 1.0f, { 0, 0, 0.0f, 0.0f }, {}, {}, 0 }),
+		m_stats({ 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0, 0 }),
+		m_threadCount((threadCount > 0) ? threadCount : GetMaxThreads()),
+		m_jobSystem(jobSystem)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+TerrainBaker::~TerrainBaker()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Runs every heightmap stage of a bake - load, level, normals and grid - timing each stage as it goes
+*******************************************************************************************************************/
+bool TerrainBaker::Bake(const std::string& heightMapFilename, const std::string& fileLocation, float level)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	//--- Stamped before loading, so a heightmap changed part way through a bake is simply baked again next time
+	m_geometry.sourceStamp = GetSourceStamp(fileLocation);
+
+	//--- Generate the heightmap for the terrain
+	if (!GenerateHeightMap(fileLocation)) { return false; }
+	m_stats.loadTime = GetElapsedTime(start);
+
+	//--- Level out the heightmap so that the height of the terrain is not too high
+	start = std::chrono::steady_clock::now();
+	LevelHeightMap(level);
+	m_stats.levelTime = GetElapsedTime(start);
+
+	//--- Calculate normals for terrain lighting (make sure this is done after leveling the terrain)
+	start = std::chrono::steady_clock::now();
+	CalculateNormals();
+	m_stats.normalsTime = GetElapsedTime(start);
+
+	//--- Calculate the terrain grid length
+	m_geometry.grid.length = (float)(m_geometry.heights.size() - 1);
+
+	//--- Determine the grids square size. Will always be 1 in this case
+	m_geometry.grid.square = (float)(m_geometry.width - 1) / m_geometry.grid.length;
+
+	m_geometry.heightMapFilename	= heightMapFilename;
+	m_stats.geometrySize			= GetGeometrySize(m_geometry);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Saves the baked geometry to a cereal binary file
+*******************************************************************************************************************/
+bool TerrainBaker::Save(const std::string& fileLocation)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	std::ofstream stream(fileLocation, std::ios::binary);
+	if (!stream.is_open()) { m_error = "Could not open file for writing: " + fileLocation; return false; }
+
+	{
+		cereal::BinaryOutputArchive archive(stream); archive(s_fileMagic, s_fileVersion, m_geometry.sourceStamp, m_geometry);
+	}
+
+	m_stats.fileSize = (size_t)stream.tellp();
+	m_stats.saveTime = GetElapsedTime(start);
+
+	if (!stream.good()) { m_error = "Problem writing file: " + fileLocation; return false; }
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Loads previously baked geometry from a cereal binary file
+*******************************************************************************************************************/
+bool TerrainBaker::Load(const std::string& fileLocation)
+{
+	std::ifstream stream(fileLocation, std::ios::binary);
+	if (!stream.is_open()) { m_error = "Baked terrain file doesn't exist: " + fileLocation; return false; }
+
+	//--- cereal reports a truncated or corrupt file by throwing (or a garbage length can fail to allocate), which we
+	//--- turn into a normal error
+	try {
+		cereal::BinaryInputArchive archive(stream);
+
+		//--- Files from before the header (or an older format) are turned away before any of the geometry is read
+		uint32_t magic = 0, version = 0;
+		archive(magic, version);
+
+		if (magic != s_fileMagic || version != s_fileVersion) {
+			m_error = "Baked terrain file is out of date: " + fileLocation; return false;
+		}
+
+		archive(m_geometry.sourceStamp, m_geometry);
+	}
+	catch (const std::exception& exception) {
+		m_error = "Baked terrain file is corrupt: " + fileLocation + " (" + exception.what() + ")";
+		return false;
+	}
+
+	m_stats.geometrySize = GetGeometrySize(m_geometry);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that loads in a heightmap file and stores the heights and heightmap vertex data, in a single pass
+	References:
+	http://www.rastertek.com/tertut02.html
+*******************************************************************************************************************/
+bool TerrainBaker::GenerateHeightMap(const std::string& fileLocation)
+{
+	HeightMapLoader heightMap;
+
+	if (!heightMap.Load(fileLocation)) {
+		m_error = heightMap.GetError() + ": " + heightMap.GetFileLocation();
+		return false;
+	}
+
+	int width	= heightMap.GetWidth();
+	int height	= heightMap.GetHeight();
+
+	m_geometry.width	= width;
+	m_geometry.height	= height;
+
+	//--- Create the structure to hold the height map data
+	m_geometry.map.resize((size_t)width * height);
+
+	//--- Create the structure to hold the height data for terrain collision checks & normal calculations
+	m_geometry.heights.assign(width, std::vector<float>(height));
+
+	std::vector<HeightMap>& map				= m_geometry.map;
+	std::vector<std::vector<float>>& heights	= m_geometry.heights;
+
+	//--- Loop through the heightmap samples, storing each one straight into our containers
+	heightMap.ForEachSample([width, &map, &heights](int column, int row, float sample) {
+
+		//--- Store the height of the terrain at this point into the heights container
+		//--- so we can access it later to determine collision and normals
+		heights[column][row] = sample;
+
+		//--- Set the heightmap data; y being the height read in from the heightmap file,
+		//--- and x and z being the incrementation of our nested loops (0 - width, 0 - height)
+		HeightMap& point = map[((size_t)width * row) + column];
+
+		point.position		= glm::vec3((float)column, sample, (float)row);
+		point.textureCoord	= glm::vec2((float)column, (float)row);
+	});
+
+	//--- Keep track of how much sample data we read in
+	size_t sampleSize = 1;
+	if		(heightMap.GetFormat() == HeightMapLoader::FORMAT_RAW32) { sampleSize = sizeof(float); }
+	else if (heightMap.GetFormat() != HeightMapLoader::FORMAT_PNG8)	{ sampleSize = sizeof(uint16_t); }
+
+	m_stats.heightMapSize = (size_t)width * height * sampleSize;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that levels out a heightmap (shrinks/expands the height/width/depth of terrain)
+*******************************************************************************************************************/
+void TerrainBaker::LevelHeightMap(float level)
+{
+	m_geometry.level = level;
+
+	ParallelRows(m_geometry.height, m_threadCount, m_jobSystem, [this, level](int first, int last) {
+		for (int row = first; row < last; row++) {
+			for (int column = 0; column < m_geometry.width; column++) {
+				m_geometry.map[((size_t)m_geometry.width * row) + column].position.y	/= level;
+				m_geometry.heights[column][row]										/= level;
+			}
+		}
+	});
+}
+
+
+/*******************************************************************************************************************
+	Function that calculates terrain normals, using finite difference method
+	References:
+	https://en.wikipedia.org/wiki/Finite_difference_method
+	https://www.youtube.com/watch?v=O9v6olrHPwI&list=PLRIWtICgwaX0u7Rf9zkZhLoLuZVfUksDP&index=21
+*******************************************************************************************************************/
+void TerrainBaker::CalculateNormals()
+{
+	//--- Each row only reads heights and writes its own normals, so rows can safely be calculated in parallel
+	ParallelRows(m_geometry.height, m_threadCount, m_jobSystem, [this](int first, int last) {
+
+		//--- Neighbouring vertices - left, right, bottom and top
+		struct { float l, r, b, t; } neighbours = { 0 };
+
+		for (int row = first; row < last; row++) {
+			for (int column = 0; column < m_geometry.width; column++) {
+
+				//--- We calculate the height of all 4 neighbouring vertices
+				neighbours.l = FindHeightAtPoint(column - 1, row);
+				neighbours.r = FindHeightAtPoint(column + 1, row);
+				neighbours.b = FindHeightAtPoint(column, row - 1);
+				neighbours.t = FindHeightAtPoint(column, row + 1);
+
+				//--- Then create the normal from the data generated above
+				m_geometry.map[((size_t)m_geometry.width * row) + column].normal =
+					glm::normalize(glm::vec3(neighbours.l - neighbours.r, 2.0f, neighbours.b - neighbours.t));
+			}
+		}
+	});
+}
+
+
+/*******************************************************************************************************************
+	Function that generates the terrain vertices for the geometry we baked, timing the generation
+*******************************************************************************************************************/
+void TerrainBaker::GenerateVertices(std::vector<PackedVertex>& vertices)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	GenerateVertices(m_geometry.width, m_geometry.height, m_geometry.map, vertices, m_threadCount, m_jobSystem);
+
+	m_stats.verticesTime	= GetElapsedTime(start);
+	m_stats.vertexSize		= vertices.size() * sizeof(PackedVertex);
+}
+
+
+/*******************************************************************************************************************
+	Function that generates the terrain vertex positions, prior to sending the data to GPU for rendering
+*******************************************************************************************************************/
+void TerrainBaker::GenerateVertices(int width, int height, const std::vector<HeightMap>& map, std::vector<PackedVertex>& vertices, unsigned int threadCount,
+									JobSystem* jobSystem)
+{
+	//--- We do -1 to make the width and height of terrain an odd number, necessary for accurate placement of vertex data
+	int offsetHeight	= (height - 1);
+	int offsetWidth		= (width - 1);
+
+	if (offsetHeight <= 0 || offsetWidth <= 0) { vertices.clear(); return; }
+
+	//--- Calculate number of vertices in terrain mesh (6 points/vertices to make 1 face - 2 x triangles, 3 points per triangle)
+	//--- and resize vector to the size of the vertex count
+	vertices.resize((size_t)offsetHeight * offsetWidth * s_vertexCount);
+
+	//--- Every grid square writes to its own 6 vertices, so each thread can take a block of rows without locking
+	ParallelRows(offsetHeight, threadCount, jobSystem, [width, offsetWidth, &map, &vertices](int first, int last) {
+
+		//--- Vertex positions for each vertex - bottom left, bottom right, top left and top right
+		struct { size_t bottomLeft, bottomRight, topLeft, topRight; } vertex = { 0 };
+
+		//--- Temporary variables for tangent and bitangent calculations
+		struct { glm::vec3 first, second; } deltaPosition = {};
+		struct { glm::vec2 first, second; } deltaTexCoord = {};
+
+		float denominator	= 0.0f;
+
+		glm::vec3 tangent	= glm::vec3(0.0f);
+		glm::vec3 bitangent = glm::vec3(0.0f);
+
+		size_t index = (size_t)first * offsetWidth * s_vertexCount;
+
+		for (int row = first; row < last; row++) {
+			for (int column = 0; column < offsetWidth; column++) {
+
+				//--- Calculate the vertex positions on the screen
+				vertex.bottomLeft	= ((size_t)width * row) + column;
+				vertex.bottomRight	= ((size_t)width * row) + (column + 1);
+				vertex.topLeft		= ((size_t)width * (row + 1)) + column;
+				vertex.topRight		= ((size_t)width * (row + 1)) + (column + 1);
+
+				//--- Ugly maths formula's to get the tangent and bitangent of the terrain for normal mapping.
+				//--- References:
+				//--- http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-13-normal-mapping/
+				//--- https://learnopengl.com/Advanced-Lighting/Normal-Mapping
+
+				//--- First Triangle
+				deltaPosition.first		= map[vertex.topLeft].position - map[vertex.topRight].position;
+				deltaPosition.second	= map[vertex.bottomLeft].position - map[vertex.topRight].position;
+				deltaTexCoord.first		= map[vertex.topLeft].textureCoord - map[vertex.topRight].textureCoord;
+				deltaTexCoord.second	= map[vertex.bottomLeft].textureCoord - map[vertex.topRight].textureCoord;
+
+				denominator	= 1.0f / (deltaTexCoord.first.x * deltaTexCoord.second.y - deltaTexCoord.second.x * deltaTexCoord.first.y);
+				tangent		= denominator * (deltaTexCoord.second.y * deltaPosition.first - deltaTexCoord.first.y * deltaPosition.second);
+				bitangent	= denominator * (-deltaTexCoord.second.x * deltaPosition.first + deltaTexCoord.first.x * deltaPosition.second);
+
+				vertices[index++] = { map[vertex.topRight].position, map[vertex.topRight].textureCoord, map[vertex.topRight].normal, tangent, bitangent };
+				vertices[index++] = { map[vertex.topLeft].position, map[vertex.topLeft].textureCoord, map[vertex.topLeft].normal, tangent, bitangent };
+				vertices[index++] = { map[vertex.bottomLeft].position, map[vertex.bottomLeft].textureCoord, map[vertex.bottomLeft].normal, tangent, bitangent };
+
+				//--- Second Triangle
+				deltaPosition.first		= map[vertex.bottomRight].position - map[vertex.bottomLeft].position;
+				deltaPosition.second	= map[vertex.topRight].position - map[vertex.bottomLeft].position;
+				deltaTexCoord.first		= map[vertex.bottomRight].textureCoord - map[vertex.bottomLeft].textureCoord;
+				deltaTexCoord.second	= map[vertex.topRight].textureCoord - map[vertex.bottomLeft].textureCoord;
+
+				denominator	= 1.0f / (deltaTexCoord.first.x * deltaTexCoord.second.y - deltaTexCoord.second.x * deltaTexCoord.first.y);
+				tangent		= denominator * (deltaTexCoord.second.y * deltaPosition.first - deltaTexCoord.first.y * deltaPosition.second);
+				bitangent	= denominator * (-deltaTexCoord.second.x * deltaPosition.first + deltaTexCoord.first.x * deltaPosition.second);
+
+				vertices[index++] = { map[vertex.bottomLeft].position, map[vertex.bottomLeft].textureCoord, map[vertex.bottomLeft].normal, tangent, bitangent };
+				vertices[index++] = { map[vertex.bottomRight].position, map[vertex.bottomRight].textureCoord, map[vertex.bottomRight].normal, tangent, bitangent };
+				vertices[index++] = { map[vertex.topRight].position, map[vertex.topRight].textureCoord, map[vertex.topRight].normal, tangent, bitangent };
+			}
+		}
+	});
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the height of a given x and z position, relative to the terrain (for collision)
+*******************************************************************************************************************/
+float TerrainBaker::GetHeight(const std::vector<std::vector<float>>& heights, TerrainGrid& grid, float x, float z, float offset)
+{
+	//--- Determine which grid square the object is in
+	grid.x = (int)std::floor(x / grid.square);
+	grid.z = (int)std::floor(z / grid.square);
+
+	//--- Make sure the object coordinates are within a valid grid square on the terrain, if not return the height as 0
+	if (grid.x >= grid.length || grid.z >= grid.length || grid.x < 0 || grid.z < 0)
+	{
+		return 0.0f;
+	}
+
+	//--- Find out where on the grid square the object is located.
+	//--- Get the x and z distance of object from top left corner of the grid square by using % operator,
+	//--- and then divide the result by the grid square size, which will give us an x and z coordinate between 0 and 1.
+	glm::vec3 object = glm::vec3(0.0f);
+	object.x = (std::fmod(x, grid.square)) / grid.square;
+	object.z = (std::fmod(z, grid.square)) / grid.square;
+
+	//--- The grid square is made up of 2 triangles, so figure out which triangle within the grid square the object is standing on
+	if (object.x <= (1 - object.z)) {
+
+		//--- If the object is in the left triangle, use Barycentric interpolation
+		//--- to figure out the height of the terrain where the object is located
+		object.y = maths::Barycentric(	glm::vec3(0, heights[grid.x][grid.z], 0),
+										glm::vec3(1, heights[grid.x + 1][grid.z], 0),
+										glm::vec3(0, heights[grid.x][grid.z + 1], 1),
+										glm::vec2(object.x, object.z));
+	}
+	else {
+
+		//--- If the object is in the right triangle, use Barycentric interpolation
+		//--- to figure out the height of the terrain where the object is located
+		object.y = maths::Barycentric(	glm::vec3(1, heights[grid.x + 1][grid.z], 0),
+										glm::vec3(1, heights[grid.x + 1][grid.z + 1], 1),
+										glm::vec3(0, heights[grid.x][grid.z + 1], 1),
+										glm::vec2(object.x, object.z));
+	}
+
+	//--- Finally, return the calculated height, plus any additional offset provided
+	//--- (add an offset for when you want objects to have an additional height, still relative to the terrain height, e.g birds!)
+	return object.y + offset;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the height of the terrain at a specific point
+*******************************************************************************************************************/
+float TerrainBaker::FindHeightAtPoint(int column, int row) const
+{
+	if (column < 0)						{ column = 0; }
+	if (row < 0)						{ row = 0; }
+	if (column >= m_geometry.width)		{ column = (m_geometry.width - 1); }
+	if (row >= m_geometry.height)		{ row = (m_geometry.height - 1); }
+
+	return m_geometry.heights[column][row];
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+TerrainBaker::Geometry& TerrainBaker::GetGeometry()				{ return m_geometry; }
+const TerrainBaker::Stats& TerrainBaker::GetStats() const		{ return m_stats; }
+const std::string& TerrainBaker::GetError() const				{ return m_error; }
+unsigned int TerrainBaker::GetThreadCount() const				{ return m_threadCount; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const unsigned int TerrainBaker::s_vertexCount	= 6;
+const int TerrainBaker::s_minRowsPerThread		= 32;
+const uint32_t TerrainBaker::s_fileMagic		= 0x54474F43;
+const uint32_t TerrainBaker::s_fileVersion		= 1;
+
+unsigned int TerrainBaker::GetMaxThreads()
+{
+	unsigned int threads = std::thread::hardware_concurrency();
+	return (threads > 0) ? threads : 1;
+}
+
+size_t TerrainBaker::GetGeometrySize(const Geometry& geometry)
+{
+	size_t size = geometry.map.size() * sizeof(HeightMap);
+	for (const auto& column : geometry.heights) { size += column.size() * sizeof(float); }
+	return size;
+}
+
+uint64_t TerrainBaker::GetSourceStamp(const std::string& fileLocation)
+{
+	//--- Every file HeightMapLoader could read the heightmap from (pass the location without an extension), so adding,
+	//--- removing or changing any of them changes the stamp. FNV-1a over each one's extension and contents
+	uint64_t stamp = 14695981039346656037ull;
+	auto hash = [&stamp](const char* bytes, size_t size) { for (size_t i = 0; i < size; i++) { stamp = (stamp ^ (uint8_t)bytes[i]) * 1099511628211ull; } };
+
+	std::vector<char> buffer(1 << 16);
+
+	for (const char* extension : { ".r16", ".raw", ".r32", ".png" }) {
+
+		std::ifstream stream(fileLocation + extension, std::ios::binary);
+		if (!stream.is_open()) { continue; }
+
+		hash(extension, std::char_traits<char>::length(extension));
+
+		while (stream.read(buffer.data(), buffer.size()) || stream.gcount() > 0) { hash(buffer.data(), (size_t)stream.gcount()); }
+	}
+
+	return stamp;
+}
+
+double TerrainBaker::GetElapsedTime(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#pragma once
+
+/*******************************************************************************************************************
+	TerrainBaker.h, TerrainBaker.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Bakes a heightmap file into terrain geometry - the heights, the heightmap vertex data, normals and the terrain grid.
+	This is the part of terrain generation that doesn't need a window or a GPU, split out of the Terrain class.
+
+	[Features]
+	Heightmap loading (any format supported by HeightMapLoader).
+	Leveling, normal generation (finite difference method) and vertex generation, split across rows over multiple threads
+	(as jobs, when given a running JobSystem - otherwise each stage spins up its own threads).
+	Height queries using barycentric coordinates (used by the terrain for collision).
+	Timings and data sizes for every stage of the bake, so the asset pipeline can see where the time goes.
+	Saving/loading of baked geometry, so a terrain can skip the heightmap stages entirely.
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	This class must not include anything that depends on SDL, OpenGL, Windows or the engine singletons - it is
+	compiled into both the game and the COGBake command-line tool, which runs on build machines with no display.
+	Errors are returned as strings via GetError() rather than logged, so each side can report them its own way.
+	Baked files start with a magic number, a format version (s_fileVersion) and a stamp of the heightmap they were
+	baked from (GetSourceStamp()). The version must be bumped whenever Geometry changes - a file from an older
+	version fails to load as out of date, and one whose stamp no longer matches its heightmap files is baked again.
+	The stamp is a hash of the heightmap files' contents rather than their times, so baked files copied along with
+	the heightmaps (e.g. from the build machines) are still used.
+
+*******************************************************************************************************************/
+#ifndef COG_NVP
+	#define COG_NVP(T) CEREAL_NVP(T)
+#endif
+
+#include <pretty_glm/glm.hpp>
+#include <pretty_cereal/includes.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "graphics/buffers/PackedVertex.h"
+#include "utilities/JobSystem.h"
+
+class TerrainBaker {
+
+public:
+	struct HeightMap {
+		glm::vec3 position;
+		glm::vec2 textureCoord;
+		glm::vec3 normal;
+
+		template <class Archive>
+		void Serialize(Archive& archive)
+		{
+			archive(COG_NVP(position), COG_NVP(textureCoord), COG_NVP(normal));
+		}
+	};
+
+	struct TerrainGrid {
+		int x, z;
+		float length;
+		float square;
+
+		template <class Archive>
+		void Serialize(Archive& archive)
+		{
+			archive(COG_NVP(x), COG_NVP(z), COG_NVP(length), COG_NVP(square));
+		}
+	};
+
+	struct Geometry {
+		std::string heightMapFilename;
+		int width, height;
+		float level;
+		TerrainGrid grid;
+		std::vector<HeightMap> map;
+		std::vector<std::vector<float>> heights;
+		uint64_t sourceStamp;
+
+		//--- The source stamp is written in the file's header, ahead of the rest (see Save())
+		template <class Archive>
+		void Serialize(Archive& archive)
+		{
+			archive(COG_NVP(heightMapFilename), COG_NVP(width), COG_NVP(height), COG_NVP(level), COG_NVP(grid), COG_NVP(map), COG_NVP(heights));
+		}
+	};
+
+	//--- Timings are in milliseconds, sizes are in bytes
+	struct Stats {
+		double loadTime, levelTime, normalsTime, verticesTime, saveTime;
+		size_t heightMapSize, geometrySize, vertexSize, fileSize;
+	};
+
+public:
+	TerrainBaker(unsigned int threadCount = 1, JobSystem* jobSystem = nullptr);
+	~TerrainBaker();
+
+public:
+	bool Bake(const std::string& heightMapFilename, const std::string& fileLocation, float level);
+	bool Save(const std::string& fileLocation);
+	bool Load(const std::string& fileLocation);
+
+public:
+	bool GenerateHeightMap(const std::string& fileLocation);
+	void LevelHeightMap(float level);
+	void CalculateNormals();
+	void GenerateVertices(std::vector<PackedVertex>& vertices);
+
+public:
+	static void GenerateVertices(int width, int height, const std::vector<HeightMap>& map, std::vector<PackedVertex>& vertices, unsigned int threadCount = 1,
+								 JobSystem* jobSystem = nullptr);
+	static float GetHeight(const std::vector<std::vector<float>>& heights, TerrainGrid& grid, float x, float z, float offset = 0.0f);
+
+public:
+	Geometry&			GetGeometry();
+	const Stats&		GetStats() const;
+	const std::string&	GetError() const;
+	unsigned int		GetThreadCount() const;
+
+public:
+	static unsigned int	GetMaxThreads();
+	static size_t		GetGeometrySize(const Geometry& geometry);
+	static uint64_t		GetSourceStamp(const std::string& fileLocation);
+
+private:
+	TerrainBaker(const TerrainBaker&)				= delete;
+	TerrainBaker& operator=(const TerrainBaker&)	= delete;
+
+private:
+	float FindHeightAtPoint(int column, int row) const;
+
+private:
+	static double GetElapsedTime(const std::chrono::steady_clock::time_point& start);
+
+private:
+	template <typename T> static void ParallelRows(int rows, unsigned int threadCount, JobSystem* jobSystem, T job);
+
+private:
+	Geometry		m_geometry;
+	Stats			m_stats;
+	std::string		m_error;
+	unsigned int	m_threadCount;
+	JobSystem*		m_jobSystem;
+
+private:
+	static const unsigned int s_vertexCount;
+	static const int s_minRowsPerThread;
+	static const uint32_t s_fileMagic;
+	static const uint32_t s_fileVersion;
+};
+
+/*******************************************************************************************************************
+	Template function that splits the rows [0, rows) into one contiguous block per thread and runs job(first, last)
+	on each block. The calling thread takes the first block, so a thread count of 1 never creates a thread.
+	With a running job system, the blocks are run as jobs instead (and the thread count is ignored).
+*******************************************************************************************************************/
+template <typename T> void TerrainBaker::ParallelRows(int rows, unsigned int threadCount, JobSystem* jobSystem, T job)
+{
+	if (jobSystem && jobSystem->IsRunning()) {
+		jobSystem->ParallelFor((unsigned int)rows, (unsigned int)s_minRowsPerThread, [&job](unsigned int first, unsigned int last) { job((int)first, (int)last); });
+		return;
+	}
+
+	//--- Don't bother spinning up threads for tiny blocks of work - the thread creation would cost more than the work
+	int blocks = (int)threadCount;
+	if (blocks > rows / s_minRowsPerThread) { blocks = rows / s_minRowsPerThread; }
+	if (blocks < 1) { blocks = 1; }
+
+	std::vector<std::thread> threads;
+	threads.reserve(blocks - 1);
+
+	int rowsPerBlock = (rows + blocks - 1) / blocks;
+
+	for (int block = 1; block < blocks; block++) {
+		int first	= block * rowsPerBlock;
+		int last	= (first + rowsPerBlock < rows) ? first + rowsPerBlock : rows;
+		if (first < last) { threads.emplace_back(job, first, last); }
+	}
+
+	job(0, (rowsPerBlock < rows) ? rowsPerBlock : rows);
+
+	for (auto& thread : threads) { thread.join(); }
+}
\ No newline at end of file
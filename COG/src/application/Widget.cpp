@@ -1,4 +1,5 @@
 #include "Widget.h"
+#include "graphics/FramePacket.h"
 #include "graphics/shaders/InterfaceShader.h"
 #include "utilities/Tools.h"
 #include "managers/InputManager.h"
@@ -112,6 +113,19 @@ void Widget::Render(Shader* shader)
 }
 
 
+/*******************************************************************************************************************
+	Function that adds the widget (and its open/close button) to a frame packet, for the render thread to draw
+*******************************************************************************************************************/
+void Widget::Submit(FramePacket& packet)
+{
+	if (m_isActive) {
+		m_sprite.Submit(packet, m_transform.GetRenderMatrix());
+		m_close.Submit(packet);
+	}
+	else { m_open.Submit(packet); }
+}
+
+
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
@@ -29,6 +29,7 @@ public:
 public:
 	virtual void Update()				override;
 	virtual void Render(Shader* shader) override;
+	virtual void Submit(FramePacket& packet) override;
 
 public:
 	static Widget* Create(const std::string& tag);
@@ -284,6 +284,39 @@ bool EditState::Render() {
 	ImGui::ColorEdit4("Tint Color", &m_skyboxTintColor[0]);
 	ImGui::DragFloat("Tint Begin", &m_tintBegin, 0.01f, 0.0f, 100.0f, "%.2f");
 	ImGui::DragFloat("Tint End", &m_tintEnd, 0.01f, 0.0f, 100.0f, "%.2f");
+	ImGui::Separator();
+
+	//--- Only query the memory usage while the panel is open, as the texture sizes come from OpenGL
+	if (ImGui::CollapsingHeader("Memory")) {
+
+		if (ImGui::IsItemHovered()) { ImGui::SetTooltip("Memory used by the current terrain. Peak is the most used while the terrain was being baked/loaded."); }
+
+		Terrain::MemoryUsage usage				= m_terrain->GetMemoryUsage();
+		const Terrain::MemoryUsage& peakUsage	= m_terrain->GetPeakMemoryUsage();
+
+		auto row = [](const char* component, size_t bytes, size_t peakBytes) {
+			ImGui::Text("%s", component);							ImGui::NextColumn();
+			ImGui::Text("%.2f MiB", bytes / (1024.0 * 1024.0));		ImGui::NextColumn();
+			ImGui::Text("%.2f MiB", peakBytes / (1024.0 * 1024.0));	ImGui::NextColumn();
+		};
+
+		ImGui::Columns(3, "##Memory");
+		ImGui::Text("Component");	ImGui::NextColumn();
+		ImGui::Text("Current");		ImGui::NextColumn();
+		ImGui::Text("Peak");		ImGui::NextColumn();
+		ImGui::Separator();
+
+		row("Heightmap File", usage.heightMapFile, peakUsage.heightMapFile);
+		row("Map", usage.map, peakUsage.map);
+		row("Heights", usage.heights, peakUsage.heights);
+		row("Vertices", usage.vertices, peakUsage.vertices);
+		row("Vertex Buffer", usage.vertexBuffer, peakUsage.vertexBuffer);
+		row("Textures", usage.textures, peakUsage.textures);
+		ImGui::Separator();
+		row("Total", usage.total, peakUsage.total);
+
+		ImGui::Columns(1);
+	}
 
 	ImGui::End();
 	ImGui::Render();
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include "PlayState.h"
 #include "managers/GameManager.h"
+#include "cache/StateCache.h"
 #include "utilities/Log.h"
+#include "utilities/Tools.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
@@ -14,15 +17,22 @@ PlayState::PlayState(GameState* previousState)
 		m_minimapCamera(nullptr),
 		m_picker(nullptr),
 		m_frustum(nullptr),
+		m_occlusionBuffer(nullptr),
+		m_lightClusters(nullptr),
+		m_entityTree(nullptr),
+		m_broadPhase(nullptr),
 		m_text(nullptr),
 		m_minimapWidget(nullptr),
 		m_menuButton(nullptr),
 		m_helpButton(nullptr),
+		m_sceneRenderer(nullptr),
+		m_renderThread(nullptr),
 		m_lightCount(10),
 		m_finalEventIssued(false),
 		m_debugMode(false),
 		m_wireFrameMode(false),
-		m_finishedEvents(false)
+		m_finishedEvents(false),
+		m_playerHandle(0)
 {
 	Initialize();
 }
@@ -33,6 +43,10 @@ PlayState::PlayState(GameState* previousState)
 *******************************************************************************************************************/
 PlayState::~PlayState() 
 {
+	//--- Stop the render thread first, as it may still be drawing the objects deleted below
+	if (m_renderThread)		{ delete m_renderThread; m_renderThread = nullptr; }
+	if (m_sceneRenderer)	{ delete m_sceneRenderer; m_sceneRenderer = nullptr; }
+
 	if (m_menuButton)		{ delete m_menuButton; m_menuButton = nullptr; }
 	if (m_helpButton)		{ delete m_helpButton; m_helpButton = nullptr; }
 	if (m_minimapWidget)	{ delete m_minimapWidget; m_minimapWidget = nullptr; }
@@ -40,7 +54,11 @@ PlayState::~PlayState()
 
 	RemoveFromScene(m_shaders);
 
-	if (m_frustum)	{ delete m_frustum; m_frustum = nullptr; }
+	if (m_entityTree)	{ delete m_entityTree; m_entityTree = nullptr; }
+	if (m_broadPhase)	{ delete m_broadPhase; m_broadPhase = nullptr; }
+	if (m_frustum)		{ delete m_frustum; m_frustum = nullptr; }
+	if (m_occlusionBuffer)	{ delete m_occlusionBuffer; m_occlusionBuffer = nullptr; }
+	if (m_lightClusters)	{ delete m_lightClusters; m_lightClusters = nullptr; }
 	if (m_picker)	{ delete m_picker; m_picker = nullptr; }
 	
 	RemoveFromScene(m_components);
@@ -68,6 +86,7 @@ void PlayState::Initialize()
 	LoadComponents();
 	LoadShaders();
 	LoadInterface();
+	LoadRenderer();
 	
 	//--- Show startup tooltip / begin state
 	Game::Instance()->GetStates()->MakeTemporaryState<BeginState>(this);
@@ -113,6 +132,9 @@ void PlayState::LoadObjects()
 
 	m_terrain->LoadTerrainBinary("Default");
 
+	//--- A coarse copy of the terrain, drawn into the occlusion buffer so entities behind hills aren't drawn
+	m_terrain->GetOccluderMesh(s_terrainOccluderStep, m_occluderVertices, m_occluderIndices);
+
 	//--- Give the player something to walk on
 	if (m_terrain) { m_player->SetGround(m_terrain); }
 
@@ -125,6 +147,35 @@ void PlayState::LoadObjects()
 	for (unsigned int i = 0; i < s_maxEntities; i++) {
 		AddToScene(m_entities, Entity::Create("Object" + std::to_string(i))); 
 	}
+
+	//--- Index the entities by position, so we only ever visit the ones near the camera
+	glm::vec3 minimum = m_entities.front()->GetBound().GetMin();
+	glm::vec3 maximum = m_entities.front()->GetBound().GetMax();
+
+	for (auto entity : m_entities) {
+		minimum = glm::min(minimum, entity->GetBound().GetMin());
+		maximum = glm::max(maximum, entity->GetBound().GetMax());
+	}
+
+	m_entityTree = new QuadTree(minimum, maximum);
+
+	ReserveMemory(m_entityHandles, s_maxEntities);
+	for (unsigned int i = 0; i < m_entities.size(); i++) {
+		m_entityHandles.push_back(m_entityTree->Insert(i, m_entities[i]->GetBound().GetMin(), m_entities[i]->GetBound().GetMax()));
+	}
+
+	//--- Add the collidable entities and the player to the broad phase - entities only collide with the player, not each other
+	//--- (Entities without a collision response still get a handle so the handles line up with the entity indices)
+	m_broadPhase = new BroadPhase();
+
+	ReserveMemory(m_collisionHandles, s_maxEntities);
+	for (unsigned int i = 0; i < m_entities.size(); i++) {
+		unsigned int mask = m_entities[i]->HasCollisionResponse() ? LAYER_PLAYER : 0;
+		m_collisionHandles.push_back(m_broadPhase->Add(i, m_entities[i]->GetBound().GetMin(), m_entities[i]->GetBound().GetMax(), LAYER_ENTITY, mask));
+	}
+
+	//--- The player's ID is one past the last entity, so it can't be mistaken for one in the pairs
+	m_playerHandle = m_broadPhase->Add((unsigned int)m_entities.size(), m_player->GetBound().GetMin(), m_player->GetBound().GetMax(), LAYER_PLAYER, LAYER_ENTITY);
 	
 	//--- Add all the collectables to the scene (using a deque so no need to reserve memory like the other containers)
 	for (unsigned int i = 0; i < s_maxCollectables; i++) {
@@ -149,7 +200,10 @@ void PlayState::LoadComponents()
 
 	//--- Create the mouse ray and frustum (these will be components as well, eventually)
 	m_picker	= new Picker(m_mainCamera);
-	m_frustum	= new Frustum(Screen::Instance()->GetProjectionMatrix(), m_mainCamera->GetViewMatrix());
+	m_frustum	= new Frustum(Screen::Instance()->GetPerspectiveMatrix(), m_mainCamera->GetViewMatrix());
+
+	m_occlusionBuffer = new OcclusionBuffer(256, 128, Game::Instance()->GetJobSystem());
+	m_lightClusters = new LightClusters();
 }
 
 
@@ -165,6 +219,28 @@ void PlayState::LoadInterface()
 }
 
 
+/*******************************************************************************************************************
+	A function that creates the render thread, and the renderer it uses to draw this game state's frame packets
+*******************************************************************************************************************/
+void PlayState::LoadRenderer()
+{
+	SceneRenderer::Scene scene = {
+		Downcast<SkyboxShader>(m_shaders[SHADER_SKYBOX]),
+		Downcast<TerrainShader>(m_shaders[SHADER_TERRAIN]),
+		Downcast<EntityShader>(m_shaders[SHADER_ENTITY]),
+		Downcast<InterfaceShader>(m_shaders[SHADER_INTERFACE]),
+		Downcast<TextShader>(m_shaders[SHADER_TEXT]),
+		m_skybox,
+		m_terrain,
+		m_minimapWidget->GetMinimap()->GetRenderTarget(),
+		m_text
+	};
+
+	m_sceneRenderer	= new SceneRenderer(scene);
+	m_renderThread	= new RenderThread(m_sceneRenderer);
+}
+
+
 /*******************************************************************************************************************
 	A function that creates and initializes all the lights within this game state
 *******************************************************************************************************************/
@@ -188,8 +264,14 @@ void PlayState::ProcessInput()
 	if (Input::Instance()->IsKeyPressed(SDL_SCANCODE_EQUALS))	{ m_mainCamera->Zoom(-s_defaultCameraZoom); }
 	if (Input::Instance()->IsKeyPressed(SDL_SCANCODE_MINUS))	{ m_mainCamera->Zoom(s_defaultCameraZoom); }
 
+	//--- NOTE
+	// New states load their own shaders and textures, which needs the OpenGL context back from the render thread
+	// It's started again the next time this state renders
+	//---
+
 	//--- Remove the play state and go back to the menu if user clicks on menu button
 	if (m_menuButton->IsClicked()) {
+		m_renderThread->Stop();
 		Audio::Instance()->StopChannel("Play");
 		Audio::Instance()->StopChannel("FinalQuest");
 		Game::Instance()->GetStates()->MakePermanentState<MenuState>(this);
@@ -198,6 +280,7 @@ void PlayState::ProcessInput()
 	
 	//--- Show the guide state if the help button is clicked
 	if (m_helpButton->IsClicked()) {
+		m_renderThread->Stop();
 		Game::Instance()->GetStates()->MakeTemporaryState<GuideState>(this);
 		IsActive() = false;
 	}
@@ -234,129 +317,93 @@ bool PlayState::Update()
 
 
 /*******************************************************************************************************************
-	Function that renders all play state graphics to the screen
+	Function that builds a frame packet of everything in view and hands it over to the render thread
 *******************************************************************************************************************/
 bool PlayState::Render() {
 
-	//--- Render all 3D objects
-	Screen::Instance()->BeginScene(0.0f, 0.0f, 0.0f);
-	Screen::Instance()->PerspectiveView(true);
-	Screen::Instance()->EnableBlending(false);
-	Screen::Instance()->EnableDepth(true);
-
-	RenderWorld();
+	//--- The render thread takes the OpenGL context the first time we render (and again after anything stopped it)
+	if (!m_renderThread->IsRunning()) { m_renderThread->Start(); }
 
-	//--- Render all 2D objects
-	Screen::Instance()->PerspectiveView(false);
-	Screen::Instance()->EnableBlending(true);
-	Screen::Instance()->EnableDepth(false);
-	Screen::Instance()->CullBackFace(false);
+	//--- Waits if the render thread is still to pick up the last frame
+	FramePacket& packet = m_renderThread->BeginFrame();
 
-	RenderInterface();
+	SubmitWorld(packet);
+	SubmitInterface(packet);
 
-	Screen::Instance()->EndScene();
+	m_renderThread->SubmitFrame();
 
 	return true;
 }
 
 
 /*******************************************************************************************************************
-	Function that renders all 3D objects to the screen
+	Function that adds all 3D objects to the frame packet (the skybox and terrain are drawn by the renderer itself)
 *******************************************************************************************************************/
-void PlayState::RenderWorld()
+void PlayState::SubmitWorld(FramePacket& packet)
 {
 
 #if COG_DEBUG == 1
-	Screen::Instance()->WireframeMode(m_wireFrameMode);
+	packet.isWireframe	= m_wireFrameMode;
+	packet.isDebugMode	= m_debugMode;
 #endif
 
-	//--- Render the skybox
-	Screen::Instance()->CullBackFace(false);
-	m_shaders[SHADER_SKYBOX]->Bind();
-		m_skybox->Render(m_shaders[SHADER_SKYBOX]);
-	m_shaders[SHADER_SKYBOX]->Unbind();
-	Screen::Instance()->CullBackFace(true);
-
-	//--- Render to texture (minimap)
-	m_minimapWidget->GetMinimap()->GetRenderTarget()->BeginScene(true);
-		m_shaders[SHADER_TERRAIN]->Bind();
-		m_shaders[SHADER_TERRAIN]->SwapCamera(m_minimapCamera);
-			m_terrain->SetMinimapMode(true);
-			m_terrain->Render(m_shaders[SHADER_TERRAIN]);
-		m_shaders[SHADER_TERRAIN]->Unbind();
-	m_minimapWidget->GetMinimap()->GetRenderTarget()->EndScene();
-
-	//--- Render the terrain
-	m_shaders[SHADER_TERRAIN]->Bind();
-#if COG_DEBUG == 1
-	m_shaders[SHADER_TERRAIN]->DebugMode(m_debugMode);
-#endif
-	m_shaders[SHADER_TERRAIN]->SetLights(m_lights);
-	m_shaders[SHADER_TERRAIN]->SwapCamera(m_mainCamera);
-		m_terrain->SetMinimapMode(false);
-		m_terrain->Render(m_shaders[SHADER_TERRAIN]);
-	m_shaders[SHADER_TERRAIN]->Unbind();
-
-	// Render the entities
-	m_shaders[SHADER_ENTITY]->Bind();
-#if COG_DEBUG == 1
-	m_shaders[SHADER_ENTITY]->DebugMode(m_debugMode);
-#endif
-	m_shaders[SHADER_ENTITY]->SetLights(m_lights);
-		for (auto entity : m_entities) {
-			//--- Entities are only rendered when within view
-			if (m_frustum->IsRectangleInside(
-				entity->GetBound().GetPosition(),
-				entity->GetBound().GetHalfDimension())) {
-				
-					entity->Render(m_shaders[SHADER_ENTITY]);
-			}
-		}
+	packet.camera			= m_mainCamera->GetRenderView();
+	packet.minimapCamera	= m_minimapCamera->GetRenderView();
+	packet.isMinimapVisible	= m_minimapWidget->IsActive();
+
+	for (auto light : m_lights) { packet.lights.push_back(*light); }
+
+	//--- Entities are only rendered when within view (found once per frame, at the end of UpdateComponents())
+	for (auto i : m_visibleEntities) { m_entities[i]->Submit(packet); }
 		
-		//--- Only if there is still items to be collected do we render them
-		if (!m_player->HasCollectedAllItems()) {
-			//--- Collectables are only rendered when within view
-			if (m_frustum->IsRectangleInside(
-				m_collectables.front()->GetBound().GetPosition(),
-				m_collectables.front()->GetBound().GetHalfDimension())) {
+	//--- Only if there is still items to be collected do we render them
+	if (!m_player->HasCollectedAllItems()) {
+		//--- Collectables are only rendered when within view
+		if (m_frustum->IsRectangleInside(
+			m_collectables.front()->GetBound().GetPosition(),
+			m_collectables.front()->GetBound().GetHalfDimension())) {
 				
-				m_collectables.front()->Render(m_shaders[SHADER_ENTITY]);
-			}
+			m_collectables.front()->Submit(packet);
 		}
-	m_shaders[SHADER_ENTITY]->Unbind();
+	}
 }
 
 
 /*******************************************************************************************************************
-	Function that renders all the 2D objects to the screen
+	Function that adds all the 2D objects to the frame packet
 *******************************************************************************************************************/
-void PlayState::RenderInterface()
+void PlayState::SubmitInterface(FramePacket& packet)
 {
-	//--- Render the interface objects
-	m_shaders[SHADER_INTERFACE]->Bind();
-		m_menuButton->Render(m_shaders[SHADER_INTERFACE]);
-		m_helpButton->Render(m_shaders[SHADER_INTERFACE]);
-		m_minimapWidget->Render(m_shaders[SHADER_INTERFACE]);
-		m_player->Render(m_shaders[SHADER_INTERFACE]);
-	m_shaders[SHADER_INTERFACE]->Unbind();
-
-	//--- Render the text
-	m_shaders[SHADER_TEXT]->Bind();
-		if (m_finalEventIssued) {
-			m_text->Render(m_shaders[SHADER_TEXT], "Lights remaining: " + std::to_string(m_lightCount), Transform(glm::vec2(10.0f, 10.0f), glm::vec2(1.0f)), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
-		}
-		if (m_menuButton->IsHovered()) {
-			m_text->Render(m_shaders[SHADER_TEXT], "Return to main menu. Your game will not be saved.", Transform(glm::vec2(40.0f, 403.0f), glm::vec2(0.8f)), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
-		}
-		if (m_helpButton->IsHovered()) {
-			m_text->Render(m_shaders[SHADER_TEXT], "Display the guide.", Transform(glm::vec2(40.0f, 376.0f), glm::vec2(0.8f)), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
-		}
+	//--- Add the interface objects
+	m_menuButton->Submit(packet);
+	m_helpButton->Submit(packet);
+	m_minimapWidget->Submit(packet);
+	m_player->Submit(packet);
+
+	//--- Add the text
+	if (m_finalEventIssued) {
+		packet.AddText("Lights remaining: " + std::to_string(m_lightCount), glm::vec2(10.0f, 10.0f), glm::vec2(1.0f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	}
+	if (m_menuButton->IsHovered()) {
+		packet.AddText("Return to main menu. Your game will not be saved.", glm::vec2(40.0f, 403.0f), glm::vec2(0.8f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	}
+	if (m_helpButton->IsHovered()) {
+		packet.AddText("Display the guide.", glm::vec2(40.0f, 376.0f), glm::vec2(0.8f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	}
 #if COG_DEBUG == 1
-		//m_text->Render(m_shaders[SHADER_TEXT], "FPS : " + std::to_string(Game::Instance()->GetFramesPerSecond()), Transform(glm::vec2(10.0f, 200.0f), glm::vec2(1.0f)), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
-		//m_text->Render(m_shaders[SHADER_TEXT], "Frame Time : " + std::to_string(Game::Instance()->GetCurrentFrameTime()), Transform(glm::vec2(10.0f, 180.0f), glm::vec2(1.0f)), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
-		//m_text->Render(m_shaders[SHADER_TEXT], "CPU % : " + std::to_string(Game::Instance()->GetMainframePercentage()), Transform(glm::vec2(10.0f, 160.0f), glm::vec2(1.0f)), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	//packet.AddText("FPS : " + std::to_string(Game::Instance()->GetFramesPerSecond()), glm::vec2(10.0f, 200.0f), glm::vec2(1.0f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	//packet.AddText("Frame Time : " + std::to_string(Game::Instance()->GetCurrentFrameTime()), glm::vec2(10.0f, 180.0f), glm::vec2(1.0f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	//packet.AddText("CPU % : " + std::to_string(Game::Instance()->GetMainframePercentage()), glm::vec2(10.0f, 160.0f), glm::vec2(1.0f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	if (m_debugMode) {
+		Frustum::Counters counters = m_frustum->GetCounters();
+		packet.AddText("Culling : " + std::to_string(counters.objectTests) + " objects, " + std::to_string(counters.planeTests) + " plane tests, " +
+					   std::to_string(counters.cacheHits) + " cache hits" + (counters.isReused ? " (reused)" : ""), glm::vec2(10.0f, 140.0f), glm::vec2(0.6f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+		packet.AddText("GL binds : " + std::to_string(GLState::Instance()->GetIssuedCalls()) + " issued, " +
+					   std::to_string(GLState::Instance()->GetSkippedCalls()) + " skipped", glm::vec2(10.0f, 125.0f), glm::vec2(0.6f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+		packet.AddText("Lights : " + std::to_string(m_lightClusters->GetVisibleLights().size()) + " in view, " +
+					   std::to_string(m_lightClusters->GetMaxLightsPerCluster()) + " per cluster at most", glm::vec2(10.0f, 110.0f), glm::vec2(0.6f), glm::vec4(1.0, 1.0f, 1.0f, 1.0f));
+	}
 #endif
-	m_shaders[SHADER_TEXT]->Unbind();
 }
 
 
@@ -380,6 +427,10 @@ void PlayState::UpdateObjects()
 			//--- Check if the mouse ray is colliding and if the user clicks then pickup the item and add to inventory
 			if (m_picker->IsColliding(m_collectables.front()->GetBound(), s_maxCollectableRange)) {
 				if (Input::Instance()->IsMouseButtonPressed(SDL_BUTTON_LEFT, false)) {
+
+					//--- Picking up creates the item's textures, and the collectable is deleted straight after,
+					//--- so take the OpenGL context back (and let the render thread finish any frame still drawing it)
+					m_renderThread->Stop();
 						
 					m_player->PickUp(m_collectables.front());
 						
@@ -394,22 +445,24 @@ void PlayState::UpdateObjects()
 		}
 	}
 
-	for (auto entity : m_entities) {
-		
-		//--- Don't update anything unless we can see it
-		if (m_frustum->IsRectangleInside(
-			entity->GetBound().GetPosition(),
-			entity->GetBound().GetHalfDimension())) {
+	//--- If the player collides with anything then stop movement (set to players previous position)
+	//--- (Eventually I'll figure out how to implement wall sliding...)
+	m_broadPhase->Update(m_playerHandle, m_player->GetBound().GetMin(), m_player->GetBound().GetMax());
+	m_broadPhase->FindPairs(m_collisionPairs);
 
-			//--- Check if the object is even collidable (some objects are outwith world bounds and so don't need to be checked!)
-			if (entity->HasCollisionResponse()) {
+	for (const auto& pair : m_collisionPairs) {
+		if (pair.first == m_entities.size() || pair.second == m_entities.size()) { m_player->Stop(); break; }
+	}
 
-				//--- If the player collides then stop movement (set to players previous position)
-				//--- (Eventually I'll figure out how to implement wall sliding...)
-				if (m_player->GetBound().IsColliding(entity->GetBound())) { m_player->Stop(); }
-			}
-			entity->Update();
-		}
+	//--- Don't update anything unless we can see it (as of the last frame, the frustum is only built further on)
+	for (auto i : m_visibleEntities) {
+
+		Entity* entity = m_entities[i];
+		entity->Update();
+
+		//--- Only entities we can see are updated, so they are the only ones that can have moved
+		m_entityTree->Update(m_entityHandles[i], entity->GetBound().GetMin(), entity->GetBound().GetMax());
+		m_broadPhase->Update(m_collisionHandles[i], entity->GetBound().GetMin(), entity->GetBound().GetMax());
 	}
 }
 
@@ -435,7 +488,15 @@ void PlayState::UpdateComponents()
 	m_picker->Update();
 
 	//--- Create our new frustum every frame - must be done at the end of all 3D objects updates
-	m_frustum->Update(Screen::Instance()->GetProjectionMatrix(), m_mainCamera->GetViewMatrix());
+	m_frustum->Update(Screen::Instance()->GetPerspectiveMatrix(), m_mainCamera->GetViewMatrix());
+
+	//--- Then draw the terrain into the occlusion buffer from the same view, ready for culling
+	m_occlusionBuffer->Begin(Screen::Instance()->GetPerspectiveMatrix() * m_mainCamera->GetViewMatrix());
+	m_occlusionBuffer->AddOccluder(m_occluderVertices, m_occluderIndices);
+	m_occlusionBuffer->Render();
+
+	//--- Now find what's in view, once - rendering draws these and the next update only updates these
+	CullEntities();
 }
 
 
@@ -444,15 +505,37 @@ void PlayState::UpdateComponents()
 *******************************************************************************************************************/
 void PlayState::UpdateLights()
 {
-	//--- Loop through all the lights and only compute lighting calculations in shader if they are within view
-	//--- otherwise, disable them when they fall outwith the frustum
-	//--- I surround the lights within a temporary radius for now - this can be improved later
+	//--- Only compute lighting calculations in shader for the point lights that reach something within view, so
+	//--- switch on every point light that hasn't been turned off for good (no margin) and bin them all into clusters
 	for (auto light : m_lights) {
-		if (m_frustum->IsSphereInside(light->GetPosition(), s_maxLightRadius) && light->GetMargin() != 0.0f) {
-			if (light->IsOfType(Light::LIGHT_POINT)) { light->SetEnabled(true); }
-		}
-		else { if (light->IsOfType(Light::LIGHT_POINT)) { light->SetEnabled(false); } }
+		if (light->IsOfType(Light::LIGHT_POINT)) { light->SetEnabled(light->GetMargin() != 0.0f); }
+	}
+
+	//--- The field of view changes when zooming, so the clusters follow the screen's projection every frame
+	using namespace screen_constants;
+	m_lightClusters->SetProjection(Screen::Instance()->GetFieldOfView(), Screen::Instance()->GetAspectRatio(), NEAR_VIEW, FAR_VIEW);
+	m_lightClusters->Update(m_mainCamera->GetViewMatrix(), m_lights);
+
+	//--- Then disable the point lights that didn't reach a single cluster
+	for (auto light : m_lights) {
+		if (light->IsOfType(Light::LIGHT_POINT)) { light->SetEnabled(false); }
 	}
+
+	for (auto i : m_lightClusters->GetVisibleLights()) { m_lights[i]->SetEnabled(true); }
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the entities within view, visiting only the parts of the entity tree the frustum touches
+*******************************************************************************************************************/
+void PlayState::CullEntities()
+{
+	m_entityTree->CullFrustum(*m_frustum, m_visibleEntities);
+
+	//--- Then remove anything inside the frustum that is hidden behind the terrain
+	m_visibleEntities.erase(std::remove_if(m_visibleEntities.begin(), m_visibleEntities.end(), [this](unsigned int i) {
+		return !m_occlusionBuffer->IsVisible(m_entities[i]->GetBound().GetMin(), m_entities[i]->GetBound().GetMax());
+	}), m_visibleEntities.end());
 }
 
 
@@ -472,8 +555,14 @@ void PlayState::UpdateInterface()
 *******************************************************************************************************************/
 void PlayState::IssueFinalEvent()
 {
+	//--- The lights that can be clicked on are re-added to the picker every frame, as they turn on/off with the frustum
+	m_picker->ClearObjects();
+	float pickRange = 0.0f;
+
 	//--- If we get to this stage, the player is at the final event within the game
-	for (auto light : m_lights) {
+	for (unsigned int i = 0; i < m_lights.size(); i++) {
+
+		Light* light = m_lights[i];
 		
 		//--- Change the fancy new graphics and sounds only once when event is activated
 		if (light->IsOfType(Light::LIGHT_DIRECTION) && !m_finalEventIssued) {
@@ -497,24 +586,30 @@ void PlayState::IssueFinalEvent()
 			
 			light->SetLinear(abs(cos(SDL_GetTicks() / s_linearPulseAmount)));
 			
-			//--- Create a temporary bound for this light
+			//--- Create a temporary bound for this light so the mouse ray can be checked against it
 			AABounds3D bound(light->GetPosition(), glm::vec3(5.0f), glm::vec3(1.0f), true);
 			
-			//--- Check if the mouse ray collides with it
-			if (m_picker->IsColliding(bound, light->GetMargin())) {
+			m_picker->AddObject(i, bound);
+			pickRange = std::max(pickRange, light->GetMargin());
+		}
+	}
 
-				//--- If the user clicks on the light, turn it off forever and reduce the light count
-				if (Input::Instance()->IsMouseButtonPressed(SDL_BUTTON_LEFT, false)) {
-					light->SetMargin(0.0f);
-					light->SetEnabled(false);
-					m_lightCount--;
-				}
-			}
+	//--- Check which light the mouse ray hits first, so a light hidden behind another one can't be clicked through it
+	BVH::Hit hit;
+
+	if (m_picker->Raycast(pickRange, hit) && hit.distance <= m_lights[hit.ID]->GetMargin()) {
+
+		//--- If the user clicks on the light, turn it off forever and reduce the light count
+		if (Input::Instance()->IsMouseButtonPressed(SDL_BUTTON_LEFT, false)) {
+			m_lights[hit.ID]->SetMargin(0.0f);
+			m_lights[hit.ID]->SetEnabled(false);
+			m_lightCount--;
 		}
 	}
 	
 	//--- Finally if we reach 0 lights it means the player has finished the game, so show the end state
 	if (m_lightCount == 0) {
+		m_renderThread->Stop();
 		Game::Instance()->GetStates()->MakeTemporaryState<EndState>(this);
 
 		//--- PlayState still alive at this point as they may want to return to it
@@ -531,8 +626,8 @@ const unsigned int PlayState::s_maxEntities		= 47;
 const unsigned int PlayState::s_maxShaders		= 5;
 const unsigned int PlayState::s_maxCollectables = 8;
 const unsigned int PlayState::s_maxComponents	= 2;
+const unsigned int PlayState::s_terrainOccluderStep = 16;
 
-const float PlayState::s_maxLightRadius			= 20.0f;
 const float PlayState::s_linearPulseAmount		= 360.0f;
 const float PlayState::s_maxCollectableRange	= 50.0f;
 const float PlayState::s_defaultCameraZoom		= 3.0f;
\ No newline at end of file
@@ -24,15 +24,22 @@
 #include "application/Skybox.h"
 #include "application/Player.h"
 #include "graphics/Frustum.h"
+#include "graphics/OcclusionBuffer.h"
+#include "graphics/LightClusters.h"
+#include "physics/QuadTree.h"
+#include "physics/BroadPhase.h"
 #include "graphics/Text.h"
 #include "application/MinimapWidget.h"
 #include "application/Entity.h"
 #include "graphics/Light.h"
+#include "graphics/RenderThread.h"
+#include "graphics/SceneRenderer.h"
 
 class PlayState : public GameState {
 
 private:
 	enum ShaderType	{ SHADER_SKYBOX, SHADER_TERRAIN, SHADER_ENTITY, SHADER_INTERFACE, SHADER_TEXT };
+	enum LayerType	{ LAYER_PLAYER = 1, LAYER_ENTITY = 2 };
 
 public:
 	PlayState(GameState* previousState);
@@ -49,6 +56,7 @@ private:
 	void LoadComponents();
 	void LoadInterface();
 	void LoadLights();
+	void LoadRenderer();
 
 private:
 	void ProcessInput();
@@ -56,10 +64,11 @@ private:
 	void UpdateObjects();
 	void UpdateComponents();
 	void UpdateInterface();
+	void CullEntities();
 
 private:
-	void RenderWorld();
-	void RenderInterface();
+	void SubmitWorld(FramePacket& packet);
+	void SubmitInterface(FramePacket& packet);
 
 private:
 	void IssueFinalEvent();
@@ -74,6 +83,10 @@ private:
 	Camera*			m_minimapCamera;
 	Picker*			m_picker;
 	Frustum*		m_frustum;
+	OcclusionBuffer*	m_occlusionBuffer;
+	LightClusters*	m_lightClusters;
+	QuadTree*		m_entityTree;
+	BroadPhase*		m_broadPhase;
 
 private:
 	Text*			m_text;
@@ -81,6 +94,10 @@ private:
 	Button*			m_menuButton;
 	Button*			m_helpButton;
 
+private:
+	SceneRenderer*	m_sceneRenderer;
+	RenderThread*	m_renderThread;
+
 private:
 	unsigned int	m_lightCount;
 	bool			m_finalEventIssued;
@@ -95,14 +112,25 @@ private:
 	std::vector<Light*>				m_lights;
 	std::vector<GameComponent*>		m_components;
 
+private:
+	std::vector<QuadTree::Handle>	m_entityHandles;
+	std::vector<unsigned int>		m_visibleEntities;
+	std::vector<BroadPhase::Handle>	m_collisionHandles;
+	std::vector<BroadPhase::Pair>	m_collisionPairs;
+	BroadPhase::Handle				m_playerHandle;
+
+private:
+	std::vector<glm::vec3>			m_occluderVertices;
+	std::vector<unsigned int>		m_occluderIndices;
+
 private:
 	static const unsigned int s_maxEntities;
 	static const unsigned int s_maxShaders;
 	static const unsigned int s_maxCollectables;
 	static const unsigned int s_maxComponents;
+	static const unsigned int s_terrainOccluderStep;
 
 private:
-	static const float s_maxLightRadius;
 	static const float s_maxCollectableRange;
 	static const float s_linearPulseAmount;
 	static const float s_defaultCameraZoom;
@@ -1,6 +1,7 @@
 #include "FontCache.h"
 #include "utilities/Tools.h"
 #include "utilities/Log.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Default Constructor
@@ -31,14 +32,12 @@ void FontCache::Unload() {
 
 	for (auto& font : s_fonts)
 	{
-		//--- For this font, get all the characters and delete them
-		for (GLubyte glyph = 0; glyph < Character::s_maxGlyphs; glyph++)
-		{
-			COG_LOG("[FONT CACHE] Deleting glyph texture from s_fonts map: "
-				+ GetKey(font) + ", OpenGL texture ID: ", GetValue(font).at(glyph).ID, LOG_MEMORY);
+		//--- All the characters of this font share the one atlas texture
+		COG_LOG("[FONT CACHE] Deleting glyph atlas from s_fonts map: "
+			+ GetKey(font) + ", OpenGL texture ID: ", GetValue(font).atlas, LOG_MEMORY);
 
-			COG_GLCALL(glDeleteTextures(1, &GetValue(font).at(glyph).ID));
-		}
+		COG_GLCALL(glDeleteTextures(1, &GetValue(font).atlas));
+		GLState::Instance()->ForgetTexture(GetValue(font).atlas);
 
 		COG_LOG("[FONT CACHE] Font removed: ", GetKey(font).c_str(), LOG_RESOURCE);
 
@@ -55,9 +54,9 @@ void FontCache::Unload() {
 /*******************************************************************************************************************
 	Function that adds a font to the font map if it doesn't already exist
 *******************************************************************************************************************/
-void FontCache::AddFont(const std::string& tag, const std::map<GLchar, Character>& characters)
+void FontCache::AddFont(const std::string& tag, const Font& font)
 {
-	s_fonts.try_emplace(tag, characters);
+	s_fonts.try_emplace(tag, font);
 
 	COG_LOG("[FONT CACHE] Font added to s_fonts map: ", tag.c_str(), LOG_RESOURCE);
 }
@@ -77,11 +76,16 @@ bool FontCache::FindFont(const std::string& tag)
 /*******************************************************************************************************************
 	Function that get's a single character bound to a font in memory
 *******************************************************************************************************************/
-FontCache::Character* FontCache::GetCharacter(const std::string& tag, GLchar character) { return &s_fonts.at(tag).at(character); }
+FontCache::Character* FontCache::GetCharacter(const std::string& tag, GLchar character) { return &s_fonts.at(tag).characters.at(character); }
+
+
+/*******************************************************************************************************************
+	Function that get's the atlas texture every character of a font is drawn from
+*******************************************************************************************************************/
+GLuint FontCache::GetAtlas(const std::string& tag) { return s_fonts.at(tag).atlas; }
 
 
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
-GLubyte FontCache::Character::s_maxGlyphs	= 128;
 FontCache::Cache FontCache::s_fonts;
\ No newline at end of file
@@ -12,10 +12,10 @@
 	Supports caching of fonts and emplaces them into a font cache.
 	Re-uses existing fonts already in the cache.
 	Access to individual characters of a font.
+	Every font is one atlas texture - each character holds the UV's of its glyph within it.
 
 	[Upcoming]
 	Multi-support for bitmap fonts also.
-	Conversion of FreeType font into just one bitmap, rather than multiple textures per character.
 
 	[Side Notes]
 	All cache classes should be created within either a static class or a singleton.
@@ -34,11 +34,15 @@ class FontCache {
 
 public:
 	struct Character {
-		GLuint			ID;
+		glm::vec4		uv;
 		glm::ivec2		size;
 		glm::ivec2		bearing;
 		signed long		advance;
-		static GLubyte	s_maxGlyphs;
+	};
+
+	struct Font {
+		GLuint						atlas;
+		std::map<GLchar, Character>	characters;
 	};
 
 public:
@@ -49,14 +53,15 @@ public:
 	~FontCache();
 
 public:
-	void AddFont(const std::string& tag, const std::map<GLchar, Character>& characters);
+	void AddFont(const std::string& tag, const Font& font);
 	bool FindFont(const std::string& tag);
 
 public:
-	Character* GetCharacter(const std::string& tag, GLchar character);
+	Character*	GetCharacter(const std::string& tag, GLchar character);
+	GLuint		GetAtlas(const std::string& tag);
 
 private:
-	typedef std::map<std::string, std::map<GLchar, Character>> Cache;
+	typedef std::map<std::string, Font> Cache;
 
 private:
 	static Cache s_fonts;
@@ -0,0 +1,209 @@
+#include "StateCache.h"
+#include "utilities/Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+StateCache::StateCache()
+	:	m_issuedCalls(0),
+		m_skippedCalls(0),
+		m_lastIssuedCalls(0),
+		m_lastSkippedCalls(0)
+{
+	Invalidate();
+}
+
+
+/*******************************************************************************************************************
+	Function that binds a program (shader), if it isn't bound already
+*******************************************************************************************************************/
+void StateCache::UseProgram(GLuint program)
+{
+	if (m_program == program) { m_skippedCalls++; return; }
+
+	COG_GLCALL(glUseProgram(program));
+
+	m_program = program;
+	m_issuedCalls++;
+}
+
+
+/*******************************************************************************************************************
+	Function that binds a vertex array object, if it isn't bound already
+*******************************************************************************************************************/
+void StateCache::BindVertexArray(GLuint vertexArray)
+{
+	if (m_vertexArray == vertexArray) { m_skippedCalls++; return; }
+
+	COG_GLCALL(glBindVertexArray(vertexArray));
+
+	m_vertexArray = vertexArray;
+	m_issuedCalls++;
+
+	//--- The element buffer binding belongs to the VAO, so we no longer know what it is
+	m_buffers[BUFFER_ELEMENT] = s_unknown;
+}
+
+
+/*******************************************************************************************************************
+	Function that binds a buffer object to a target, if it isn't bound there already
+*******************************************************************************************************************/
+void StateCache::BindBuffer(GLenum target, GLuint buffer)
+{
+	GLuint* bound = GetBuffer(target);
+
+	if (bound && *bound == buffer) { m_skippedCalls++; return; }
+
+	COG_GLCALL(glBindBuffer(target, buffer));
+
+	if (bound) { *bound = buffer; }
+	m_issuedCalls++;
+}
+
+
+/*******************************************************************************************************************
+	Function that binds a texture to a texture unit, if it isn't bound there already. The unit is only made active
+	when the texture on it needs changing
+*******************************************************************************************************************/
+void StateCache::BindTexture(GLenum unit, GLenum target, GLuint texture)
+{
+	GLuint* bound = GetTexture(unit, target);
+
+	if (bound && *bound == texture) { m_skippedCalls++; return; }
+
+	if (m_activeUnit != unit) {
+		COG_GLCALL(glActiveTexture(unit));
+		m_activeUnit = unit;
+		m_issuedCalls++;
+	}
+
+	COG_GLCALL(glBindTexture(target, texture));
+
+	if (bound) { *bound = texture; }
+	m_issuedCalls++;
+}
+
+
+/*******************************************************************************************************************
+	Function that makes a texture unit the active one, if it isn't already - for calls that act on whatever is bound
+	to the active unit (glGetTexLevelParameteriv etc.), as BindTexture() doesn't switch units for a texture that is
+	already bound
+*******************************************************************************************************************/
+void StateCache::ActiveTexture(GLenum unit)
+{
+	if (m_activeUnit == unit) { m_skippedCalls++; return; }
+
+	COG_GLCALL(glActiveTexture(unit));
+
+	m_activeUnit = unit;
+	m_issuedCalls++;
+}
+
+
+/*******************************************************************************************************************
+	Functions that forget a deleted object - OpenGL unbinds an object when it's deleted, so if it was bound, nothing
+	is bound now
+*******************************************************************************************************************/
+void StateCache::ForgetProgram(GLuint program)
+{
+	if (m_program == program) { m_program = 0; }
+}
+
+void StateCache::ForgetVertexArray(GLuint vertexArray)
+{
+	if (m_vertexArray == vertexArray) { m_vertexArray = 0; }
+}
+
+void StateCache::ForgetBuffer(GLuint buffer)
+{
+	for (auto& bound : m_buffers) { if (bound == buffer) { bound = 0; } }
+}
+
+void StateCache::ForgetTexture(GLuint texture)
+{
+	for (auto& unit : m_textures) {
+		for (auto& bound : unit) { if (bound == texture) { bound = 0; } }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that forgets what is bound to a buffer target, for when something else has changed it
+	(e.g. glBindBufferBase() also binds the buffer to the target itself)
+*******************************************************************************************************************/
+void StateCache::ForgetBufferTarget(GLenum target)
+{
+	if (GLuint* bound = GetBuffer(target)) { *bound = s_unknown; }
+}
+
+
+/*******************************************************************************************************************
+	Function that forgets everything, so the next bind of anything is always passed on to OpenGL
+*******************************************************************************************************************/
+void StateCache::Invalidate()
+{
+	m_program		= s_unknown;
+	m_vertexArray	= s_unknown;
+	m_activeUnit	= s_unknown;
+
+	for (auto& bound : m_buffers) { bound = s_unknown; }
+
+	for (auto& unit : m_textures) {
+		for (auto& bound : unit) { bound = s_unknown; }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that stores this frame's counters (for the accessors) and starts counting again for the next frame
+*******************************************************************************************************************/
+void StateCache::EndFrame()
+{
+	m_lastIssuedCalls	= m_issuedCalls;
+	m_lastSkippedCalls	= m_skippedCalls;
+
+	m_issuedCalls	= 0;
+	m_skippedCalls	= 0;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns where the buffer bound to a target is cached (or nullptr for targets we don't cache)
+*******************************************************************************************************************/
+GLuint* StateCache::GetBuffer(GLenum target)
+{
+	switch (target) {
+		case GL_ARRAY_BUFFER:			return &m_buffers[BUFFER_ARRAY];
+		case GL_ELEMENT_ARRAY_BUFFER:	return &m_buffers[BUFFER_ELEMENT];
+		case GL_UNIFORM_BUFFER:			return &m_buffers[BUFFER_UNIFORM];
+		default:						return nullptr;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns where the texture bound to a unit is cached (or nullptr for units/targets we don't cache)
+*******************************************************************************************************************/
+GLuint* StateCache::GetTexture(GLenum unit, GLenum target)
+{
+	if (unit < GL_TEXTURE0 || unit >= GL_TEXTURE0 + MAX_TEXTURE_UNITS) { return nullptr; }
+
+	switch (target) {
+		case GL_TEXTURE_2D:			return &m_textures[unit - GL_TEXTURE0][TEXTURE_2D];
+		case GL_TEXTURE_CUBE_MAP:	return &m_textures[unit - GL_TEXTURE0][TEXTURE_CUBE_MAP];
+		default:					return nullptr;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods (both return the counts from the last finished frame)
+*******************************************************************************************************************/
+unsigned int StateCache::GetIssuedCalls() const		{ return m_lastIssuedCalls; }
+unsigned int StateCache::GetSkippedCalls() const	{ return m_lastSkippedCalls; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const GLuint StateCache::s_unknown = 0xFFFFFFFF;
\ No newline at end of file
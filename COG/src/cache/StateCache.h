@@ -0,0 +1,94 @@
+#pragma once
+
+/*******************************************************************************************************************
+	StateCache.h, StateCache.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A singleton that remembers what OpenGL currently has bound - the program, the VAO, the buffer bound to each
+	target and the texture bound to each unit - so binding something that is already bound costs nothing.
+
+	[Features]
+	Every bind in the program goes through here (shaders, VAOs, VBOs, EBOs, UBOs and textures), and is only passed
+	on to OpenGL if it would actually change something.
+	Texture units are only switched (glActiveTexture) when the texture on that unit needs changing.
+	Counts the binds passed on to OpenGL and the ones skipped, per frame (see EndFrame()).
+
+	[Upcoming]
+	Caching the rest of the fixed function state (blending, depth, culling) from the ScreenManager.
+
+	[Side Notes]
+	The cache only knows about the binds that go through it, so anything binding directly (ImGui) must put things
+	back the way it found them, which the ImGui renderer already does. If in doubt, call Invalidate().
+	Anything deleted must be forgotten (Forget...()), as OpenGL unbinds deleted objects and can re-use their IDs.
+	The element buffer is part of the VAO, so it's forgotten whenever the VAO changes.
+	Binding a texture doesn't promise its unit is the active one (it is only switched to when something changes),
+	so don't rely on Bind() to pick the unit for glTexImage2D/glTexParameter - only new textures are uploaded to.
+	Anything querying or changing a texture that may already be bound calls ActiveTexture() before binding it.
+	Only one thread has the context at a time, so only that thread touches the cache - the per-frame counters are
+	the exception, and can be read from any thread.
+
+*******************************************************************************************************************/
+#include <pretty_opengl/glew.h>
+#include <atomic>
+#include "utilities/Singleton.h"
+
+class StateCache {
+
+public:
+	friend class Singleton<StateCache>;
+
+public:
+	void UseProgram(GLuint program);
+	void BindVertexArray(GLuint vertexArray);
+	void BindBuffer(GLenum target, GLuint buffer);
+	void BindTexture(GLenum unit, GLenum target, GLuint texture);
+	void ActiveTexture(GLenum unit);
+
+public:
+	void ForgetProgram(GLuint program);
+	void ForgetVertexArray(GLuint vertexArray);
+	void ForgetBuffer(GLuint buffer);
+	void ForgetBufferTarget(GLenum target);
+	void ForgetTexture(GLuint texture);
+	void Invalidate();
+
+public:
+	void EndFrame();
+
+public:
+	unsigned int GetIssuedCalls() const;
+	unsigned int GetSkippedCalls() const;
+
+private:
+	StateCache();
+	StateCache(const StateCache&)				= delete;
+	StateCache& operator=(const StateCache&)	= delete;
+
+private:
+	GLuint* GetBuffer(GLenum target);
+	GLuint* GetTexture(GLenum unit, GLenum target);
+
+private:
+	enum BufferTarget	{ BUFFER_ARRAY, BUFFER_ELEMENT, BUFFER_UNIFORM, MAX_BUFFER_TARGETS };
+	enum TextureTarget	{ TEXTURE_2D, TEXTURE_CUBE_MAP, MAX_TEXTURE_TARGETS };
+	enum				{ MAX_TEXTURE_UNITS = 32 };
+
+private:
+	GLuint	m_program;
+	GLuint	m_vertexArray;
+	GLuint	m_buffers[MAX_BUFFER_TARGETS];
+	GLuint	m_textures[MAX_TEXTURE_UNITS][MAX_TEXTURE_TARGETS];
+	GLenum	m_activeUnit;
+
+private:
+	unsigned int				m_issuedCalls;
+	unsigned int				m_skippedCalls;
+	std::atomic<unsigned int>	m_lastIssuedCalls;
+	std::atomic<unsigned int>	m_lastSkippedCalls;
+
+private:
+	static const GLuint s_unknown;
+};
+
+typedef Singleton<StateCache> GLState;
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "TextureCache.h"
 #include "utilities/Log.h"
 #include "utilities/Tools.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Default Constructor
@@ -35,6 +36,7 @@ void TextureCache::Unload() {
 			+ GetKey(texture) + ", OpenGL texture ID: ", GetValue(texture), LOG_MEMORY);
 
 		COG_GLCALL(glDeleteTextures(1, &GetValue(texture)));
+		GLState::Instance()->ForgetTexture(GetValue(texture));
 
 		textureCount--;
 
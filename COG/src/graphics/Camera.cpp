@@ -18,6 +18,7 @@ Camera::Camera(const std::string& tag, const glm::vec3& position, const glm::vec
 		m_viewMatrix(1.0f),
 		m_rotationMatrix(1.0f),
 		m_translationMatrix(1.0f),
+		m_snapshotTick(s_noSnapshot),
 		m_isDirty(true)
 {
 	//--- Update the cameras view matrix when an instance is first created
@@ -39,6 +40,8 @@ Camera::~Camera()
 *******************************************************************************************************************/
 void Camera::Move(const glm::vec3& direction, float amount)
 {
+	SaveSnapshot();
+
 	m_position += direction * amount * Game::Instance()->GetDeltaTime();
 
 	m_isDirty = true;
@@ -71,6 +74,8 @@ void Camera::Zoom(float distance)
 *******************************************************************************************************************/
 void Camera::Rotate(float pitch, float yaw, float roll)
 {
+	SaveSnapshot();
+
 	m_rotation.x += glm::radians(pitch) * Game::Instance()->GetDeltaTime();
 	m_rotation.y += glm::radians(yaw) * Game::Instance()->GetDeltaTime();
 	m_rotation.z += glm::radians(roll) * Game::Instance()->GetDeltaTime();
@@ -95,8 +100,12 @@ void Camera::Update()
 		glm::vec3 parentPosition = GetParentTransform()->GetPosition();
 		glm::vec3 parentRotation = GetParentTransform()->GetRotation();
 
-		if (m_position != parentPosition) { m_position = parentPosition; m_isDirty = true; }
-		if (m_rotation != parentRotation) { m_rotation = parentRotation; m_isDirty = true; }
+		if (m_position != parentPosition || m_rotation != parentRotation) {
+			SaveSnapshot();
+			m_position	= parentPosition;
+			m_rotation	= parentRotation;
+			m_isDirty	= true;
+		}
 	}
 	
 	if (m_isDirty) {
@@ -113,9 +122,7 @@ void Camera::Update()
 *******************************************************************************************************************/
 void Camera::UpdateRotationMatrix()
 {
-	m_rotationMatrix =	glm::rotate(m_rotation.z, glm::vec3(s_defaultForwardAxis)) *
-						glm::rotate(m_rotation.x, glm::vec3(s_defaultRightAxis)) *
-						glm::rotate(m_rotation.y, glm::vec3(s_defaultUpAxis));
+	m_rotationMatrix = CreateRotationMatrix(m_rotation);
 }
 
 
@@ -142,6 +149,62 @@ void Camera::UpdateViewMatrix()
 }
 
 
+/*******************************************************************************************************************
+	Function that keeps a copy of where the camera is before its first change of each fixed update
+*******************************************************************************************************************/
+void Camera::SaveSnapshot()
+{
+	//--- Changes made outside of a fixed update aren't interpolated, the camera is drawn exactly where it is
+	if (!Game::Instance()->IsTicking()) { m_snapshotTick = s_noSnapshot; return; }
+
+	unsigned int tick = Game::Instance()->GetTick();
+
+	if (m_snapshotTick != tick) {
+		m_previousPosition	= m_position;
+		m_previousRotation	= m_rotation;
+		m_snapshotTick		= tick;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the view matrix to render with, blended between the last two fixed updates
+*******************************************************************************************************************/
+glm::mat4 Camera::GetRenderViewMatrix() const
+{
+	if (m_snapshotTick == s_noSnapshot || m_snapshotTick != Game::Instance()->GetTick()) { return m_viewMatrix; }
+
+	return GetRenderRotationMatrix() * glm::translate(-glm::mix(m_previousPosition, m_position, Game::Instance()->GetInterpolation()));
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the rotation matrix to render with (e.g. for the skybox), blended between the last two
+	fixed updates
+*******************************************************************************************************************/
+glm::mat4 Camera::GetRenderRotationMatrix() const
+{
+	if (m_snapshotTick == s_noSnapshot || m_snapshotTick != Game::Instance()->GetTick()) { return m_rotationMatrix; }
+
+	return CreateRotationMatrix(glm::mix(m_previousRotation, m_rotation, Game::Instance()->GetInterpolation()));
+}
+
+
+/*******************************************************************************************************************
+	Function that returns a copy of everything the shaders need from the camera to render this frame
+*******************************************************************************************************************/
+CameraView Camera::GetRenderView() const
+{
+	if (m_snapshotTick == s_noSnapshot || m_snapshotTick != Game::Instance()->GetTick()) { return { m_viewMatrix, m_rotationMatrix, m_position }; }
+
+	float interpolation		= Game::Instance()->GetInterpolation();
+	glm::vec3 position		= glm::mix(m_previousPosition, m_position, interpolation);
+	glm::mat4 rotation		= CreateRotationMatrix(glm::mix(m_previousRotation, m_rotation, interpolation));
+
+	return { rotation * glm::translate(-position), rotation, position };
+}
+
+
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
@@ -160,8 +223,8 @@ glm::mat4 Camera::GetTranslationMatrix() const	{ return m_translationMatrix; }
 /*******************************************************************************************************************
 	Modifier methods
 *******************************************************************************************************************/
-void Camera::SetPosition(const glm::vec3& position)	{ m_position = position; m_isDirty = true; }
-void Camera::SetRotation(const glm::vec3& rotation)	{ m_rotation = glm::radians(rotation); m_isDirty = true; }
+void Camera::SetPosition(const glm::vec3& position)	{ SaveSnapshot(); m_position = position; m_isDirty = true; }
+void Camera::SetRotation(const glm::vec3& rotation)	{ SaveSnapshot(); m_rotation = glm::radians(rotation); m_isDirty = true; }
 
 void Camera::SetForward(const glm::vec3& forward)	{ m_forward = forward; m_isDirty = true; }
 
@@ -172,4 +235,12 @@ void Camera::SetForward(const glm::vec3& forward)	{ m_forward = forward; m_isDir
 glm::vec3 Camera::s_defaultUpAxis		= glm::vec3(0.0f, 1.0f, 0.0f);
 glm::vec3 Camera::s_defaultForwardAxis	= glm::vec3(0.0f, 0.0f, -1.0f);
 glm::vec3 Camera::s_defaultRightAxis	= glm::vec3(1.0f, 0.0f, 0.0f);
-glm::vec2 Camera::s_maxRotation			= glm::vec2(0.4f, 1.0f);
\ No newline at end of file
+glm::vec2 Camera::s_maxRotation			= glm::vec2(0.4f, 1.0f);
+const unsigned int Camera::s_noSnapshot	= ~0u;
+
+glm::mat4 Camera::CreateRotationMatrix(const glm::vec3& rotation)
+{
+	return	glm::rotate(rotation.z, glm::vec3(s_defaultForwardAxis)) *
+			glm::rotate(rotation.x, glm::vec3(s_defaultRightAxis)) *
+			glm::rotate(rotation.y, glm::vec3(s_defaultUpAxis));
+}
\ No newline at end of file
@@ -15,6 +15,10 @@
 	rotation matrix of the camera)
 	The camera's view matrix is only updated when changes have happened - using an optimization technique known
 	as a dirty flag. The zoom feature also only updates when a change has happened.
+	Render interpolation - the same as Transform, GetRenderViewMatrix() blends between where the camera was before the
+	last fixed update and where it is now.
+	GetRenderView() - a copy of the camera as it should be drawn this frame, for anything that renders on another
+	thread (e.g. the frame packets of the render thread).
 
 	[Upcoming]
 	Support for quaternion rotation.
@@ -27,6 +31,7 @@
 *******************************************************************************************************************/
 #include <pretty_glm/glm.hpp>
 #include "application/GameComponent.h"
+#include "graphics/CameraView.h"
 
 class Camera : public GameComponent {
 
@@ -56,6 +61,11 @@ public:
 	glm::mat4 GetRotationMatrix() const;
 	glm::mat4 GetTranslationMatrix() const;
 
+public:
+	glm::mat4	GetRenderViewMatrix() const;
+	glm::mat4	GetRenderRotationMatrix() const;
+	CameraView	GetRenderView() const;
+
 public:
 	void SetPosition(const glm::vec3& position);
 	void SetRotation(const glm::vec3& rotation);
@@ -67,6 +77,7 @@ private:
 	void UpdateViewMatrix();
 	void UpdateRotationMatrix();
 	void UpdateTranslationMatrix();
+	void SaveSnapshot();
 
 private:
 	glm::vec3 m_position;
@@ -82,6 +93,11 @@ private:
 	glm::mat4 m_rotationMatrix;
 	glm::mat4 m_translationMatrix;
 
+private:
+	glm::vec3		m_previousPosition;
+	glm::vec3		m_previousRotation;
+	unsigned int	m_snapshotTick;
+
 private:
 	bool m_isDirty;
 
@@ -90,4 +106,8 @@ private:
 	static glm::vec3	s_defaultForwardAxis;
 	static glm::vec3	s_defaultRightAxis;
 	static glm::vec2	s_maxRotation;
+	static const unsigned int s_noSnapshot;
+
+private:
+	static glm::mat4 CreateRotationMatrix(const glm::vec3& rotation);
 };
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+/*******************************************************************************************************************
+	CameraView.h
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A copy of everything the shaders need from a camera for one frame - see Camera::GetRenderView().
+
+	[Side Notes]
+	Lives in its own header with no dependencies on Camera, so the shaders and frame packets can hold one without
+	pulling in the game object headers (Camera.h includes Shader.h through GameComponent.h).
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+
+struct CameraView {
+	glm::mat4 view;
+	glm::mat4 rotation;
+	glm::vec3 position;
+};
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include <pretty_freetype/ft2build.h>
+#include <pretty_freetype/freetype.h>
+
+#include "FontBaker.h"
+#include <algorithm>
+#include <fstream>
+#include "utilities/DistanceField.h"
+#include "utilities/SkylinePacker.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+FontBaker::FontBaker(JobSystem* jobSystem)
+	:	m_font({ "", 0, 0, 0, {}, {}, 0 }),
+		m_stats({ 0.0, 0.0, 0.0, 0.0, 0, 0, 0.0f }),
+		m_jobSystem(jobSystem)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+FontBaker::~FontBaker()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Rasterises every glyph of a font with FreeType, then packs them all into one atlas. With a spread, the atlas is
+	then turned into a distance field reaching that many pixels either side of every edge
+*******************************************************************************************************************/
+bool FontBaker::Bake(const std::string& fontFilename, const std::string& fileLocation, unsigned int size, int spread)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	//--- Initialize FreeType, returns any number other than 0 on fail
+	FT_Library freeType = { 0 };
+	if (FT_Init_FreeType(&freeType)) { m_error = "Problem initializing FreeType"; return false; }
+
+	//--- Load the font file, returns any number other than 0 on fail
+	FT_Face face = { 0 };
+	if (FT_New_Face(freeType, fileLocation.c_str(), 0, &face)) {
+		FT_Done_FreeType(freeType);
+		m_error = "Failed to load font: " + fileLocation;
+		return false;
+	}
+
+	//--- Width should remain at 0 for automatic determination of font dimensions
+	FT_Set_Pixel_Sizes(face, 0, size);
+
+	std::vector<Glyph> glyphs;
+	std::vector<std::vector<unsigned char>> bitmaps;
+
+	for (int character = 0; character < s_maxGlyphs; character++) {
+
+		//--- Glyphs the font doesn't have are skipped, the same as they were when rendering straight from FreeType
+		if (FT_Load_Char(face, character, FT_LOAD_RENDER)) { continue; }
+
+		const FT_Bitmap& bitmap = face->glyph->bitmap;
+
+		//--- Distance fields need room around each glyph for the field to fade out in (blank glyphs stay blank)
+		int border = (spread > 0 && bitmap.width > 0 && bitmap.rows > 0) ? spread : 0;
+		int width = (int)bitmap.width + border * 2;
+
+		glyphs.push_back({	character, 0, 0, width, (int)bitmap.rows + border * 2,
+							face->glyph->bitmap_left - border, face->glyph->bitmap_top + border, (int)face->glyph->advance.x });
+
+		//--- FreeType rows can be padded, so copy the bitmap a row at a time
+		std::vector<unsigned char> pixels((size_t)width * glyphs.back().height, 0);
+		for (unsigned int row = 0; row < bitmap.rows; row++) {
+			std::copy(bitmap.buffer + row * bitmap.pitch, bitmap.buffer + row * bitmap.pitch + bitmap.width, pixels.begin() + (row + border) * width + border);
+		}
+
+		bitmaps.push_back(std::move(pixels));
+	}
+
+	//--- Destroy the font and remove the FreeType object now that we have the bitmaps
+	FT_Done_Face(face);
+	FT_Done_FreeType(freeType);
+
+	if (glyphs.empty()) { m_error = "Font has no glyphs: " + fileLocation; return false; }
+
+	m_stats.rasterTime = GetElapsedTime(start);
+
+	start = std::chrono::steady_clock::now();
+	if (!Pack(glyphs)) { return false; }
+
+	//--- Copy every glyph into its place in the atlas
+	m_font.pixels.assign((size_t)m_font.width * (size_t)m_font.height, 0);
+
+	for (size_t i = 0; i < glyphs.size(); i++) {
+		for (int row = 0; row < glyphs[i].height; row++) {
+			std::copy(	bitmaps[i].begin() + row * glyphs[i].width,
+						bitmaps[i].begin() + (row + 1) * glyphs[i].width,
+						m_font.pixels.begin() + (size_t)(glyphs[i].y + row) * m_font.width + glyphs[i].x);
+		}
+	}
+
+	m_stats.packTime = GetElapsedTime(start);
+
+	//--- The glyphs are at least the spread apart (their borders don't overlap), so one transform over the whole
+	//--- atlas gives every glyph the same field it would have had on its own
+	if (spread > 0) {
+		start = std::chrono::steady_clock::now();
+
+		std::vector<unsigned char> field;
+		DistanceField(m_jobSystem).Generate(m_font.pixels, m_font.width, m_font.height, spread, field);
+		m_font.pixels.swap(field);
+
+		m_stats.distanceTime = GetElapsedTime(start);
+	}
+
+	m_stats.atlasSize = m_font.pixels.size();
+
+	m_font.fontFilename	= fontFilename;
+	m_font.size			= size;
+	m_font.spread		= std::max(spread, 0);
+	m_font.glyphs		= std::move(glyphs);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that places every glyph in the atlas - tallest first, in the smallest atlas they all fit in
+*******************************************************************************************************************/
+bool FontBaker::Pack(std::vector<Glyph>& glyphs)
+{
+	std::vector<Glyph*> order;
+	order.reserve(glyphs.size());
+	for (auto& glyph : glyphs) { order.push_back(&glyph); }
+
+	std::stable_sort(order.begin(), order.end(), [](const Glyph* a, const Glyph* b) {
+		return (a->height != b->height) ? a->height > b->height : a->width > b->width;
+	});
+
+	SkylinePacker packer;
+
+	//--- Start small and double the shorter side until everything fits
+	for (int width = s_minAtlasSize, height = s_minAtlasSize; width <= s_maxAtlasSize && height <= s_maxAtlasSize;) {
+
+		packer.Reset(width, height, s_padding);
+
+		bool isPacked = true;
+
+		for (Glyph* glyph : order) {
+
+			//--- Blank glyphs (e.g. spaces) take up no room in the atlas
+			if (glyph->width == 0 || glyph->height == 0) { glyph->x = glyph->y = 0; continue; }
+
+			if (!packer.Insert(glyph->width, glyph->height, glyph->x, glyph->y)) { isPacked = false; break; }
+		}
+
+		if (isPacked) {
+
+			//--- Trim the atlas down to the smallest power of two that still holds every glyph
+			m_font.width	= width;
+			m_font.height	= 1;
+			while (m_font.height < packer.GetUsedHeight()) { m_font.height <<= 1; }
+
+			m_stats.occupancy = packer.GetOccupancy();
+
+			return true;
+		}
+
+		if (width <= height)	{ width <<= 1; }
+		else					{ height <<= 1; }
+	}
+
+	m_error = "Glyphs don't fit in a " + std::to_string(s_maxAtlasSize) + " x " + std::to_string(s_maxAtlasSize) + " atlas";
+
+	return false;
+}
+
+
+/*******************************************************************************************************************
+	Saves the baked font to a cereal binary file
+*******************************************************************************************************************/
+bool FontBaker::Save(const std::string& fileLocation)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	std::ofstream stream(fileLocation, std::ios::binary);
+	if (!stream.is_open()) { m_error = "Could not open file for writing: " + fileLocation; return false; }
+
+	{
+		cereal::BinaryOutputArchive archive(stream); archive(s_fileMagic, s_fileVersion, m_font);
+	}
+
+	m_stats.fileSize = (size_t)stream.tellp();
+	m_stats.saveTime = GetElapsedTime(start);
+
+	if (!stream.good()) { m_error = "Problem writing file: " + fileLocation; return false; }
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Loads a previously baked font from a cereal binary file
+*******************************************************************************************************************/
+bool FontBaker::Load(const std::string& fileLocation)
+{
+	std::ifstream stream(fileLocation, std::ios::binary);
+	if (!stream.is_open()) { m_error = "Baked font file doesn't exist: " + fileLocation; return false; }
+
+	//--- cereal reports a truncated or corrupt file by throwing (or a garbage length can fail to allocate), which we
+	//--- turn into a normal error
+	try {
+		cereal::BinaryInputArchive archive(stream);
+
+		//--- Files from before the header (or an older format) are turned away before any of the font is read
+		uint32_t magic = 0, version = 0;
+		archive(magic, version);
+
+		if (magic != s_fileMagic || version != s_fileVersion) {
+			m_error = "Baked font file is out of date: " + fileLocation; return false;
+		}
+
+		archive(m_font);
+	}
+	catch (const std::exception& exception) {
+		m_error = "Baked font file is corrupt: " + fileLocation + " (" + exception.what() + ")";
+		return false;
+	}
+
+	m_stats.atlasSize = m_font.pixels.size();
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+FontBaker::BakedFont& FontBaker::GetFont()				{ return m_font; }
+const FontBaker::Stats& FontBaker::GetStats() const		{ return m_stats; }
+const std::string& FontBaker::GetError() const			{ return m_error; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const int FontBaker::s_maxGlyphs		= 128;
+const int FontBaker::s_padding			= 1;
+const int FontBaker::s_minAtlasSize		= 64;
+const int FontBaker::s_maxAtlasSize		= 4096;
+
+//--- "COGF" read as a little endian number. Version 2 added the distance field spread
+const uint32_t FontBaker::s_fileMagic	= 0x46474F43;
+const uint32_t FontBaker::s_fileVersion	= 2;
+
+//--- Baked fonts are named after the font and its pixel size, e.g. FuturaCM.otf at 32 pixels is FuturaCM_32.bin
+//--- (or FuturaCM_32_sdf.bin, for its distance field)
+std::string FontBaker::GetBakedFilename(const std::string& fontFilename, unsigned int size, int spread)
+{
+	return fontFilename.substr(0, fontFilename.find_last_of('.')) + "_" + std::to_string(size) + ((spread > 0) ? "_sdf.bin" : ".bin");
+}
+
+double FontBaker::GetElapsedTime(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
\ No newline at end of file
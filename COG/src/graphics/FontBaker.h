@@ -0,0 +1,129 @@
+#pragma once
+
+/*******************************************************************************************************************
+	FontBaker.h, FontBaker.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Bakes a font at one pixel size into a single glyph atlas and a table of glyph metrics, using FreeType.
+	This is the part of font loading that doesn't need a window or a GPU, split out of the Text class.
+	The atlas holds either the glyphs' coverage (drawn at the size they were baked at), or their signed distance
+	fields (drawn sharply at any size, scaling the metrics to suit).
+
+	[Features]
+	Rasterises the first 128 characters of a font and packs them into one 8 bit atlas with the SkylinePacker
+	(tallest glyphs first). The atlas starts small and doubles until everything fits, then is trimmed down to the
+	smallest power of two height that holds every glyph.
+	The metrics table holds each glyph's rectangle in the atlas (in pixels), its bearing and its advance.
+	Distance field atlases - every glyph is given a border as wide as the spread, and the distance transform is run
+	over the whole atlas in one go (see DistanceField), split across the job system's workers when it's running.
+	Timings and sizes for every stage of the bake, plus how much of the atlas the glyphs cover.
+	Saving/loading of baked fonts, so later launches can skip FreeType entirely.
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	This class must not include anything that depends on SDL, OpenGL, Windows or the engine singletons - it is
+	compiled into both the game and the COGBake command-line tool, which runs on build machines with no display.
+	Errors are returned as strings via GetError() rather than logged, so each side can report them its own way.
+	For the same reason Save()/Load() use plain file streams rather than the FileManager, and catch cereal's exceptions
+	so a corrupt file is an error rather than a crash.
+	Baked files start with a magic number and a format version (s_fileVersion), which must be bumped whenever
+	BakedFont changes - a file from an older version fails to load as out of date, so the font is baked again.
+	A spread of 0 means a coverage atlas. Distance field glyph rectangles and bearings include the border, so the
+	quads built from them line up with the glyphs either way.
+
+*******************************************************************************************************************/
+#ifndef COG_NVP
+	#define COG_NVP(T) CEREAL_NVP(T)
+#endif
+
+#include <pretty_cereal/includes.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "utilities/JobSystem.h"
+
+class FontBaker {
+
+public:
+	struct Glyph {
+		int character;
+		int x, y, width, height;
+		int bearingX, bearingY;
+		int advance;
+
+		template <class Archive>
+		void Serialize(Archive& archive)
+		{
+			archive(COG_NVP(character), COG_NVP(x), COG_NVP(y), COG_NVP(width), COG_NVP(height), COG_NVP(bearingX), COG_NVP(bearingY), COG_NVP(advance));
+		}
+	};
+
+	struct BakedFont {
+		std::string fontFilename;
+		unsigned int size;
+		int width, height;
+		std::vector<Glyph> glyphs;
+		std::vector<unsigned char> pixels;
+		int spread;
+
+		template <class Archive>
+		void Serialize(Archive& archive)
+		{
+			archive(COG_NVP(fontFilename), COG_NVP(size), COG_NVP(width), COG_NVP(height), COG_NVP(glyphs), COG_NVP(pixels), COG_NVP(spread));
+		}
+	};
+
+	//--- Timings are in milliseconds, sizes are in bytes
+	struct Stats {
+		double rasterTime, packTime, distanceTime, saveTime;
+		size_t atlasSize, fileSize;
+		float occupancy;
+	};
+
+public:
+	FontBaker(JobSystem* jobSystem = nullptr);
+	~FontBaker();
+
+public:
+	bool Bake(const std::string& fontFilename, const std::string& fileLocation, unsigned int size, int spread = 0);
+	bool Save(const std::string& fileLocation);
+	bool Load(const std::string& fileLocation);
+
+public:
+	BakedFont&			GetFont();
+	const Stats&		GetStats() const;
+	const std::string&	GetError() const;
+
+public:
+	static std::string GetBakedFilename(const std::string& fontFilename, unsigned int size, int spread = 0);
+
+private:
+	FontBaker(const FontBaker&)				= delete;
+	FontBaker& operator=(const FontBaker&)	= delete;
+
+private:
+	bool Pack(std::vector<Glyph>& glyphs);
+
+private:
+	static double GetElapsedTime(const std::chrono::steady_clock::time_point& start);
+
+private:
+	BakedFont	m_font;
+	Stats		m_stats;
+	std::string	m_error;
+	JobSystem*	m_jobSystem;
+
+private:
+	static const int s_maxGlyphs;
+	static const int s_padding;
+	static const int s_minAtlasSize;
+	static const int s_maxAtlasSize;
+
+private:
+	static const uint32_t s_fileMagic;
+	static const uint32_t s_fileVersion;
+};
\ No newline at end of file
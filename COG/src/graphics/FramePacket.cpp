@@ -0,0 +1,37 @@
+#include "FramePacket.h"
+#include "graphics/Material.h"
+#include "graphics/Model.h"
+#include "graphics/Texture.h"
+
+/*******************************************************************************************************************
+	Function that adds a mesh to draw with the entity shader, and pushes its draw command onto the render queue. The
+	shininess is read now, so instanced batches never have to look at the material (see InstanceBatcher)
+*******************************************************************************************************************/
+void FramePacket::AddMesh(Model* model, Material* material, const glm::mat4& world)
+{
+	float distance = glm::length(glm::vec3(world[3]) - camera.position);
+
+	queue.Push(RenderQueue::MakeKey(RenderQueue::PASS_OPAQUE, SHADER_ENTITY, material->GetID(), model->GetID(), distance),
+			   (unsigned int)meshes.size());
+
+	meshes.push_back({ model, material, world, material->GetShininess() });
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an interface sprite to draw with the interface shader. The texture offset is read now, as an
+	animated sprite's frame can change on the update thread while the packet is being drawn
+*******************************************************************************************************************/
+void FramePacket::AddSprite(Texture* texture, Quad* quad, const glm::mat4& world)
+{
+	sprites.push_back({ texture, quad, world, texture ? texture->GetOffset() : glm::vec2(0.0f) });
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a line of text to draw with the text shader
+*******************************************************************************************************************/
+void FramePacket::AddText(const std::string& text, const glm::vec2& position, const glm::vec2& scale, const glm::vec4& color)
+{
+	labels.push_back({ text, position, scale, color });
+}
\ No newline at end of file
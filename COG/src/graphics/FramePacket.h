@@ -0,0 +1,106 @@
+#pragma once
+
+/*******************************************************************************************************************
+	FramePacket.h, FramePacket.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Everything needed to draw one frame - what to draw, where to draw it and how it's lit - copied out of the game
+	by the update thread, so the render thread can draw it without reading any game objects.
+
+	[Features]
+	Meshes, interface sprites and text labels, each with the world matrix (or screen position) to draw it with.
+	A copy of the cameras and lights as they were when the frame was built, and whether the minimap is on screen (the
+	renderer only draws the terrain into the minimap when it is, and tells the terrain which way to draw itself for
+	each pass rather than changing the terrain's own minimap mode).
+	A render queue of the meshes - every mesh added pushes a command keyed on its shader, material, model and
+	distance from the camera, and the queue is sorted when the packet is handed over (RenderThread::SubmitFrame()).
+	Clear() keeps the memory of every list, so a packet that is re-used every frame stops allocating once it has
+	grown to the size of the biggest frame.
+
+	[Upcoming]
+	Sorting sprites by texture (within the same layer) as well.
+
+	[Side Notes]
+	A packet only holds pointers to models, materials, textures and quads (the OpenGL resources), never to the game
+	objects that own them. Anything that owns one of those must not be deleted while a packet using it is in flight
+	(see RenderThread::Stop()).
+	The camera must be set before any meshes are added, as their sort keys are worked out from it.
+	Once a packet has been handed over (RenderThread::SubmitFrame()) it is only ever read, never changed.
+	The constructor and Clear() are in the header so the render thread can be built (and tested, in COGTest) without
+	the models, materials and textures the Add functions read from.
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <string>
+#include <vector>
+#include "graphics/CameraView.h"
+#include "graphics/Light.h"
+#include "graphics/RenderQueue.h"
+
+class Model; class Material; class Texture; class Quad;
+
+struct FramePacket {
+
+	enum ShaderID { SHADER_ENTITY };
+
+	struct MeshDraw {
+		Model*		model;
+		Material*	material;
+		glm::mat4	world;
+		float		shininess;
+	};
+
+	struct SpriteDraw {
+		Texture*	texture;
+		Quad*		quad;
+		glm::mat4	world;
+		glm::vec2	offset;
+	};
+
+	struct TextDraw {
+		std::string	text;
+		glm::vec2	position;
+		glm::vec2	scale;
+		glm::vec4	color;
+	};
+
+	FramePacket()
+		:	camera({ glm::mat4(1.0f), glm::mat4(1.0f), glm::vec3(0.0f) }),
+			minimapCamera({ glm::mat4(1.0f), glm::mat4(1.0f), glm::vec3(0.0f) }),
+			frame(0),
+			isMinimapVisible(false),
+			isDebugMode(false),
+			isWireframe(false) {}
+
+	//--- Empties the packet, ready to build the next frame (keeps the memory of every list)
+	void Clear()
+	{
+		meshes.clear();
+		sprites.clear();
+		labels.clear();
+		lights.clear();
+		queue.Clear();
+
+		isMinimapVisible	= false;
+		isDebugMode			= false;
+		isWireframe			= false;
+	}
+
+	void AddMesh(Model* model, Material* material, const glm::mat4& world);
+	void AddSprite(Texture* texture, Quad* quad, const glm::mat4& world);
+	void AddText(const std::string& text, const glm::vec2& position, const glm::vec2& scale, const glm::vec4& color);
+
+	std::vector<MeshDraw>	meshes;
+	std::vector<SpriteDraw>	sprites;
+	std::vector<TextDraw>	labels;
+	std::vector<Light>		lights;
+	RenderQueue				queue;
+
+	CameraView		camera;
+	CameraView		minimapCamera;
+	unsigned int	frame;
+	bool			isMinimapVisible;
+	bool			isDebugMode;
+	bool			isWireframe;
+};
\ No newline at end of file
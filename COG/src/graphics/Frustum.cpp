@@ -1,16 +1,22 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include "Frustum.h"
+#include "utilities/Simd.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
 *******************************************************************************************************************/
 Frustum::Frustum(const glm::mat4& projection, const glm::mat4& view)
+	:	m_planes(),
+		m_absoluteNormals(),
+		m_objectTests(0),
+		m_planeTests(0),
+		m_cacheHits(0),
+		m_isReused(false),
+		m_version(0),
+		m_motionThreshold(s_defaultMotionThreshold)
 {
-	//--- Prepare our frustum and reserve memory when an instance is first created
-	m_frustum.resize(s_maxSides);
-	for (unsigned int side = 0; side < s_maxSides; side++) {
-		m_frustum[side].resize(s_maxPlaneContents);
-	}
-
 	//--- Update frustum when an instance is first created, to set the startup clipping planes
 	Update(projection, view);
 }
@@ -26,25 +32,26 @@ Frustum::~Frustum()
 
 
 /*******************************************************************************************************************
-	A function which calculates a magnitude of a normal to a plane and then normalizes it
+	A function which stores a plane, after calculating the magnitude of its normal and normalizing it
 *******************************************************************************************************************/
-void Frustum::NormalizePlane(std::vector <std::vector<float>>& frustum, SideType side) {
-	
+void Frustum::SetPlane(SideType side, float a, float b, float c, float d) {
+
 	//--- Here we calculate the magnitude of the normal to the plane (point A B C)
 	//--- Remember that (A, B, C) is that same thing as the normal's (X, Y, Z).
 	//--- To calculate magnitude you use the equation:  magnitude = sqrt( x^2 + y^2 + z^2)
-	float magnitude = (float)sqrt(
-		frustum[side][A] * frustum[side][A] +
-		frustum[side][B] * frustum[side][B] +
-		frustum[side][C] * frustum[side][C]
-	);
-	
+	float magnitude = (float)sqrt(a * a + b * b + c * c);
+
 	//--- Then we divide the plane's values by it's magnitude.
 	//--- This makes it easier to work with.
-	frustum[side][A] /= magnitude;
-	frustum[side][B] /= magnitude;
-	frustum[side][C] /= magnitude;
-	frustum[side][D] /= magnitude;
+	m_planes[A][side] = a / magnitude;
+	m_planes[B][side] = b / magnitude;
+	m_planes[C][side] = c / magnitude;
+	m_planes[D][side] = d / magnitude;
+
+	//--- The box tests use the absolute normal to find how far the box reaches towards the plane
+	m_absoluteNormals[A][side] = fabs(m_planes[A][side]);
+	m_absoluteNormals[B][side] = fabs(m_planes[B][side]);
+	m_absoluteNormals[C][side] = fabs(m_planes[C][side]);
 }
 
 
@@ -53,71 +60,71 @@ void Frustum::NormalizePlane(std::vector <std::vector<float>>& frustum, SideType
 *******************************************************************************************************************/
 void Frustum::Update(const glm::mat4& projection, const glm::mat4& view) {
 
+	//--- A new frame, so start counting the culling work again
+	m_objectTests	= 0;
+	m_planeTests	= 0;
+	m_cacheHits		= 0;
+	m_isReused		= false;
+
+	//--- Keep hold of the current planes, in case the camera hasn't moved enough to replace them
+	float planes[D + 1][FRONT + 1];
+	float absoluteNormals[C + 1][FRONT + 1];
+	std::memcpy(planes, m_planes, sizeof(m_planes));
+	std::memcpy(absoluteNormals, m_absoluteNormals, sizeof(m_absoluteNormals));
+
 	//--- This will hold the clipping planes (sides of the frustum)
 	glm::mat4 clip = projection * view;
 
 	//--- Now we actually want to get the sides of the frustum. To do this we take
 	//--- the clipping planes we received above and extract the sides from them.
+	//--- Each side is a normal (A, B, C) and a distance (D), which SetPlane normalizes.
+	SetPlane(RIGHT,		clip[0][3] - clip[0][0], clip[1][3] - clip[1][0], clip[2][3] - clip[2][0], clip[3][3] - clip[3][0]);
+	SetPlane(LEFT,		clip[0][3] + clip[0][0], clip[1][3] + clip[1][0], clip[2][3] + clip[2][0], clip[3][3] + clip[3][0]);
+	SetPlane(BOTTOM,	clip[0][3] + clip[0][1], clip[1][3] + clip[1][1], clip[2][3] + clip[2][1], clip[3][3] + clip[3][1]);
+	SetPlane(TOP,		clip[0][3] - clip[0][1], clip[1][3] - clip[1][1], clip[2][3] - clip[2][1], clip[3][3] - clip[3][1]);
+	SetPlane(BACK,		clip[0][3] - clip[0][2], clip[1][3] - clip[1][2], clip[2][3] - clip[2][2], clip[3][3] - clip[3][2]);
+	SetPlane(FRONT,		clip[0][3] + clip[0][2], clip[1][3] + clip[1][2], clip[2][3] + clip[2][2], clip[3][3] + clip[3][2]);
+
+	//--- NOTE
+	// Most frames the camera barely moves, so if no plane moved by more than the threshold we put the old planes back.
+	// The version doesn't change, which tells anyone culling against us that last frame's results are still valid.
+	// The planes are compared against the last planes we kept (not last frame's), so slow movement still adds up.
+	//---
+
+	if (m_version > 0) {
+
+		float motion = 0.0f;
+
+		for (unsigned int side = 0; side < s_maxSides; side++) {
+			for (unsigned int content = 0; content < s_maxPlaneContents; content++) {
+				motion = std::max(motion, (float)fabs(m_planes[content][side] - planes[content][side]));
+			}
+		}
 
-	//--- This will extract the RIGHT side of the frustum
-	m_frustum[RIGHT][A] = clip[0][3] - clip[0][0];
-	m_frustum[RIGHT][B] = clip[1][3] - clip[1][0];
-	m_frustum[RIGHT][C] = clip[2][3] - clip[2][0];
-	m_frustum[RIGHT][D] = clip[3][3] - clip[3][0];
-
-	//--- Now that we have a normal (A, B, C) and a distance (D) to the plane,
-	//--- we want to normalize that normal and distance.
-	NormalizePlane(m_frustum, RIGHT);
-
-	m_frustum[LEFT][A] = clip[0][3] + clip[0][0];
-	m_frustum[LEFT][B] = clip[1][3] + clip[1][0];
-	m_frustum[LEFT][C] = clip[2][3] + clip[2][0];
-	m_frustum[LEFT][D] = clip[3][3] + clip[3][0];
-
-	NormalizePlane(m_frustum, LEFT);
-
-	m_frustum[BOTTOM][A] = clip[0][3] + clip[0][1];
-	m_frustum[BOTTOM][B] = clip[1][3] + clip[1][1];
-	m_frustum[BOTTOM][C] = clip[2][3] + clip[2][1];
-	m_frustum[BOTTOM][D] = clip[3][3] + clip[3][1];
-
-	NormalizePlane(m_frustum, BOTTOM);
-
-	m_frustum[TOP][A] = clip[0][3] - clip[0][1];
-	m_frustum[TOP][B] = clip[1][3] - clip[1][1];
-	m_frustum[TOP][C] = clip[2][3] - clip[2][1];
-	m_frustum[TOP][D] = clip[3][3] - clip[3][1];
-
-	NormalizePlane(m_frustum, TOP);
-
-	m_frustum[BACK][A] = clip[0][3] - clip[0][2];
-	m_frustum[BACK][B] = clip[1][3] - clip[1][2];
-	m_frustum[BACK][C] = clip[2][3] - clip[2][2];
-	m_frustum[BACK][D] = clip[3][3] - clip[3][2];
-
-	NormalizePlane(m_frustum, BACK);
-
-	m_frustum[FRONT][A] = clip[0][3] + clip[0][2];
-	m_frustum[FRONT][B] = clip[1][3] + clip[1][2];
-	m_frustum[FRONT][C] = clip[2][3] + clip[2][2];
-	m_frustum[FRONT][D] = clip[3][3] + clip[3][2];
+		if (motion <= m_motionThreshold) {
+			std::memcpy(m_planes, planes, sizeof(m_planes));
+			std::memcpy(m_absoluteNormals, absoluteNormals, sizeof(m_absoluteNormals));
+			m_isReused = true;
+			return;
+		}
+	}
 
-	NormalizePlane(m_frustum, FRONT);
+	m_version++;
 }
 
 
 /*******************************************************************************************************************
 	A function which checks if a single point is inside the frustum
 *******************************************************************************************************************/
-bool Frustum::IsPointInside(const glm::vec3& position) {
+bool Frustum::IsPointInside(const glm::vec3& position) const {
 
 	//--- Go through all the sides of the frustum
 	for (unsigned int side = 0; side < s_maxSides; side++) {
 		//--- Calculate the plane equation and check if the point is behind a side of the frustum
-		if (m_frustum[side][A] * position.x +
-			m_frustum[side][B] * position.y +
-			m_frustum[side][C] * position.z +
-			m_frustum[side][D] <= 0.0f) {
+		if (m_planes[A][side] * position.x +
+			m_planes[B][side] * position.y +
+			m_planes[C][side] * position.z +
+			m_planes[D][side] <= 0.0f) {
 			//--- The point was behind a side, so it ISN'T in the frustum
 			return false;
 		}
@@ -131,21 +138,53 @@ bool Frustum::IsPointInside(const glm::vec3& position) {
 /*******************************************************************************************************************
 	A function which checks if a sphere is inside the frustum, giving its center position and radius
 *******************************************************************************************************************/
-bool Frustum::IsSphereInside(const glm::vec3& centerPosition, float radius) {
+bool Frustum::IsSphereInside(const glm::vec3& centerPosition, float radius) const {
+
+	unsigned int lastSide = 0;
+	return IsSphereInside(centerPosition, radius, lastSide);
+}
+
+
+/*******************************************************************************************************************
+	A function which checks if a sphere is inside the frustum, testing the side that rejected it last time first
+*******************************************************************************************************************/
+bool Frustum::IsSphereInside(const glm::vec3& centerPosition, float radius, unsigned int& lastSide) const {
+
+	Counters counters = { 0, 0, 0, false };
+	bool isInside = IsSphereInside(centerPosition, radius, lastSide, counters);
+
+	AddCounters(counters);
+	return isInside;
+}
+
+
+/*******************************************************************************************************************
+	A function which checks if a sphere is inside the frustum like above, adding the work done to the counters passed in
+*******************************************************************************************************************/
+bool Frustum::IsSphereInside(const glm::vec3& centerPosition, float radius, unsigned int& lastSide, Counters& counters) const {
+
+	counters.objectTests++;
 
 	//--- Go through all the sides of the frustum
-	for (unsigned int side = 0; side < s_maxSides; side++) {
+	for (unsigned int i = 0; i < s_maxSides; i++) {
+
+		unsigned int side = GetSide(i, lastSide);
+
 		//--- If the center of the sphere is farther away from the plane than the radius
-		if (m_frustum[side][A] * centerPosition.x +
-			m_frustum[side][B] * centerPosition.y +
-			m_frustum[side][C] * centerPosition.z +
-			m_frustum[side][D] <= -radius) {
+		if (m_planes[A][side] * centerPosition.x +
+			m_planes[B][side] * centerPosition.y +
+			m_planes[C][side] * centerPosition.z +
+			m_planes[D][side] <= -radius) {
 			//--- The distance was greater than the radius so the sphere is outside of the frustum
+			counters.planeTests += i + 1;
+			if (i == 0) { counters.cacheHits++; }
+			lastSide = side;
 			return false;
 		}
 	}
 
 	//--- The sphere was inside of the frustum!
+	counters.planeTests += s_maxSides;
 	return true;
 }
 
@@ -153,138 +192,407 @@ bool Frustum::IsSphereInside(const glm::vec3& centerPosition, float radius) {
 /*******************************************************************************************************************
 	A function which checks if a cube is inside the frustum given its center position and length / 2.0
 *******************************************************************************************************************/
-bool Frustum::IsCubeInside(const glm::vec3& centerPosition, float halfDepth) {
-	
-	//--- Extract the center position of the cube and half the length (depth(z axis) / 2.0)
-	//--- Then we check each point in the cube and seeing if it is inside the frustum.
-	//--- If a point is found in front of a side, then we skip to the next side.
-	//--- If we get to a plane that does NOT have a point in front of it, then it will return false.
+bool Frustum::IsCubeInside(const glm::vec3& centerPosition, float halfDepth) const {
 
-	for (unsigned int side = 0; side < s_maxSides; side++) {
-		if (m_frustum[side][A] * (centerPosition.x - halfDepth) +
-			m_frustum[side][B] * (centerPosition.y - halfDepth) +
-			m_frustum[side][C] * (centerPosition.z - halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDepth) +
-			m_frustum[side][B] * (centerPosition.y - halfDepth) +
-			m_frustum[side][C] * (centerPosition.z - halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x - halfDepth) +
-			m_frustum[side][B] * (centerPosition.y + halfDepth) +
-			m_frustum[side][C] * (centerPosition.z - halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDepth) +
-			m_frustum[side][B] * (centerPosition.y + halfDepth) +
-			m_frustum[side][C] * (centerPosition.z - halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x - halfDepth) +
-			m_frustum[side][B] * (centerPosition.y - halfDepth) +
-			m_frustum[side][C] * (centerPosition.z + halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDepth) +
-			m_frustum[side][B] * (centerPosition.y - halfDepth) +
-			m_frustum[side][C] * (centerPosition.z + halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x - halfDepth) +
-			m_frustum[side][B] * (centerPosition.y + halfDepth) +
-			m_frustum[side][C] * (centerPosition.z + halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDepth) +
-			m_frustum[side][B] * (centerPosition.y + halfDepth) +
-			m_frustum[side][C] * (centerPosition.z + halfDepth) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		//--- If we get here, it isn't in the frustum
-		return false;
+	//--- A cube is just a rectangle with the same half length on every axis
+	return IsRectangleInside(centerPosition, glm::vec3(halfDepth));
+}
+
+
+/*******************************************************************************************************************
+	A function which checks if a rectangle is inside the frustum given its center position half dimension
+*******************************************************************************************************************/
+bool Frustum::IsRectangleInside(const glm::vec3& centerPosition, const glm::vec3& halfDimension) const {
+
+	unsigned int lastSide = 0;
+	return TestRectangle(centerPosition, halfDimension, lastSide) != OUTSIDE;
+}
+
+
+/*******************************************************************************************************************
+	A function which checks if a rectangle is inside the frustum, testing the side that rejected it last time first
+*******************************************************************************************************************/
+bool Frustum::IsRectangleInside(const glm::vec3& centerPosition, const glm::vec3& halfDimension, unsigned int& lastSide) const {
+
+	return TestRectangle(centerPosition, halfDimension, lastSide) != OUTSIDE;
+}
+
+
+/*******************************************************************************************************************
+	A function which checks if a rectangle is outside, crossing or fully inside the frustum
+*******************************************************************************************************************/
+Frustum::Intersection Frustum::TestRectangle(const glm::vec3& centerPosition, const glm::vec3& halfDimension) const {
+
+	unsigned int lastSide = 0;
+	return TestRectangle(centerPosition, halfDimension, lastSide);
+}
+
+
+/*******************************************************************************************************************
+	A function which tests a rectangle against the frustum, testing the side that rejected it last time first
+*******************************************************************************************************************/
+Frustum::Intersection Frustum::TestRectangle(const glm::vec3& centerPosition, const glm::vec3& halfDimension, unsigned int& lastSide) const {
+
+	Counters counters = { 0, 0, 0, false };
+	Intersection result = TestRectangle(centerPosition, halfDimension, lastSide, counters);
+
+	AddCounters(counters);
+	return result;
+}
+
+
+/*******************************************************************************************************************
+	A function which tests a rectangle against the frustum like above, adding the work done to the counters passed in
+*******************************************************************************************************************/
+Frustum::Intersection Frustum::TestRectangle(const glm::vec3& centerPosition, const glm::vec3& halfDimension, unsigned int& lastSide, Counters& counters) const {
+
+	//--- NOTE
+	// Rather than testing all 8 corners against every side, we only need the two corners that matter.
+	// The p-vertex is the corner furthest along the plane's normal - its distance is the distance of the center plus
+	// how far the box reaches towards the plane (the half dimension projected onto the absolute normal).
+	// If even the p-vertex is behind a side, every corner is, so the box is outside.
+	// The n-vertex is the opposite corner - if it is behind a side, the box crosses that side.
+	//---
+
+	//--- Objects rarely move far between frames, so the side that rejected this box last time most likely rejects it
+	//--- again - testing that side first means most hidden boxes only cost a single plane test
+	counters.objectTests++;
+
+	Intersection result = INSIDE;
+
+	for (unsigned int i = 0; i < s_maxSides; i++) {
+
+		unsigned int side = GetSide(i, lastSide);
+
+		float distance	=	m_planes[A][side] * centerPosition.x +
+							m_planes[B][side] * centerPosition.y +
+							m_planes[C][side] * centerPosition.z +
+							m_planes[D][side];
+
+		float reach		=	m_absoluteNormals[A][side] * halfDimension.x +
+							m_absoluteNormals[B][side] * halfDimension.y +
+							m_absoluteNormals[C][side] * halfDimension.z;
+
+		if (distance + reach < 0.0f) {
+			counters.planeTests += i + 1;
+			if (i == 0) { counters.cacheHits++; }
+			lastSide = side;
+			return OUTSIDE;
+		}
+
+		if (distance - reach < 0.0f) { result = INTERSECTING; }
 	}
 
-	return true;
+	counters.planeTests += s_maxSides;
+	return result;
 }
 
 
 /*******************************************************************************************************************
-	A function which checks if a rectangle is inside the frustum given its center position half dimension
+	A function which culls a list of boxes, setting bit i of the visibility mask if box i is inside the frustum
 *******************************************************************************************************************/
-bool Frustum::IsRectangleInside(const glm::vec3& centerPosition, const glm::vec3& halfDimension) {
+void Frustum::CullBoxes(const BoxList& boxes, std::vector<unsigned int>& visibility) const {
 
-	//--- Rectangles are the same as cubes only we take into acount the full dimension
-	//--- Due to the sides being un-equal; so equivelant to width, height and depth of a models
-	//--- bounding box / 2.0
+	size_t count = boxes.GetSize();
+	visibility.assign((count + s_bitsPerMask - 1) / s_bitsPerMask, 0);
 
-	for (unsigned int side = 0; side < s_maxSides; side++) {
-		if (m_frustum[side][A] * (centerPosition.x - halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y - halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z - halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y - halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z - halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x - halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y + halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z - halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y + halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z - halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x - halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y - halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z + halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y - halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z + halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x - halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y + halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z + halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		if (m_frustum[side][A] * (centerPosition.x + halfDimension.x) +
-			m_frustum[side][B] * (centerPosition.y + halfDimension.y) +
-			m_frustum[side][C] * (centerPosition.z + halfDimension.z) +
-			m_frustum[side][D] >= 0.0f)
-			continue;
-
-		//--- If we get here, it isn't in the frustum
-		return false;
+	size_t index = 0;
+	Counters counters = { 0, 0, 0, false };
+
+#if COG_SIMD == 1
+	//--- Test 4 boxes at once against each side, using the same p-vertex test as TestRectangle
+	//--- A box is only outside if it is behind at least one side, so we OR the results from every side together
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; index + 4 <= count; index += 4) {
+
+		__m128 x		= _mm_loadu_ps(&boxes.x[index]);
+		__m128 y		= _mm_loadu_ps(&boxes.y[index]);
+		__m128 z		= _mm_loadu_ps(&boxes.z[index]);
+		__m128 halfX	= _mm_loadu_ps(&boxes.halfX[index]);
+		__m128 halfY	= _mm_loadu_ps(&boxes.halfY[index]);
+		__m128 halfZ	= _mm_loadu_ps(&boxes.halfZ[index]);
+		__m128 outside	= zero;
+
+		for (unsigned int side = 0; side < s_maxSides; side++) {
+
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_planes[A][side]), x),
+													_mm_mul_ps(_mm_set1_ps(m_planes[B][side]), y)),
+										 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_planes[C][side]), z),
+													_mm_set1_ps(m_planes[D][side])));
+
+			__m128 reach	= _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_absoluteNormals[A][side]), halfX),
+													_mm_mul_ps(_mm_set1_ps(m_absoluteNormals[B][side]), halfY)),
+										 _mm_mul_ps(_mm_set1_ps(m_absoluteNormals[C][side]), halfZ));
+
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+		}
+
+		//--- Each group of 4 starts on a multiple of 4, so it never crosses into the next mask
+		unsigned int visible = ~(unsigned int)_mm_movemask_ps(outside) & 0xF;
+		visibility[index / s_bitsPerMask] |= visible << (index % s_bitsPerMask);
 	}
 
-	return true;
+	counters.objectTests	+= (unsigned int)index;
+	counters.planeTests		+= (unsigned int)index * s_maxSides;
+#endif
+
+	//--- Whatever is left over (or everything, without SSE) is tested one box at a time
+	for (; index < count; index++) {
+		unsigned int lastSide = 0;
+		if (TestRectangle(glm::vec3(boxes.x[index], boxes.y[index], boxes.z[index]),
+						  glm::vec3(boxes.halfX[index], boxes.halfY[index], boxes.halfZ[index]), lastSide, counters) != OUTSIDE) {
+			visibility[index / s_bitsPerMask] |= 1u << (index % s_bitsPerMask);
+		}
+	}
+
+	AddCounters(counters);
 }
 
 
+/*******************************************************************************************************************
+	A function which culls a list of spheres, setting bit i of the visibility mask if sphere i is inside the frustum
+*******************************************************************************************************************/
+void Frustum::CullSpheres(const SphereList& spheres, std::vector<unsigned int>& visibility) const {
+
+	size_t count = spheres.GetSize();
+	visibility.assign((count + s_bitsPerMask - 1) / s_bitsPerMask, 0);
+
+	size_t index = 0;
+	Counters counters = { 0, 0, 0, false };
+
+#if COG_SIMD == 1
+	//--- Test 4 spheres at once against each side, using the same test as IsSphereInside
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	for (; index + 4 <= count; index += 4) {
+
+		__m128 x		= _mm_loadu_ps(&spheres.x[index]);
+		__m128 y		= _mm_loadu_ps(&spheres.y[index]);
+		__m128 z		= _mm_loadu_ps(&spheres.z[index]);
+		__m128 radius	= _mm_xor_ps(_mm_loadu_ps(&spheres.radius[index]), signMask);
+		__m128 outside	= _mm_setzero_ps();
+
+		for (unsigned int side = 0; side < s_maxSides; side++) {
+
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_planes[A][side]), x),
+													_mm_mul_ps(_mm_set1_ps(m_planes[B][side]), y)),
+										 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_planes[C][side]), z),
+													_mm_set1_ps(m_planes[D][side])));
+
+			outside = _mm_or_ps(outside, _mm_cmple_ps(distance, radius));
+		}
+
+		unsigned int visible = ~(unsigned int)_mm_movemask_ps(outside) & 0xF;
+		visibility[index / s_bitsPerMask] |= visible << (index % s_bitsPerMask);
+	}
+
+	counters.objectTests	+= (unsigned int)index;
+	counters.planeTests		+= (unsigned int)index * s_maxSides;
+#endif
+
+	//--- Whatever is left over (or everything, without SSE) is tested one sphere at a time
+	for (; index < count; index++) {
+		unsigned int lastSide = 0;
+		if (IsSphereInside(glm::vec3(spheres.x[index], spheres.y[index], spheres.z[index]), spheres.radius[index], lastSide, counters)) {
+			visibility[index / s_bitsPerMask] |= 1u << (index % s_bitsPerMask);
+		}
+	}
+
+	AddCounters(counters);
+}
+
+
+/*******************************************************************************************************************
+	A function which culls a list of boxes like above, but tests the side that rejected each box last time first
+*******************************************************************************************************************/
+void Frustum::CullBoxes(const BoxList& boxes, std::vector<unsigned int>& visibility, std::vector<unsigned int>& lastSides) const {
+
+	size_t count = boxes.GetSize();
+	visibility.assign((count + s_bitsPerMask - 1) / s_bitsPerMask, 0);
+	lastSides.resize(count, 0);
+
+	size_t index = 0;
+	Counters counters = { 0, 0, 0, false };
+
+#if COG_SIMD == 1
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; index + 4 <= count; index += 4) {
+
+		__m128 x		= _mm_loadu_ps(&boxes.x[index]);
+		__m128 y		= _mm_loadu_ps(&boxes.y[index]);
+		__m128 z		= _mm_loadu_ps(&boxes.z[index]);
+		__m128 halfX	= _mm_loadu_ps(&boxes.halfX[index]);
+		__m128 halfY	= _mm_loadu_ps(&boxes.halfY[index]);
+		__m128 halfZ	= _mm_loadu_ps(&boxes.halfZ[index]);
+
+		//--- First, test each box against its own cached side (each lane has a different side) - the sides come from
+		//--- the caller, so any that isn't a side is tested from the first side instead, as GetSide() does
+		unsigned int sides[4];
+		for (unsigned int lane = 0; lane < 4; lane++) { sides[lane] = GetSide(0, lastSides[index + lane]); }
+
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_setr_ps(m_planes[A][sides[0]], m_planes[A][sides[1]], m_planes[A][sides[2]], m_planes[A][sides[3]]), x),
+												_mm_mul_ps(_mm_setr_ps(m_planes[B][sides[0]], m_planes[B][sides[1]], m_planes[B][sides[2]], m_planes[B][sides[3]]), y)),
+									 _mm_add_ps(_mm_mul_ps(_mm_setr_ps(m_planes[C][sides[0]], m_planes[C][sides[1]], m_planes[C][sides[2]], m_planes[C][sides[3]]), z),
+												_mm_setr_ps(m_planes[D][sides[0]], m_planes[D][sides[1]], m_planes[D][sides[2]], m_planes[D][sides[3]])));
+
+		__m128 reach	= _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_setr_ps(m_absoluteNormals[A][sides[0]], m_absoluteNormals[A][sides[1]], m_absoluteNormals[A][sides[2]], m_absoluteNormals[A][sides[3]]), halfX),
+												_mm_mul_ps(_mm_setr_ps(m_absoluteNormals[B][sides[0]], m_absoluteNormals[B][sides[1]], m_absoluteNormals[B][sides[2]], m_absoluteNormals[B][sides[3]]), halfY)),
+									 _mm_mul_ps(_mm_setr_ps(m_absoluteNormals[C][sides[0]], m_absoluteNormals[C][sides[1]], m_absoluteNormals[C][sides[2]], m_absoluteNormals[C][sides[3]]), halfZ));
+
+		unsigned int rejected = (unsigned int)_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+
+		counters.objectTests	+= 4;
+		counters.planeTests		+= 4;
+		counters.cacheHits		+= (rejected & 1) + ((rejected >> 1) & 1) + ((rejected >> 2) & 1) + ((rejected >> 3) & 1);
+
+		//--- If the cached sides rejected all 4 boxes, we are done with this group
+		if (rejected == 0xF) { continue; }
+
+		//--- Otherwise run the full test, and remember the side that rejected any box the cache didn't catch
+		for (unsigned int side = 0; side < s_maxSides; side++) {
+
+			distance	= _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_planes[A][side]), x),
+												_mm_mul_ps(_mm_set1_ps(m_planes[B][side]), y)),
+									 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_planes[C][side]), z),
+												_mm_set1_ps(m_planes[D][side])));
+
+			reach		= _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_absoluteNormals[A][side]), halfX),
+												_mm_mul_ps(_mm_set1_ps(m_absoluteNormals[B][side]), halfY)),
+									 _mm_mul_ps(_mm_set1_ps(m_absoluteNormals[C][side]), halfZ));
+
+			unsigned int outside	= (unsigned int)_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+			unsigned int newlyOut	= outside & ~rejected;
+
+			for (unsigned int lane = 0; newlyOut; lane++, newlyOut >>= 1) {
+				if (newlyOut & 1) { lastSides[index + lane] = side; }
+			}
+
+			rejected |= outside;
+		}
+
+		counters.planeTests += 4 * s_maxSides;
+
+		unsigned int visible = ~rejected & 0xF;
+		visibility[index / s_bitsPerMask] |= visible << (index % s_bitsPerMask);
+	}
+#endif
+
+	//--- Whatever is left over (or everything, without SSE) is tested one box at a time
+	for (; index < count; index++) {
+		if (TestRectangle(glm::vec3(boxes.x[index], boxes.y[index], boxes.z[index]),
+						  glm::vec3(boxes.halfX[index], boxes.halfY[index], boxes.halfZ[index]), lastSides[index], counters) != OUTSIDE) {
+			visibility[index / s_bitsPerMask] |= 1u << (index % s_bitsPerMask);
+		}
+	}
+
+	AddCounters(counters);
+}
+
+
+/*******************************************************************************************************************
+	A function which adds the work done by one call to the frame's counters - once per call, as they are atomic
+*******************************************************************************************************************/
+void Frustum::AddCounters(const Counters& counters) const {
+
+	m_objectTests	+= counters.objectTests;
+	m_planeTests	+= counters.planeTests;
+	m_cacheHits		+= counters.cacheHits;
+}
+
+
+/*******************************************************************************************************************
+	[BoxList] Functions that add, change and clear the boxes within the list
+*******************************************************************************************************************/
+void Frustum::BoxList::Add(const glm::vec3& centerPosition, const glm::vec3& halfDimension)
+{
+	x.push_back(centerPosition.x);
+	y.push_back(centerPosition.y);
+	z.push_back(centerPosition.z);
+	halfX.push_back(halfDimension.x);
+	halfY.push_back(halfDimension.y);
+	halfZ.push_back(halfDimension.z);
+}
+
+void Frustum::BoxList::Set(size_t index, const glm::vec3& centerPosition, const glm::vec3& halfDimension)
+{
+	x[index]		= centerPosition.x;
+	y[index]		= centerPosition.y;
+	z[index]		= centerPosition.z;
+	halfX[index]	= halfDimension.x;
+	halfY[index]	= halfDimension.y;
+	halfZ[index]	= halfDimension.z;
+}
+
+void Frustum::BoxList::Clear()
+{
+	x.clear(); y.clear(); z.clear();
+	halfX.clear(); halfY.clear(); halfZ.clear();
+}
+
+size_t Frustum::BoxList::GetSize() const { return x.size(); }
+
+
+/*******************************************************************************************************************
+	[SphereList] Functions that add, change and clear the spheres within the list
+*******************************************************************************************************************/
+void Frustum::SphereList::Add(const glm::vec3& centerPosition, float radius)
+{
+	x.push_back(centerPosition.x);
+	y.push_back(centerPosition.y);
+	z.push_back(centerPosition.z);
+	this->radius.push_back(radius);
+}
+
+void Frustum::SphereList::Set(size_t index, const glm::vec3& centerPosition, float radius)
+{
+	x[index]			= centerPosition.x;
+	y[index]			= centerPosition.y;
+	z[index]			= centerPosition.z;
+	this->radius[index]	= radius;
+}
+
+void Frustum::SphereList::Clear()
+{
+	x.clear(); y.clear(); z.clear();
+	radius.clear();
+}
+
+size_t Frustum::SphereList::GetSize() const { return x.size(); }
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+Frustum::Counters Frustum::GetCounters() const		{ return { m_objectTests, m_planeTests, m_cacheHits, m_isReused }; }
+unsigned int Frustum::GetVersion() const				{ return m_version; }
+
+
+/*******************************************************************************************************************
+	Modifier methods
+*******************************************************************************************************************/
+void Frustum::SetMotionThreshold(float threshold)		{ m_motionThreshold = threshold; }
+
+
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
 const unsigned int Frustum::s_maxPlaneContents	= 4;
-const unsigned int Frustum::s_maxSides			= 6;
\ No newline at end of file
+const unsigned int Frustum::s_maxSides			= 6;
+const unsigned int Frustum::s_bitsPerMask		= 32;
+const float Frustum::s_defaultMotionThreshold	= 0.001f;
+
+unsigned int Frustum::GetSide(unsigned int index, unsigned int lastSide) {
+
+	//--- The last side lives with the caller's objects, so one that isn't a side can't be used to index the planes
+	if (lastSide >= s_maxSides) { lastSide = 0; }
+
+	//--- The last side goes first, followed by every other side in order (skipping over the last side)
+	if (index == 0) { return lastSide; }
+	return (index <= lastSide) ? index - 1 : index;
+}
+
+bool Frustum::IsVisible(const std::vector<unsigned int>& visibility, size_t index) {
+	return (visibility[index / s_bitsPerMask] >> (index % s_bitsPerMask)) & 1u;
+}
\ No newline at end of file
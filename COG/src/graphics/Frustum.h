@@ -3,18 +3,31 @@
 /*******************************************************************************************************************
 	Frustum.h, Frustum.cpp
 	Created by Kim Kane
-	Last updated: 19/05/2018
+	Last updated: 18/10/2026
 
 	Generates a culling frustum to cull objects not visible by the projection.
 
 	[Features]
 	Optimizes rendering of many objects.
 	Support for points, spheres, boxes and rectangles.
+	Planes stored as aligned structure-of-arrays (all A's together, all B's together, etc.).
+	Boxes are tested using only the corner nearest each plane (p-vertex) and furthest from it (n-vertex), not all 8 corners.
+	Batched culling of box and sphere lists, 4 objects at a time with SSE, writing a visibility bitmask.
+	Temporal coherence - each object can remember the side that rejected it last frame, which is tested first next frame.
+	Camera motion threshold - if the planes barely move, last frame's planes are kept so visibility results can be re-used.
+	Per-frame counters (objects tested, plane tests, cache hits) to measure how much culling work is being done.
+	Safe to cull from several threads at once - the tests only read the planes, and the counters are atomic.
 
 	[Upcoming]
 	Nothing at present.
 
 	[Side Notes]
+	For the batched functions, keep a BoxList/SphereList alive between frames and only update the entries that moved,
+	rather than re-building them. Bit i of the visibility mask is set if object i is visible, see IsVisible().
+	For temporal coherence, pass in a last side value (starting at 0) that lives with the object between frames.
+	A last side that isn't a side (6 or more) is treated as 0, so a stale or uninitialized value is only ever slower.
+	Check GetVersion() to see if the planes changed since you last culled - if not, your last results are still correct.
+
 	References and Credits:
 	Ben Humphrey (DigiBen)
 	Game Programmer
@@ -23,11 +36,46 @@
 	https://gist.github.com/jimmikaelkael/2e4ffa5712d61816c7ca
 
 *******************************************************************************************************************/
+#include <atomic>
 #include <pretty_glm/glm.hpp>
 #include <vector>
 
 class Frustum {
 
+public:
+	//--- Result of a box test - the n-vertex tells us if the box is fully inside, or crosses a side
+	enum Intersection { OUTSIDE, INTERSECTING, INSIDE };
+
+	//--- Structure-of-arrays box list, for culling many boxes at once (center position and half dimension)
+	struct BoxList {
+		std::vector<float> x, y, z;
+		std::vector<float> halfX, halfY, halfZ;
+
+		void Add(const glm::vec3& centerPosition, const glm::vec3& halfDimension);
+		void Set(size_t index, const glm::vec3& centerPosition, const glm::vec3& halfDimension);
+		void Clear();
+		size_t GetSize() const;
+	};
+
+	//--- Structure-of-arrays sphere list, for culling many spheres at once (center position and radius)
+	struct SphereList {
+		std::vector<float> x, y, z;
+		std::vector<float> radius;
+
+		void Add(const glm::vec3& centerPosition, float radius);
+		void Set(size_t index, const glm::vec3& centerPosition, float radius);
+		void Clear();
+		size_t GetSize() const;
+	};
+
+	//--- Culling work done since the last Update(), so we can see what the culling costs each frame (a copy, see GetCounters())
+	struct Counters {
+		unsigned int objectTests;
+		unsigned int planeTests;
+		unsigned int cacheHits;
+		bool		 isReused;
+	};
+
 private:
 	//--- Position of plane's normal, and the distance the plane is from the origin
 	enum PlaneType { A, B, C, D };
@@ -43,18 +91,54 @@ public:
 	void Update(const glm::mat4& projection, const glm::mat4& view);
 	
 public:
-	bool IsPointInside(const glm::vec3& position);
-	bool IsSphereInside(const glm::vec3& centerPosition, float radius);
-	bool IsCubeInside(const glm::vec3& centerPosition, float halfDepth);
-	bool IsRectangleInside(const glm::vec3& centerPosition, const glm::vec3& halfDimension);
+	bool IsPointInside(const glm::vec3& position) const;
+	bool IsSphereInside(const glm::vec3& centerPosition, float radius) const;
+	bool IsCubeInside(const glm::vec3& centerPosition, float halfDepth) const;
+	bool IsRectangleInside(const glm::vec3& centerPosition, const glm::vec3& halfDimension) const;
+	Intersection TestRectangle(const glm::vec3& centerPosition, const glm::vec3& halfDimension) const;
+
+public:
+	bool IsSphereInside(const glm::vec3& centerPosition, float radius, unsigned int& lastSide) const;
+	bool IsRectangleInside(const glm::vec3& centerPosition, const glm::vec3& halfDimension, unsigned int& lastSide) const;
+	Intersection TestRectangle(const glm::vec3& centerPosition, const glm::vec3& halfDimension, unsigned int& lastSide) const;
+
+public:
+	void CullBoxes(const BoxList& boxes, std::vector<unsigned int>& visibility) const;
+	void CullSpheres(const SphereList& spheres, std::vector<unsigned int>& visibility) const;
+	void CullBoxes(const BoxList& boxes, std::vector<unsigned int>& visibility, std::vector<unsigned int>& lastSides) const;
+
+public:
+	Counters		GetCounters() const;
+	unsigned int	GetVersion() const;
+	void			SetMotionThreshold(float threshold);
+
+public:
+	static bool IsVisible(const std::vector<unsigned int>& visibility, size_t index);
+
+private:
+	void SetPlane(SideType side, float a, float b, float c, float d);
+	bool IsSphereInside(const glm::vec3& centerPosition, float radius, unsigned int& lastSide, Counters& counters) const;
+	Intersection TestRectangle(const glm::vec3& centerPosition, const glm::vec3& halfDimension, unsigned int& lastSide, Counters& counters) const;
+	void AddCounters(const Counters& counters) const;
+	static unsigned int GetSide(unsigned int index, unsigned int lastSide);
 
 private:
-	void NormalizePlane(std::vector <std::vector<float>>& frustum, SideType side);
+	//--- Indexed [A, B, C or D][side]. The absolute normals are kept so the box tests don't need to work them out
+	alignas(16) float m_planes[D + 1][FRONT + 1];
+	alignas(16) float m_absoluteNormals[C + 1][FRONT + 1];
 
 private:
-	std::vector<std::vector<float>> m_frustum;
+	//--- Every test counts its work locally, then adds it in here once - atomic, as culling can run on several threads
+	mutable std::atomic<unsigned int>	m_objectTests;
+	mutable std::atomic<unsigned int>	m_planeTests;
+	mutable std::atomic<unsigned int>	m_cacheHits;
+	bool								m_isReused;
+	unsigned int						m_version;
+	float								m_motionThreshold;
 
 private:
 	static const unsigned int s_maxPlaneContents;
 	static const unsigned int s_maxSides;
+	static const unsigned int s_bitsPerMask;
+	static const float s_defaultMotionThreshold;
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "InstanceBatcher.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+InstanceBatcher::InstanceBatcher(unsigned int maxInstances)
+	:	m_meshes(nullptr),
+		m_shader(0),
+		m_maxInstances(maxInstances > 0 ? maxInstances : s_maxInstances),
+		m_isNewBatch(true)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+InstanceBatcher::~InstanceBatcher()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that builds this frame's batches and instances from a sorted render queue and the meshes it draws
+*******************************************************************************************************************/
+void InstanceBatcher::Build(const RenderQueue& queue, const std::vector<FramePacket::MeshDraw>& meshes)
+{
+	m_batches.clear();
+	m_instances.clear();
+	m_instances.reserve(queue.GetCount());
+
+	m_meshes		= &meshes;
+	m_isNewBatch	= true;
+
+	queue.Execute(*this);
+
+	m_meshes = nullptr;
+}
+
+
+/*******************************************************************************************************************
+	Functions that start a new batch whenever the shader, material or model changes
+*******************************************************************************************************************/
+void InstanceBatcher::BindShader(unsigned int shader)	{ m_shader = shader; m_isNewBatch = true; }
+void InstanceBatcher::BindMaterial(unsigned int draw)	{ m_isNewBatch = true; }
+void InstanceBatcher::BindMesh(unsigned int draw)		{ m_isNewBatch = true; }
+
+
+/*******************************************************************************************************************
+	Function that adds a mesh's instance data to the current batch (or a new one, if the current one is full)
+*******************************************************************************************************************/
+void InstanceBatcher::Draw(unsigned int draw)
+{
+	const FramePacket::MeshDraw& mesh = (*m_meshes)[draw];
+
+	if (!m_isNewBatch && m_batches.back().count >= m_maxInstances) { m_isNewBatch = true; }
+
+	if (m_isNewBatch) {
+		m_batches.push_back({ m_shader, draw, (unsigned int)m_instances.size(), 0 });
+		m_isNewBatch = false;
+	}
+
+	//--- Normals only need the rotation and scale, and the inverse transpose keeps them right under non-uniform scale
+	glm::mat3 normal = glm::transpose(glm::inverse(glm::mat3(mesh.world)));
+
+	m_instances.push_back({ mesh.world, normal, mesh.shininess });
+	m_batches.back().count++;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+const std::vector<InstanceBatcher::Batch>& InstanceBatcher::GetBatches() const	{ return m_batches; }
+const std::vector<PackedInstance>& InstanceBatcher::GetInstances() const		{ return m_instances; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+//--- Keeps each draw's slice of the instance buffer to ~100 KB, so one huge crowd doesn't become one huge draw
+const unsigned int InstanceBatcher::s_maxInstances = 1024;
\ No newline at end of file
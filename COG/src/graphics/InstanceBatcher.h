@@ -0,0 +1,79 @@
+#pragma once
+
+/*******************************************************************************************************************
+	InstanceBatcher.h, InstanceBatcher.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Turns a frame's sorted render queue into instanced batches - one batch for every run of meshes sharing the same
+	shader, material and model, with the per-instance data of the whole frame packed into one array.
+
+	[Features]
+	A RenderQueue backend that never touches OpenGL - the queue tells it when the shader, material or model changes
+	(which starts a new batch), and each draw appends a PackedInstance to the current batch.
+	Only ever groups on the queue's material and model IDs, and only reads the world matrix and shininess of each
+	mesh, so it never needs a material or model (and can be built and tested without OpenGL).
+	Batches are capped at a maximum number of instances (1024 by default), a longer run is split into more than
+	one batch.
+	The instances are laid out batch after batch, so the whole frame is uploaded to an InstanceBuffer in one go
+	and each batch draws its own slice of it.
+	Draw calls scale with the number of different meshes in view, rather than the number of objects.
+
+	[Upcoming]
+	Per-instance texture atlas offsets, if entities ever start animating their textures.
+
+	[Side Notes]
+	Materials are batched by ID (see Material::GetID()), so every instance in a batch binds the same textures. The
+	shininess is the only material value that can still differ between them, so it travels with each instance
+	(FramePacket::AddMesh() reads it from the material).
+	A batch remembers the first mesh it was made from (draw), to find the model and material to bind. Batches split
+	by the cap share their model and material with the one before them, so drawing them costs no extra binds.
+
+*******************************************************************************************************************/
+#include <vector>
+#include "graphics/FramePacket.h"
+#include "graphics/RenderQueue.h"
+#include "graphics/buffers/PackedInstance.h"
+
+class InstanceBatcher : public RenderQueue::Backend {
+
+public:
+	struct Batch {
+		unsigned int shader;
+		unsigned int draw;
+		unsigned int first;
+		unsigned int count;
+	};
+
+public:
+	InstanceBatcher(unsigned int maxInstances = s_maxInstances);
+	virtual ~InstanceBatcher();
+
+public:
+	void Build(const RenderQueue& queue, const std::vector<FramePacket::MeshDraw>& meshes);
+
+public:
+	virtual void BindShader(unsigned int shader)	override;
+	virtual void BindMaterial(unsigned int draw)	override;
+	virtual void BindMesh(unsigned int draw)		override;
+	virtual void Draw(unsigned int draw)			override;
+
+public:
+	const std::vector<Batch>&			GetBatches() const;
+	const std::vector<PackedInstance>&	GetInstances() const;
+
+private:
+	InstanceBatcher(const InstanceBatcher&)				= delete;
+	InstanceBatcher& operator=(const InstanceBatcher&)	= delete;
+
+private:
+	const std::vector<FramePacket::MeshDraw>*	m_meshes;
+	std::vector<Batch>							m_batches;
+	std::vector<PackedInstance>					m_instances;
+	unsigned int								m_shader;
+	unsigned int								m_maxInstances;
+	bool										m_isNewBatch;
+
+private:
+	static const unsigned int s_maxInstances;
+};
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cmath>
+#include "LightClusters.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+LightClusters::LightClusters(unsigned int tilesX, unsigned int tilesY, unsigned int slices)
+	:	m_tilesX(std::max(tilesX, 1u)),
+		m_tilesY(std::max(tilesY, 1u)),
+		m_slices(std::max(slices, 1u)),
+		m_tanHalfFieldOfViewX(0.0f),
+		m_tanHalfFieldOfViewY(0.0f),
+		m_nearPlane(0.0f),
+		m_farPlane(0.0f),
+		m_firstSliceDepth(0.0f),
+		m_sliceScale(0.0f),
+		m_maxLightsPerCluster(0)
+{
+	//--- Same as the default screen perspective, until SetProjection() is called with the real one
+	SetProjection(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+LightClusters::~LightClusters()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	A function that sets up the depth slices and the view space bounds of every cluster, for a perspective projection
+*******************************************************************************************************************/
+void LightClusters::SetProjection(float fieldOfView, float aspectRatio, float nearPlane, float farPlane)
+{
+	m_tanHalfFieldOfViewY	= std::tan(fieldOfView * 0.5f);
+	m_tanHalfFieldOfViewX	= m_tanHalfFieldOfViewY * aspectRatio;
+	m_nearPlane				= nearPlane;
+	m_farPlane				= farPlane;
+
+	//--- NOTE
+	// Depth slices get exponentially bigger the further away they are, so clusters stay roughly cube shaped.
+	// With a near plane of 0.1 that would waste a lot of slices on the first few units in front of the camera,
+	// where there's hardly anything to light - so the first slice always covers everything up to s_firstSliceDepth,
+	// and only the slices after it are exponential.
+	//---
+	m_firstSliceDepth	= (m_slices > 1) ? std::min(std::max(s_firstSliceDepth, nearPlane), farPlane) : farPlane;
+	m_sliceScale		= (m_slices > 1 && farPlane > m_firstSliceDepth) ? (m_slices - 1) / std::log(farPlane / m_firstSliceDepth) : 0.0f;
+
+	m_sliceDepths.resize(m_slices + 1);
+	m_sliceDepths[0] = nearPlane;
+
+	for (unsigned int slice = 1; slice <= m_slices; slice++) {
+		m_sliceDepths[slice] = m_firstSliceDepth * std::pow(farPlane / m_firstSliceDepth, (slice - 1) / (float)std::max(m_slices - 1, 1u));
+	}
+
+	//--- A column's x range (and a row's y range) grows with depth, so within a slice it's widest at the far end
+	m_columns.resize(m_slices * m_tilesX);
+	m_rows.resize(m_slices * m_tilesY);
+
+	for (unsigned int slice = 0; slice < m_slices; slice++) {
+
+		float nearDepth	= m_sliceDepths[slice];
+		float farDepth	= m_sliceDepths[slice + 1];
+
+		for (unsigned int x = 0; x < m_tilesX; x++) {
+
+			float left	= (-1.0f + 2.0f * x / m_tilesX) * m_tanHalfFieldOfViewX;
+			float right	= (-1.0f + 2.0f * (x + 1) / m_tilesX) * m_tanHalfFieldOfViewX;
+
+			m_columns[slice * m_tilesX + x] = { std::min(left * nearDepth, left * farDepth), std::max(right * nearDepth, right * farDepth) };
+		}
+
+		for (unsigned int y = 0; y < m_tilesY; y++) {
+
+			float bottom	= (-1.0f + 2.0f * y / m_tilesY) * m_tanHalfFieldOfViewY;
+			float top		= (-1.0f + 2.0f * (y + 1) / m_tilesY) * m_tanHalfFieldOfViewY;
+
+			m_rows[slice * m_tilesY + y] = { std::min(bottom * nearDepth, bottom * farDepth), std::max(top * nearDepth, top * farDepth) };
+		}
+	}
+
+	m_clusters.assign(m_tilesX * m_tilesY * m_slices, { 0, 0 });
+	m_lightIndices.clear();
+	m_maxLightsPerCluster = 0;
+}
+
+
+/*******************************************************************************************************************
+	A function that bins every enabled light into the clusters it reaches, and rebuilds the per-cluster lists
+*******************************************************************************************************************/
+void LightClusters::Update(const glm::mat4& view, const std::vector<Light*>& lights)
+{
+	m_entries.clear();
+	m_directionalLights.clear();
+	m_visibleLights.clear();
+
+	for (unsigned int i = 0; i < lights.size(); i++) {
+
+		if (!lights[i] || !lights[i]->IsEnabled()) { continue; }
+
+		if (lights[i]->IsOfType(Light::LIGHT_DIRECTION))	{ m_directionalLights.push_back(i); }
+		else if (AddLight(i, *lights[i], view))				{ m_visibleLights.push_back(i); }
+	}
+
+	BuildLists();
+}
+
+
+/*******************************************************************************************************************
+	A function that finds every cluster a point or spot light reaches, returns false if it doesn't reach any of them
+*******************************************************************************************************************/
+bool LightClusters::AddLight(unsigned int index, const Light& light, const glm::mat4& view)
+{
+	glm::vec3 center	= glm::vec3(view * glm::vec4(glm::vec3(light.GetPosition()), 1.0f));
+	float radius		= light.GetMargin();
+	float depth			= -center.z;
+
+	//--- Skip lights with no range, or that are completely in front of the near plane or behind the far plane
+	if (radius <= 0.0f || depth + radius < m_nearPlane || depth - radius > m_farPlane) { return false; }
+
+	bool isSpot			= light.IsOfType(Light::LIGHT_SPOT);
+	glm::vec3 direction	= glm::vec3(view * glm::vec4(glm::vec3(light.GetDirection()), 0.0f));
+
+	if (isSpot && glm::dot(direction, direction) > 0.0f) { direction = glm::normalize(direction); }
+	else												 { isSpot = false; }
+
+	size_t firstEntry		= m_entries.size();
+	unsigned int firstSlice	= GetSlice(std::max(depth - radius, m_nearPlane));
+	unsigned int lastSlice	= GetSlice(std::min(depth + radius, m_farPlane));
+
+	for (unsigned int slice = firstSlice; slice <= lastSlice; slice++) {
+
+		const Extent* columns	= &m_columns[slice * m_tilesX];
+		const Extent* rows		= &m_rows[slice * m_tilesY];
+
+		//--- Columns and rows are in order, so we can stop as soon as we are past the light
+		for (unsigned int x = 0; x < m_tilesX; x++) {
+
+			if (columns[x].maximum < center.x - radius) { continue; }
+			if (columns[x].minimum > center.x + radius) { break; }
+
+			for (unsigned int y = 0; y < m_tilesY; y++) {
+
+				if (rows[y].maximum < center.y - radius) { continue; }
+				if (rows[y].minimum > center.y + radius) { break; }
+
+				//--- View space looks down -Z, so the far end of the slice is the minimum
+				glm::vec3 minimum = glm::vec3(columns[x].minimum, rows[y].minimum, -m_sliceDepths[slice + 1]);
+				glm::vec3 maximum = glm::vec3(columns[x].maximum, rows[y].maximum, -m_sliceDepths[slice]);
+
+				if (!IsSphereInside(center, radius, minimum, maximum)) { continue; }
+				if (isSpot && !IsConeInside(center, direction, radius, light.GetOuterCutOff(), minimum, maximum)) { continue; }
+
+				m_entries.push_back({ GetClusterIndex(x, y, slice), index });
+			}
+		}
+	}
+
+	return m_entries.size() > firstEntry;
+}
+
+
+/*******************************************************************************************************************
+	A function that turns the cluster/light entries into compact per-cluster lists (a counting sort)
+*******************************************************************************************************************/
+void LightClusters::BuildLists()
+{
+	for (auto& cluster : m_clusters) { cluster = { 0, 0 }; }
+	for (const auto& entry : m_entries) { m_clusters[entry.cluster].count++; }
+
+	unsigned int offset		= 0;
+	m_maxLightsPerCluster	= 0;
+
+	for (auto& cluster : m_clusters) {
+		m_maxLightsPerCluster	= std::max(m_maxLightsPerCluster, cluster.count);
+		cluster.offset			= offset;
+		offset					+= cluster.count;
+		cluster.count			= 0;
+	}
+
+	//--- Entries were added one light at a time, so each cluster's list ends up sorted by light index
+	m_lightIndices.resize(m_entries.size());
+
+	for (const auto& entry : m_entries) {
+		Cluster& cluster = m_clusters[entry.cluster];
+		m_lightIndices[cluster.offset + cluster.count++] = entry.light;
+	}
+}
+
+
+/*******************************************************************************************************************
+	A function that returns the depth slice a view space depth (distance in front of the camera) falls into
+*******************************************************************************************************************/
+unsigned int LightClusters::GetSlice(float depth) const
+{
+	if (depth < m_firstSliceDepth) { return 0; }
+
+	int slice = 1 + (int)(std::log(depth / m_firstSliceDepth) * m_sliceScale);
+
+	return (unsigned int)std::min(std::max(slice, 0), (int)m_slices - 1);
+}
+
+
+/*******************************************************************************************************************
+	A function that returns the index of the cluster at a tile and depth slice
+*******************************************************************************************************************/
+unsigned int LightClusters::GetClusterIndex(unsigned int x, unsigned int y, unsigned int slice) const
+{
+	return (slice * m_tilesY + y) * m_tilesX + x;
+}
+
+
+/*******************************************************************************************************************
+	A function that returns the index of the cluster holding a view space position (clamped to the grid)
+*******************************************************************************************************************/
+unsigned int LightClusters::GetClusterIndex(const glm::vec3& viewPosition) const
+{
+	float depth = std::max(-viewPosition.z, m_nearPlane);
+
+	//--- Project into normalized device coordinates (-1, 1), then into tiles
+	float x = (viewPosition.x / (depth * m_tanHalfFieldOfViewX) * 0.5f + 0.5f) * m_tilesX;
+	float y = (viewPosition.y / (depth * m_tanHalfFieldOfViewY) * 0.5f + 0.5f) * m_tilesY;
+
+	unsigned int tileX = (unsigned int)std::min(std::max(x, 0.0f), (float)(m_tilesX - 1));
+	unsigned int tileY = (unsigned int)std::min(std::max(y, 0.0f), (float)(m_tilesY - 1));
+
+	return GetClusterIndex(tileX, tileY, GetSlice(depth));
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+const std::vector<LightClusters::Cluster>& LightClusters::GetClusters() const	{ return m_clusters; }
+const std::vector<unsigned int>& LightClusters::GetLightIndices() const			{ return m_lightIndices; }
+const std::vector<unsigned int>& LightClusters::GetDirectionalLights() const	{ return m_directionalLights; }
+const std::vector<unsigned int>& LightClusters::GetVisibleLights() const		{ return m_visibleLights; }
+unsigned int LightClusters::GetMaxLightsPerCluster() const						{ return m_maxLightsPerCluster; }
+unsigned int LightClusters::GetTilesX() const									{ return m_tilesX; }
+unsigned int LightClusters::GetTilesY() const									{ return m_tilesY; }
+unsigned int LightClusters::GetSlices() const									{ return m_slices; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const float LightClusters::s_firstSliceDepth = 5.0f;
+
+bool LightClusters::IsSphereInside(const glm::vec3& center, float radius, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	//--- Distance from the sphere to the closest point of the box
+	glm::vec3 offset = glm::clamp(center, minimum, maximum) - center;
+	return glm::dot(offset, offset) <= radius * radius;
+}
+
+bool LightClusters::IsConeInside(const glm::vec3& position, const glm::vec3& direction, float range, float cosine,
+								 const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	//--- NOTE
+	// Tests the cone against a sphere around the cluster, rather than the box itself (cheap, and never misses).
+	// Reference: https://bartwronski.com/2017/04/13/cull-that-cone/
+	//---
+	glm::vec3 center	= (minimum + maximum) * 0.5f;
+	glm::vec3 offset	= center - position;
+	float radius		= glm::length(maximum - minimum) * 0.5f;
+	float along			= glm::dot(offset, direction);
+	float sine			= std::sqrt(std::max(1.0f - cosine * cosine, 0.0f));
+	float closest		= cosine * std::sqrt(std::max(glm::dot(offset, offset) - along * along, 0.0f)) - along * sine;
+
+	return !(closest > radius || along > radius + range || along < -radius);
+}
\ No newline at end of file
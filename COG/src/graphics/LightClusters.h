@@ -0,0 +1,124 @@
+#pragma once
+
+/*******************************************************************************************************************
+	LightClusters.h, LightClusters.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Splits the camera's view frustum into a 3D grid of clusters (screen tiles x depth slices) and works out which
+	point and spot lights reach each cluster, so a fragment only has to loop through the lights near it, rather than
+	every light in the scene. This is what lets us go past Shader::MAX_LIGHTS for the night levels.
+
+	[Features]
+	Tiles split the screen evenly, depth slices are exponential (small near the camera, big far away).
+	Point lights are tested as spheres against each cluster's bounds, spot lights also get a cone test.
+	Lights are only tested against the clusters inside their screen/depth range, not the whole grid.
+	Compact per-cluster lists - each cluster is an offset/count into one shared array of light indices,
+	so both arrays can be uploaded to the GPU as buffers as they are.
+	Keeps a list of the point and spot lights that reach at least one cluster (GetVisibleLights()), so lights that
+	can't light anything in view can be switched off - the play state does this every frame.
+	Pure CPU and glm, nothing here touches OpenGL - so it can be tested without a GPU.
+
+	[Upcoming]
+	Uploading the grid to a texture buffer, and the fragment shader side of the lookup.
+	Only updating the clusters when the camera or lights have changed.
+
+	[Side Notes]
+	Directional lights light everything, so they aren't put in clusters - they are kept in their own list.
+	A light's margin is used as its range (as with the shaders), and disabled lights are skipped - so to find out
+	which of a set of lights are in view, enable them all before Update().
+	Light indices are indices into the vector of lights passed in to Update().
+	To find the cluster for a fragment, use the same maths as GetClusterIndex(): the tile comes from its screen
+	position and the slice from its view space depth.
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <vector>
+#include "graphics/Light.h"
+
+class LightClusters {
+
+public:
+	struct Cluster {
+		unsigned int offset;
+		unsigned int count;
+	};
+
+private:
+	//--- The view space range of a column (x) or row (y) of clusters within one depth slice
+	struct Extent {
+		float minimum, maximum;
+	};
+
+	struct Entry {
+		unsigned int cluster;
+		unsigned int light;
+	};
+
+public:
+	LightClusters(unsigned int tilesX = 16, unsigned int tilesY = 9, unsigned int slices = 24);
+	~LightClusters();
+
+public:
+	void SetProjection(float fieldOfView, float aspectRatio, float nearPlane, float farPlane);
+	void Update(const glm::mat4& view, const std::vector<Light*>& lights);
+
+public:
+	unsigned int GetClusterIndex(unsigned int x, unsigned int y, unsigned int slice) const;
+	unsigned int GetClusterIndex(const glm::vec3& viewPosition) const;
+	unsigned int GetSlice(float depth) const;
+
+public:
+	const std::vector<Cluster>&			GetClusters() const;
+	const std::vector<unsigned int>&	GetLightIndices() const;
+	const std::vector<unsigned int>&	GetDirectionalLights() const;
+	const std::vector<unsigned int>&	GetVisibleLights() const;
+	unsigned int						GetMaxLightsPerCluster() const;
+
+public:
+	unsigned int GetTilesX() const;
+	unsigned int GetTilesY() const;
+	unsigned int GetSlices() const;
+
+private:
+	LightClusters(const LightClusters&)				= delete;
+	LightClusters& operator=(const LightClusters&)	= delete;
+
+private:
+	bool AddLight(unsigned int index, const Light& light, const glm::mat4& view);
+	void BuildLists();
+
+private:
+	static bool IsSphereInside(const glm::vec3& center, float radius, const glm::vec3& minimum, const glm::vec3& maximum);
+	static bool IsConeInside(const glm::vec3& position, const glm::vec3& direction, float range, float cosine,
+							 const glm::vec3& minimum, const glm::vec3& maximum);
+
+private:
+	unsigned int m_tilesX;
+	unsigned int m_tilesY;
+	unsigned int m_slices;
+
+private:
+	float m_tanHalfFieldOfViewX;
+	float m_tanHalfFieldOfViewY;
+	float m_nearPlane;
+	float m_farPlane;
+	float m_firstSliceDepth;
+	float m_sliceScale;
+
+private:
+	std::vector<float>	m_sliceDepths;
+	std::vector<Extent>	m_columns;
+	std::vector<Extent>	m_rows;
+
+private:
+	std::vector<Entry>			m_entries;
+	std::vector<Cluster>		m_clusters;
+	std::vector<unsigned int>	m_lightIndices;
+	std::vector<unsigned int>	m_directionalLights;
+	std::vector<unsigned int>	m_visibleLights;
+	unsigned int				m_maxLightsPerCluster;
+
+private:
+	static const float s_firstSliceDepth;
+};
\ No newline at end of file
@@ -33,6 +33,11 @@ void Material::Load(const std::string& diffuse, const std::string& normal, const
 	if (AddTexture(Shader::TEXTURE_NORMAL, normal))		{ m_isNormalMapped	= true; }
 	if (AddTexture(Shader::TEXTURE_SPECULAR, specular))	{ m_isReflective	= true; }
 	if (AddTexture(Shader::TEXTURE_EMISSIVE, emissive)) { m_isGlowing		= true; }
+
+	//--- Textures are only loaded once per file, so materials made from the same files bind exactly the same textures
+	std::string textures = diffuse + "|" + normal + "|" + specular + "|" + emissive;
+
+	m_ID = s_IDs.try_emplace(textures, (unsigned int)s_IDs.size()).first->second;
 }
 
 
@@ -70,6 +75,7 @@ void Material::Unbind()
 	Accessor methods
 *******************************************************************************************************************/
 float Material::GetShininess() const	{ return m_shininess; }
+unsigned int Material::GetID() const	{ return m_ID; }
 
 Texture* Material::GetDiffuse()		{ return &m_textures[Shader::TEXTURE_DIFFUSE]; }
 Texture* Material::GetEmissive()	{ return &m_textures[Shader::TEXTURE_EMISSIVE]; }
@@ -90,4 +96,5 @@ void Material::SetShininess(float shininess) { m_shininess = shininess; }
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
-float Material::s_defaultShininess = 64.0f;
\ No newline at end of file
+float								Material::s_defaultShininess = 64.0f;
+std::map<std::string, unsigned int>	Material::s_IDs;
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 	[Features]
 	Supports diffuse, specular, emissive and normal map textures.
+	Every material made from the same textures shares an ID (GetID()), which is what the render queue sorts
+	meshes by - each entity has its own copy of its material, but copies with the same ID bind the same textures.
 
 	[Upcoming]
 	Tint color to alter the final texture color.
@@ -34,7 +36,8 @@ public:
 	void Unbind();
 
 public:
-	float GetShininess() const;
+	float			GetShininess() const;
+	unsigned int	GetID() const;
 
 public:
 	Texture* GetDiffuse();
@@ -55,7 +58,8 @@ private:
 	bool AddTexture(Shader::TextureUnit unit, const std::string& texture);
 
 private:
-	float m_shininess;
+	float			m_shininess;
+	unsigned int	m_ID;
 	
 private:
 	bool m_isReflective;
@@ -66,5 +70,6 @@ private:
 	std::map<Shader::TextureUnit, Texture> m_textures;
 
 private:
-	static float s_defaultShininess;
+	static float								s_defaultShininess;
+	static std::map<std::string, unsigned int>	s_IDs;
 };
\ No newline at end of file
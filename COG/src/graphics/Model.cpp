@@ -13,6 +13,9 @@
 Model::Model(const std::string& obj)
 	:	m_tag(obj)
 {
+	//--- Models are only loaded once per file, so the file name is enough to tell which buffers a model uses
+	m_ID = s_IDs.try_emplace(m_tag, (unsigned int)s_IDs.size()).first->second;
+
 	Load();
 }
 
@@ -31,14 +34,39 @@ Model::~Model()
 *******************************************************************************************************************/
 void Model::Render()
 {
-	//--- Bind the VAO related to this model
+	Bind();
+	Draw();
+}
+
+
+/*******************************************************************************************************************
+	Function that binds the VAO related to this model
+*******************************************************************************************************************/
+void Model::Bind()
+{
 	Resource::Instance()->GetVAO(m_tag)->Bind();
+}
+
 
-	//--- Render the EBO related to this model
+/*******************************************************************************************************************
+	Function that renders the EBO related to this model (the model's VAO must already be bound)
+*******************************************************************************************************************/
+void Model::Draw()
+{
 	Resource::Instance()->GetEBO(m_tag)->Render();
 }
 
 
+/*******************************************************************************************************************
+	Function that renders the EBO related to this model once for each instance (the model's VAO must already be bound,
+	with its instance attributes attached)
+*******************************************************************************************************************/
+void Model::DrawInstanced(unsigned int instances)
+{
+	Resource::Instance()->GetEBO(m_tag)->RenderInstanced(instances);
+}
+
+
 /*******************************************************************************************************************
 	Function that loads the object data from an OBJ file using Assimp and stores the data into the relevant vectors
 *******************************************************************************************************************/
@@ -183,10 +211,12 @@ void Model::CalculateDimension(std::vector<VertexBuffer::PackedVertex>& containe
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
-const glm::vec3& Model::GetDimension() const { return m_dimensions[m_tag]; }
+const glm::vec3& Model::GetDimension() const	{ return m_dimensions[m_tag]; }
+unsigned int Model::GetID() const				{ return m_ID; }
 
 
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
-std::map<std::string, glm::vec3> Model::m_dimensions;
\ No newline at end of file
+std::map<std::string, glm::vec3>	Model::m_dimensions;
+std::map<std::string, unsigned int>	Model::s_IDs;
\ No newline at end of file
@@ -14,6 +14,9 @@
 	(See ResourceManager to see how this works)
 	Supports obtaining the min/max extents of a model; able to retrieve width, height and depth
 	of model by calling the GetDimension function.
+	Every model loaded from the same file shares an ID (GetID()), which is what the render queue sorts meshes by.
+	Bind() and Draw() split Render() in two, so models sharing a mesh only have to bind it once.
+	DrawInstanced() draws the model once for each instance in the bound instance buffer (see InstanceBuffer).
 
 	[Upcoming]
 	Nothing at present.
@@ -34,17 +37,23 @@ public:
 
 public:
 	void Render();
+	void Bind();
+	void Draw();
+	void DrawInstanced(unsigned int instances);
 
 public:
-	const glm::vec3& GetDimension() const;
+	const glm::vec3&	GetDimension() const;
+	unsigned int		GetID() const;
 
 private:
 	bool Load();
 	void CalculateDimension(std::vector<VertexBuffer::PackedVertex>& container);
 
 private:
-	std::string	m_tag;
+	std::string		m_tag;
+	unsigned int	m_ID;
 
 private:
-	static std::map<std::string, glm::vec3> m_dimensions;
+	static std::map<std::string, glm::vec3>		m_dimensions;
+	static std::map<std::string, unsigned int>	s_IDs;
 };
\ No newline at end of file
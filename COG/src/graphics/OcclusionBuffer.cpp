@@ -0,0 +1,503 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include "OcclusionBuffer.h"
+#include "utilities/Simd.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+OcclusionBuffer::OcclusionBuffer(unsigned int width, unsigned int height, JobSystem* jobSystem)
+	:	m_viewProjection(1.0f),
+		m_width((std::max(width, 4u) + 3) & ~3u),
+		m_height(std::max(height, 1u)),
+		m_jobSystem(jobSystem)
+{
+	m_layer.resize(m_width * m_height, s_emptyDepth);
+	m_silhouette.resize(m_width * m_height, 0);
+
+	//--- Each level is half the size of the one before, for as long as the size divides evenly
+	unsigned int levelWidth		= m_width;
+	unsigned int levelHeight	= m_height;
+
+	m_levels.push_back({ levelWidth, levelHeight, std::vector<float>(levelWidth * levelHeight, s_clearDepth) });
+
+	while (levelWidth % 2 == 0 && levelHeight % 2 == 0 && levelWidth > 2 && levelHeight > 2) {
+		levelWidth	/= 2;
+		levelHeight	/= 2;
+		m_levels.push_back({ levelWidth, levelHeight, std::vector<float>(levelWidth * levelHeight, s_clearDepth) });
+	}
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+OcclusionBuffer::~OcclusionBuffer()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	A function that starts a new frame - removing last frame's occluders and setting the camera to draw them from
+*******************************************************************************************************************/
+void OcclusionBuffer::Begin(const glm::mat4& viewProjection)
+{
+	m_viewProjection = viewProjection;
+	m_triangles.clear();
+	m_edges.clear();
+	m_occluders.clear();
+}
+
+
+/*******************************************************************************************************************
+	A function that adds an indexed triangle mesh (in world space) as an occluder
+*******************************************************************************************************************/
+void OcclusionBuffer::AddOccluder(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices)
+{
+	//--- Project every vertex once, rather than once for each triangle that uses it
+	std::vector<glm::vec3> screenPositions(vertices.size());
+	std::vector<bool> isInFront(vertices.size());
+
+	for (size_t i = 0; i < vertices.size(); i++) { isInFront[i] = Project(vertices[i], screenPositions[i]); }
+
+	//--- NOTE
+	// Each edge (keyed by its two vertex indices, lowest first) counts the triangles drawn with it, and which side
+	// of it they lie on screen. An edge with exactly 2 triangles, one either side, is inside the occluder - any
+	// other edge is on its silhouette (including the edges of triangles we skipped, as nothing is drawn there).
+	//---
+	struct EdgeUse {
+		unsigned int	count;
+		float			side;
+		bool			isInside;
+	};
+
+	std::unordered_map<uint64_t, EdgeUse> edgeUses;
+
+	Occluder occluder = { (unsigned int)m_triangles.size(), 0, (unsigned int)m_edges.size(), 0, 0, 0, 0, 0 };
+	glm::vec2 minimum = glm::vec2(FLT_MAX);
+	glm::vec2 maximum = glm::vec2(-FLT_MAX);
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+
+		const unsigned int triangle[3] = { indices[i], indices[i + 1], indices[i + 2] };
+
+		if (triangle[0] >= vertices.size() || triangle[1] >= vertices.size() || triangle[2] >= vertices.size()) { continue; }
+		if (!isInFront[triangle[0]] || !isInFront[triangle[1]] || !isInFront[triangle[2]]) { continue; }
+
+		const glm::vec3& a = screenPositions[triangle[0]];
+		const glm::vec3& b = screenPositions[triangle[1]];
+		const glm::vec3& c = screenPositions[triangle[2]];
+
+		if (!AddTriangle(a, b, c)) { continue; }
+
+		minimum = glm::min(minimum, glm::vec2(std::min(std::min(a.x, b.x), c.x), std::min(std::min(a.y, b.y), c.y)));
+		maximum = glm::max(maximum, glm::vec2(std::max(std::max(a.x, b.x), c.x), std::max(std::max(a.y, b.y), c.y)));
+
+		for (unsigned int edge = 0; edge < 3; edge++) {
+
+			unsigned int first	= std::min(triangle[edge], triangle[(edge + 1) % 3]);
+			unsigned int second	= std::max(triangle[edge], triangle[(edge + 1) % 3]);
+
+			const glm::vec3& start	= screenPositions[first];
+			const glm::vec3& end	= screenPositions[second];
+			const glm::vec3& other	= screenPositions[triangle[(edge + 2) % 3]];
+
+			float side = (end.x - start.x) * (other.y - start.y) - (end.y - start.y) * (other.x - start.x);
+
+			EdgeUse& use = edgeUses[((uint64_t)first << 32) | second];
+
+			use.isInside	= (use.count == 1) && ((use.side > 0.0f && side < 0.0f) || (use.side < 0.0f && side > 0.0f));
+			use.side		= side;
+			use.count++;
+		}
+	}
+
+	occluder.lastTriangle = (unsigned int)m_triangles.size();
+
+	if (occluder.firstTriangle == occluder.lastTriangle) { return; }
+
+	for (const auto& use : edgeUses) {
+
+		if (use.second.count == 2 && use.second.isInside) { continue; }
+
+		const glm::vec3& start	= screenPositions[(unsigned int)(use.first >> 32)];
+		const glm::vec3& end	= screenPositions[(unsigned int)(use.first & 0xffffffffu)];
+
+		m_edges.push_back({ glm::vec2(start.x, start.y), glm::vec2(end.x, end.y) });
+	}
+
+	occluder.lastEdge = (unsigned int)m_edges.size();
+
+	//--- A pixel touches whatever is on its borders too, so a position on a pixel's left edge touches the pixel before
+	occluder.left	= std::max((int)std::ceil(minimum.x) - 1, 0);
+	occluder.bottom	= std::max((int)std::ceil(minimum.y) - 1, 0);
+	occluder.right	= std::min((int)std::floor(maximum.x), (int)m_width - 1);
+	occluder.top	= std::min((int)std::floor(maximum.y), (int)m_height - 1);
+
+	m_occluders.push_back(occluder);
+}
+
+
+/*******************************************************************************************************************
+	A function that adds a solid box (in world space) as an occluder - it must fit inside the object it stands for
+*******************************************************************************************************************/
+void OcclusionBuffer::AddOccluder(const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	//--- Corner i takes the maximum on the x axis if bit 0 is set, the y axis if bit 1 is set and the z axis if bit 2 is set
+	std::vector<glm::vec3> corners(8);
+
+	for (unsigned int i = 0; i < 8; i++) {
+		corners[i] = glm::vec3((i & 1) ? maximum.x : minimum.x, (i & 2) ? maximum.y : minimum.y, (i & 4) ? maximum.z : minimum.z);
+	}
+
+	//--- Two triangles for each face, sharing the corners so the edges between faces aren't taken for silhouettes
+	static const std::vector<unsigned int> indices = {
+		0, 2, 6, 0, 6, 4,	1, 5, 7, 1, 7, 3,	0, 4, 5, 0, 5, 1,
+		2, 3, 7, 2, 7, 6,	0, 1, 3, 0, 3, 2,	4, 6, 7, 4, 7, 5
+	};
+
+	AddOccluder(corners, indices);
+}
+
+
+/*******************************************************************************************************************
+	A function that clears the depth buffer and draws every occluder added this frame, then builds the hierarchy
+*******************************************************************************************************************/
+void OcclusionBuffer::Render()
+{
+	//--- Bands are never smaller than s_minRowsPerThread rows - any smaller and the jobs would cost more than the work
+	if (m_jobSystem)	{ m_jobSystem->ParallelFor(m_height, s_minRowsPerThread, [this](unsigned int first, unsigned int last) { RasterizeRows(first, last); }); }
+	else				{ RasterizeRows(0, m_height); }
+
+	BuildHierarchy();
+}
+
+
+/*******************************************************************************************************************
+	A function that checks if any part of a box (in world space) could be in front of the occluders
+*******************************************************************************************************************/
+bool OcclusionBuffer::IsVisible(const glm::vec3& minimum, const glm::vec3& maximum) const
+{
+	glm::vec3 screenMinimum = glm::vec3(FLT_MAX);
+	glm::vec3 screenMaximum = glm::vec3(-FLT_MAX);
+
+	for (unsigned int i = 0; i < 8; i++) {
+
+		glm::vec3 corner = glm::vec3((i & 1) ? maximum.x : minimum.x, (i & 2) ? maximum.y : minimum.y, (i & 4) ? maximum.z : minimum.z);
+		glm::vec3 screenPosition;
+
+		if (!Project(corner, screenPosition)) { return true; }
+
+		screenMinimum = glm::min(screenMinimum, screenPosition);
+		screenMaximum = glm::max(screenMaximum, screenPosition);
+	}
+
+	if (screenMaximum.x <= 0.0f || screenMaximum.y <= 0.0f || screenMinimum.x >= m_width || screenMinimum.y >= m_height) { return true; }
+
+	//--- The pixels the box's screen rectangle touches (inclusive), and the nearest depth of the box
+	int left	= std::max((int)std::floor(screenMinimum.x), 0);
+	int bottom	= std::max((int)std::floor(screenMinimum.y), 0);
+	int right	= std::max(std::min((int)std::ceil(screenMaximum.x), (int)m_width) - 1, left);
+	int top		= std::max(std::min((int)std::ceil(screenMaximum.y), (int)m_height) - 1, bottom);
+
+	//--- Go up the hierarchy until the rectangle only covers a few texels
+	unsigned int level = 0;
+
+	while (level + 1 < m_levels.size() &&
+		   (unsigned int)(((right >> level) - (left >> level) + 1) * ((top >> level) - (bottom >> level) + 1)) > s_maxTexelsPerTest) {
+		level++;
+	}
+
+	const Level& current = m_levels[level];
+
+	//--- If the box is nearer than the furthest occluder depth in any texel, some of it might be showing
+	for (int y = bottom >> level; y <= (top >> level); y++) {
+		for (int x = left >> level; x <= (right >> level); x++) {
+			if (current.depths[y * current.width + x] >= screenMinimum.z) { return true; }
+		}
+	}
+
+	return false;
+}
+
+
+/*******************************************************************************************************************
+	A function that projects a world position into the buffer - returns false if it is behind the near plane
+*******************************************************************************************************************/
+bool OcclusionBuffer::Project(const glm::vec3& position, glm::vec3& screenPosition) const
+{
+	glm::vec4 clip = m_viewProjection * glm::vec4(position, 1.0f);
+
+	if (clip.w <= 0.0f || clip.z < -clip.w) { return false; }
+
+	screenPosition.x = (clip.x / clip.w * 0.5f + 0.5f) * m_width;
+	screenPosition.y = (clip.y / clip.w * 0.5f + 0.5f) * m_height;
+	screenPosition.z = clip.z / clip.w;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that stores a screen space triangle, wound anti-clockwise, if it covers any of the buffer. Returns
+	false if it was skipped
+*******************************************************************************************************************/
+bool OcclusionBuffer::AddTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+	if (area == 0.0f) { return false; }
+
+	glm::vec3 minimum = glm::min(glm::min(a, b), c);
+	glm::vec3 maximum = glm::max(glm::max(a, b), c);
+
+	if (maximum.x < 0.0f || maximum.y < 0.0f || minimum.x > m_width || minimum.y > m_height) { return false; }
+
+	//--- Both sides of an occluder hide what's behind them, so clockwise triangles are flipped rather than culled
+	if (area > 0.0f)	{ m_triangles.push_back({ a, b, c }); }
+	else				{ m_triangles.push_back({ a, c, b }); }
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that clears and draws one band of rows [first, last) - each band only ever writes to its own rows
+	(of the depths, the layer and the silhouette), so the bands can be drawn at the same time
+*******************************************************************************************************************/
+void OcclusionBuffer::RasterizeRows(unsigned int first, unsigned int last)
+{
+	std::vector<float>& depths = m_levels[0].depths;
+
+	std::fill(depths.begin() + first * m_width, depths.begin() + last * m_width, s_clearDepth);
+
+	for (const auto& occluder : m_occluders) {
+
+		int bottom	= std::max(occluder.bottom, (int)first);
+		int top		= std::min(occluder.top, (int)last - 1);
+
+		if (bottom > top) { continue; }
+
+		for (int y = bottom; y <= top; y++) {
+			std::fill(m_layer.begin() + y * m_width + occluder.left, m_layer.begin() + y * m_width + occluder.right + 1, s_emptyDepth);
+			std::fill(m_silhouette.begin() + y * m_width + occluder.left, m_silhouette.begin() + y * m_width + occluder.right + 1, 0);
+		}
+
+		for (unsigned int i = occluder.firstTriangle; i < occluder.lastTriangle; i++) { RasterizeTriangle(m_triangles[i], bottom, top + 1); }
+		for (unsigned int i = occluder.firstEdge; i < occluder.lastEdge; i++) { RasterizeEdge(m_edges[i], bottom, top + 1); }
+
+		//--- Every pixel the occluder touches, but not its silhouette, is covered by it
+		for (int y = bottom; y <= top; y++) {
+			for (int x = occluder.left; x <= occluder.right; x++) {
+
+				size_t pixel = (size_t)y * m_width + x;
+
+				if (m_layer[pixel] != s_emptyDepth && !m_silhouette[pixel]) { depths[pixel] = std::min(depths[pixel], m_layer[pixel]); }
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	A function that draws the part of a triangle within rows [first, last) into the layer, keeping the furthest depth
+	in each pixel the triangle touches
+	References:
+	https://fgiesen.wordpress.com/2013/02/08/triangle-rasterization-in-practice/
+	https://software.intel.com/en-us/articles/masked-software-occlusion-culling
+*******************************************************************************************************************/
+void OcclusionBuffer::RasterizeTriangle(const Triangle& triangle, int first, int last)
+{
+	const glm::vec3& a = triangle.a;
+	const glm::vec3& b = triangle.b;
+	const glm::vec3& c = triangle.c;
+
+	//--- The pixels the triangle touches (inclusive) - as with the occluder, a pixel touches its borders
+	int minimumX = std::max((int)std::ceil(std::min(std::min(a.x, b.x), c.x)) - 1, 0);
+	int maximumX = std::min((int)std::floor(std::max(std::max(a.x, b.x), c.x)), (int)m_width - 1);
+	int minimumY = std::max((int)std::ceil(std::min(std::min(a.y, b.y), c.y)) - 1, first);
+	int maximumY = std::min((int)std::floor(std::max(std::max(a.y, b.y), c.y)), last - 1);
+
+	if (minimumX > maximumX || minimumY > maximumY) { return; }
+
+	//--- NOTE
+	// Each edge has a function E(x, y) = A * x + B * y + C, which is positive on the inside of the edge. A pixel
+	// touches the triangle if it is inside its bounds, and some corner of it is on the inside of all 3 edges - the
+	// corner furthest inside an edge is (|A| + |B|) / 2 further in than the pixel's center. The depth is a plane
+	// across the triangle, z(x, y) = depthX * x + depthY * y + depthC, and the furthest depth within a pixel is
+	// (|depthX| + |depthY|) / 2 behind its center (but never behind the triangle's furthest corner).
+	//---
+	float edgeA[3]		= { a.y - b.y, b.y - c.y, c.y - a.y };
+	float edgeB[3]		= { b.x - a.x, c.x - b.x, a.x - c.x };
+	float edgeC[3]		= { a.x * b.y - a.y * b.x, b.x * c.y - b.y * c.x, c.x * a.y - c.y * a.x };
+	float edgeCorner[3]	= { 0.5f * (std::abs(edgeA[0]) + std::abs(edgeB[0])), 0.5f * (std::abs(edgeA[1]) + std::abs(edgeB[1])),
+							0.5f * (std::abs(edgeA[2]) + std::abs(edgeB[2])) };
+
+	float area			= (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	float depthX		= ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+	float depthY		= ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+	float depthC		= a.z - depthX * a.x - depthY * a.y;
+	float depthCorner	= 0.5f * (std::abs(depthX) + std::abs(depthY));
+	float furthest		= std::max(std::max(a.z, b.z), c.z);
+
+#if COG_SIMD == 1
+	//--- Start on a multiple of 4, so a group of 4 pixels never crosses the end of a row (the width is a multiple of 4)
+	const __m128 zero		= _mm_setzero_ps();
+	const __m128 pixels		= _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	const __m128 centers	= _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	const __m128 left		= _mm_set1_ps((float)minimumX);
+	const __m128 right		= _mm_set1_ps((float)maximumX);
+	const __m128 back		= _mm_set1_ps(furthest);
+	int startX				= minimumX & ~3;
+
+	for (int y = minimumY; y <= maximumY; y++) {
+
+		float centerY	= y + 0.5f;
+		float* row		= &m_layer[y * m_width];
+
+		__m128 rowEdge0	= _mm_set1_ps(edgeB[0] * centerY + edgeC[0] + edgeCorner[0]);
+		__m128 rowEdge1	= _mm_set1_ps(edgeB[1] * centerY + edgeC[1] + edgeCorner[1]);
+		__m128 rowEdge2	= _mm_set1_ps(edgeB[2] * centerY + edgeC[2] + edgeCorner[2]);
+		__m128 rowDepth	= _mm_set1_ps(depthY * centerY + depthC + depthCorner);
+
+		for (int x = startX; x <= maximumX; x += 4) {
+
+			__m128 pixelX	= _mm_add_ps(_mm_set1_ps((float)x), pixels);
+			__m128 centerX	= _mm_add_ps(_mm_set1_ps((float)x), centers);
+
+			__m128 edge0	= _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[0]), centerX), rowEdge0);
+			__m128 edge1	= _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[1]), centerX), rowEdge1);
+			__m128 edge2	= _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[2]), centerX), rowEdge2);
+			__m128 isInside	= _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+
+			isInside		= _mm_and_ps(isInside, _mm_and_ps(_mm_cmpge_ps(pixelX, left), _mm_cmple_ps(pixelX, right)));
+
+			if (_mm_movemask_ps(isInside) == 0) { continue; }
+
+			__m128 depth	= _mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthX), centerX), rowDepth), back);
+			__m128 current	= _mm_loadu_ps(row + x);
+			__m128 deepest	= _mm_max_ps(current, depth);
+
+			_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(isInside, deepest), _mm_andnot_ps(isInside, current)));
+		}
+	}
+#else
+	for (int y = minimumY; y <= maximumY; y++) {
+
+		float centerY	= y + 0.5f;
+		float* row		= &m_layer[y * m_width];
+
+		float rowEdge0	= edgeB[0] * centerY + edgeC[0] + edgeCorner[0];
+		float rowEdge1	= edgeB[1] * centerY + edgeC[1] + edgeCorner[1];
+		float rowEdge2	= edgeB[2] * centerY + edgeC[2] + edgeCorner[2];
+		float rowDepth	= depthY * centerY + depthC + depthCorner;
+
+		for (int x = minimumX; x <= maximumX; x++) {
+
+			float centerX = x + 0.5f;
+
+			if (edgeA[0] * centerX + rowEdge0 < 0.0f || edgeA[1] * centerX + rowEdge1 < 0.0f || edgeA[2] * centerX + rowEdge2 < 0.0f) { continue; }
+
+			row[x] = std::max(row[x], std::min(depthX * centerX + rowDepth, furthest));
+		}
+	}
+#endif
+}
+
+
+/*******************************************************************************************************************
+	A function that marks every pixel within rows [first, last) that a silhouette edge touches - a row at a time,
+	from where the edge enters the row to where it leaves it
+*******************************************************************************************************************/
+void OcclusionBuffer::RasterizeEdge(const Edge& edge, int first, int last)
+{
+	//--- The edge is made a little longer and wider, so rounding can only ever mark too many pixels, never too few
+	float minimumY = std::min(edge.a.y, edge.b.y) - s_edgeMargin;
+	float maximumY = std::max(edge.a.y, edge.b.y) + s_edgeMargin;
+
+	int firstRow	= std::max((int)std::ceil(minimumY) - 1, first);
+	int lastRow		= std::min((int)std::floor(maximumY), last - 1);
+
+	float slope = (edge.b.y != edge.a.y) ? (edge.b.x - edge.a.x) / (edge.b.y - edge.a.y) : 0.0f;
+
+	for (int y = firstRow; y <= lastRow; y++) {
+
+		float startX, endX;
+
+		if (edge.b.y == edge.a.y) {
+			startX	= std::min(edge.a.x, edge.b.x);
+			endX	= std::max(edge.a.x, edge.b.x);
+		}
+		else {
+			float bottom	= std::max((float)y, std::min(edge.a.y, edge.b.y));
+			float top		= std::min((float)(y + 1), std::max(edge.a.y, edge.b.y));
+			float bottomX	= edge.a.x + (bottom - edge.a.y) * slope;
+			float topX		= edge.a.x + (top - edge.a.y) * slope;
+
+			startX	= std::min(bottomX, topX);
+			endX	= std::max(bottomX, topX);
+		}
+
+		int left	= std::max((int)std::ceil(startX - s_edgeMargin) - 1, 0);
+		int right	= std::min((int)std::floor(endX + s_edgeMargin), (int)m_width - 1);
+
+		if (left <= right) { std::fill(m_silhouette.begin() + y * m_width + left, m_silhouette.begin() + y * m_width + right + 1, 1); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	A function that builds each level of the hierarchy from the furthest depth of 2 x 2 texels in the level below
+*******************************************************************************************************************/
+void OcclusionBuffer::BuildHierarchy()
+{
+	for (size_t level = 1; level < m_levels.size(); level++) {
+
+		const Level& below	= m_levels[level - 1];
+		Level& current		= m_levels[level];
+
+		for (unsigned int y = 0; y < current.height; y++) {
+
+			const float* top	= &below.depths[(y * 2) * below.width];
+			const float* bottom	= top + below.width;
+
+			for (unsigned int x = 0; x < current.width; x++) {
+				current.depths[y * current.width + x] = std::max(std::max(top[x * 2], top[x * 2 + 1]), std::max(bottom[x * 2], bottom[x * 2 + 1]));
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+unsigned int OcclusionBuffer::GetWidth() const				{ return m_width; }
+unsigned int OcclusionBuffer::GetHeight() const				{ return m_height; }
+unsigned int OcclusionBuffer::GetLevelCount() const			{ return (unsigned int)m_levels.size(); }
+unsigned int OcclusionBuffer::GetTriangleCount() const		{ return (unsigned int)m_triangles.size(); }
+
+
+/*******************************************************************************************************************
+	Function that returns the depth of a texel in a level of the hierarchy (level 0 is the full size buffer)
+*******************************************************************************************************************/
+float OcclusionBuffer::GetDepth(unsigned int x, unsigned int y, unsigned int level) const
+{
+	const Level& current = m_levels[std::min(level, (unsigned int)m_levels.size() - 1)];
+
+	return current.depths[std::min(y, current.height - 1) * current.width + std::min(x, current.width - 1)];
+}
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const unsigned int OcclusionBuffer::s_minRowsPerThread	= 16;
+const unsigned int OcclusionBuffer::s_maxTexelsPerTest	= 16;
+const float OcclusionBuffer::s_clearDepth				= 1.0f;
+const float OcclusionBuffer::s_emptyDepth				= -FLT_MAX;
+const float OcclusionBuffer::s_edgeMargin				= 1.0f / 1024.0f;
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+/*******************************************************************************************************************
+	OcclusionBuffer.h, OcclusionBuffer.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A small software depth buffer, drawn on the CPU every frame from a few big occluders (e.g. the terrain's hills),
+	used to skip objects that are inside the view frustum but completely hidden behind something.
+
+	[Features]
+	Low resolution (256 x 128 by default) so rasterizing is cheap - it only needs to be roughly right.
+	Conservative - a pixel only takes an occluder's depth if the occluder covers all of it, and it takes the
+	furthest depth the occluder has within the pixel, so a box is never culled by a pixel it can see past.
+	Rasterizes 4 pixels at a time with SSE edge functions (falls back to one pixel at a time without SSE).
+	The rows are split into bands, each band drawn as its own job, so the workers never touch the same memory.
+	A max depth hierarchy (each level holds the furthest depth of 2 x 2 texels below it), so an object's screen
+	rectangle is only ever tested against a handful of texels, whatever its size.
+	Pure CPU and glm, nothing here touches OpenGL - so it can be tested without a GPU.
+
+	[Upcoming]
+	Re-using the hierarchy for shadow caster culling.
+
+	[Side Notes]
+	Occluders must be inside the object they stand for (never bigger), or visible objects could be culled.
+	Terrain::GetOccluderMesh() builds a mesh like this for the terrain.
+	Each occluder is drawn into a layer of its own first - every pixel a triangle touches keeps the furthest
+	depth of the triangles touching it, then the pixels its silhouette edges touch are thrown away (those are the
+	only pixels it can cover part of). An edge is part of the silhouette unless it's shared by exactly 2 triangles
+	lying either side of it on screen, so occluder meshes must share their vertices (by index) to cull anything.
+	Triangles that cross the near plane are skipped rather than clipped - that only means less gets culled.
+	Objects that cross the near plane, or are off screen, are always treated as visible (the frustum deals with those).
+	Without a job system, Render() draws the whole buffer on the calling thread.
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <vector>
+#include "utilities/JobSystem.h"
+
+class OcclusionBuffer {
+
+private:
+	//--- Screen space triangle - x and y are in pixels, z is the normalized depth (-1 near, 1 far)
+	struct Triangle {
+		glm::vec3 a, b, c;
+	};
+
+	//--- Screen space silhouette edge
+	struct Edge {
+		glm::vec2 a, b;
+	};
+
+	//--- An occluder's triangles and silhouette edges [first, last), and the pixels they touch (inclusive)
+	struct Occluder {
+		unsigned int	firstTriangle, lastTriangle;
+		unsigned int	firstEdge, lastEdge;
+		int				left, bottom, right, top;
+	};
+
+	struct Level {
+		unsigned int		width, height;
+		std::vector<float>	depths;
+	};
+
+public:
+	OcclusionBuffer(unsigned int width = 256, unsigned int height = 128, JobSystem* jobSystem = nullptr);
+	~OcclusionBuffer();
+
+public:
+	void Begin(const glm::mat4& viewProjection);
+	void AddOccluder(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices);
+	void AddOccluder(const glm::vec3& minimum, const glm::vec3& maximum);
+	void Render();
+
+public:
+	bool IsVisible(const glm::vec3& minimum, const glm::vec3& maximum) const;
+
+public:
+	float			GetDepth(unsigned int x, unsigned int y, unsigned int level = 0) const;
+	unsigned int	GetWidth() const;
+	unsigned int	GetHeight() const;
+	unsigned int	GetLevelCount() const;
+	unsigned int	GetTriangleCount() const;
+
+private:
+	OcclusionBuffer(const OcclusionBuffer&)				= delete;
+	OcclusionBuffer& operator=(const OcclusionBuffer&)	= delete;
+
+private:
+	bool Project(const glm::vec3& position, glm::vec3& screenPosition) const;
+	bool AddTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+	void RasterizeRows(unsigned int first, unsigned int last);
+	void RasterizeTriangle(const Triangle& triangle, int first, int last);
+	void RasterizeEdge(const Edge& edge, int first, int last);
+	void BuildHierarchy();
+
+private:
+	glm::mat4				m_viewProjection;
+	std::vector<Triangle>	m_triangles;
+	std::vector<Edge>		m_edges;
+	std::vector<Occluder>	m_occluders;
+	std::vector<Level>		m_levels;
+
+private:
+	//--- The occluder being drawn - its depths, and the pixels its silhouette touches
+	std::vector<float>			m_layer;
+	std::vector<unsigned char>	m_silhouette;
+	unsigned int			m_width;
+	unsigned int			m_height;
+	JobSystem*				m_jobSystem;
+
+private:
+	static const unsigned int	s_minRowsPerThread;
+	static const unsigned int	s_maxTexelsPerTest;
+	static const float			s_clearDepth;
+	static const float			s_emptyDepth;
+	static const float			s_edgeMargin;
+};
\ No newline at end of file
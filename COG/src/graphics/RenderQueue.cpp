@@ -0,0 +1,207 @@
+#include <algorithm>
+#include "RenderQueue.h"
+
+/*******************************************************************************************************************
+	Recording backend constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+RenderQueue::RecordingBackend::RecordingBackend()
+	:	m_passCount(0),
+		m_shaderBinds(0),
+		m_materialBinds(0),
+		m_meshBinds(0)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Functions that count what the queue asked for instead of doing it
+*******************************************************************************************************************/
+void RenderQueue::RecordingBackend::BeginPass(unsigned int pass)		{ m_passCount++; }
+void RenderQueue::RecordingBackend::BindShader(unsigned int shader)		{ m_shaderBinds++; }
+void RenderQueue::RecordingBackend::BindMaterial(unsigned int draw)		{ m_materialBinds++; }
+void RenderQueue::RecordingBackend::BindMesh(unsigned int draw)			{ m_meshBinds++; }
+void RenderQueue::RecordingBackend::Draw(unsigned int draw)				{ m_draws.push_back(draw); }
+
+
+/*******************************************************************************************************************
+	Function that forgets everything recorded so far
+*******************************************************************************************************************/
+void RenderQueue::RecordingBackend::Reset()
+{
+	m_passCount		= 0;
+	m_shaderBinds	= 0;
+	m_materialBinds	= 0;
+	m_meshBinds		= 0;
+	m_draws.clear();
+}
+
+
+/*******************************************************************************************************************
+	Recording backend accessor methods
+*******************************************************************************************************************/
+unsigned int RenderQueue::RecordingBackend::GetPassCount() const				{ return m_passCount; }
+unsigned int RenderQueue::RecordingBackend::GetShaderBinds() const				{ return m_shaderBinds; }
+unsigned int RenderQueue::RecordingBackend::GetMaterialBinds() const			{ return m_materialBinds; }
+unsigned int RenderQueue::RecordingBackend::GetMeshBinds() const				{ return m_meshBinds; }
+unsigned int RenderQueue::RecordingBackend::GetStateChanges() const				{ return m_shaderBinds + m_materialBinds + m_meshBinds; }
+const std::vector<unsigned int>& RenderQueue::RecordingBackend::GetDraws() const	{ return m_draws; }
+
+
+/*******************************************************************************************************************
+	Default constructor
+*******************************************************************************************************************/
+RenderQueue::RenderQueue()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+RenderQueue::~RenderQueue()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a draw command to the queue
+*******************************************************************************************************************/
+void RenderQueue::Push(uint64_t key, unsigned int draw)
+{
+	m_commands.push_back({ key, draw });
+}
+
+
+/*******************************************************************************************************************
+	Function that empties the queue, keeping its memory for the next frame
+*******************************************************************************************************************/
+void RenderQueue::Clear()
+{
+	m_commands.clear();
+}
+
+
+/*******************************************************************************************************************
+	Function that sorts the commands by key, a byte at a time (least significant first). Each pass is stable, so
+	commands with the same key keep the order they were pushed in
+*******************************************************************************************************************/
+void RenderQueue::Sort()
+{
+	unsigned int count = (unsigned int)m_commands.size();
+
+	if (count < 2) { return; }
+
+	m_scratch.resize(count);
+
+	Command* source			= m_commands.data();
+	Command* destination	= m_scratch.data();
+
+	for (unsigned int shift = 0; shift < 64; shift += 8) {
+
+		//--- One counter for every value the byte can have
+		unsigned int offsets[256] = {};
+
+		for (unsigned int i = 0; i < count; i++) { offsets[(source[i].key >> shift) & 0xFF]++; }
+
+		//--- Every key has the same byte here, so this pass wouldn't move anything
+		if (offsets[(source[0].key >> shift) & 0xFF] == count) { continue; }
+
+		unsigned int total = 0;
+
+		for (unsigned int& offset : offsets) {
+			unsigned int size = offset;
+			offset = total;
+			total += size;
+		}
+
+		for (unsigned int i = 0; i < count; i++) { destination[offsets[(source[i].key >> shift) & 0xFF]++] = source[i]; }
+
+		std::swap(source, destination);
+	}
+
+	//--- If the sorted commands ended up in the scratch buffer, just swap the buffers over
+	if (source != m_commands.data()) { m_commands.swap(m_scratch); }
+}
+
+
+/*******************************************************************************************************************
+	Function that runs through the sorted commands, telling the backend about every pass, shader, material and mesh
+	change (and only the changes) before asking it to draw
+*******************************************************************************************************************/
+void RenderQueue::Execute(Backend& backend) const
+{
+	if (m_commands.empty()) { return; }
+
+	uint64_t previous = m_commands.front().key;
+
+	backend.BeginPass(GetPass(previous));
+	backend.BindShader(GetShader(previous));
+	backend.BindMaterial(m_commands.front().draw);
+	backend.BindMesh(m_commands.front().draw);
+
+	for (const auto& command : m_commands) {
+
+		//--- Anything below a change is bound again, as a new pass or shader may have reset it
+		bool isNewPass		= GetPass(command.key) != GetPass(previous);
+		bool isNewShader	= isNewPass || GetShader(command.key) != GetShader(previous);
+		bool isNewMaterial	= isNewShader || GetMaterial(command.key) != GetMaterial(previous);
+		bool isNewMesh		= isNewShader || GetMesh(command.key) != GetMesh(previous);
+
+		if (isNewPass) {
+			backend.EndPass(GetPass(previous));
+			backend.BeginPass(GetPass(command.key));
+		}
+
+		if (isNewShader)	{ backend.BindShader(GetShader(command.key)); }
+		if (isNewMaterial)	{ backend.BindMaterial(command.draw); }
+		if (isNewMesh)		{ backend.BindMesh(command.draw); }
+
+		backend.Draw(command.draw);
+
+		previous = command.key;
+	}
+
+	backend.EndPass(GetPass(previous));
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+const std::vector<RenderQueue::Command>& RenderQueue::GetCommands() const	{ return m_commands; }
+unsigned int RenderQueue::GetCount() const									{ return (unsigned int)m_commands.size(); }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const unsigned int	RenderQueue::s_passShift		= 60;
+const unsigned int	RenderQueue::s_shaderShift		= 52;
+const unsigned int	RenderQueue::s_materialShift	= 36;
+const unsigned int	RenderQueue::s_meshShift		= 20;
+const uint64_t		RenderQueue::s_passMask			= 0xF;
+const uint64_t		RenderQueue::s_shaderMask		= 0xFF;
+const uint64_t		RenderQueue::s_materialMask		= 0xFFFF;
+const uint64_t		RenderQueue::s_meshMask			= 0xFFFF;
+const uint64_t		RenderQueue::s_depthMask		= 0xFFFFF;
+const float			RenderQueue::s_maxDistance		= 1000.0f;
+
+uint64_t RenderQueue::MakeKey(unsigned int pass, unsigned int shader, unsigned int material, unsigned int mesh, float distance)
+{
+	//--- Anything beyond the far plane (or behind the camera) is clamped, it's only used to order the draws
+	float depth = std::min(std::max(distance / s_maxDistance, 0.0f), 1.0f);
+
+	return	((pass & s_passMask) << s_passShift)			|
+			((shader & s_shaderMask) << s_shaderShift)		|
+			((material & s_materialMask) << s_materialShift)	|
+			((mesh & s_meshMask) << s_meshShift)			|
+			(uint64_t)(depth * s_depthMask);
+}
+
+unsigned int RenderQueue::GetPass(uint64_t key)		{ return (unsigned int)((key >> s_passShift) & s_passMask); }
+unsigned int RenderQueue::GetShader(uint64_t key)	{ return (unsigned int)((key >> s_shaderShift) & s_shaderMask); }
+unsigned int RenderQueue::GetMaterial(uint64_t key)	{ return (unsigned int)((key >> s_materialShift) & s_materialMask); }
+unsigned int RenderQueue::GetMesh(uint64_t key)		{ return (unsigned int)((key >> s_meshShift) & s_meshMask); }
\ No newline at end of file
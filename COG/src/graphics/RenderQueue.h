@@ -0,0 +1,120 @@
+#pragma once
+
+/*******************************************************************************************************************
+	RenderQueue.h, RenderQueue.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A list of draw commands, each a 64 bit sort key and the index of the draw it belongs to. Commands are pushed in
+	any order, radix sorted once per frame, then executed in one go - so every draw sharing a shader, material or
+	mesh ends up next to each other, and each of those is only bound once per run rather than once per object.
+
+	[Features]
+	Sort keys, from the most to the least significant bits: pass (4), shader (8), material (16), mesh (16) and
+	depth (20). Opaque draws within a mesh are drawn front to back, so the depth test throws away more pixels.
+	LSD radix sort, a byte at a time - bytes that are the same in every key (e.g. the pass, most frames) are skipped.
+	Execute() only tells the backend about what has changed since the last command (a new pass, shader, material or
+	mesh), then asks it to draw.
+	RecordingBackend - counts (and remembers) everything it's asked to do, so state changes can be counted without
+	OpenGL.
+
+	[Upcoming]
+	A translucent pass, with the depth moved above the material and flipped (back to front).
+
+	[Side Notes]
+	Shader IDs are whatever the backend wants them to be, material and mesh IDs come from Material::GetID() and
+	Model::GetID(), which are the same for every material/model that binds the same textures/buffers. Only the low 16
+	bits of those are kept, so past 65535 materials (or models) two of them could share a key and a bind.
+	Sort() must be called before Execute(), and nothing should be pushed in between.
+
+*******************************************************************************************************************/
+#include <cstdint>
+#include <vector>
+
+class RenderQueue {
+
+public:
+	enum Pass { PASS_OPAQUE };
+
+	struct Command {
+		uint64_t		key;
+		unsigned int	draw;
+	};
+
+	class Backend {
+
+	public:
+		virtual ~Backend() {}
+
+	public:
+		virtual void BeginPass(unsigned int pass)		{}
+		virtual void EndPass(unsigned int pass)			{}
+		virtual void BindShader(unsigned int shader)	= 0;
+		virtual void BindMaterial(unsigned int draw)	= 0;
+		virtual void BindMesh(unsigned int draw)		= 0;
+		virtual void Draw(unsigned int draw)			= 0;
+	};
+
+	class RecordingBackend : public Backend {
+
+	public:
+		RecordingBackend();
+
+	public:
+		virtual void BeginPass(unsigned int pass)		override;
+		virtual void BindShader(unsigned int shader)	override;
+		virtual void BindMaterial(unsigned int draw)	override;
+		virtual void BindMesh(unsigned int draw)		override;
+		virtual void Draw(unsigned int draw)			override;
+
+	public:
+		void Reset();
+
+	public:
+		unsigned int						GetPassCount() const;
+		unsigned int						GetShaderBinds() const;
+		unsigned int						GetMaterialBinds() const;
+		unsigned int						GetMeshBinds() const;
+		unsigned int						GetStateChanges() const;
+		const std::vector<unsigned int>&	GetDraws() const;
+
+	private:
+		unsigned int				m_passCount;
+		unsigned int				m_shaderBinds;
+		unsigned int				m_materialBinds;
+		unsigned int				m_meshBinds;
+		std::vector<unsigned int>	m_draws;
+	};
+
+public:
+	RenderQueue();
+	~RenderQueue();
+
+public:
+	void Push(uint64_t key, unsigned int draw);
+	void Clear();
+	void Sort();
+	void Execute(Backend& backend) const;
+
+public:
+	const std::vector<Command>&	GetCommands() const;
+	unsigned int				GetCount() const;
+
+public:
+	static uint64_t MakeKey(unsigned int pass, unsigned int shader, unsigned int material, unsigned int mesh, float distance);
+
+public:
+	static unsigned int GetPass(uint64_t key);
+	static unsigned int GetShader(uint64_t key);
+	static unsigned int GetMaterial(uint64_t key);
+	static unsigned int GetMesh(uint64_t key);
+
+private:
+	std::vector<Command> m_commands;
+	std::vector<Command> m_scratch;
+
+private:
+	static const unsigned int	s_passShift, s_shaderShift, s_materialShift, s_meshShift;
+	static const uint64_t		s_passMask, s_shaderMask, s_materialMask, s_meshMask, s_depthMask;
+	static const float			s_maxDistance;
+};
\ No newline at end of file
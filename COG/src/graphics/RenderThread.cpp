@@ -0,0 +1,176 @@
+#include <utility>
+#include "RenderThread.h"
+
+/*******************************************************************************************************************
+	Null backend constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+RenderThread::NullBackend::NullBackend()
+	:	m_frameCount(0),
+		m_drawCount(0),
+		m_lastFrame(0)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that counts the frame and its draws instead of drawing them
+*******************************************************************************************************************/
+void RenderThread::NullBackend::Render(const FramePacket& packet)
+{
+	m_frameCount++;
+	m_drawCount += (unsigned int)(packet.meshes.size() + packet.sprites.size() + packet.labels.size());
+	m_lastFrame = packet.frame;
+}
+
+
+/*******************************************************************************************************************
+	Null backend accessor methods
+*******************************************************************************************************************/
+unsigned int RenderThread::NullBackend::GetFrameCount() const	{ return m_frameCount; }
+unsigned int RenderThread::NullBackend::GetDrawCount() const	{ return m_drawCount; }
+unsigned int RenderThread::NullBackend::GetLastFrame() const	{ return m_lastFrame; }
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+RenderThread::RenderThread(Backend* backend)
+	:	m_writeIndex(0),
+		m_readyIndex(1),
+		m_readIndex(2),
+		m_frame(0),
+		m_hasNewFrame(false),
+		m_backend(backend),
+		m_isRunning(false),
+		m_framesRendered(0)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+RenderThread::~RenderThread()
+{
+	Stop();
+}
+
+
+/*******************************************************************************************************************
+	Function that hands the backend (and its OpenGL context) over to a new render thread
+*******************************************************************************************************************/
+void RenderThread::Start()
+{
+	if (m_isRunning || !m_backend) { return; }
+
+	//--- The context can only be current on one thread, so let go of it here before the render thread takes it
+	m_backend->Detach();
+
+	m_isRunning	= true;
+	m_thread	= std::thread(&RenderThread::Loop, this);
+}
+
+
+/*******************************************************************************************************************
+	Function that lets the render thread draw the last frame it was given, stops it and takes the backend back
+*******************************************************************************************************************/
+void RenderThread::Stop()
+{
+	if (!m_isRunning) { return; }
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_isRunning = false;
+	}
+
+	m_frameReady.notify_one();
+	m_frameTaken.notify_one();
+
+	m_thread.join();
+
+	m_backend->Attach();
+}
+
+
+/*******************************************************************************************************************
+	Function that returns an empty packet to build the next frame into. Waits if the render thread hasn't picked up
+	the last frame yet, so the update thread is never more than one frame ahead
+*******************************************************************************************************************/
+FramePacket& RenderThread::BeginFrame()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+		m_frameTaken.wait(lock, [this]() { return !m_hasNewFrame || !m_isRunning; });
+	}
+
+	//--- The packet being written is never the one being drawn, so it can be filled without holding the lock
+	FramePacket& packet = m_packets[m_writeIndex];
+
+	packet.Clear();
+	packet.frame = ++m_frame;
+
+	return packet;
+}
+
+
+/*******************************************************************************************************************
+	Function that hands the packet from BeginFrame() over to the render thread (or draws it now, if not running)
+*******************************************************************************************************************/
+void RenderThread::SubmitFrame()
+{
+	//--- This is the last time the update thread touches the packet, so sort its draws here rather than on the render thread
+	m_packets[m_writeIndex].queue.Sort();
+
+	if (!m_isRunning) {
+		if (m_backend) { m_backend->Render(m_packets[m_writeIndex]); m_framesRendered++; }
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		std::swap(m_writeIndex, m_readyIndex);
+		m_hasNewFrame = true;
+	}
+
+	m_frameReady.notify_one();
+}
+
+
+/*******************************************************************************************************************
+	The loop the render thread runs - wait for a new frame, take it and draw it. When stopped, the last frame is
+	still drawn before the thread finishes
+*******************************************************************************************************************/
+void RenderThread::Loop()
+{
+	m_backend->Attach();
+
+	while (true) {
+
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_frameReady.wait(lock, [this]() { return m_hasNewFrame || !m_isRunning; });
+
+			if (!m_hasNewFrame) { break; }
+
+			std::swap(m_readIndex, m_readyIndex);
+			m_hasNewFrame = false;
+		}
+
+		//--- The update thread can start the next frame as soon as this one has been taken
+		m_frameTaken.notify_one();
+
+		m_backend->Render(m_packets[m_readIndex]);
+		m_framesRendered++;
+	}
+
+	m_backend->Detach();
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+bool RenderThread::IsRunning() const					{ return m_isRunning; }
+unsigned int RenderThread::GetFramesRendered() const	{ return m_framesRendered; }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+/*******************************************************************************************************************
+	RenderThread.h, RenderThread.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A thread that owns the OpenGL context and draws frame packets, so the update thread can build frame N+1 while
+	the render thread is still drawing frame N.
+
+	[Features]
+	Triple buffered mailbox - the update thread fills one packet, the render thread draws another, and the third
+	holds the newest finished frame. Handing a packet over is just swapping two indices, nothing is copied.
+	The update thread never gets more than one frame ahead - BeginFrame() waits for the render thread to pick up
+	the last frame first, so no frame is thrown away and the game doesn't build frames nobody will see.
+	Backends - the drawing itself is done by a Backend (e.g. SceneRenderer), so the handoff can be tested without
+	OpenGL using the NullBackend, which just counts what it was given.
+	If the thread isn't running, SubmitFrame() draws the packet straight away on the calling thread.
+
+	[Upcoming]
+	Letting the update thread run further ahead when the render thread can't keep up.
+
+	[Side Notes]
+	Start() releases the OpenGL context on the calling thread and the render thread takes it, Stop() draws the last
+	frame, stops the thread and hands the context back. Anything that needs OpenGL outside of the render thread
+	(creating textures, loading a new state) must Stop() first - it's started again on the next Render().
+	Stop() is also the only point at which every packet is finished with, so stop before deleting anything a
+	packet could point to.
+	While it's running the main thread has no OpenGL context, so main thread jobs mustn't call OpenGL either.
+
+*******************************************************************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "graphics/FramePacket.h"
+
+class RenderThread {
+
+public:
+	class Backend {
+
+	public:
+		virtual ~Backend() {}
+
+	public:
+		virtual void Attach() {}
+		virtual void Detach() {}
+		virtual void Render(const FramePacket& packet) = 0;
+	};
+
+	class NullBackend : public Backend {
+
+	public:
+		NullBackend();
+
+	public:
+		virtual void Render(const FramePacket& packet) override;
+
+	public:
+		unsigned int GetFrameCount() const;
+		unsigned int GetDrawCount() const;
+		unsigned int GetLastFrame() const;
+
+	private:
+		std::atomic<unsigned int> m_frameCount;
+		std::atomic<unsigned int> m_drawCount;
+		std::atomic<unsigned int> m_lastFrame;
+	};
+
+public:
+	RenderThread(Backend* backend);
+	~RenderThread();
+
+public:
+	void Start();
+	void Stop();
+
+public:
+	FramePacket&	BeginFrame();
+	void			SubmitFrame();
+
+public:
+	bool			IsRunning() const;
+	unsigned int	GetFramesRendered() const;
+
+private:
+	RenderThread(const RenderThread&)				= delete;
+	RenderThread& operator=(const RenderThread&)	= delete;
+
+private:
+	void Loop();
+
+private:
+	FramePacket		m_packets[3];
+	unsigned int	m_writeIndex;
+	unsigned int	m_readyIndex;
+	unsigned int	m_readIndex;
+	unsigned int	m_frame;
+	bool			m_hasNewFrame;
+
+private:
+	Backend*					m_backend;
+	std::thread					m_thread;
+	std::mutex					m_lock;
+	std::condition_variable		m_frameReady;
+	std::condition_variable		m_frameTaken;
+	std::atomic<bool>			m_isRunning;
+	std::atomic<unsigned int>	m_framesRendered;
+};
\ No newline at end of file
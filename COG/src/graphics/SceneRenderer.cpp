@@ -0,0 +1,295 @@
+#include "SceneRenderer.h"
+#include "managers/ScreenManager.h"
+#include "graphics/shaders/SkyboxShader.h"
+#include "graphics/shaders/TerrainShader.h"
+#include "graphics/shaders/EntityShader.h"
+#include "graphics/shaders/InterfaceShader.h"
+#include "graphics/shaders/TextShader.h"
+#include "graphics/buffers/RenderTarget.h"
+#include "graphics/Material.h"
+#include "graphics/Model.h"
+#include "graphics/Texture.h"
+#include "graphics/Text.h"
+#include "application/Skybox.h"
+#include "application/Terrain.h"
+#include "application/Quad.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+SceneRenderer::SceneRenderer(const Scene& scene)
+	:	m_scene(scene),
+		m_packet(nullptr),
+		m_material(nullptr)
+{
+	m_lights.reserve(Shader::MAX_LIGHTS);
+	m_lightPointers.reserve(Shader::MAX_LIGHTS);
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+SceneRenderer::~SceneRenderer()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that makes the OpenGL context current on the thread that is about to render
+*******************************************************************************************************************/
+void SceneRenderer::Attach()
+{
+	Screen::Instance()->MakeContextCurrent(true);
+}
+
+
+/*******************************************************************************************************************
+	Function that releases the OpenGL context from the thread that has finished rendering
+*******************************************************************************************************************/
+void SceneRenderer::Detach()
+{
+	Screen::Instance()->MakeContextCurrent(false);
+}
+
+
+/*******************************************************************************************************************
+	Function that renders a frame packet to the screen
+*******************************************************************************************************************/
+void SceneRenderer::Render(const FramePacket& packet)
+{
+	//--- Render all 3D objects
+	Screen::Instance()->BeginScene(0.0f, 0.0f, 0.0f);
+	Screen::Instance()->PerspectiveView(true);
+	Screen::Instance()->EnableBlending(false);
+	Screen::Instance()->EnableDepth(true);
+
+	RenderWorld(packet);
+
+	//--- Render all 2D objects
+	Screen::Instance()->PerspectiveView(false);
+	Screen::Instance()->EnableBlending(true);
+	Screen::Instance()->EnableDepth(false);
+	Screen::Instance()->CullBackFace(false);
+
+	RenderInterface(packet);
+
+	Screen::Instance()->EndScene();
+}
+
+
+/*******************************************************************************************************************
+	Function that renders all 3D objects to the screen
+*******************************************************************************************************************/
+void SceneRenderer::RenderWorld(const FramePacket& packet)
+{
+
+#if COG_DEBUG == 1
+	Screen::Instance()->WireframeMode(packet.isWireframe);
+#endif
+
+	//--- The shaders take the lights by pointer, so point them at our own copy rather than into the packet
+	m_lights.assign(packet.lights.begin(), packet.lights.end());
+	m_lightPointers.clear();
+	for (auto& light : m_lights) { m_lightPointers.push_back(&light); }
+
+	//--- Render the skybox
+	Screen::Instance()->CullBackFace(false);
+	m_scene.skyboxShader->Bind();
+	m_scene.skyboxShader->SetView(packet.camera);
+		m_scene.skybox->Render(m_scene.skyboxShader);
+	m_scene.skyboxShader->Unbind();
+	Screen::Instance()->CullBackFace(true);
+
+	//--- Render to texture (minimap), only when the minimap is on screen
+	if (packet.isMinimapVisible) {
+		m_scene.minimap->BeginScene(true);
+			m_scene.terrainShader->Bind();
+			m_scene.terrainShader->SetView(packet.minimapCamera);
+				m_scene.terrain->Render(m_scene.terrainShader, true);
+			m_scene.terrainShader->Unbind();
+		m_scene.minimap->EndScene();
+	}
+
+	//--- Render the terrain
+	m_scene.terrainShader->Bind();
+#if COG_DEBUG == 1
+	m_scene.terrainShader->DebugMode(packet.isDebugMode);
+#endif
+	m_scene.terrainShader->SetView(packet.camera);
+	m_scene.terrainShader->SetLights(m_lightPointers);
+		m_scene.terrain->Render(m_scene.terrainShader, false);
+	m_scene.terrainShader->Unbind();
+
+	//--- Render the entities (only the ones that were in view when the packet was built)
+	RenderEntities(packet);
+}
+
+
+/*******************************************************************************************************************
+	Function that renders the entities, one instanced draw call for each batch of meshes sharing a model and material
+*******************************************************************************************************************/
+void SceneRenderer::RenderEntities(const FramePacket& packet)
+{
+	//--- A shader that can't read the instance attributes draws one mesh at a time, straight from the render queue
+	if (!m_scene.entityShader->IsInstancingSupported()) {
+		RenderDraws(packet);
+		return;
+	}
+
+	m_batcher.Build(packet.queue, packet.meshes);
+
+	if (m_batcher.GetBatches().empty()) { return; }
+
+	//--- Every instance of the frame goes up in one upload, each batch then draws its own slice of it
+	m_instanceBuffer.Push(m_batcher.GetInstances());
+
+	m_scene.entityShader->Bind();
+#if COG_DEBUG == 1
+	m_scene.entityShader->DebugMode(packet.isDebugMode);
+#endif
+	m_scene.entityShader->SetView(packet.camera);
+	m_scene.entityShader->SetLights(m_lightPointers);
+	m_scene.entityShader->Instancing(true);
+
+	//--- And so does every batch's material and texture data, before any of them are drawn
+	const auto& batches = m_batcher.GetBatches();
+
+	m_scene.entityShader->BeginBatches();
+	for (const auto& batch : batches) { m_scene.entityShader->AddBatch(packet.meshes[batch.draw].material); }
+	m_scene.entityShader->UploadBatches();
+
+	Material* material = nullptr;
+
+	for (unsigned int i = 0; i < batches.size(); i++) {
+
+		const auto& mesh = packet.meshes[batches[i].draw];
+
+		m_scene.entityShader->SetBatchData(i);
+
+		//--- Batches split by the cap share a material, otherwise unbind the last one's textures before binding
+		if (!material || material->GetID() != mesh.material->GetID()) {
+			if (material) { material->Unbind(); }
+			material = mesh.material;
+			material->Bind();
+		}
+
+		mesh.model->Bind();
+		m_instanceBuffer.Attach(batches[i].first);
+		mesh.model->DrawInstanced(batches[i].count);
+	}
+
+	material->Unbind();
+
+	m_scene.entityShader->EndBatches();
+	m_scene.entityShader->Instancing(false);
+	m_scene.entityShader->Unbind();
+}
+
+
+/*******************************************************************************************************************
+	Function that renders the entities one mesh at a time, from the render queue. Every mesh's matrix, material and
+	texture blocks are uploaded in one go first (a batch of one each, numbered the same as the packet's meshes), so
+	each draw only binds its own ranges of the ring buffer rather than updating the UBO's
+*******************************************************************************************************************/
+void SceneRenderer::RenderDraws(const FramePacket& packet)
+{
+	if (packet.meshes.empty()) { return; }
+
+	m_scene.entityShader->SetView(packet.camera);
+
+	m_scene.entityShader->BeginBatches();
+	for (const auto& mesh : packet.meshes) { m_scene.entityShader->AddDraw(mesh.world, mesh.material); }
+	m_scene.entityShader->UploadBatches();
+
+	m_packet = &packet;
+		packet.queue.Execute(*this);
+	m_packet = nullptr;
+
+	m_scene.entityShader->EndBatches();
+}
+
+
+/*******************************************************************************************************************
+	Function that unbinds whatever the render queue left bound once a pass is finished
+*******************************************************************************************************************/
+void SceneRenderer::EndPass(unsigned int pass)
+{
+	if (m_material) { m_material->Unbind(); m_material = nullptr; }
+
+	m_scene.entityShader->Unbind();
+}
+
+
+/*******************************************************************************************************************
+	Function that binds a shader for the render queue, and sets everything that stays the same for the whole frame
+*******************************************************************************************************************/
+void SceneRenderer::BindShader(unsigned int shader)
+{
+	if (shader != FramePacket::SHADER_ENTITY) { return; }
+
+	m_scene.entityShader->Bind();
+#if COG_DEBUG == 1
+	m_scene.entityShader->DebugMode(m_packet->isDebugMode);
+#endif
+	m_scene.entityShader->SetView(m_packet->camera);
+	m_scene.entityShader->SetLights(m_lightPointers);
+}
+
+
+/*******************************************************************************************************************
+	Function that binds the textures of a draw's material for the render queue
+*******************************************************************************************************************/
+void SceneRenderer::BindMaterial(unsigned int draw)
+{
+	if (m_material) { m_material->Unbind(); }
+
+	m_material = m_packet->meshes[draw].material;
+	m_material->Bind();
+}
+
+
+/*******************************************************************************************************************
+	Function that binds the buffers of a draw's model for the render queue
+*******************************************************************************************************************/
+void SceneRenderer::BindMesh(unsigned int draw)
+{
+	m_packet->meshes[draw].model->Bind();
+}
+
+
+/*******************************************************************************************************************
+	Function that draws a mesh for the render queue - its material and model are already bound, only its uniform
+	blocks (uploaded in RenderDraws()) need binding
+*******************************************************************************************************************/
+void SceneRenderer::Draw(unsigned int draw)
+{
+	m_scene.entityShader->SetBatchData(draw);
+	m_packet->meshes[draw].model->Draw();
+}
+
+
+/*******************************************************************************************************************
+	Function that renders all the 2D objects to the screen
+*******************************************************************************************************************/
+void SceneRenderer::RenderInterface(const FramePacket& packet)
+{
+	//--- Render the interface objects
+	m_scene.interfaceShader->Bind();
+		for (const auto& sprite : packet.sprites) {
+			m_scene.interfaceShader->SetInstanceData(sprite.world, sprite.texture, sprite.offset);
+			sprite.texture->Bind();
+				sprite.quad->Render();
+			sprite.texture->Unbind();
+		}
+	m_scene.interfaceShader->Unbind();
+
+	//--- Render the text
+	m_scene.textShader->Bind();
+		for (const auto& label : packet.labels) {
+			m_scene.text->Render(m_scene.textShader, label.text, Transform(label.position, label.scale), label.color);
+		}
+		m_scene.text->EndFrame();
+	m_scene.textShader->Unbind();
+}
\ No newline at end of file
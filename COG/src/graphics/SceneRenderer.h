@@ -0,0 +1,92 @@
+#pragma once
+
+/*******************************************************************************************************************
+	SceneRenderer.h, SceneRenderer.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	The OpenGL backend of the render thread - draws the play state's frame packets (skybox, minimap, terrain,
+	entities, interface and text) in the same order the play state used to draw them itself.
+
+	[Features]
+	Only reads from the frame packet and from the objects that never change after loading (shaders, skybox,
+	terrain, minimap render target and font), so it never touches an object the update thread is changing.
+	Attach()/Detach() make the OpenGL context current on (or release it from) whichever thread is rendering.
+	Draws the entities in instanced batches - the packet's (already sorted) render queue is turned into batches by
+	an InstanceBatcher, every instance of the frame is uploaded in one go, and each batch is a single draw call.
+	An entity shader without the instance attributes draws one mesh at a time instead - the renderer is then the
+	render queue's OpenGL backend, binding each material and model only when it's different from the last one.
+	The batches' material and texture uniform blocks are uploaded in one go as well (see EntityShader::AddBatch()),
+	and so are the matrix, material and texture blocks of every single draw (see EntityShader::AddDraw()).
+
+	[Upcoming]
+	Sorting the interface sprites by texture as well.
+
+	[Side Notes]
+	The shaders are given a copy of the cameras from the packet (Shader::SetView()), so once the render thread has
+	been started the shaders no longer follow the play state's cameras - the packet decides what they see.
+
+*******************************************************************************************************************/
+#include <vector>
+#include "graphics/InstanceBatcher.h"
+#include "graphics/RenderQueue.h"
+#include "graphics/RenderThread.h"
+#include "graphics/buffers/InstanceBuffer.h"
+
+class SkyboxShader; class TerrainShader; class EntityShader; class InterfaceShader; class TextShader;
+class Skybox; class Terrain; class RenderTarget; class Text;
+
+class SceneRenderer : public RenderThread::Backend, public RenderQueue::Backend {
+
+public:
+	struct Scene {
+		SkyboxShader*		skyboxShader;
+		TerrainShader*		terrainShader;
+		EntityShader*		entityShader;
+		InterfaceShader*	interfaceShader;
+		TextShader*			textShader;
+		Skybox*				skybox;
+		Terrain*			terrain;
+		RenderTarget*		minimap;
+		Text*				text;
+	};
+
+public:
+	SceneRenderer(const Scene& scene);
+	virtual ~SceneRenderer();
+
+public:
+	virtual void Attach() override;
+	virtual void Detach() override;
+	virtual void Render(const FramePacket& packet) override;
+
+public:
+	virtual void EndPass(unsigned int pass)			override;
+	virtual void BindShader(unsigned int shader)	override;
+	virtual void BindMaterial(unsigned int draw)	override;
+	virtual void BindMesh(unsigned int draw)		override;
+	virtual void Draw(unsigned int draw)			override;
+
+private:
+	SceneRenderer(const SceneRenderer&)				= delete;
+	SceneRenderer& operator=(const SceneRenderer&)	= delete;
+
+private:
+	void RenderWorld(const FramePacket& packet);
+	void RenderEntities(const FramePacket& packet);
+	void RenderDraws(const FramePacket& packet);
+	void RenderInterface(const FramePacket& packet);
+
+private:
+	Scene				m_scene;
+	std::vector<Light>	m_lights;
+	std::vector<Light*>	m_lightPointers;
+
+private:
+	InstanceBatcher		m_batcher;
+	InstanceBuffer		m_instanceBuffer;
+
+private:
+	const FramePacket*	m_packet;
+	Material*			m_material;
+};
\ No newline at end of file
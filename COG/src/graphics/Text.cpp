@@ -1,21 +1,26 @@
-#include <pretty_freetype/ft2build.h>
-#include <pretty_freetype/freetype.h>
-
+#include <filesystem>
 #include <vector>
 #include <map>
 #include "Text.h"
 #include "utilities/Log.h"
 #include "managers/ResourceManager.h"
+#include "graphics/FontBaker.h"
 #include "graphics/shaders/TextShader.h"
 #include "utilities/Tools.h"
+#include "cache/StateCache.h"
+#include "managers/GameManager.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
 *******************************************************************************************************************/
-Text::Text(const std::string& font, unsigned int size)
-	:	m_tag(font),
+Text::Text(const std::string& font, unsigned int size, bool isDistanceField)
+	:	m_font(font),
+		m_tag(isDistanceField ? font + "_sdf" : font),
 		m_transform(glm::vec2(0.0f), glm::vec2(1.0f)),
-		m_color(glm::vec4(1.0f))
+		m_color(glm::vec4(1.0f)),
+		m_scale(isDistanceField ? (float)size / (float)s_distanceFieldSize : 1.0f),
+		m_isDistanceField(isDistanceField),
+		m_layouts(&s_layouts[m_tag])
 {
 	Load(size);
 }
@@ -31,11 +36,12 @@ Text::~Text()
 
 
 /*******************************************************************************************************************
-	A function that loads in a new font using FreeType library
+	A function that loads in a new font - from its baked atlas if there is one, otherwise using FreeType library.
+	Distance field fonts are always baked at the same size, and scaled to the size asked for when rendered
 *******************************************************************************************************************/
 bool Text::Load(unsigned int size)
 {
-	if (m_tag.empty()) { return false; }
+	if (m_font.empty()) { return false; }
 
 	//--- If the font already exists in our font cache, just use the previous buffers and textures generated for this font
 	if (Resource::Instance()->FindFont(m_tag)) {
@@ -43,83 +49,77 @@ bool Text::Load(unsigned int size)
 		return false;
 	}
 
-	std::string src = "Assets\\Fonts\\" + m_tag;
-
-	//--- Initialize FreeType, returns any number other than 0 on fail
-	FT_Library freeType = { 0 };
-	if (FT_Init_FreeType(&freeType))
-	{
-		COG_LOG("[FONT] Problem initializing FreeType", COG_LOG_EMPTY, LOG_ERROR);
+	//--- NOTE
+	// Rasterising and packing the glyphs lives in FontBaker, so it can be shared with the COGBake command-line tool.
+	// If this font has already been baked at this size (by the asset pipeline, or a previous launch) we just load
+	// the atlas and metrics, otherwise we bake it here and save the result so the next launch can skip FreeType.
+	// The distance transform is spread over the job system's workers, as it's the slowest part of a bake.
+	// Unlike every other binary file, the baked file doesn't go through the FileManager - FontBaker reads and writes
+	// it with plain file streams, as it can't use the engine singletons (COGBake) and FileManager::Parse() lets a
+	// corrupt file's exception through rather than failing the load.
+	//---
+
+	int spread = m_isDistanceField ? s_distanceFieldSpread : 0;
+	if (m_isDistanceField) { size = s_distanceFieldSize; }
+
+	FontBaker baker(Game::Instance()->GetJobSystem());
+	FontBaker::BakedFont& baked = baker.GetFont();
+	std::string bakedLocation = "Assets\\Fonts\\Baked\\" + FontBaker::GetBakedFilename(m_font, size, spread);
+
+	//--- A missing, corrupt or out of date baked file is never fatal, we just bake the font again and replace it
+	bool isLoaded = baker.Load(bakedLocation);
+	if (!isLoaded) { COG_LOG("[FONT] No usable pre-baked font file: ", baker.GetError().c_str(), LOG_WARN); }
+
+	if (isLoaded && baked.fontFilename == m_font && baked.size == size && baked.spread == spread) {
+		COG_LOG("[FONT] Pre-baked font file loaded successfully: ", bakedLocation.c_str(), LOG_SUCCESS);
+	}
+	else if (!baker.Bake(m_font, "Assets\\Fonts\\" + m_font, size, spread)) {
+		COG_LOG("[FONT] Problem baking font: ", baker.GetError().c_str(), LOG_ERROR);
 		return false;
 	}
+	else {
+		std::error_code error;
+		std::filesystem::create_directories("Assets\\Fonts\\Baked", error);
 
-	//--- Load the font file, returns any number other than 0 on fail
-	FT_Face face = { 0 };
-	if (FT_New_Face(freeType, src.c_str(), 0, &face))
-	{
-		COG_LOG("[FONT] Failed to load font: ", src.c_str(), LOG_ERROR);
-		return false;
+		if (baker.Save(bakedLocation))	{ COG_LOG("[FONT] Font baked successfully: ", bakedLocation.c_str(), LOG_SUCCESS); }
+		else							{ COG_LOG("[FONT] Problem saving baked font: ", baker.GetError().c_str(), LOG_WARN); }
 	}
 
-	//--- Set the dimensions of the font
-	//--- Width should remain at 0 for automatic determination of font dimensions
-	//--- The size we pass in should be quite a large number, this will make our font always render in a high resolution
-	//--- And we can scale it down later (always better to scale down, than up!)
-	FT_Set_Pixel_Sizes(face, 0, size);
+	FontCache::Font font = { 0 };
 
-	//--- Disable byte alignment restriction
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-	
-	//--- Create a temporary map for the font characters
-	std::map<GLchar, FontCache::Character> characters;
-	
-	//--- For every character in this font (default 128), generate a glyph
-	for (GLubyte glyph = 0; glyph < FontCache::Character::s_maxGlyphs; glyph++)
-	{
-		//--- Load character glyph 
-		if (FT_Load_Char(face, glyph, FT_LOAD_RENDER))
-		{
-			COG_LOG("[FONT] Failed to load glyph: ", glyph, LOG_ERROR);
-			continue;
-		}
-
-		//--- Generate texture for each glyph
-		GLuint textureID = 0;
-		COG_GLCALL(glGenTextures(1, &textureID));
-		COG_GLCALL(glBindTexture(GL_TEXTURE_2D, textureID));
-		
-		unsigned int width		= face->glyph->bitmap.width;
-		unsigned int height		= face->glyph->bitmap.rows;
-		unsigned char* pixels	= face->glyph->bitmap.buffer;
+	//--- Turn every glyph's pixel rectangle in the atlas into UV's
+	glm::vec2 atlasSize((float)baked.width, (float)baked.height);
 
-		//--- Use GL_RED for fonts
-		COG_GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels));
+	for (const auto& glyph : baked.glyphs) {
 
-		COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-		COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-		COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-		COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+		FontCache::Character character = {	glm::vec4(glyph.x / atlasSize.x, glyph.y / atlasSize.y, (glyph.x + glyph.width) / atlasSize.x, (glyph.y + glyph.height) / atlasSize.y),
+											{ glyph.width, glyph.height },
+											{ glyph.bearingX, glyph.bearingY },
+											glyph.advance };
 
-		FT_Int leftOffset	= face->glyph->bitmap_left;
-		FT_Int topOffset	= face->glyph->bitmap_top;
-		FT_Pos advance		= face->glyph->advance.x;
-		
-		//--- Now store this character for later use
-		FontCache::Character character = { textureID, { width, height }, { leftOffset, topOffset }, advance };
+		font.characters.emplace((GLchar)glyph.character, character);
+	}
+
+	//--- Disable byte alignment restriction
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-		characters.emplace(glyph, character);
+	//--- Generate one texture for the whole font (use GL_RED for fonts)
+	COG_GLCALL(glGenTextures(1, &font.atlas));
+	GLState::Instance()->BindTexture(Shader::GetTextureUnit(Shader::TEXTURE_TEXT), GL_TEXTURE_2D, font.atlas);
 
-		COG_LOG("[FONT] Generated glyph, texture ID: ", textureID, LOG_MEMORY);
-	}
+	COG_GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, baked.width, baked.height, 0, GL_RED, GL_UNSIGNED_BYTE, &baked.pixels.front()));
 
-	COG_GLCALL(glBindTexture(GL_TEXTURE_2D, 0));
+	COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+	COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+	COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+	COG_GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
 
-	//--- Destroy the font and remove the FreeType object now that OpenGL has the data
-	FT_Done_Face(face);
-	FT_Done_FreeType(freeType);
+	GLState::Instance()->BindTexture(Shader::GetTextureUnit(Shader::TEXTURE_TEXT), GL_TEXTURE_2D, 0);
+
+	COG_LOG("[FONT] Generated glyph atlas, texture ID: ", font.atlas, LOG_MEMORY);
 
 	//--- Add this new font to our font cache
-	Resource::Instance()->AddFont(m_tag, characters);
+	Resource::Instance()->AddFont(m_tag, font);
 
 	COG_LOG("[FONT] Generated font: ", m_tag.c_str(), LOG_MEMORY);
 	
@@ -135,85 +135,142 @@ bool Text::Load(unsigned int size)
 *******************************************************************************************************************/
 void Text::SetupBuffers()
 {
-	std::vector<GLfloat> textureCoords = {
-		0.0f, 0.0f,
-		0.0f, 1.0f,
-		1.0f, 1.0f,
-		0.0f, 0.0f,
-		1.0f, 1.0f,
-		1.0f, 0.0f
-	};
-
-	std::vector<GLfloat> vertices(s_numVertices);
-
+	//--- Give the buffers storage for the whole layout cache, which new strings are then uploaded into (see Upload())
 	Resource::Instance()->GetVAO(m_tag)->Bind();
-		Resource::Instance()->GetVBO(m_tag, VertexBuffer::LAYOUT_POSITION)->Push(vertices, VertexBuffer::LAYOUT_POSITION, true);
-		Resource::Instance()->GetVBO(m_tag, VertexBuffer::LAYOUT_UV)->Push(textureCoords, VertexBuffer::LAYOUT_UV, false);
+		Upload();
 	Resource::Instance()->GetVAO(m_tag)->Unbind();
 }
 
 
 /*******************************************************************************************************************
-	A function that renders the font to the screen (notice we take in the shader - font is rendered differently)
+	A function that sends the layout cache's new vertices to the font's buffers (the VAO must be bound). The whole
+	block is pushed again only when the cache has moved or resized it, otherwise just the strings added since
 *******************************************************************************************************************/
-void Text::Render(Shader* shader, const std::string& text, const Transform& transform, const glm::vec4& color)
+void Text::Upload()
 {
-	//--- Change the colour for this string
-	m_color = color;
+	unsigned int first = 0, count = 0;
+	if (!m_layouts->GetUpload(first, count)) { return; }
 
-	//--- We have to change the transformation for every string we render (not every text object)
-	m_transform = transform;
+	VertexBuffer* positions		= Resource::Instance()->GetVBO(m_tag, VertexBuffer::LAYOUT_POSITION);
+	VertexBuffer* textureCoords	= Resource::Instance()->GetVBO(m_tag, VertexBuffer::LAYOUT_UV);
 
-	//--- And update the shader for every string we render
-	if (TextShader* textShader = Downcast<TextShader>(shader)) {
-		
-		textShader->SetInstanceData(&m_transform, m_color);
+	if (m_layouts->NeedsFullUpload()) {
+		textureCoords->Push(m_layouts->GetTextureCoords(), VertexBuffer::LAYOUT_UV, true);
+		positions->Push(m_layouts->GetPositions(), VertexBuffer::LAYOUT_POSITION, true);
 	}
+	else {
+		textureCoords->Update(m_layouts->GetTextureCoords(), first * 2, count * 2);
+		positions->Update(m_layouts->GetPositions(), first * 3, count * 3);
+	}
+
+	m_layouts->MarkUploaded();
+}
 
-	COG_GLCALL(glActiveTexture(Shader::GetTextureUnit(Shader::TEXTURE_TEXT)));
 
-	Resource::Instance()->GetVAO(m_tag)->Bind();
+/*******************************************************************************************************************
+	A function that builds the quads of a string the font hasn't drawn before, at the origin and unscaled, and adds
+	them to the layout cache
+*******************************************************************************************************************/
+const TextLayoutCache::Layout* Text::BuildLayout(const std::string& text)
+{
+	m_positions.clear();
+	m_textureCoords.clear();
+
+	//--- Distance field glyphs are baked at one size, so are scaled down (or up) to the size of this text
+	glm::vec2 cursor(0.0f);
+	glm::vec2 scale(m_scale);
 
 	//--- Go through every character within this string
-		for (auto& c : text) {
+	for (auto& c : text) {
 
-			//--- And get the character from the font cache
-			FontCache::Character* character = Resource::Instance()->GetFontCharacter(m_tag, c);
-	
-			if (character) {
+		//--- And get the character from the font cache
+		FontCache::Character* character = Resource::Instance()->GetFontCharacter(m_tag, c);
+
+		if (!character) { continue; }
+
+		//--- Set up our new position and dimension of this character
+		glm::vec2 position(	cursor.x + character->bearing.x * scale.x,
+							cursor.y - (character->size.y - character->bearing.y) * scale.y);
+
+		glm::vec2 dimension(character->size.x * scale.x, character->size.y * scale.y);
+
+		//--- Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+		cursor.x += (character->advance >> 6) * scale.x; // Bitshift by 6 to get value in pixels (2^6 = 64)
+
+		//--- Nothing to draw for blank characters (e.g. spaces)
+		if (character->size.x == 0 || character->size.y == 0) { continue; }
+
+		const glm::vec4& uv = character->uv;
+
+		m_positions.insert(m_positions.end(), {	position.x,					position.y + dimension.y,	0.0f,
+												position.x,					position.y,					0.0f,
+												position.x + dimension.x,	position.y,					0.0f,
+												position.x,					position.y + dimension.y,	0.0f,
+												position.x + dimension.x,	position.y,					0.0f,
+												position.x + dimension.x,	position.y + dimension.y,	0.0f });
+
+		m_textureCoords.insert(m_textureCoords.end(), {	uv.x, uv.y,
+														uv.x, uv.w,
+														uv.z, uv.w,
+														uv.x, uv.y,
+														uv.z, uv.w,
+														uv.z, uv.y });
+	}
+
+	return m_layouts->Add(text, m_positions, m_textureCoords);
+}
+
+
+/*******************************************************************************************************************
+	A function that renders the font to the screen (notice we take in the shader - font is rendered differently).
+	Each string's quads come from the font's layout cache, so a string drawn before is just one ranged draw call
+*******************************************************************************************************************/
+void Text::Render(Shader* shader, const std::string& text, const Transform& transform, const glm::vec4& color)
+{
+	//--- Change the colour for this string
+	m_color = color;
 
-				//--- Set up our new position and dimension of this character
-				glm::vec2 position(	m_transform.GetPosition().x + character->bearing.x * m_transform.GetDimensions().x,
-									m_transform.GetPosition().y - (character->size.y - character->bearing.y) * m_transform.GetDimensions().y);
+	//--- We have to change the transformation for every string we render (not every text object)
+	m_transform = transform;
 
-				glm::vec2 dimension(character->size.x * m_transform.GetDimensions().x,
-									character->size.y * m_transform.GetDimensions().y);
+	//--- Only strings we haven't seen before need building (blank strings are cached too, with nothing to draw)
+	const TextLayoutCache::Layout* layout = m_layouts->Find(text);
+	if (!layout) { layout = BuildLayout(text); }
 
-				std::vector<GLfloat> vertices = {
-					position.x,					position.y + dimension.y,	0.0f,
-					position.x,					position.y,					0.0f,
-					position.x + dimension.x,	position.y,					0.0f,
-					position.x,					position.y + dimension.y,	0.0f,
-					position.x + dimension.x,	position.y,					0.0f,
-					position.x + dimension.x,	position.y + dimension.y,	0.0f
-				};
+	if (layout->count == 0) { return; }
 
-				//--- Bind this characters texture ID
-				COG_GLCALL(glBindTexture(GL_TEXTURE_2D, character->ID));
+	//--- The layout was built at the origin, so it's moved and scaled into place by the shader instead
+	glm::mat4 world =	m_transform.GetRenderMatrix() *
+						glm::translate(glm::vec3(glm::vec2(m_transform.GetPosition()), 0.0f)) *
+						glm::scale(glm::vec3(glm::vec2(m_transform.GetDimensions()), 1.0f));
 
-				//--- And update the OpenGL buffers with the new positions for this character and render to the screen
-				Resource::Instance()->GetVBO(m_tag, VertexBuffer::LAYOUT_POSITION)->Update(vertices);
-				Resource::Instance()->GetVBO(m_tag, VertexBuffer::LAYOUT_POSITION)->Render();
+	//--- And update the shader for every string we render
+	if (TextShader* textShader = Downcast<TextShader>(shader)) {
+		
+		textShader->SetInstanceData(world, m_color);
+		textShader->SetDistanceField(m_isDistanceField);
+	}
 
-				//--- Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-				m_transform.SetPosition(m_transform.GetPosition().x + (character->advance >> 6) * m_transform.GetDimensions().x, m_transform.GetPosition().y); // Bitshift by 6 to get value in pixels (2^6 = 64)
-			}
-		}
+	//--- Bind the whole font's atlas once, for every character in the string
+	GLState::Instance()->BindTexture(Shader::GetTextureUnit(Shader::TEXTURE_TEXT), GL_TEXTURE_2D, Resource::Instance()->GetFontAtlas(m_tag));
 
-	//--- Make sure we unbind everything when we are done rendering this string
+	//--- Upload any new strings, then draw just this string's range of the buffers
+	Resource::Instance()->GetVAO(m_tag)->Bind();
+		Upload();
+		Resource::Instance()->GetVBO(m_tag, VertexBuffer::LAYOUT_POSITION)->Render((GLint)layout->first, (GLsizei)layout->count);
 	Resource::Instance()->GetVAO(m_tag)->Unbind();
 
-	COG_GLCALL(glBindTexture(GL_TEXTURE_2D, 0));
+	GLState::Instance()->BindTexture(Shader::GetTextureUnit(Shader::TEXTURE_TEXT), GL_TEXTURE_2D, 0);
+}
+
+
+/*******************************************************************************************************************
+	A function that tells the font's layout cache a frame has been drawn - strings not drawn for a while are the
+	first to go when the cache is full
+*******************************************************************************************************************/
+void Text::EndFrame()
+{
+	m_layouts->EndFrame();
 }
 
 
@@ -227,4 +284,8 @@ Transform* Text::GetTransform()			{ return &m_transform; }
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
-const unsigned int Text::s_numVertices = 18;
\ No newline at end of file
+const unsigned int	Text::s_distanceFieldSize		= 48;
+const int			Text::s_distanceFieldSpread		= 6;
+
+//--- One layout cache per font tag, as every Text object using a font draws from the same buffers
+std::map<std::string, TextLayoutCache> Text::s_layouts;
\ No newline at end of file
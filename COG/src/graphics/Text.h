@@ -9,31 +9,49 @@
 	
 	[Features]
 	Supports FreeType font library.
+	Every glyph of a font is packed into one atlas texture, so a whole string is built into one set of buffers,
+	uploaded once and drawn with a single draw call.
+	Fonts are baked once (see FontBaker) and saved to Assets/Fonts/Baked, so later launches load the atlas and
+	glyph metrics straight from file without touching FreeType.
+	Distance field fonts - one atlas (baked at 48 pixels) serves every size, and stays sharp when the text is scaled.
+	Every string's quads are built once and kept in a layout cache per font (see TextLayoutCache), in one block of
+	vertices that stays on the GPU. A string drawn again is one lookup and one ranged draw call - only new strings
+	are built and uploaded.
 
 	[Upcoming]
-	Nothing at present.
+	Batching every string of a frame into one draw call (needs per-vertex colours in the text shader).
 
 	[Side Notes]
 	The in-game text is a standalone object - it doesn't relate to any other object in the game, due to
 	its unique set up and the way it is rendered. It has its own shader and it is the last object drawn in any scene,
 	as we want it to be on top of everything, including the 2D interface objects.
+	A distance field font is cached under its own tag (the font name + "_sdf"), so it can be used alongside the
+	normal version of the same font. The fragment shader thresholds the atlas at 0.5 (smoothed over fwidth()) when
+	uniform_text_isDistanceField is set, instead of using it as the alpha.
+	Layouts are built at the origin and unscaled, and placed by the matrix given to the text shader, so they are
+	cached by string alone - moving or scaling a string never rebuilds it. Text objects sharing a font tag share its
+	buffers, so they share its layout cache too. EndFrame() must be called once every string of a frame is drawn.
 
 *******************************************************************************************************************/
 #include <pretty_opengl/glew.h>
 #include <pretty_glm/glm.hpp>
 #include <string>
+#include <vector>
+#include <map>
 #include "physics/Transform.h"
+#include "graphics/TextLayoutCache.h"
 
 class Shader;
 
 class Text {
 
 public:
-	Text(const std::string& font, unsigned int size);
+	Text(const std::string& font, unsigned int size, bool isDistanceField = false);
 	~Text();
 
 public:
 	void Render(Shader* shader, const std::string& text, const Transform& transform, const glm::vec4& color);
+	void EndFrame();
 
 public:
 	const glm::vec4& GetColor() const;
@@ -42,12 +60,30 @@ public:
 private:
 	bool Load(unsigned int size);
 	void SetupBuffers();
+	void Upload();
+
+private:
+	const TextLayoutCache::Layout* BuildLayout(const std::string& text);
 	
 private:
+	std::string m_font;
 	std::string m_tag;
 	Transform	m_transform;
 	glm::vec4	m_color;
+	float		m_scale;
+	bool		m_isDistanceField;
+
+private:
+	TextLayoutCache* m_layouts;
+
+private:
+	std::vector<GLfloat> m_positions;
+	std::vector<GLfloat> m_textureCoords;
+
+private:
+	static const unsigned int	s_distanceFieldSize;
+	static const int			s_distanceFieldSpread;
 
 private:
-	static const unsigned int s_numVertices;
+	static std::map<std::string, TextLayoutCache> s_layouts;
 };
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include "TextLayoutCache.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+TextLayoutCache::TextLayoutCache(unsigned int capacity)
+	:	m_capacity(0),
+		m_vertexCount(0),
+		m_uploadedCount(0),
+		m_frame(0),
+		m_needsFullUpload(true),
+		m_hits(0),
+		m_misses(0),
+		m_compactions(0)
+{
+	Reserve(std::max(capacity, 1u));
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+TextLayoutCache::~TextLayoutCache()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the layout of a string that has been drawn before (or nullptr if it hasn't), and marks
+	it as used this frame
+*******************************************************************************************************************/
+const TextLayoutCache::Layout* TextLayoutCache::Find(const std::string& text)
+{
+	auto layout = m_layouts.find(text);
+
+	if (layout == m_layouts.end()) { m_misses++; return nullptr; }
+
+	layout->second.lastFrame = m_frame;
+	m_hits++;
+
+	return &layout->second;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds the layout of a new string - its quads built at the origin, 3 position and 2 UV floats per
+	vertex. Blank strings are added too (with no vertices), so they aren't built again every time they're drawn
+*******************************************************************************************************************/
+const TextLayoutCache::Layout* TextLayoutCache::Add(const std::string& text, const std::vector<float>& positions, const std::vector<float>& textureCoords)
+{
+	unsigned int count = (unsigned int)std::min(positions.size() / s_positionElements, textureCoords.size() / s_uvElements);
+
+	if (m_vertexCount + count > m_capacity) {
+
+		Compact();
+
+		//--- Everything left is in use this frame, so there's nothing for it but to make the block bigger
+		unsigned int capacity = m_capacity;
+		while (m_vertexCount + count > capacity) { capacity *= 2; }
+		if (capacity != m_capacity) { Reserve(capacity); }
+	}
+
+	std::copy(positions.begin(), positions.begin() + count * s_positionElements, m_positions.begin() + m_vertexCount * s_positionElements);
+	std::copy(textureCoords.begin(), textureCoords.begin() + count * s_uvElements, m_textureCoords.begin() + m_vertexCount * s_uvElements);
+
+	Layout& layout = m_layouts[text];
+	layout = { m_vertexCount, count, m_frame };
+
+	m_vertexCount += count;
+
+	return &layout;
+}
+
+
+/*******************************************************************************************************************
+	Function that starts a new frame - layouts not used from here on are the first to go when the block is full
+*******************************************************************************************************************/
+void TextLayoutCache::EndFrame()
+{
+	m_frame++;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the range of vertices that needs uploading to the vertex buffers, if there is one
+	(when NeedsFullUpload() is true, the whole block needs uploading - it has been moved or resized)
+*******************************************************************************************************************/
+bool TextLayoutCache::GetUpload(unsigned int& first, unsigned int& count) const
+{
+	if (m_needsFullUpload) { first = 0; count = m_capacity; return true; }
+
+	first = m_uploadedCount;
+	count = m_vertexCount - m_uploadedCount;
+
+	return count > 0;
+}
+
+
+/*******************************************************************************************************************
+	Function that records that the vertex buffers now hold everything in the block
+*******************************************************************************************************************/
+void TextLayoutCache::MarkUploaded()
+{
+	m_uploadedCount		= m_vertexCount;
+	m_needsFullUpload	= false;
+}
+
+
+/*******************************************************************************************************************
+	Function that drops every layout not used this frame and moves the rest down to the front of the block
+*******************************************************************************************************************/
+void TextLayoutCache::Compact()
+{
+	std::vector<Layout*> kept;
+
+	for (auto layout = m_layouts.begin(); layout != m_layouts.end();) {
+		if (layout->second.lastFrame != m_frame)	{ layout = m_layouts.erase(layout); }
+		else										{ kept.push_back(&layout->second); layout++; }
+	}
+
+	//--- Moving them in the order they are in the block means nothing is overwritten before it has been moved
+	std::sort(kept.begin(), kept.end(), [](const Layout* a, const Layout* b) { return a->first < b->first; });
+
+	unsigned int vertexCount = 0;
+
+	for (Layout* layout : kept) {
+
+		std::copy(	m_positions.begin() + layout->first * s_positionElements,
+					m_positions.begin() + (layout->first + layout->count) * s_positionElements,
+					m_positions.begin() + vertexCount * s_positionElements);
+
+		std::copy(	m_textureCoords.begin() + layout->first * s_uvElements,
+					m_textureCoords.begin() + (layout->first + layout->count) * s_uvElements,
+					m_textureCoords.begin() + vertexCount * s_uvElements);
+
+		layout->first = vertexCount;
+		vertexCount += layout->count;
+	}
+
+	m_vertexCount		= vertexCount;
+	m_needsFullUpload	= true;
+	m_compactions++;
+}
+
+
+/*******************************************************************************************************************
+	Function that resizes the block (keeping the layouts in it), which the vertex buffers must then be resized to
+*******************************************************************************************************************/
+void TextLayoutCache::Reserve(unsigned int capacity)
+{
+	m_capacity = capacity;
+	m_positions.resize((size_t)capacity * s_positionElements, 0.0f);
+	m_textureCoords.resize((size_t)capacity * s_uvElements, 0.0f);
+
+	m_needsFullUpload = true;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+const std::vector<float>& TextLayoutCache::GetPositions() const			{ return m_positions; }
+const std::vector<float>& TextLayoutCache::GetTextureCoords() const		{ return m_textureCoords; }
+unsigned int TextLayoutCache::GetCapacity() const						{ return m_capacity; }
+unsigned int TextLayoutCache::GetVertexCount() const					{ return m_vertexCount; }
+unsigned int TextLayoutCache::GetLayoutCount() const					{ return (unsigned int)m_layouts.size(); }
+bool TextLayoutCache::NeedsFullUpload() const							{ return m_needsFullUpload; }
+unsigned int TextLayoutCache::GetHits() const							{ return m_hits; }
+unsigned int TextLayoutCache::GetMisses() const							{ return m_misses; }
+unsigned int TextLayoutCache::GetCompactions() const					{ return m_compactions; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const unsigned int TextLayoutCache::s_defaultCapacity	= 6144;
+const unsigned int TextLayoutCache::s_positionElements	= 3;
+const unsigned int TextLayoutCache::s_uvElements		= 2;
\ No newline at end of file
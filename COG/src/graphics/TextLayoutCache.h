@@ -0,0 +1,92 @@
+#pragma once
+
+/*******************************************************************************************************************
+	TextLayoutCache.h, TextLayoutCache.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Remembers the glyph quads (positions and UV's) built for every string drawn with a font, so a string that is
+	drawn again - most of the interface, every frame - costs one lookup instead of one font cache lookup and quad per
+	character.
+
+	[Features]
+	Every layout lives in one block of vertices, sized for the vertex buffers they are drawn from. New layouts are
+	added to the end, and only the vertices added since the last upload need sending to the GPU.
+	Layouts are built at the origin and unscaled, so moving or scaling a string never rebuilds it (the text shader
+	does that with the string's transform).
+	When the block is full, every layout not used this frame is dropped and the rest are moved down to the front
+	(the block only grows if the strings used this frame don't fit on their own).
+	Hit, miss and compaction counters, so the cache can be checked to be doing its job.
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	This class doesn't touch OpenGL - Text builds the layouts and uploads whatever GetUpload() asks for.
+	Layouts returned by Find()/Add() are only valid until the next Add(), which may move everything.
+	EndFrame() must be called once a frame, as layouts used this frame are the ones kept when the block is full.
+
+*******************************************************************************************************************/
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TextLayoutCache {
+
+public:
+	struct Layout {
+		unsigned int first;
+		unsigned int count;
+		unsigned int lastFrame;
+	};
+
+public:
+	TextLayoutCache(unsigned int capacity = s_defaultCapacity);
+	~TextLayoutCache();
+
+public:
+	const Layout*	Find(const std::string& text);
+	const Layout*	Add(const std::string& text, const std::vector<float>& positions, const std::vector<float>& textureCoords);
+	void			EndFrame();
+
+public:
+	bool GetUpload(unsigned int& first, unsigned int& count) const;
+	void MarkUploaded();
+
+public:
+	const std::vector<float>&	GetPositions() const;
+	const std::vector<float>&	GetTextureCoords() const;
+	unsigned int				GetCapacity() const;
+	unsigned int				GetVertexCount() const;
+	unsigned int				GetLayoutCount() const;
+	bool						NeedsFullUpload() const;
+
+public:
+	unsigned int GetHits() const;
+	unsigned int GetMisses() const;
+	unsigned int GetCompactions() const;
+
+private:
+	void Compact();
+	void Reserve(unsigned int capacity);
+
+private:
+	std::unordered_map<std::string, Layout>	m_layouts;
+	std::vector<float>						m_positions;
+	std::vector<float>						m_textureCoords;
+	unsigned int							m_capacity;
+	unsigned int							m_vertexCount;
+	unsigned int							m_uploadedCount;
+	unsigned int							m_frame;
+	bool									m_needsFullUpload;
+
+private:
+	unsigned int m_hits;
+	unsigned int m_misses;
+	unsigned int m_compactions;
+
+private:
+	static const unsigned int s_defaultCapacity;
+	static const unsigned int s_positionElements;
+	static const unsigned int s_uvElements;
+};
\ No newline at end of file
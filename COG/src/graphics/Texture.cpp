@@ -2,6 +2,7 @@
 #include "utilities/Log.h"
 #include "managers/ResourceManager.h"
 #include "managers/ScreenManager.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	[Texture] Constructor with initializer list to set default values of data members
@@ -352,8 +353,7 @@ void Texture::GenerateTexture()
 *******************************************************************************************************************/
 void Texture::Bind() const
 {	
-	COG_GLCALL(glActiveTexture(m_data.slot));
-	COG_GLCALL(glBindTexture(m_data.type, m_data.ID));
+	GLState::Instance()->BindTexture(m_data.slot, m_data.type, m_data.ID);
 
 	//--- NOTE
 	// As we are using multi-textures for the terrain plus diffuse/specular, etc. textures for every object
@@ -362,16 +362,17 @@ void Texture::Bind() const
 	// use one texture slot for all your objects in the scene.
 	// However, that wouldn't allow you to switch between texture slots depending on the objects being drawn,
 	// which is why I have set it up in this generic way.
+	// The state cache only switches slot (and binds) when this texture isn't already bound there.
 	//--- 
 }
 
 
 /*******************************************************************************************************************
-	Unbinds the texture object ID to the relevant texture type & makes it disactive
+	Unbinds the texture object ID from the relevant texture type on its own texture slot
 *******************************************************************************************************************/
 void Texture::Unbind() const
 {
-	COG_GLCALL(glBindTexture(m_data.type, 0));
+	GLState::Instance()->BindTexture(m_data.slot, m_data.type, 0);
 }
 
 
@@ -400,6 +401,53 @@ const glm::vec2& Texture::GetOffset() {
 }
 
 
+/*******************************************************************************************************************
+	Function that asks OpenGL how many bytes this texture takes up in video memory (every mip level and cube map face)
+*******************************************************************************************************************/
+size_t Texture::GetMemoryUsage() const
+{
+	if (m_data.ID == 0) { return 0; }
+
+	//--- NOTE
+	// We ask the driver rather than using m_width/m_height, as textures re-used from the cache never set them.
+	// The size is worked out from the internal format the driver picked, so it doesn't include any padding or
+	// alignment the driver adds behind the scenes - it is the same number a texture tool would report.
+	//---
+
+	GLenum target	= (m_data.type == GL_TEXTURE_CUBE_MAP) ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : GL_TEXTURE_2D;
+	int faces		= (m_data.type == GL_TEXTURE_CUBE_MAP) ? 6 : 1;
+	size_t bytes	= 0;
+
+	//--- The queries read whatever is bound to the active unit, so make sure that's our unit before binding to it
+	GLState::Instance()->ActiveTexture(m_data.slot);
+	Bind();
+
+	for (int face = 0; face < faces; face++) {
+		for (int level = 0; level < s_maxMipLevels; level++) {
+
+			GLint width = 0, height = 0, red = 0, green = 0, blue = 0, alpha = 0, depth = 0;
+			COG_GLCALL(glGetTexLevelParameteriv(target + face, level, GL_TEXTURE_WIDTH, &width));
+			COG_GLCALL(glGetTexLevelParameteriv(target + face, level, GL_TEXTURE_HEIGHT, &height));
+
+			//--- Levels past the last mipmap have no size, so we are done with this face
+			if (width == 0 || height == 0) { break; }
+
+			COG_GLCALL(glGetTexLevelParameteriv(target + face, level, GL_TEXTURE_RED_SIZE, &red));
+			COG_GLCALL(glGetTexLevelParameteriv(target + face, level, GL_TEXTURE_GREEN_SIZE, &green));
+			COG_GLCALL(glGetTexLevelParameteriv(target + face, level, GL_TEXTURE_BLUE_SIZE, &blue));
+			COG_GLCALL(glGetTexLevelParameteriv(target + face, level, GL_TEXTURE_ALPHA_SIZE, &alpha));
+			COG_GLCALL(glGetTexLevelParameteriv(target + face, level, GL_TEXTURE_DEPTH_SIZE, &depth));
+
+			bytes += (size_t)width * height * ((red + green + blue + alpha + depth + 7) / 8);
+		}
+	}
+
+	Unbind();
+
+	return bytes;
+}
+
+
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
@@ -430,5 +478,6 @@ void Texture::SetTransparency(bool hasTransparency) { m_hasTransparency = hasTra
 *******************************************************************************************************************/
 unsigned int Texture::s_defaultIndex	= 0;
 unsigned int Texture::s_defaultRows		= 1;
+const int Texture::s_maxMipLevels		= 16;
 
 unsigned int Texture::GetDefaultRows() { return s_defaultRows; }
\ No newline at end of file
@@ -3,7 +3,7 @@
 /*******************************************************************************************************************
 	Texture.h, Texture.cpp
 	Created by Kim Kane
-	Last updated: 21/03/2018
+	Last updated: 18/10/2026
 	Class finalized: 02/04/2018
 
 	Generates a 2D texture using the SDL library.
@@ -17,6 +17,7 @@
 	Texture atlases supported.
 	Texture mirroring supported.
 	Cube maps supported.
+	Video memory usage query (every mip level and cube map face), for the editor memory panel.
 
 	[Upcoming]
 	Nothing at present.
@@ -83,6 +84,7 @@ public:
 	int GetWidth() const;
 	int GetHeight() const;
 	int GetRows() const;
+	size_t GetMemoryUsage() const;
 	const glm::vec2& GetOffset();
 	static unsigned int GetDefaultRows();
 
@@ -123,4 +125,5 @@ private:
 private:
 	static unsigned int s_defaultRows;
 	static unsigned int s_defaultIndex;
+	static const int s_maxMipLevels;
 };
\ No newline at end of file
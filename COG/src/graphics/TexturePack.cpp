@@ -146,6 +146,18 @@ void TexturePack::Unbind() const
 }
 
 
+/*******************************************************************************************************************
+	Function that returns the video memory used by all the textures within the m_textures array
+*******************************************************************************************************************/
+size_t TexturePack::GetMemoryUsage() const
+{
+	size_t bytes = 0;
+	for (auto& texture : m_textures) { bytes += GetValue(texture).GetMemoryUsage(); }
+
+	return bytes;
+}
+
+
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
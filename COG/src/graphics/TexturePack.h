@@ -3,7 +3,7 @@
 /*******************************************************************************************************************
 	TexturePack.h, TexturePack.cpp
 	Created by Kim Kane
-	Last updated: 02/04/2018
+	Last updated: 18/10/2026
 
 	A simple class that loads in multiple textures at once and stores them into an array.
 	Prime usage would be for terrain multi-textures.
@@ -72,6 +72,7 @@ public:
 
 public:
 	Texture* GetBlendMap();
+	size_t GetMemoryUsage() const;
 	std::map<Shader::TextureUnit, Texture>* GetTextures() { return &m_textures; }
 
 private:
@@ -0,0 +1,88 @@
+#include <cstring>
+#include <numeric>
+#include "UniformArena.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+UniformArena::UniformArena(size_t alignment)
+	:	m_alignment(s_std140Alignment),
+		m_blockCount(0)
+{
+	SetAlignment(alignment);
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+UniformArena::~UniformArena()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that appends a uniform block to the arena and returns its offset (always a multiple of the alignment)
+*******************************************************************************************************************/
+size_t UniformArena::Append(const void* block, size_t size)
+{
+	size_t offset = Align(m_data.size(), m_alignment);
+
+	//--- Grows with zeroes, so the padding before this block (and at the end of it) is always blank
+	m_data.resize(offset + GetBlockSize(size), 0);
+	std::memcpy(&m_data[offset], block, size);
+
+	m_blockCount++;
+
+	return offset;
+}
+
+
+/*******************************************************************************************************************
+	Function that empties the arena for the next frame (the memory is kept for re-use)
+*******************************************************************************************************************/
+void UniformArena::Clear()
+{
+	m_data.clear();
+	m_blockCount = 0;
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the alignment every block starts on - a multiple of both the alignment passed in and a vec4,
+	as std140 blocks need
+*******************************************************************************************************************/
+void UniformArena::SetAlignment(size_t alignment)
+{
+	m_alignment = (alignment == 0) ? s_std140Alignment : std::lcm(alignment, s_std140Alignment);
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+const unsigned char* UniformArena::GetData() const		{ return m_data.data(); }
+size_t UniformArena::GetSize() const					{ return m_data.size(); }
+size_t UniformArena::GetAlignment() const				{ return m_alignment; }
+unsigned int UniformArena::GetBlockCount() const		{ return m_blockCount; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+//--- OpenGL only promises the offset alignment is at most 256 bytes, so it's the safe choice before we've asked
+const size_t UniformArena::s_defaultAlignment	= 256;
+const size_t UniformArena::s_std140Alignment	= 16;
+
+//--- The alignment doesn't have to be a power of two, so round up by division rather than masking
+size_t UniformArena::Align(size_t offset, size_t alignment)
+{
+	return (alignment == 0) ? offset : (offset + alignment - 1) / alignment * alignment;
+}
+
+//--- A std140 block is rounded up to a whole number of vec4's
+size_t UniformArena::GetBlockSize(size_t size)
+{
+	return Align(size, s_std140Alignment);
+}
\ No newline at end of file
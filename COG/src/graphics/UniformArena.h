@@ -0,0 +1,77 @@
+#pragma once
+
+/*******************************************************************************************************************
+	UniformArena.h, UniformArena.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Packs a frame's worth of uniform blocks (one set per draw) into one array, so they can all be uploaded to a
+	uniform buffer in one go and each draw can bind its own range of it.
+
+	[Features]
+	Append() copies a block to the end of the arena and returns its offset. Every block starts on the offset
+	alignment the GPU asks for (GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT), and takes up a whole number of vec4's, as a
+	std140 block does.
+	Clear() empties the arena without giving up its memory, so a frame only allocates when it needs more room than
+	any frame before it.
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	This class doesn't touch OpenGL - the alignment is passed in, so the packing can be checked without a context.
+	The blocks must already match their std140 layout in the shader (see UniformBlocks.h), the arena only takes
+	care of where each block starts and how much room it is given.
+	The padding between blocks is zeroed, so the same blocks always pack into the same bytes.
+
+*******************************************************************************************************************/
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+class UniformArena {
+
+public:
+	UniformArena(size_t alignment = s_defaultAlignment);
+	~UniformArena();
+
+public:
+	template <typename T> size_t Append(const T& block);
+	size_t Append(const void* block, size_t size);
+	void Clear();
+	void SetAlignment(size_t alignment);
+
+public:
+	const unsigned char*	GetData() const;
+	size_t					GetSize() const;
+	size_t					GetAlignment() const;
+	unsigned int			GetBlockCount() const;
+
+public:
+	static size_t Align(size_t offset, size_t alignment);
+	static size_t GetBlockSize(size_t size);
+
+private:
+	UniformArena(const UniformArena&)				= delete;
+	UniformArena& operator=(const UniformArena&)	= delete;
+
+private:
+	std::vector<unsigned char>	m_data;
+	size_t						m_alignment;
+	unsigned int				m_blockCount;
+
+private:
+	static const size_t s_defaultAlignment;
+	static const size_t s_std140Alignment;
+};
+
+
+/*******************************************************************************************************************
+	A template function that appends a uniform block struct to the arena and returns its offset
+*******************************************************************************************************************/
+template <typename T> size_t UniformArena::Append(const T& block)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Uniform blocks are copied byte for byte, so must be trivially copyable");
+
+	return Append(&block, sizeof(T));
+}
\ No newline at end of file
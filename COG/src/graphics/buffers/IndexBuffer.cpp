@@ -1,5 +1,6 @@
 #include "IndexBuffer.h"
 #include "utilities/Log.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
@@ -18,6 +19,7 @@ IndexBuffer::IndexBuffer()
 IndexBuffer::~IndexBuffer()
 {
 	COG_GLCALL(glDeleteBuffers(1, &m_indexBufferObject));
+	GLState::Instance()->ForgetBuffer(m_indexBufferObject);
 
 	COG_LOG("[INDEX BUFFER] Index buffer object destroyed: ", m_indexBufferObject, LOG_MEMORY);
 }
@@ -28,7 +30,7 @@ IndexBuffer::~IndexBuffer()
 *******************************************************************************************************************/
 void IndexBuffer::Bind() const
 {
-	COG_GLCALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferObject));
+	GLState::Instance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferObject);
 }
 
 
@@ -37,7 +39,7 @@ void IndexBuffer::Bind() const
 *******************************************************************************************************************/
 void IndexBuffer::Unbind() const
 {
-	COG_GLCALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+	GLState::Instance()->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 
@@ -50,6 +52,15 @@ void IndexBuffer::Render(GLenum mode) const
 }
 
 
+/*******************************************************************************************************************
+	A function that renders the indexed buffer data to the screen once for each instance
+*******************************************************************************************************************/
+void IndexBuffer::RenderInstanced(GLsizei instances, GLenum mode) const
+{
+	COG_GLCALL(glDrawElementsInstanced(mode, m_indexCount, GL_UNSIGNED_INT, nullptr, instances));
+}
+
+
 /*******************************************************************************************************************
 	A function that pushes all the passed in indexed data to the GPU for rendering
 *******************************************************************************************************************/
@@ -52,6 +52,7 @@ public:
 
 public:
 	void Render(GLenum mode = GL_TRIANGLES) const;
+	void RenderInstanced(GLsizei instances, GLenum mode = GL_TRIANGLES) const;
 	bool Push(const std::vector<GLuint>& data, bool dynamic = false);
 
 private:
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include "InstanceBuffer.h"
+#include "utilities/Log.h"
+#include "cache/StateCache.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+InstanceBuffer::InstanceBuffer()
+	:	m_instanceBufferObject(0)
+{
+	GenerateBufferObject();
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+InstanceBuffer::~InstanceBuffer()
+{
+	COG_GLCALL(glDeleteBuffers(1, &m_instanceBufferObject));
+	GLState::Instance()->ForgetBuffer(m_instanceBufferObject);
+
+	COG_LOG("[INSTANCE BUFFER] Instance buffer object destroyed: ", m_instanceBufferObject, LOG_MEMORY);
+}
+
+
+/*******************************************************************************************************************
+	Binds the instance buffer object ID & makes it the active buffer
+*******************************************************************************************************************/
+void InstanceBuffer::Bind() const
+{
+	GLState::Instance()->BindBuffer(GL_ARRAY_BUFFER, m_instanceBufferObject);
+}
+
+
+/*******************************************************************************************************************
+	Unbinds the instance buffer object ID & makes it disactive
+*******************************************************************************************************************/
+void InstanceBuffer::Unbind() const
+{
+	GLState::Instance()->BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+
+/*******************************************************************************************************************
+	A function that uploads a whole frame of instances to the GPU
+*******************************************************************************************************************/
+void InstanceBuffer::Push(const std::vector<PackedInstance>& data)
+{
+	if (data.empty()) { return; }
+
+	Bind();
+
+	//--- NOTE
+	// Giving glBufferData new storage every frame (rather than glBufferSubData into the old one) lets the driver
+	// hand us fresh memory while the GPU is still reading last frame's instances, instead of waiting for it.
+	//---
+	COG_GLCALL(glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(PackedInstance), &data.front(), GL_STREAM_DRAW));
+}
+
+
+/*******************************************************************************************************************
+	A function that points the instance attributes of the bound VAO at the instance 'first' within this buffer
+*******************************************************************************************************************/
+void InstanceBuffer::Attach(unsigned int first) const
+{
+	Bind();
+
+	size_t base = first * sizeof(PackedInstance);
+
+	//--- A matrix attribute takes one location per column
+	for (unsigned int column = 0; column < 4; column++) {
+		DefineAttributeData(ATTRIBUTE_WORLD + column, 4, base + offsetof(PackedInstance, world) + column * sizeof(glm::vec4));
+	}
+
+	for (unsigned int column = 0; column < 3; column++) {
+		DefineAttributeData(ATTRIBUTE_NORMAL + column, 3, base + offsetof(PackedInstance, normal) + column * sizeof(glm::vec3));
+	}
+
+	DefineAttributeData(ATTRIBUTE_SHININESS, 1, base + offsetof(PackedInstance, shininess));
+}
+
+
+/*******************************************************************************************************************
+	Function that defines a per-instance vertex attribute & enables the layout location of the data
+*******************************************************************************************************************/
+void InstanceBuffer::DefineAttributeData(unsigned int location, int size, size_t offset) const
+{
+	COG_GLCALL(glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, sizeof(PackedInstance), (size_t*)offset));
+	COG_GLCALL(glEnableVertexAttribArray(location));
+	COG_GLCALL(glVertexAttribDivisor(location, 1));
+}
+
+
+/*******************************************************************************************************************
+	Generate the buffer objects ID
+*******************************************************************************************************************/
+void InstanceBuffer::GenerateBufferObject()
+{
+	COG_GLCALL(glGenBuffers(1, &m_instanceBufferObject));
+
+	COG_LOG("[INSTANCE BUFFER] Instance buffer object created: ", m_instanceBufferObject, LOG_MEMORY);
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+/*******************************************************************************************************************
+	InstanceBuffer.h, InstanceBuffer.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A streaming VBO holding a whole frame of per-instance entity data, drawn from with instanced draw calls.
+
+	[Features]
+	Push() uploads every instance of the frame in one go, orphaning last frame's storage so we never wait on the GPU
+	to finish reading it.
+	Attach() points the instance attributes of the bound VAO at any instance within the buffer, so each batch can
+	draw its own slice of the one buffer.
+
+	[Upcoming]
+	Persistently mapped storage, once we move past OpenGL 4.0.
+
+	[Side Notes]
+	Attribute locations 5 to 12 follow on from VertexBuffer::LayoutType - the world matrix takes 4 locations (one per
+	column), the normal matrix 3, and the shininess 1. They're advanced once per instance (divisor 1).
+	Attach() changes VAO state, so bind the VAO you're going to draw first.
+
+*******************************************************************************************************************/
+#include <pretty_opengl/glew.h>
+#include <vector>
+#include "graphics/buffers/PackedInstance.h"
+
+class InstanceBuffer {
+
+public:
+	enum Attribute : unsigned int { ATTRIBUTE_WORLD = 5, ATTRIBUTE_NORMAL = 9, ATTRIBUTE_SHININESS = 12 };
+
+public:
+	InstanceBuffer();
+	~InstanceBuffer();
+
+public:
+	void Bind() const;
+	void Unbind() const;
+
+public:
+	void Push(const std::vector<PackedInstance>& data);
+	void Attach(unsigned int first) const;
+
+private:
+	InstanceBuffer(InstanceBuffer const&)	= delete;
+	void operator=(InstanceBuffer const&)	= delete;
+
+private:
+	void GenerateBufferObject();
+	void DefineAttributeData(unsigned int location, int size, size_t offset) const;
+
+private:
+	GLuint m_instanceBufferObject;
+};
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+/*******************************************************************************************************************
+	PackedInstance.h
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	The per-instance layout used by instanced entity draws - see InstanceBuffer and InstanceBatcher.
+
+	[Side Notes]
+	Lives in its own header with no OpenGL dependencies (like PackedVertex), so instances can be built and tested
+	without GLEW. Every member is made of floats, so the struct is tightly packed (104 bytes).
+	The entity vertex shader reads it from attribute locations 5 to 12 (see InstanceBuffer::Attribute).
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+
+struct PackedInstance {
+	glm::mat4	world;
+	glm::mat3	normal;
+	float		shininess;
+};
\ No newline at end of file
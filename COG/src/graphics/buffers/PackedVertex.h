@@ -0,0 +1,27 @@
+#pragma once
+
+/*******************************************************************************************************************
+	PackedVertex.h
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	The common vertex layout used by models and the terrain - see VertexBuffer::Push(std::vector<PackedVertex>).
+
+	[Side Notes]
+	Lives in its own header with no OpenGL dependencies, so code that only builds vertex data (e.g. the headless
+	terrain baker) doesn't need to pull in GLEW. VertexBuffer::PackedVertex is a typedef of this struct.
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <cstring>
+
+struct PackedVertex {
+	glm::vec3 position;
+	glm::vec2 textureCoord;
+	glm::vec3 normal;
+	glm::vec3 tangent;
+	glm::vec3 bitangent;
+	bool operator<(const PackedVertex that) const {
+		return memcmp((void*)this, (void*)&that, sizeof(PackedVertex))>0;
+	};
+};
\ No newline at end of file
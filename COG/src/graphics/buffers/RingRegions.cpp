@@ -0,0 +1,86 @@
+#include <algorithm>
+#include "RingRegions.h"
+#include "graphics/UniformArena.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members. The last region is current to begin
+	with, so the first Advance() starts at the first one
+*******************************************************************************************************************/
+RingRegions::RingRegions(unsigned int count, size_t alignment, size_t minRegionSize)
+	:	m_isFenced(std::max(count, 1u), false),
+		m_alignment(std::max(alignment, (size_t)1)),
+		m_minRegionSize(minRegionSize),
+		m_regionSize(0),
+		m_region(std::max(count, 1u) - 1)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+RingRegions::~RingRegions()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that moves on to the next region for an upload of 'size' bytes. Returns true if every region had to
+	grow first, in which case the buffer needs new storage (see GetSize()) and every fence has been dropped
+*******************************************************************************************************************/
+bool RingRegions::Advance(size_t size)
+{
+	m_region = (m_region + 1) % GetCount();
+
+	if (size <= m_regionSize) { return false; }
+
+	size_t regionSize = std::max(std::max(m_regionSize, m_minRegionSize), (size_t)1);
+	while (regionSize < size) { regionSize *= 2; }
+
+	m_regionSize = UniformArena::Align(regionSize, m_alignment);
+	m_isFenced.assign(m_isFenced.size(), false);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that marks the current region as being read by the GPU, until it's unfenced
+*******************************************************************************************************************/
+void RingRegions::Fence()
+{
+	m_isFenced[m_region] = true;
+}
+
+
+/*******************************************************************************************************************
+	Function that marks a region as finished with by the GPU, so it can be written to again
+*******************************************************************************************************************/
+void RingRegions::Unfence(unsigned int region)
+{
+	if (region < m_isFenced.size()) { m_isFenced[region] = false; }
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the alignment every region starts on. Only takes effect the next time the regions grow, as
+	the regions already handed out can't move
+*******************************************************************************************************************/
+void RingRegions::SetAlignment(size_t alignment)
+{
+	m_alignment = std::max(alignment, (size_t)1);
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+bool RingRegions::IsFenced(unsigned int region) const	{ return region < m_isFenced.size() && m_isFenced[region]; }
+unsigned int RingRegions::GetRegion() const				{ return m_region; }
+unsigned int RingRegions::GetCount() const				{ return (unsigned int)m_isFenced.size(); }
+size_t RingRegions::GetStart() const					{ return m_region * m_regionSize; }
+size_t RingRegions::GetRegionSize() const				{ return m_regionSize; }
+size_t RingRegions::GetSize() const						{ return m_regionSize * m_isFenced.size(); }
+size_t RingRegions::GetAlignment() const				{ return m_alignment; }
\ No newline at end of file
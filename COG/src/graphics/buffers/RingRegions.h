@@ -0,0 +1,62 @@
+#pragma once
+
+/*******************************************************************************************************************
+	RingRegions.h, RingRegions.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	The bookkeeping of a buffer split into regions that are written in turn, one per frame in flight - which
+	region is next, where it starts, when every region has to grow, and which regions the GPU may still be reading.
+
+	[Features]
+	Advance() moves on to the next region (wrapping back to the first), growing every region first (doubling) if
+	the upload doesn't fit.
+	Every region starts on the offset alignment, so offsets that are aligned within a region stay aligned in the
+	buffer.
+	Fence() marks the current region as in use by the GPU, IsFenced() tells the owner to wait on it before writing
+	to it again, and Unfence() once it has.
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	This class doesn't touch OpenGL (like UniformArena), so the ring's behaviour can be checked without a context -
+	UniformRingBuffer owns the buffer and the fence objects, and asks this class what to do with them.
+	Growing gives the buffer new storage, so every fence is dropped - the old storage is the driver's problem.
+
+*******************************************************************************************************************/
+#include <cstddef>
+#include <vector>
+
+class RingRegions {
+
+public:
+	RingRegions(unsigned int count, size_t alignment = 1, size_t minRegionSize = 0);
+	~RingRegions();
+
+public:
+	bool Advance(size_t size);
+	void Fence();
+	void Unfence(unsigned int region);
+	void SetAlignment(size_t alignment);
+
+public:
+	bool			IsFenced(unsigned int region) const;
+	unsigned int	GetRegion() const;
+	unsigned int	GetCount() const;
+	size_t			GetStart() const;
+	size_t			GetRegionSize() const;
+	size_t			GetSize() const;
+	size_t			GetAlignment() const;
+
+private:
+	RingRegions(const RingRegions&)				= delete;
+	RingRegions& operator=(const RingRegions&)	= delete;
+
+private:
+	std::vector<bool>	m_isFenced;
+	size_t				m_alignment;
+	size_t				m_minRegionSize;
+	size_t				m_regionSize;
+	unsigned int		m_region;
+};
\ No newline at end of file
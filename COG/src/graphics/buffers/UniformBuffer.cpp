@@ -1,10 +1,12 @@
 #include "UniformBuffer.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
 *******************************************************************************************************************/
 UniformBuffer::UniformBuffer()
-	:	m_uniformBufferObject(0)
+	:	m_uniformBufferObject(0),
+		m_binding(0)
 {
 	GenerateBufferObject();
 }
@@ -16,6 +18,7 @@ UniformBuffer::UniformBuffer()
 UniformBuffer::~UniformBuffer()
 {
 	COG_GLCALL(glDeleteBuffers(1, &m_uniformBufferObject));
+	GLState::Instance()->ForgetBuffer(m_uniformBufferObject);
 
 	COG_LOG("[UNIFORM BUFFER] Uniform buffer object destroyed: ", m_uniformBufferObject, LOG_MEMORY);
 }
@@ -36,7 +39,20 @@ void UniformBuffer::Push(GLsizeiptr byteSize, GLuint binding, bool dynamic)
 	Unbind();
 
 	//--- Bind this UBO to the binding number we have selected
-	COG_GLCALL(glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_uniformBufferObject));
+	m_binding = binding;
+	Rebind();
+}
+
+
+/*******************************************************************************************************************
+	A function that binds this UBO (the whole of it) to its binding number again
+*******************************************************************************************************************/
+void UniformBuffer::Rebind() const
+{
+	COG_GLCALL(glBindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_uniformBufferObject));
+
+	//--- Binding to an index also binds to the target itself, so the state cache can't trust what it had
+	GLState::Instance()->ForgetBufferTarget(GL_UNIFORM_BUFFER);
 }
 
 
@@ -56,7 +72,7 @@ void UniformBuffer::GenerateBufferObject()
 *******************************************************************************************************************/
 void UniformBuffer::Bind() const
 {
-	COG_GLCALL(glBindBuffer(GL_UNIFORM_BUFFER, m_uniformBufferObject));
+	GLState::Instance()->BindBuffer(GL_UNIFORM_BUFFER, m_uniformBufferObject);
 }
 
 
@@ -65,5 +81,5 @@ void UniformBuffer::Bind() const
 *******************************************************************************************************************/
 void UniformBuffer::Unbind() const
 {
-	COG_GLCALL(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+	GLState::Instance()->BindBuffer(GL_UNIFORM_BUFFER, 0);
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 	[Features]
 	Nothing fancy.
+	Rebind() puts the UBO back on its binding point after something else was bound there (see UniformRingBuffer).
 
 	[Upcoming]
 	Nothing at present.
@@ -51,6 +52,7 @@ public:
 
 public:
 	void Push(GLsizeiptr byteSize, GLuint binding, bool dynamic = false);
+	void Rebind() const;
 	
 public:	
 	template <typename T> void Update(const T* data);
@@ -64,11 +66,13 @@ private:
 
 private:
 	GLuint m_uniformBufferObject;
+	GLuint m_binding;
 };
 
 
 /*******************************************************************************************************************
-	A template function that updates already existing data stored within the GPU
+	A template function that updates already existing data stored within the GPU. The UBO is left bound, so
+	updating the same UBO again (e.g. every frame) doesn't need to bind it again
 *******************************************************************************************************************/
 template <typename T> void UniformBuffer::Update(const T* data)
 {
@@ -77,7 +81,4 @@ template <typename T> void UniformBuffer::Update(const T* data)
 
 	//--- Update the data
 	COG_GLCALL(glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(T), data));
-
-	//--- Unbind the UBO
-	Unbind();
 }
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include <cstring>
+#include "UniformRingBuffer.h"
+#include "utilities/Log.h"
+#include "cache/StateCache.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+UniformRingBuffer::UniformRingBuffer()
+	:	m_uniformBufferObject(0),
+		m_regions(REGION_COUNT, 256, s_minRegionSize),
+		m_fences()
+{
+	GenerateBufferObject();
+
+	//--- Every block bound with glBindBufferRange must start on a multiple of this (256 is the most it can be)
+	GLint alignment = 0;
+	COG_GLCALL(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+	if (alignment > 0) { m_regions.SetAlignment((size_t)alignment); }
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+UniformRingBuffer::~UniformRingBuffer()
+{
+	for (auto& fence : m_fences) {
+		if (fence) { COG_GLCALL(glDeleteSync(fence)); fence = nullptr; }
+	}
+
+	COG_GLCALL(glDeleteBuffers(1, &m_uniformBufferObject));
+	GLState::Instance()->ForgetBuffer(m_uniformBufferObject);
+
+	COG_LOG("[UNIFORM RING BUFFER] Uniform ring buffer object destroyed: ", m_uniformBufferObject, LOG_MEMORY);
+}
+
+
+/*******************************************************************************************************************
+	Binds the uniform buffer object ID & makes it the active buffer
+*******************************************************************************************************************/
+void UniformRingBuffer::Bind() const
+{
+	GLState::Instance()->BindBuffer(GL_UNIFORM_BUFFER, m_uniformBufferObject);
+}
+
+
+/*******************************************************************************************************************
+	Unbinds the uniform buffer object ID & makes it disactive
+*******************************************************************************************************************/
+void UniformRingBuffer::Unbind() const
+{
+	GLState::Instance()->BindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+
+/*******************************************************************************************************************
+	A function that uploads a whole frame's arena of uniform blocks into the next region of the buffer
+*******************************************************************************************************************/
+bool UniformRingBuffer::Upload(const UniformArena& arena)
+{
+	if (arena.GetSize() == 0) { return false; }
+
+	//--- Every region is made bigger if this frame doesn't fit, which gives the buffer new storage
+	if (m_regions.Advance(arena.GetSize())) { Reserve(); }
+
+	unsigned int region = m_regions.GetRegion();
+
+	WaitForRegion(region);
+
+	Bind();
+
+	//--- NOTE
+	// The fence has told us the GPU is done with this region, so it's safe to map it unsynchronized - the driver
+	// doesn't have to wait on (or make a copy for) the draws still reading the other two regions.
+	//---
+	void* memory = nullptr;
+	COG_GLCALL(memory = glMapBufferRange(GL_UNIFORM_BUFFER, m_regions.GetStart(), arena.GetSize(),
+										 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+
+	if (!memory) {
+		COG_LOG("[UNIFORM RING BUFFER] Could not map region for writing: ", region, LOG_ERROR); return false;
+	}
+
+	std::memcpy(memory, arena.GetData(), arena.GetSize());
+
+	GLboolean isIntact = GL_TRUE;
+	COG_GLCALL(isIntact = glUnmapBuffer(GL_UNIFORM_BUFFER));
+
+	if (isIntact == GL_FALSE) {
+		COG_LOG("[UNIFORM RING BUFFER] Region was corrupted while mapped: ", region, LOG_ERROR); return false;
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that binds one block of this frame's upload (offset and size from the arena) to a binding point
+*******************************************************************************************************************/
+void UniformRingBuffer::BindRange(GLuint binding, size_t offset, size_t size) const
+{
+	COG_GLCALL(glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_uniformBufferObject, m_regions.GetStart() + offset, size));
+
+	//--- Binding to an index also binds to the target itself, so the state cache can't trust what it had
+	GLState::Instance()->ForgetBufferTarget(GL_UNIFORM_BUFFER);
+}
+
+
+/*******************************************************************************************************************
+	A function that marks the end of the draws reading this frame's region, so it isn't written again too soon
+*******************************************************************************************************************/
+void UniformRingBuffer::Fence()
+{
+	unsigned int region = m_regions.GetRegion();
+
+	if (m_fences[region]) { COG_GLCALL(glDeleteSync(m_fences[region])); }
+
+	COG_GLCALL(m_fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+	m_regions.Fence();
+}
+
+
+/*******************************************************************************************************************
+	A function that waits for the GPU to finish with a region (if it hasn't already)
+*******************************************************************************************************************/
+void UniformRingBuffer::WaitForRegion(unsigned int region)
+{
+	if (!m_regions.IsFenced(region) || !m_fences[region]) { return; }
+
+	GLenum result = GL_TIMEOUT_EXPIRED;
+
+	while (result == GL_TIMEOUT_EXPIRED) {
+		COG_GLCALL(result = glClientWaitSync(m_fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, s_fenceTimeout));
+	}
+
+	COG_GLCALL(glDeleteSync(m_fences[region]));
+	m_fences[region] = nullptr;
+
+	m_regions.Unfence(region);
+}
+
+
+/*******************************************************************************************************************
+	A function that gives the buffer new storage, with room for every region at their new size
+*******************************************************************************************************************/
+void UniformRingBuffer::Reserve()
+{
+	//--- The old storage (and whatever is still reading it) is left to the driver, so the fences no longer apply
+	for (auto& fence : m_fences) {
+		if (fence) { COG_GLCALL(glDeleteSync(fence)); fence = nullptr; }
+	}
+
+	Bind();
+
+	COG_GLCALL(glBufferData(GL_UNIFORM_BUFFER, m_regions.GetSize(), NULL, GL_STREAM_DRAW));
+
+	COG_LOG("[UNIFORM RING BUFFER] Region size increased to: ", m_regions.GetRegionSize(), LOG_MEMORY);
+}
+
+
+/*******************************************************************************************************************
+	Generate the buffer objects ID
+*******************************************************************************************************************/
+void UniformRingBuffer::GenerateBufferObject()
+{
+	COG_GLCALL(glGenBuffers(1, &m_uniformBufferObject));
+
+	COG_LOG("[UNIFORM RING BUFFER] Uniform ring buffer object created: ", m_uniformBufferObject, LOG_MEMORY);
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+size_t UniformRingBuffer::GetOffsetAlignment() const	{ return m_regions.GetAlignment(); }
+size_t UniformRingBuffer::GetRegionSize() const			{ return m_regions.GetRegionSize(); }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const size_t	UniformRingBuffer::s_minRegionSize	= 16384;
+const GLuint64	UniformRingBuffer::s_fenceTimeout	= 1000000;	// Nanoseconds (1 ms), before checking again
\ No newline at end of file
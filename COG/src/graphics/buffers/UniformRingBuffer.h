@@ -0,0 +1,73 @@
+#pragma once
+
+/*******************************************************************************************************************
+	UniformRingBuffer.h, UniformRingBuffer.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A UBO split into three regions, one per frame in flight, that a whole UniformArena is uploaded into at once.
+	Draws then bind their own block of it to a binding point with BindRange().
+
+	[Features]
+	One upload per frame (a mapped write of the whole arena), instead of a bind, glBufferSubData and unbind for
+	every block of every draw.
+	Each frame writes to the next region in turn, and a fence is set after the draws reading it, so a region is
+	only written again once the GPU has finished with it (three frames later, so it's normally done already).
+	The buffer grows (doubling) when a frame's arena no longer fits in a region.
+
+	[Upcoming]
+	Persistently mapped storage, once we move past OpenGL 4.0.
+
+	[Side Notes]
+	Binding a range to an index also binds the buffer to GL_UNIFORM_BUFFER itself, so the state cache is told to
+	forget that target, the same as UniformBuffer::Push() does.
+	Block offsets come from the arena and are relative to the region, BindRange() adds on where the region starts.
+	Call Fence() once every draw using this frame's upload has been issued.
+	Which region is next, where it starts and when it must be waited on is worked out by RingRegions (which doesn't
+	need OpenGL, so it can be tested) - this class only owns the buffer and the fence objects.
+
+*******************************************************************************************************************/
+#include <pretty_opengl/glew.h>
+#include "graphics/UniformArena.h"
+#include "graphics/buffers/RingRegions.h"
+
+class UniformRingBuffer {
+
+public:
+	UniformRingBuffer();
+	~UniformRingBuffer();
+
+public:
+	void Bind() const;
+	void Unbind() const;
+
+public:
+	bool Upload(const UniformArena& arena);
+	void BindRange(GLuint binding, size_t offset, size_t size) const;
+	void Fence();
+
+public:
+	size_t GetOffsetAlignment() const;
+	size_t GetRegionSize() const;
+
+private:
+	UniformRingBuffer(UniformRingBuffer const&)	= delete;
+	void operator=(UniformRingBuffer const&)	= delete;
+
+private:
+	void GenerateBufferObject();
+	void Reserve();
+	void WaitForRegion(unsigned int region);
+
+private:
+	enum { REGION_COUNT = 3 };
+
+private:
+	GLuint		m_uniformBufferObject;
+	RingRegions	m_regions;
+	GLsync		m_fences[REGION_COUNT];
+
+private:
+	static const size_t		s_minRegionSize;
+	static const GLuint64	s_fenceTimeout;
+};
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "VertexArray.h"
 #include "utilities/Log.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
@@ -17,6 +18,7 @@ VertexArray::VertexArray()
 VertexArray::~VertexArray()
 {
 	COG_GLCALL(glDeleteVertexArrays(1, &m_arrayObject));
+	GLState::Instance()->ForgetVertexArray(m_arrayObject);
 
 	COG_LOG("[VERTEX ARRAY] Vertex array object destroyed: ", m_arrayObject, LOG_MEMORY);
 }
@@ -27,7 +29,7 @@ VertexArray::~VertexArray()
 *******************************************************************************************************************/
 void VertexArray::Bind() const
 {
-	COG_GLCALL(glBindVertexArray(m_arrayObject));
+	GLState::Instance()->BindVertexArray(m_arrayObject);
 }
 
 
@@ -36,7 +38,7 @@ void VertexArray::Bind() const
 *******************************************************************************************************************/
 void VertexArray::Unbind() const
 {
-	COG_GLCALL(glBindVertexArray(0));
+	GLState::Instance()->BindVertexArray(0);
 }
 
 
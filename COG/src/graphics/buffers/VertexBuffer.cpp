@@ -1,4 +1,5 @@
 #include "VertexBuffer.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
@@ -17,6 +18,7 @@ VertexBuffer::VertexBuffer()
 VertexBuffer::~VertexBuffer()
 {
 	COG_GLCALL(glDeleteBuffers(1, &m_vertexBufferObject));
+	GLState::Instance()->ForgetBuffer(m_vertexBufferObject);
 
 	COG_LOG("[VERTEX BUFFER] Vertex buffer object destroyed: ", m_vertexBufferObject, LOG_MEMORY);
 }
@@ -27,7 +29,7 @@ VertexBuffer::~VertexBuffer()
 *******************************************************************************************************************/
 void VertexBuffer::Bind() const
 {
-	COG_GLCALL(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferObject));
+	GLState::Instance()->BindBuffer(GL_ARRAY_BUFFER, m_vertexBufferObject);
 }
 
 
@@ -36,7 +38,7 @@ void VertexBuffer::Bind() const
 *******************************************************************************************************************/
 void VertexBuffer::Unbind() const
 {
-	COG_GLCALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+	GLState::Instance()->BindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 
@@ -49,6 +51,15 @@ void VertexBuffer::Render(GLenum mode) const
 }
 
 
+/*******************************************************************************************************************
+	A function that renders a range of the vertex buffer data to the screen
+*******************************************************************************************************************/
+void VertexBuffer::Render(GLint first, GLsizei count, GLenum mode) const
+{
+	COG_GLCALL(glDrawArrays(mode, first, count));
+}
+
+
 /*******************************************************************************************************************
 	A function that pushes interleaved vertex data to the GPU (there is also a template rendition of this function)
 *******************************************************************************************************************/
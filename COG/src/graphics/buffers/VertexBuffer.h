@@ -12,6 +12,7 @@
 	Supports an std::vector container of T data to send to the GPU, where T is templated data.
 	Also added support for common vertex data - See PackedVertex struct within this class.
 	Ability to switch between render modes at run time and push dynamic/static data to the GPU.
+	Ranges of a buffer can be updated and drawn on their own, so one buffer can hold many meshes (see Text).
 
 	[Upcoming]
 	Nothing at present.
@@ -43,6 +44,7 @@
 #include <vector>
 #include <map>
 
+#include "graphics/buffers/PackedVertex.h"
 #include "utilities/Log.h"
 
 class VertexBuffer {
@@ -55,16 +57,7 @@ public:
 	~VertexBuffer();
 
 public:
-	struct PackedVertex {
-		glm::vec3 position;
-		glm::vec2 textureCoord;
-		glm::vec3 normal;
-		glm::vec3 tangent;
-		glm::vec3 bitangent;
-		bool operator<(const PackedVertex that) const {
-			return memcmp((void*)this, (void*)&that, sizeof(PackedVertex))>0;
-		};
-	};
+	typedef ::PackedVertex PackedVertex;
 
 public:
 	void Bind() const;
@@ -72,6 +65,7 @@ public:
 
 public:
 	void Render(GLenum mode = GL_TRIANGLES) const;
+	void Render(GLint first, GLsizei count, GLenum mode = GL_TRIANGLES) const;
 
 public:
 	bool Push(const std::vector<PackedVertex>& data, bool dynamic);
@@ -79,6 +73,7 @@ public:
 public:
 	template <typename T> bool Push(const std::vector<T>& data, LayoutType layoutType, bool dynamic, int dataType = GL_FLOAT);
 	template <typename T> bool Update(const std::vector<T>& data);
+	template <typename T> bool Update(const std::vector<T>& data, size_t first, size_t count);
 
 private:
 	VertexBuffer(VertexBuffer const&)	= delete;
@@ -144,5 +139,29 @@ template <typename T> bool VertexBuffer::Update(const std::vector<T>& data)
 	//--- Unbind the VBO
 	Unbind();
 
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A template function that updates part of the already existing data stored within the GPU - count elements of
+	data (not vertices), starting at element first
+*******************************************************************************************************************/
+template <typename T> bool VertexBuffer::Update(const std::vector<T>& data, size_t first, size_t count)
+{
+	//--- Make sure the range is within the data before doing anything
+	if (count == 0 || first + count > data.size()) {
+		COG_LOG("[BUFFER] Update range is outside of the vertex data", COG_LOG_EMPTY, LOG_ERROR); return false;
+	}
+
+	//--- Bind VBO
+	Bind();
+
+	//--- Push just this range to the same place in the GPU's copy
+	COG_GLCALL(glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(T), count * sizeof(T), &data[first]));
+
+	//--- Unbind the VBO
+	Unbind();
+
 	return true;
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <limits>
 #include "EntityShader.h"
 #include "utilities/Log.h"
 #include "managers/ScreenManager.h"
@@ -5,12 +6,15 @@
 #include "physics/Transform.h"
 #include "graphics/Texture.h"
 #include "graphics/Material.h"
+#include "graphics/buffers/InstanceBuffer.h"
 
 /*******************************************************************************************************************
 	Default Constructor
 *******************************************************************************************************************/
 EntityShader::EntityShader(const std::string& vertex, const std::string& fragment, Camera* camera)
-	:	Shader(vertex, fragment, camera)
+	:	Shader(vertex, fragment, camera),
+		m_isUploaded(false),
+		m_isInstancingSupported(false)
 {
 	//--- Check we have a valid program
 	if (m_shaderCount != NULL) {
@@ -51,6 +55,10 @@ void EntityShader::GetAllUniforms()
 	GetUniformBlock("uniform_block_entity_lightData", sizeof(uniform_block::LightData), BIND_ENTITY_LIGHT_DATA);
 	GetUniformBlock("uniform_block_entity_materialData", sizeof(uniform_block::MaterialData), BIND_ENTITY_MATERIAL_DATA);
 
+	//--- Switches between instanced and single draws, a shader without both the switch and the instance attributes
+	//--- can only do single draws
+	m_isInstancingSupported = GetUniform("uniform_entity_isInstanced") && HasAttribute(InstanceBuffer::ATTRIBUTE_WORLD);
+
 	//--- DEBUG TOOLS
 	GetUniform("uniform_entity_debugMode");
 }
@@ -61,7 +69,7 @@ void EntityShader::GetAllUniforms()
 *******************************************************************************************************************/
 void EntityShader::DebugMode(bool enableDebugSettings)
 {
-	SetBool("uniform_entity_debugMode", enableDebugSettings);
+	SetBool(COG_UNIFORM("uniform_entity_debugMode"), enableDebugSettings);
 }
 
 
@@ -76,10 +84,10 @@ void EntityShader::SetPermanentAttributes()
 	SetFogData(FOG_EXP, IS_FOG_RANGED, FOG_DENSITY, FOG_COLOR);
 
 	//--- Set the entity samplers once as these never change
-	SetInteger("uniform_entity_material.diffuse", TEXTURE_DIFFUSE);
-	SetInteger("uniform_entity_material.specular", TEXTURE_SPECULAR);
-	SetInteger("uniform_entity_material.emission", TEXTURE_EMISSIVE);
-	SetInteger("uniform_entity_material.normal", TEXTURE_NORMAL);
+	SetInteger(COG_UNIFORM("uniform_entity_material.diffuse"), TEXTURE_DIFFUSE);
+	SetInteger(COG_UNIFORM("uniform_entity_material.specular"), TEXTURE_SPECULAR);
+	SetInteger(COG_UNIFORM("uniform_entity_material.emission"), TEXTURE_EMISSIVE);
+	SetInteger(COG_UNIFORM("uniform_entity_material.normal"), TEXTURE_NORMAL);
 }
 
 
@@ -89,24 +97,149 @@ void EntityShader::SetPermanentAttributes()
 void EntityShader::SetInstanceData(Transform* transform, Material* material)
 {
 	if (m_shaderCount != NULL) {
-		SetMatrixData(transform);
+		if (transform) { SetMatrixData(transform->GetRenderMatrix()); }
 		SetMaterialData(material);
 	}
 }
 
 
+/*******************************************************************************************************************
+	A function that starts packing the uniform blocks of a new frame's batches. The projection and view are the same
+	for every batch, so they're brought up to date once here - instanced batches read them from the matrix UBO, and
+	single draws (AddDraw()) copy them into their own matrix blocks
+*******************************************************************************************************************/
+void EntityShader::BeginBatches()
+{
+	if (m_shaderCount != NULL) { SetMatrixData(m_matrixData.world); }
+
+	m_arena.SetAlignment(m_uniformRing.GetOffsetAlignment());
+	m_arena.Clear();
+	m_batchBlocks.clear();
+	m_isUploaded = false;
+}
+
+
+/*******************************************************************************************************************
+	A function that packs the material and texture blocks of the next batch into the arena (batches are numbered in
+	the order they're added). A batch without a material or texture keeps the one before it, as a single draw would
+*******************************************************************************************************************/
+void EntityShader::AddBatch(Material* material)
+{
+	if (material) {
+		FillMaterialData(material);
+		FillTextureData(material->GetDiffuse());
+	}
+
+	m_batchBlocks.push_back({ s_noBlock, m_arena.Append(m_materialData), m_arena.Append(m_textureData) });
+}
+
+
+/*******************************************************************************************************************
+	A function that packs the matrix, material and texture blocks of a single draw into the arena, as the next batch.
+	Only the world and normal matrices differ from draw to draw, the projection and view were set in BeginBatches()
+*******************************************************************************************************************/
+void EntityShader::AddDraw(const glm::mat4& world, Material* material)
+{
+	uniform_block::MatrixData matrixData = m_matrixData;
+	matrixData.world		= world;
+	matrixData.intraWorld	= glm::transpose(glm::inverse(world));
+
+	size_t matrix = m_arena.Append(matrixData);
+
+	if (material) {
+		FillMaterialData(material);
+		FillTextureData(material->GetDiffuse());
+	}
+
+	m_batchBlocks.push_back({ matrix, m_arena.Append(m_materialData), m_arena.Append(m_textureData) });
+}
+
+
+/*******************************************************************************************************************
+	A function that uploads every batch's blocks to the GPU in one go
+*******************************************************************************************************************/
+void EntityShader::UploadBatches()
+{
+	m_isUploaded = m_uniformRing.Upload(m_arena);
+}
+
+
+/*******************************************************************************************************************
+	A function that set's the data of a batch (or single draw) - its blocks are already on the GPU (see AddBatch() and
+	AddDraw()), so they only need binding. An instanced batch has no matrix block, it uses the one BeginBatches() set
+*******************************************************************************************************************/
+void EntityShader::SetBatchData(unsigned int batch)
+{
+	if (m_shaderCount != NULL && batch < m_batchBlocks.size()) {
+
+		const BatchBlocks& blocks = m_batchBlocks[batch];
+
+		if (m_isUploaded) {
+			if (blocks.matrix != s_noBlock) {
+				m_uniformRing.BindRange(BIND_ENTITY_MATRIX_DATA, blocks.matrix, sizeof(uniform_block::MatrixData));
+			}
+			m_uniformRing.BindRange(BIND_ENTITY_MATERIAL_DATA, blocks.material, sizeof(uniform_block::MaterialData));
+			m_uniformRing.BindRange(BIND_ENTITY_TEXTURE_DATA, blocks.texture, sizeof(uniform_block::TextureData));
+			return;
+		}
+
+		//--- If the upload failed, fall back to updating the UBO's from the arena, one batch at a time
+		//--- (the matrix block goes through m_matrixData, so SetMatrixData() still knows what the UBO holds)
+		if (blocks.matrix != s_noBlock) {
+			m_matrixData = *(const uniform_block::MatrixData*)(m_arena.GetData() + blocks.matrix);
+			GetBinding(BIND_ENTITY_MATRIX_DATA)->Update(&m_matrixData);
+		}
+		GetBinding(BIND_ENTITY_MATERIAL_DATA)->Update((const uniform_block::MaterialData*)(m_arena.GetData() + blocks.material));
+		GetBinding(BIND_ENTITY_TEXTURE_DATA)->Update((const uniform_block::TextureData*)(m_arena.GetData() + blocks.texture));
+	}
+}
+
+
+/*******************************************************************************************************************
+	A function that finishes drawing this frame's batches - fencing off the ring buffer's region until the GPU is
+	done with it, and putting the matrix, material and texture UBO's back on their binding points
+*******************************************************************************************************************/
+void EntityShader::EndBatches()
+{
+	if (m_isUploaded) {
+		m_uniformRing.Fence();
+		GetBinding(BIND_ENTITY_MATRIX_DATA)->Rebind();
+		GetBinding(BIND_ENTITY_MATERIAL_DATA)->Rebind();
+		GetBinding(BIND_ENTITY_TEXTURE_DATA)->Rebind();
+	}
+
+	m_isUploaded = false;
+}
+
+
+/*******************************************************************************************************************
+	A function that switches the shader between instanced batches and single draws
+*******************************************************************************************************************/
+void EntityShader::Instancing(bool isInstanced)
+{
+	if (m_isInstancingSupported) { SetBool(COG_UNIFORM("uniform_entity_isInstanced"), isInstanced); }
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+bool EntityShader::IsInstancingSupported() const { return m_isInstancingSupported; }
+
+
 /*******************************************************************************************************************
 	A function that set's the matrix data within the shader (should only be done when a change happens)
 *******************************************************************************************************************/
-bool EntityShader::SetMatrixData(Transform* transform)
+bool EntityShader::SetMatrixData(const glm::mat4& world)
 {
-	if (!m_camera || !transform) { return false; }
+	const CameraView* camera = GetView();
+
+	if (!camera) { return false; }
 
 	bool hasChanged = false;
 
 	glm::mat4 projection	= Screen::Instance()->GetProjectionMatrix();
-	glm::mat4 view			= m_camera->GetViewMatrix();
-	glm::mat4 world			= transform->GetTransformationMatrix();
+	glm::mat4 view			= camera->view;
 	glm::mat4 intraWorld	= glm::transpose(glm::inverse(world));
 
 	//--- Check if any data has changed and only update the old data if so
@@ -147,7 +280,9 @@ void EntityShader::SetFogData(int type, bool rangeBased, float density, const gl
 *******************************************************************************************************************/
 bool EntityShader::SetLights(const std::vector<Light*>& lights)
 {
-	if (lights.empty() || !m_camera) { return false; }
+	const CameraView* camera = GetView();
+
+	if (lights.empty() || !camera) { return false; }
 
 	//--- Make sure the lights vector size is no more than our max lights set in the shader
 	if (lights.size() > MAX_LIGHTS) {
@@ -160,7 +295,7 @@ bool EntityShader::SetLights(const std::vector<Light*>& lights)
 
 		bool hasChanged = false;
 
-		glm::vec4 cameraPosition = glm::vec4(m_camera->GetPosition(), 1.0f);
+		glm::vec4 cameraPosition = glm::vec4(camera->position, 1.0f);
 
 		//--- Check if the data has changed and only update the old data if so
 		if (m_lightData.numLights != lights.size())		{ m_lightData.numLights = lights.size(); hasChanged = true; }
@@ -188,12 +323,7 @@ bool EntityShader::SetLights(const std::vector<Light*>& lights)
 *******************************************************************************************************************/
 bool EntityShader::SetMaterialData(Material* material)
 {
-	if (!material) { return false; }
-
-	m_materialData.isReflective		= (int)material->IsReflective();
-	m_materialData.isGlowing		= (int)material->IsGlowing();
-	m_materialData.isNormalMapped	= (int)material->IsNormalMapped();
-	m_materialData.shininess		= material->GetShininess();
+	if (!FillMaterialData(material)) { return false; }
 
 	//--- Update the shader with this object's data
 	GetBinding(BIND_ENTITY_MATERIAL_DATA)->Update(&m_materialData);
@@ -209,6 +339,36 @@ bool EntityShader::SetMaterialData(Material* material)
 	A function that set's all the texture data within the shader (needs to be done for every object's texture data)
 *******************************************************************************************************************/
 bool EntityShader::SetTextureData(Texture* texture)
+{
+	if (!FillTextureData(texture)) { return false; }
+
+	//--- Update the shader
+	GetBinding(BIND_ENTITY_TEXTURE_DATA)->Update(&m_textureData);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that copies an object's material into the material block (without sending it to the shader)
+*******************************************************************************************************************/
+bool EntityShader::FillMaterialData(Material* material)
+{
+	if (!material) { return false; }
+
+	m_materialData.isReflective		= (int)material->IsReflective();
+	m_materialData.isGlowing		= (int)material->IsGlowing();
+	m_materialData.isNormalMapped	= (int)material->IsNormalMapped();
+	m_materialData.shininess		= material->GetShininess();
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that copies an object's texture data into the texture block (without sending it to the shader)
+*******************************************************************************************************************/
+bool EntityShader::FillTextureData(Texture* texture)
 {
 	if (!texture) { return false; }
 
@@ -217,8 +377,12 @@ bool EntityShader::SetTextureData(Texture* texture)
 	m_textureData.hasFakeLighting	= (int)texture->HasFakeLighting();
 	m_textureData.isMirrored		= (int)texture->IsMirrored();
 
-	//--- Update the shader
-	GetBinding(BIND_ENTITY_TEXTURE_DATA)->Update(&m_textureData);
-
 	return true;
-}
\ No newline at end of file
+}
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+//--- An instanced batch has no matrix block of its own
+const size_t EntityShader::s_noBlock = std::numeric_limits<size_t>::max();
\ No newline at end of file
@@ -14,17 +14,32 @@
 	Additional support for fog effects.
 	Uses singular uniforms and uniform blocks to create and update shader data.
 	Shader data only get's updated when changes have happened.
+	Instanced batches - SetBatchData() sets what a batch shares, and the world matrix, normal matrix and shininess
+	of each instance come from the instance buffer (see InstanceBuffer) while Instancing() is switched on.
+	Batched uniform blocks - the material and texture blocks of every batch in a frame are packed into one arena
+	(AddBatch()), uploaded in one go (UploadBatches()) and bound per batch by range (SetBatchData()), rather than
+	updating the UBO's once per batch. Single draws work the same way (AddDraw()), each with its own matrix block
+	as well, so a frame of single draws is one upload rather than a few UBO updates per draw.
 
 	[Upcoming]
 	Deferred rendering support and frame buffer support.
-	Batch rendering system to improve performance and make switching textures/materials much faster and more optimized.
+	Texture arrays, so instances with different textures could share a batch.
 	PBR, parallax mapping, shadow mapping, bloom.
 
 	[Side Notes]
-	Nothing at present.
+	The vertex shader reads the instance attributes (locations 5 to 12) when uniform_entity_isInstanced is set,
+	and the world/intraWorld matrices of the matrix block otherwise. A shader without the uniform or the attributes
+	isn't instanced at all (IsInstancingSupported()), so its entities are drawn one at a time.
+	BeginBatches() to EndBatches() borrows the matrix, material and texture binding points for the ring buffer, so
+	EndBatches() must be called before any draws that use SetInstanceData(), which puts the UBO's back.
+	A batch added with AddDraw() is a single draw, so it's drawn with Instancing() switched off - the GLSL reads
+	its matrices from the matrix block as it always has, just from a range of the ring buffer.
 
 *******************************************************************************************************************/
+#include <vector>
 #include "UniformBlocks.h"
+#include "graphics/UniformArena.h"
+#include "graphics/buffers/UniformRingBuffer.h"
 
 class EntityShader : public Shader {
 
@@ -34,6 +49,14 @@ public:
 	
 public:
 	void SetInstanceData(Transform* transform, Material* material);
+	void BeginBatches();
+	void AddBatch(Material* material);
+	void AddDraw(const glm::mat4& world, Material* material);
+	void UploadBatches();
+	void SetBatchData(unsigned int batch);
+	void EndBatches();
+	void Instancing(bool isInstanced);
+	bool IsInstancingSupported() const;
 	virtual bool SetLights(const std::vector<Light*>& lights) override;
 	virtual void DebugMode(bool enableDebugSettings) override;
 
@@ -42,10 +65,19 @@ private:
 	virtual void SetPermanentAttributes()	override;
 
 private:
-	bool SetMatrixData(Transform* transform);
+	bool SetMatrixData(const glm::mat4& world);
 	void SetFogData(int type, bool rangeBased, float density, const glm::vec4& color);
 	bool SetTextureData(Texture* texture);
 	bool SetMaterialData(Material* material);
+	bool FillTextureData(Texture* texture);
+	bool FillMaterialData(Material* material);
+
+private:
+	struct BatchBlocks {
+		size_t matrix;
+		size_t material;
+		size_t texture;
+	};
 
 private:
 	uniform_block::MatrixData	m_matrixData;
@@ -53,4 +85,14 @@ private:
 	uniform_block::LightData	m_lightData;
 	uniform_block::TextureData	m_textureData;
 	uniform_block::MaterialData m_materialData;
+
+private:
+	UniformArena				m_arena;
+	UniformRingBuffer			m_uniformRing;
+	std::vector<BatchBlocks>	m_batchBlocks;
+	bool						m_isUploaded;
+	bool						m_isInstancingSupported;
+
+private:
+	static const size_t s_noBlock;
 };
\ No newline at end of file
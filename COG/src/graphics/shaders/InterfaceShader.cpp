@@ -51,7 +51,7 @@ void InterfaceShader::GetAllUniforms()
 *******************************************************************************************************************/
 void InterfaceShader::SetPermanentAttributes()
 {
-	SetInteger("uniform_interface_texture", TEXTURE_INTERFACE);
+	SetInteger(COG_UNIFORM("uniform_interface_texture"), TEXTURE_INTERFACE);
 }
 
 
@@ -62,23 +62,35 @@ void InterfaceShader::SetInstanceData(Transform* transform, Texture* texture)
 {
 	//--- Check we have a valid program
 	if (m_shaderCount != NULL) {
-		SetMatrixData(transform);
-		SetTextureData(texture);
+		if (transform)	{ SetMatrixData(transform->GetRenderMatrix()); }
+		if (texture)	{ SetTextureData(texture, texture->GetOffset()); }
 	}
 }
 
 
 /*******************************************************************************************************************
-	A function that set's the projection of the interface objects (needs to be done for every object's transform)
+	A function that set's all the data within the shader from an already calculated world matrix and texture offset
+	(e.g. a sprite from a frame packet)
 *******************************************************************************************************************/
-bool InterfaceShader::SetMatrixData(Transform* transform)
+void InterfaceShader::SetInstanceData(const glm::mat4& world, Texture* texture, const glm::vec2& offset)
 {
-	if (!transform) { return false; }
+	//--- Check we have a valid program
+	if (m_shaderCount != NULL) {
+		SetMatrixData(world);
+		SetTextureData(texture, offset);
+	}
+}
 
+
+/*******************************************************************************************************************
+	A function that set's the projection of the interface objects (needs to be done for every object's transform)
+*******************************************************************************************************************/
+bool InterfaceShader::SetMatrixData(const glm::mat4& world)
+{
 	//--- Get the projection matrix and multiply this with the transform matrix of the 2D object
-	glm::mat4 projection = Screen::Instance()->GetProjectionMatrix() * transform->GetTransformationMatrix();
+	glm::mat4 projection = Screen::Instance()->GetProjectionMatrix() * world;
 
-	SetMatrix("uniform_interface_projection", projection);
+	SetMatrix(COG_UNIFORM("uniform_interface_projection"), projection);
 
 	return true;
 }
@@ -87,13 +99,13 @@ bool InterfaceShader::SetMatrixData(Transform* transform)
 /*******************************************************************************************************************
 	A function that set's all the texture data within the shader (needs to be done for every object's texture data)
 *******************************************************************************************************************/
-bool InterfaceShader::SetTextureData(Texture* texture)
+bool InterfaceShader::SetTextureData(Texture* texture, const glm::vec2& offset)
 {
 	if (!texture) { return false; }
 
-	SetVector2f("uniform_interface_textureData.offset", texture->GetOffset());
-	SetFloat("uniform_interface_textureData.rows", (float)texture->GetRows());
-	SetBool("uniform_interface_textureData.isMirrored", (int)texture->IsMirrored());
+	SetVector2f(COG_UNIFORM("uniform_interface_textureData.offset"), offset);
+	SetFloat(COG_UNIFORM("uniform_interface_textureData.rows"), (float)texture->GetRows());
+	SetBool(COG_UNIFORM("uniform_interface_textureData.isMirrored"), (int)texture->IsMirrored());
 
 	return true;
 }
\ No newline at end of file
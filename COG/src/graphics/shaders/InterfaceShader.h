@@ -28,12 +28,13 @@ public:
 
 public:
 	void SetInstanceData(Transform* transform, Texture* texture);
+	void SetInstanceData(const glm::mat4& world, Texture* texture, const glm::vec2& offset);
 
 private:
 	virtual void GetAllUniforms()			override;
 	virtual void SetPermanentAttributes()	override;
 
 private:
-	bool SetMatrixData(Transform* transform);
-	bool SetTextureData(Texture* texture);
+	bool SetMatrixData(const glm::mat4& world);
+	bool SetTextureData(Texture* texture, const glm::vec2& offset);
 };
\ No newline at end of file
@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <fstream>
 #include <pretty_glm/gtc/type_ptr.hpp>
 #include "Shader.h"
 #include "utilities/Log.h"
 #include "utilities/vsGLInfoLib.h"
 #include "graphics/Camera.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
@@ -11,9 +13,12 @@
 Shader::Shader(const std::string& vertexFileLocation, const std::string& fragmentFileLocation, Camera* camera)	
 	:	m_shaderCount(0),
 		m_camera(camera),
+		m_view(),
+		m_hasView(false),
 		m_program(0),
 		m_vertexShader(0),
-		m_fragmentShader(0)
+		m_fragmentShader(0),
+		m_uniformMask(0)
 {
 	Load(vertexFileLocation, fragmentFileLocation);
 }
@@ -52,6 +57,9 @@ bool Shader::Load(const std::string& vertexFileLocation, const std::string& frag
 	
 	//--- Check the linking status of our program and return false if there was an issue
 	if (!LinkProgram()) { return false; }
+
+	//--- Now the program is linked, look up where every one of its uniforms lives
+	ResolveUniforms();
 	
 	//--- Finally, detach the shader objects and delete them
 	//--- We do not need them after compilation success (the program now stores the shader data)
@@ -175,6 +183,73 @@ bool Shader::LinkProgram()
 }
 
 
+/*******************************************************************************************************************
+	Function that fills this program's uniform table with the location of every active uniform, by the hash of its
+	name (uniforms inside blocks have no location, as they're set through their UBO)
+*******************************************************************************************************************/
+void Shader::ResolveUniforms()
+{
+	GLint uniformCount	= 0;
+	GLint maxLength		= 0;
+
+	COG_GLCALL(glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &uniformCount));
+	COG_GLCALL(glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+
+	std::vector<std::pair<std::string, GLint>> uniforms;
+	std::vector<GLchar> name(maxLength + 1, 0);
+
+	for (GLint i = 0; i < uniformCount; i++) {
+
+		GLsizei length	= 0;
+		GLint size		= 0;
+		GLenum type		= 0;
+
+		COG_GLCALL(glGetActiveUniform(m_program, (GLuint)i, maxLength, &length, &size, &type, name.data()));
+
+		std::string uniformName(name.data(), length);
+
+		//--- Arrays are only listed once (as their first element), so every element is looked up by its own name
+		bool isArray = (size > 1 && uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0);
+		if (isArray) { uniformName.erase(uniformName.size() - 3); }
+
+		for (GLint element = 0; element < (isArray ? size : 1); element++) {
+
+			std::string elementName = (isArray) ? uniformName + "[" + std::to_string(element) + "]" : uniformName;
+
+			GLint location = -1;
+			COG_GLCALL(location = glGetUniformLocation(m_program, elementName.c_str()));
+
+			if (location != -1) { uniforms.emplace_back(elementName, location); }
+		}
+	}
+
+	//--- Keep the table at most half full, so a lookup almost always lands on its uniform first time
+	size_t capacity = 1;
+	while (capacity < uniforms.size() * 2) { capacity <<= 1; }
+
+	m_uniforms.assign(capacity, { 0, -1 });
+	m_uniformMask = capacity - 1;
+
+	for (const auto& uniform : uniforms) {
+
+		UniformID::Hash hash = UniformID::GetHash(uniform.first.c_str());
+		size_t slot = hash & m_uniformMask;
+
+		//--- Names are unique within a program, so finding the same hash already in the table means two names clash
+		while (m_uniforms[slot].location != -1 && m_uniforms[slot].hash != hash) { slot = (slot + 1) & m_uniformMask; }
+
+		if (m_uniforms[slot].location != -1) {
+			COG_LOG("[SHADER] Uniform name hashes the same as another in this program: ", uniform.first.c_str(), LOG_ERROR);
+			continue;
+		}
+
+		m_uniforms[slot] = { hash, uniform.second };
+	}
+
+	COG_LOG("[SHADER] Uniform locations resolved: ", uniforms.size(), LOG_MESSAGE);
+}
+
+
 /*******************************************************************************************************************
 	Function to detach shader object from a program object, opposite from AttachShaders()
 *******************************************************************************************************************/
@@ -206,7 +281,7 @@ void Shader::DestroyShaders()
 *******************************************************************************************************************/
 void Shader::DestroyProgram()
 {
-	COG_GLCALL(glUseProgram(0));
+	GLState::Instance()->UseProgram(0);
 	COG_GLCALL(glDeleteProgram(m_program));
 
 	COG_LOG("[SHADER] Program destroyed: ", m_program, LOG_MEMORY);
@@ -268,7 +343,7 @@ GLint Shader::CompilationSuccess(GLuint object)
 *******************************************************************************************************************/
 void Shader::Bind() const
 {
-	COG_GLCALL(glUseProgram(m_program));
+	GLState::Instance()->UseProgram(m_program);
 }
 
 
@@ -277,7 +352,7 @@ void Shader::Bind() const
 *******************************************************************************************************************/
 void Shader::Unbind() const
 {
-	COG_GLCALL(glUseProgram(0));
+	GLState::Instance()->UseProgram(0);
 }
 
 
@@ -286,21 +361,10 @@ void Shader::Unbind() const
 *******************************************************************************************************************/
 bool Shader::GetUniform(const std::string& uniformName)
 {
-	auto uniform = s_uniforms.find(uniformName);
-	if (uniform != s_uniforms.end()) {
-		COG_LOG("[SHADER] Uniform already retrieved: ", uniformName.c_str(), LOG_WARN); return false;
-	}
-
-	GLint uniformLocation = 0;
-
-	COG_GLCALL(uniformLocation = glGetUniformLocation(m_program, uniformName.c_str()));
-
-	if (uniformLocation == -1 || uniformLocation == GL_INVALID_INDEX) { 
+	if (FindUniform(UniformID(uniformName)) == -1) {
 		COG_LOG("[SHADER] Could not find uniform location: ", uniformName.c_str(), LOG_ERROR); return false;
 	}
-	
-	s_uniforms.try_emplace(uniformName, uniformLocation);
-	
+
 	return true;
 }
 
@@ -312,11 +376,6 @@ bool Shader::GetUniformBlock(const std::string& uniformBlockName, GLsizeiptr byt
 {
 	if (!ByteSizeMatches(uniformBlockName, byteSize)) { return false; }
 
-	auto uniform = s_uniforms.find(uniformBlockName);
-	if (uniform != s_uniforms.end()) {
-		COG_LOG("[SHADER] Uniform block already retrieved: ", uniformBlockName.c_str(), LOG_WARN); return false;
-	}
-
 	GLint uniformLocation = 0;
 
 	COG_GLCALL(uniformLocation = glGetUniformBlockIndex(m_program, uniformBlockName.c_str()));
@@ -326,8 +385,6 @@ bool Shader::GetUniformBlock(const std::string& uniformBlockName, GLsizeiptr byt
 	}
 	
 	COG_GLCALL(glUniformBlockBinding(m_program, uniformLocation, binding));
-	
-	s_uniforms.try_emplace(uniformBlockName, uniformLocation);
 
 	//--- If UBO doesn't already exist, generate a new UBO for this data
 	if (!Resource::Instance()->AddBinding(byteSize, binding, dynamic)) { return false; }
@@ -346,18 +403,64 @@ UniformBuffer* Shader::GetBinding(GLuint binding)
 
 
 /*******************************************************************************************************************
-	Function that checks if a uniform name exists within our uniforms map
+	A function that checks if the program has an active vertex attribute at a location (a matrix attribute is found
+	at the location of its first column)
 *******************************************************************************************************************/
-bool Shader::UniformExists(const std::string& uniformName)
+bool Shader::HasAttribute(GLint location) const
 {
-	auto uniform = s_uniforms.find(uniformName);
+	GLint count = 0, maxLength = 0;
 
-	if (uniform == s_uniforms.end()) {
-		COG_LOG("[SHADER] Setting a uniform before retrieving it from shader file: ", uniformName.c_str(), LOG_ERROR);
-		return false;
+	COG_GLCALL(glGetProgramiv(m_program, GL_ACTIVE_ATTRIBUTES, &count));
+	COG_GLCALL(glGetProgramiv(m_program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength));
+
+	std::vector<GLchar> name(maxLength + 1, 0);
+
+	for (GLint i = 0; i < count; i++) {
+
+		GLint size = 0, attribute = -1;
+		GLenum type = 0;
+
+		COG_GLCALL(glGetActiveAttrib(m_program, (GLuint)i, (GLsizei)name.size(), nullptr, &size, &type, name.data()));
+		COG_GLCALL(attribute = glGetAttribLocation(m_program, name.data()));
+
+		if (attribute == location) { return true; }
 	}
 
-	return true;
+	return false;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the location of a uniform in this program, or -1 if the program doesn't have it
+*******************************************************************************************************************/
+GLint Shader::FindUniform(UniformID uniform) const
+{
+	if (m_uniforms.empty()) { return -1; }
+
+	//--- The table is never full, so we always reach the uniform or an empty slot
+	for (size_t slot = uniform.hash & m_uniformMask;; slot = (slot + 1) & m_uniformMask) {
+		if (m_uniforms[slot].location == -1)		{ return -1; }
+		if (m_uniforms[slot].hash == uniform.hash)	{ return m_uniforms[slot].location; }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the location of a uniform being set. Setting a uniform the program doesn't have does
+	nothing, so in debug mode the first miss of each uniform is reported (only its hash is left by now)
+*******************************************************************************************************************/
+GLint Shader::GetLocation(UniformID uniform)
+{
+	GLint location = FindUniform(uniform);
+
+#if COG_DEBUG == 1
+	if (location == -1 && std::find(m_missingUniforms.begin(), m_missingUniforms.end(), uniform.hash) == m_missingUniforms.end()) {
+		m_missingUniforms.push_back(uniform.hash);
+		COG_LOG("[SHADER] Uniform not found in program " + std::to_string(m_program) + ", hash: ", uniform.hash, LOG_WARN);
+	}
+#endif
+
+	return location;
 }
 
 
@@ -388,48 +491,67 @@ bool Shader::ByteSizeMatches(const std::string& uniformBlockName, GLsizeiptr byt
 /*******************************************************************************************************************
 	Modifier methods
 *******************************************************************************************************************/
-void Shader::SetMatrix(const std::string& uniformName, const glm::mat4& data)
+void Shader::SetMatrix(UniformID uniform, const glm::mat4& data)
 {
-	if (UniformExists(uniformName)) { COG_GLCALL(glUniformMatrix4fv(s_uniforms[uniformName], 1, GL_FALSE, glm::value_ptr(data))); }
+	GLint location = GetLocation(uniform);
+	if (location != -1) { COG_GLCALL(glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(data))); }
 }
 
-void Shader::SetVector2f(const std::string& uniformName, const glm::vec2& value)
+void Shader::SetVector2f(UniformID uniform, const glm::vec2& value)
 {
-	if (UniformExists(uniformName)) { COG_GLCALL(glUniform2f(s_uniforms[uniformName], value.x, value.y)); }
+	GLint location = GetLocation(uniform);
+	if (location != -1) { COG_GLCALL(glUniform2f(location, value.x, value.y)); }
 }
 
-void Shader::SetVector3f(const std::string& uniformName, const glm::vec3& value)
+void Shader::SetVector3f(UniformID uniform, const glm::vec3& value)
 {
-	if (UniformExists(uniformName)) { COG_GLCALL(glUniform3f(s_uniforms[uniformName], value.x, value.y, value.z)); }
+	GLint location = GetLocation(uniform);
+	if (location != -1) { COG_GLCALL(glUniform3f(location, value.x, value.y, value.z)); }
 }
 
-void Shader::SetVector4f(const std::string& uniformName, const glm::vec4& value)
+void Shader::SetVector4f(UniformID uniform, const glm::vec4& value)
 {
-	if (UniformExists(uniformName)) { COG_GLCALL(glUniform4f(s_uniforms[uniformName], value.x, value.y, value.z, value.w)); }
+	GLint location = GetLocation(uniform);
+	if (location != -1) { COG_GLCALL(glUniform4f(location, value.x, value.y, value.z, value.w)); }
 }
 
-void Shader::SetFloat(const std::string& uniformName, const float value)
+void Shader::SetFloat(UniformID uniform, const float value)
 {
-	if (UniformExists(uniformName)) { COG_GLCALL(glUniform1f(s_uniforms[uniformName], value)); }
+	GLint location = GetLocation(uniform);
+	if (location != -1) { COG_GLCALL(glUniform1f(location, value)); }
 }
 
-void Shader::SetInteger(const std::string& uniformName, const int value)
+void Shader::SetInteger(UniformID uniform, const int value)
 {
-	if (UniformExists(uniformName)) { COG_GLCALL(glUniform1i(s_uniforms[uniformName], value)); }
+	GLint location = GetLocation(uniform);
+	if (location != -1) { COG_GLCALL(glUniform1i(location, value)); }
 }
 
-void Shader::SetBool(const std::string& uniformName, const bool value)
+void Shader::SetBool(UniformID uniform, const bool value)
 {
-	if (UniformExists(uniformName)) { COG_GLCALL(glUniform1i(s_uniforms[uniformName], value)); }
+	GLint location = GetLocation(uniform);
+	if (location != -1) { COG_GLCALL(glUniform1i(location, value)); }
 }
 
-void Shader::SwapCamera(Camera* camera) { m_camera = camera; }
+void Shader::SwapCamera(Camera* camera)				{ m_camera = camera; m_hasView = false; }
+void Shader::SetView(const CameraView& view)		{ m_view = view; m_camera = nullptr; m_hasView = true; }
+
+
+/*******************************************************************************************************************
+	Function that returns the view to render with - either the camera's (read every time, as the camera may move
+	between draws) or the copy passed in with SetView() (e.g. from a frame packet on the render thread)
+*******************************************************************************************************************/
+const CameraView* Shader::GetView()
+{
+	if (m_camera) { m_view = m_camera->GetRenderView(); return &m_view; }
+
+	return (m_hasView) ? &m_view : nullptr;
+}
 
 
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
-std::map <std::string, GLuint> Shader::s_uniforms;
 std::map <Shader::TextureUnit, int> Shader::s_textureUnits = {	{ TEXTURE_DIFFUSE, GL_TEXTURE0 },
 																{ TEXTURE_SPECULAR, GL_TEXTURE1 },
 																{ TEXTURE_EMISSIVE, GL_TEXTURE2 },
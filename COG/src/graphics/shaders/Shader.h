@@ -11,7 +11,11 @@
 	Supports vertex and fragment shader loading, with complete error checking features and debug message outputs.
 	Supports individual uniform variables as well as uniform blocks.
 	Bindings are created once in cache memory (providing you use the resource manager) and can be re-used.
-	Has a static uniform map to keep track of all uniforms loaded; good for debugging.
+	Each program has its own flat table of uniform locations, filled from the program's active uniforms as soon as
+	it is linked. Uniforms are set by UniformID (a hash of the name, see COG_UNIFORM()), which indexes straight into
+	the table - no strings are built or compared when setting a uniform.
+	The view comes from a camera (SwapCamera()) or from a copy of one (SetView()), so a shader can draw a frame
+	packet on the render thread without ever touching the camera itself.
 
 	[Upcoming]
 	Shader caching - program ID's will be kept in memory for re-use (needs testing)
@@ -30,6 +34,9 @@
 	When we declare data has base 16 (alignas(16)), the compiler automatically
 	generates padding (at the end) of our struct to make it 16 byte aligned.
 	Vec3's are generally not used for uniform blocks and should be avoided.
+	GetUniform() no longer fetches anything (the table is already built), it just reports a uniform the program
+	doesn't have - e.g. one the GLSL compiler removed because it was never used. In debug mode, setting a uniform the
+	program doesn't have is reported too (once per uniform, by hash) rather than silently doing nothing.
 	Reference: https://stackoverflow.com/questions/38172696/should-i-ever-use-a-vec3-inside-of-a-uniform-buffer-or-shader-storage-buffer-o/38172697#38172697
 	We can also make use of the handy vsGLInfoLib library by LightHouse 3D, to check our
 	offsets and sizes match up properly in our shaders (Call function: VSGLInfoLib::getUniformsInfo(programID)).
@@ -63,6 +70,8 @@
 #include <map>
 #include <vector>
 #include "managers/ResourceManager.h"
+#include "graphics/CameraView.h"
+#include "graphics/shaders/UniformID.h"
 
 class Camera; class Transform; class Texture; class Material; class Light;
 
@@ -105,6 +114,7 @@ public:
 
 public:
 	void SwapCamera(Camera* camera);
+	void SetView(const CameraView& view);
 
 public:
 	static int GetTextureUnit(TextureUnit unit);
@@ -116,16 +126,18 @@ protected:
 protected:
 	bool GetUniform(const std::string& uniformName);
 	bool GetUniformBlock(const std::string& uniformBlockName, GLsizeiptr byteSize, GLuint binding, bool dynamic = false);
+	bool HasAttribute(GLint location) const;
 	UniformBuffer* GetBinding(GLuint binding);
+	const CameraView* GetView();
 
 protected:
-	void SetMatrix(const std::string& uniformName, const glm::mat4& data);
-	void SetVector2f(const std::string& uniformName, const glm::vec2& value);
-	void SetVector3f(const std::string& uniformName, const glm::vec3& value);
-	void SetVector4f(const std::string& uniformName, const glm::vec4& value);
-	void SetFloat(const std::string& uniformName, const float value);
-	void SetInteger(const std::string& uniformName, const int value);
-	void SetBool(const std::string& uniformName, const bool value);
+	void SetMatrix(UniformID uniform, const glm::mat4& data);
+	void SetVector2f(UniformID uniform, const glm::vec2& value);
+	void SetVector3f(UniformID uniform, const glm::vec3& value);
+	void SetVector4f(UniformID uniform, const glm::vec4& value);
+	void SetFloat(UniformID uniform, const float value);
+	void SetInteger(UniformID uniform, const int value);
+	void SetBool(UniformID uniform, const bool value);
 
 private:
 	Shader(Shader const&)				= delete;
@@ -142,16 +154,26 @@ private:
 private:
 	bool CreateProgram();
 	bool LinkProgram();
+	void ResolveUniforms();
 	void DestroyProgram();
 
 private:
 	GLint CompilationSuccess(GLuint object);
-	bool UniformExists(const std::string& uniformName);
+	GLint FindUniform(UniformID uniform) const;
+	GLint GetLocation(UniformID uniform);
 	bool ByteSizeMatches(const std::string& uniformBlockName, GLsizeiptr byteSize);
 
 protected:
-	GLint	m_shaderCount;
-	Camera* m_camera;
+	GLint		m_shaderCount;
+	Camera*		m_camera;
+	CameraView	m_view;
+	bool		m_hasView;
+
+private:
+	struct Uniform {
+		UniformID::Hash	hash;
+		GLint			location;
+	};
 
 private:
 	GLuint	m_program;
@@ -159,6 +181,15 @@ private:
 	GLuint	m_fragmentShader;
 
 private:
-	static std::map<std::string, GLuint>	s_uniforms;
-	static std::map<TextureUnit, int>		s_textureUnits;
+	std::vector<Uniform>	m_uniforms;
+	size_t					m_uniformMask;
+
+#if COG_DEBUG == 1
+private:
+	//--- Uniforms set that the program doesn't have, so each one is only reported once
+	std::vector<UniformID::Hash> m_missingUniforms;
+#endif
+
+private:
+	static std::map<TextureUnit, int> s_textureUnits;
 };
\ No newline at end of file
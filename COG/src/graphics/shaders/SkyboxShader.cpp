@@ -52,7 +52,7 @@ void SkyboxShader::GetAllUniforms()
 *******************************************************************************************************************/
 void SkyboxShader::SetPermanentAttributes()
 {
-	SetInteger("uniform_skybox_texture", TEXTURE_SKYBOX);
+	SetInteger(COG_UNIFORM("uniform_skybox_texture"), TEXTURE_SKYBOX);
 }
 
 
@@ -70,10 +70,10 @@ void SkyboxShader::SetInstanceData()
 
 void SkyboxShader::SetSkyboxData(bool isTintEnabled, float tintBegin, float tintEnd, const glm::vec3 & tintColor)
 {
-	SetBool("uniform_skybox_applyTint", isTintEnabled);
-	SetVector3f("uniform_skybox_tintColor", tintColor);
-	SetFloat("uniform_skybox_tintBegin", tintBegin);
-	SetFloat("uniform_skybox_tintEnd", tintEnd);
+	SetBool(COG_UNIFORM("uniform_skybox_applyTint"), isTintEnabled);
+	SetVector3f(COG_UNIFORM("uniform_skybox_tintColor"), tintColor);
+	SetFloat(COG_UNIFORM("uniform_skybox_tintBegin"), tintBegin);
+	SetFloat(COG_UNIFORM("uniform_skybox_tintEnd"), tintEnd);
 }
 
 
@@ -82,17 +82,19 @@ void SkyboxShader::SetSkyboxData(bool isTintEnabled, float tintBegin, float tint
 *******************************************************************************************************************/
 bool SkyboxShader::SetMatrixData()
 {
-	if (!m_camera) { return false; }
+	const CameraView* camera = GetView();
+
+	if (!camera) { return false; }
 
 	//--- Get the projection matrix and multiply with the camera's rotation matrix
-	glm::mat4 projection = Screen::Instance()->GetProjectionMatrix() * m_camera->GetRotationMatrix();
+	glm::mat4 projection = Screen::Instance()->GetProjectionMatrix() * camera->rotation;
 
 	//--- Only update the projection if the camera rotates
 	if (m_projection != projection) {
 			
 		m_projection = projection;
 
-		SetMatrix("uniform_skybox_projection", m_projection);
+		SetMatrix(COG_UNIFORM("uniform_skybox_projection"), m_projection);
 	}
 
 	return true;
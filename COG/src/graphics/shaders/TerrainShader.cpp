@@ -69,7 +69,7 @@ void TerrainShader::GetAllUniforms()
 *******************************************************************************************************************/
 void TerrainShader::DebugMode(bool enableDebugSettings)
 {
-	SetBool("uniform_terrain_debugMode", enableDebugSettings);
+	SetBool(COG_UNIFORM("uniform_terrain_debugMode"), enableDebugSettings);
 }
 
 
@@ -85,11 +85,11 @@ void TerrainShader::SetPermanentAttributes()
 
 	//--- Set the terrain samplers once as these never change
 	for (unsigned int i = 0; i < Terrain::GetMaxTextures(); i++) {
-		SetInteger("uniform_terrain_textures[" + std::to_string(i) + "]", TEXTURE_BASE + i);
+		SetInteger(UniformID("uniform_terrain_textures[" + std::to_string(i) + "]"), TEXTURE_BASE + i);
 	}
 
 	for (unsigned int i = 0; i < Terrain::GetMaxNormalMaps(); i++) {
-		SetInteger("uniform_terrain_normalMaps[" + std::to_string(i) + "]", TEXTURE_BASE_NORMAL + i);
+		SetInteger(UniformID("uniform_terrain_normalMaps[" + std::to_string(i) + "]"), TEXTURE_BASE_NORMAL + i);
 	}
 }
 
@@ -115,13 +115,15 @@ void TerrainShader::SetInstanceData(Transform* transform, Texture* texture, bool
 *******************************************************************************************************************/
 bool TerrainShader::SetMatrixData(Transform* transform)
 {
-	if (!m_camera || !transform) { return false; }
+	const CameraView* camera = GetView();
+
+	if (!camera || !transform) { return false; }
 
 	bool hasChanged = false;
 
 	glm::mat4 projection	= Screen::Instance()->GetProjectionMatrix();
-	glm::mat4 view			= m_camera->GetViewMatrix();
-	glm::mat4 world			= transform->GetTransformationMatrix();
+	glm::mat4 view			= camera->view;
+	glm::mat4 world			= transform->GetRenderMatrix();
 	glm::mat4 intraWorld	= glm::transpose(glm::inverse(world));
 
 	//--- Check if any data has changed and only update the old data if so
@@ -166,7 +168,9 @@ void TerrainShader::SetFogData(int type, bool rangeBased, float density, const g
 *******************************************************************************************************************/
 bool TerrainShader::SetLights(const std::vector<Light*>& lights)
 {
-	if (lights.empty() || !m_camera) { return false; }
+	const CameraView* camera = GetView();
+
+	if (lights.empty() || !camera) { return false; }
 
 	//--- Make sure the lights vector size is no more than our max lights set in the shader
 	if (lights.size() > MAX_LIGHTS)
@@ -180,7 +184,7 @@ bool TerrainShader::SetLights(const std::vector<Light*>& lights)
 
 		bool hasChanged = false;
 
-		glm::vec4 cameraPosition = glm::vec4(m_camera->GetPosition(), 1.0f);
+		glm::vec4 cameraPosition = glm::vec4(camera->position, 1.0f);
 
 		//--- Check if the data has changed and only update the old data if so
 		if (m_lightData.numLights != lights.size())		{ m_lightData.numLights = lights.size(); hasChanged = true; }
@@ -215,7 +219,7 @@ bool TerrainShader::SetTextureData(Texture* texture)
 	//--- If the terrain texture is not mirrored, this never needs to happen and so it will always be false
 	if (m_isMirrored != texture->IsMirrored()) {
 		m_isMirrored = texture->IsMirrored();
-		SetBool("uniform_terrain_isMirrored", m_isMirrored);
+		SetBool(COG_UNIFORM("uniform_terrain_isMirrored"), m_isMirrored);
 	}
 
 	return true;
@@ -228,5 +232,5 @@ bool TerrainShader::SetTextureData(Texture* texture)
 void TerrainShader::SetMinimapMode(bool minimapMode)
 {
 	//--- Changes every frame and so shader needs to be updated constantly
-	SetBool("uniform_terrain_minimapMode", minimapMode);
+	SetBool(COG_UNIFORM("uniform_terrain_minimapMode"), minimapMode);
 }
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "TextShader.h"
-#include "physics/Transform.h"
 #include "managers/ScreenManager.h"
 #include "utilities/Log.h"
 
@@ -7,7 +6,10 @@
 	Default Constructor
 *******************************************************************************************************************/
 TextShader::TextShader(const std::string& vertex, const std::string& fragment)
-	: Shader(vertex, fragment)
+	:	Shader(vertex, fragment),
+		m_isDistanceField(false),
+		m_hasDistanceField(false),
+		m_isDistanceFieldChecked(false)
 {
 	//--- Check we have a valid program
 	if (m_shaderCount != NULL) {
@@ -46,18 +48,18 @@ void TextShader::GetAllUniforms()
 *******************************************************************************************************************/
 void TextShader::SetPermanentAttributes()
 {
-	SetInteger("uniform_text_texture", TEXTURE_TEXT);
+	SetInteger(COG_UNIFORM("uniform_text_texture"), TEXTURE_TEXT);
 }
 
 
 /*******************************************************************************************************************
 	A function that set's all the per string data (not per instance) within the shader (specific to this game)
 *******************************************************************************************************************/
-void TextShader::SetInstanceData(Transform* transform, const glm::vec4& color)
+void TextShader::SetInstanceData(const glm::mat4& world, const glm::vec4& color)
 {
 	//--- Check we have a valid program
 	if (m_shaderCount != NULL) {
-		SetMatrixData(transform);
+		SetMatrixData(world);
 		SetTextProperties(color);
 	}
 }
@@ -66,17 +68,13 @@ void TextShader::SetInstanceData(Transform* transform, const glm::vec4& color)
 /*******************************************************************************************************************
 	A function that set's the projection of the text string (has to be done for every string we render)
 *******************************************************************************************************************/
-bool TextShader::SetMatrixData(Transform* transform)
+void TextShader::SetMatrixData(const glm::mat4& world)
 {
-	if (!transform) { return false; }
-
-	//--- Get the projection matrix and multiply this with the transform matrix of the text string
-	glm::mat4 projection = Screen::Instance()->GetProjectionMatrix() * transform->GetTransformationMatrix();
+	//--- Get the projection matrix and multiply this with the world matrix of the text string
+	glm::mat4 projection = Screen::Instance()->GetProjectionMatrix() * world;
 
 	//--- Update shader for every text string we render
-	SetMatrix("uniform_text_projection", projection);
-
-	return true;
+	SetMatrix(COG_UNIFORM("uniform_text_projection"), projection);
 }
 
 
@@ -85,5 +83,26 @@ bool TextShader::SetMatrixData(Transform* transform)
 *******************************************************************************************************************/
 void TextShader::SetTextProperties(const glm::vec4& color)
 {
-	SetVector4f("uniform_text_textColor", color);
+	SetVector4f(COG_UNIFORM("uniform_text_textColor"), color);
+}
+
+
+/*******************************************************************************************************************
+	A function that tells the shader whether the font's atlas holds distance fields or coverage. The switch is off
+	in a newly linked program, so coverage fonts never touch it unless a distance field font has turned it on
+*******************************************************************************************************************/
+void TextShader::SetDistanceField(bool isDistanceField)
+{
+	if (isDistanceField == m_isDistanceField) { return; }
+
+	//--- The first distance field font checks the shader has the switch (reporting it, once, if it doesn't)
+	if (!m_isDistanceFieldChecked) {
+		m_hasDistanceField			= GetUniform("uniform_text_isDistanceField");
+		m_isDistanceFieldChecked	= true;
+	}
+
+	if (!m_hasDistanceField) { return; }
+
+	SetBool(COG_UNIFORM("uniform_text_isDistanceField"), isDistanceField);
+	m_isDistanceField = isDistanceField;
 }
\ No newline at end of file
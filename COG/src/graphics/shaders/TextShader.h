@@ -8,12 +8,15 @@
 
 	[Features]
 	Supports FreeType text.
+	Supports distance field fonts (see SetDistanceField()), which stay sharp at any scale.
+	Takes each string's world matrix rather than its transform, as cached strings are placed by their matrix alone.
 
 	[Upcoming]
 	Nothing at present.
 
 	[Side Notes]
-	Nothing at present.
+	uniform_text_isDistanceField is only looked up once a distance field font is drawn, so a text shader without it
+	still draws coverage fonts without any errors.
 
 *******************************************************************************************************************/
 #include "Shader.h"
@@ -25,13 +28,19 @@ public:
 	virtual ~TextShader();
 
 public:
-	void SetInstanceData(Transform* transform, const glm::vec4& color);
+	void SetInstanceData(const glm::mat4& world, const glm::vec4& color);
+	void SetDistanceField(bool isDistanceField);
 
 private:
 	virtual void GetAllUniforms()			override;
 	virtual void SetPermanentAttributes()	override;
 
 private:
-	bool SetMatrixData(Transform* transform);
+	void SetMatrixData(const glm::mat4& world);
 	void SetTextProperties(const glm::vec4& color);
+
+private:
+	bool m_isDistanceField;
+	bool m_hasDistanceField;
+	bool m_isDistanceFieldChecked;
 };
\ No newline at end of file
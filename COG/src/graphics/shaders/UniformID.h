@@ -0,0 +1,65 @@
+#pragma once
+
+/*******************************************************************************************************************
+	UniformID.h
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Identifies a shader uniform by the FNV-1a hash of its name, so setting a uniform never has to build or compare
+	a string - see Shader::SetMatrix() etc.
+
+	[Features]
+	COG_UNIFORM("name") hashes the name at compile time (it's forced into a constant), so the call site costs no
+	more than passing a number.
+	Names only known at run time (e.g. array elements built in a loop) can be hashed with UniformID(std::string).
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	Each shader's program builds its table of hashes once it is linked, and reports any two of its uniform names
+	that hash the same (which 32 bits makes unlikely, but not impossible).
+
+*******************************************************************************************************************/
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#define COG_UNIFORM(name) UniformID(std::integral_constant<UniformID::Hash, UniformID::GetHash(name)>::value)
+
+struct UniformID {
+
+	typedef std::uint32_t Hash;
+
+	constexpr explicit UniformID(Hash hash)
+		:	hash(hash)
+	{
+
+	}
+
+	explicit UniformID(const std::string& name)
+		:	hash(GetHash(name.c_str()))
+	{
+
+	}
+
+	//--- FNV-1a - xor in each byte of the name, then multiply by the FNV prime
+	static constexpr Hash GetHash(const char* name)
+	{
+		Hash hash = 2166136261u;
+
+		while (*name) {
+			hash ^= (Hash)(unsigned char)*name++;
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+
+	Hash hash;
+};
+
+//--- Known FNV-1a (32 bit) test vectors, so a change to the hash can't silently stop names matching
+static_assert(UniformID::GetHash("") == 2166136261u, "FNV-1a hash of \"\" is wrong");
+static_assert(UniformID::GetHash("a") == 0xe40c292cu, "FNV-1a hash of \"a\" is wrong");
+static_assert(UniformID::GetHash("foobar") == 0xbf9cf968u, "FNV-1a hash of \"foobar\" is wrong");
\ No newline at end of file
@@ -23,6 +23,9 @@ void GameManager::Initialize(const std::string& title, bool fullScreen, bool cor
 
 	File::Instance()->Initialize("Assets\\Files\\srExtensions.ext");
 
+	//--- Start the worker threads (one per core, including this one)
+	m_jobSystem.Start();
+
 	//--- Initialize the game window
 	Screen::Instance()->Initialize(title, WIDTH, HEIGHT, OPENGL_VERSION, OPENGL_SUBVERSION, fullScreen, coreMode, vSync);
 
@@ -48,6 +51,9 @@ void GameManager::Initialize(const std::string& title, bool fullScreen, bool cor
 *******************************************************************************************************************/
 void GameManager::Shutdown()
 {
+	//--- Finish any jobs still running before the systems they might be using are shut down
+	m_jobSystem.Stop();
+
 	Resource::Instance()->Shutdown();
 	Audio::Instance()->Shutdown();
 	GUI::Instance()->Shutdown();
@@ -94,6 +100,9 @@ void GameManager::Run()
 			//--- Update the game and process all physics depending on the timestep amount
 			Update();
 
+			//--- Run any jobs that had to wait for the main thread (e.g. uploading data to the GPU)
+			m_jobSystem.RunMainThreadJobs();
+
 			//--- Render all graphics
 			Render();
 
@@ -181,30 +190,21 @@ void GameManager::Update()
 	//--- Update the in-game audio
 	Audio::Instance()->Update();
 
-	//--- Default frame time = (MS per second / Default FPS) = (1000.0f / 60.0f) = (approx)16.6ms
-	const float defaultFrameTime = Timer::GetDefaultFrameTime();
+	//--- Add the time since the last frame on to the timestep - returns number of milliseconds since the game timer was initialized
+	m_timestep.Update(m_gameTimer.ElapsedMilliseconds());
 
-	//--- Current ticks - returns number of milliseconds since the game timer was initialized
-	float currentTicks = m_gameTimer.ElapsedMilliseconds();
-	
-	//--- Previous ticks - returns number of ticks since the last frame
-	float previousTicks	= m_gameTimer.GetThisFrame()->previousTicks;
-	
-	//--- If (current ticks - previous ticks) is greater than (approx)16.6ms
-	if ((currentTicks - previousTicks) > defaultFrameTime) {
+	//--- Update the game in fixed steps of (approx)16.6ms, as many times as the time passed allows (up to a limit)
+	while (m_timestep.Tick()) {
 
-		//--- Update the timestep with the current ticks
-		m_timestep.Update(currentTicks);
-		
-		//--- Update the game updates with the delta time calculated
+		//--- If an update has ended the current game state, just use up the rest of this frame's time
+		if (!m_gameStates.CurrentState()->IsActive()) { continue; }
+
+		//--- Update the game updates with the fixed delta time
 		m_gameStates.CurrentState()->Update();
 
 		//--- Set the update count + 1
 		m_gameTimer.GetThisFrame()->updates++;
 
-		//--- Append the previous ticks + (approx)16.6ms
-		m_gameTimer.GetThisFrame()->previousTicks += defaultFrameTime;
-
 		//--- Game has been loaded for the first time, now allow rendering 
 		//--- (precautionary only - just makes sure objects have updated at least once before graphics being drawn)
 		if (!m_hasLoaded) { m_hasLoaded = true; }
@@ -260,6 +260,9 @@ void GameManager::ConcludeTime()
 
 		//--- Store the updates per this second
 		m_gameTimer.SetUpdatesPerSecond(m_gameTimer.GetThisFrame()->updates);
+
+		//--- Store how busy each job system worker was this second
+		m_jobSystem.UpdateStats();
 		
 		//--- Then reset the frames and updates to 0
 		m_gameTimer.GetThisFrame()->frames = 0;
@@ -272,7 +275,11 @@ void GameManager::ConcludeTime()
 	Accessor methods
 *******************************************************************************************************************/
 GameManager::GameStates* GameManager::GetStates()		{ return &m_gameStates; }
+JobSystem* GameManager::GetJobSystem()					{ return &m_jobSystem; }
 unsigned int GameManager::GetFramesPerSecond() const	{ return m_gameTimer.GetFramesPerSecond(); }
 float GameManager::GetCurrentFrameTime() const			{ return m_gameTimer.GetCurrentFrameTime(); }
 int	GameManager::GetMainframePercentage() 				{ return m_mainframeTracker.GetMainframePercentage(); }
-float GameManager::GetDeltaTime() const					{ return m_timestep.GetDeltaTime(); }
\ No newline at end of file
+float GameManager::GetDeltaTime() const					{ return m_timestep.GetDeltaTime(); }
+float GameManager::GetInterpolation() const				{ return m_timestep.GetInterpolation(); }
+unsigned int GameManager::GetTick() const				{ return m_timestep.GetTick(); }
+bool GameManager::IsTicking() const						{ return m_jobSystem.IsMainThread() && m_timestep.IsTicking(); }
\ No newline at end of file
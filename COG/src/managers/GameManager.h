@@ -10,12 +10,16 @@
 	[Features]
 	Supports game states using a finite state machine.
 	Performance trackers - support for FPS, frame time, update time, delta time and CPU usage.
+	Fixed timestep updates - the game is updated at a steady 60 updates per second however fast it renders, and
+	rendering interpolates between the last two updates (see Transform and Camera GetRender...() functions).
+	Owns the job system - started on Initialize(), stopped on Shutdown(), main thread jobs run once a frame.
 	
 	[Upcoming]
 	Nothing at present.
 
 	[Side Notes]
-	Nothing at present.
+	IsTicking() is only ever true on the main thread, so objects changed on any other thread (e.g. the text the
+	render thread positions) are never interpolated.
 
 *******************************************************************************************************************/
 #include <string>
@@ -43,6 +47,7 @@
 #include "utilities/Timer.h"
 #include "utilities/Timestep.h"
 #include "utilities/MainframeTracker.h"
+#include "utilities/JobSystem.h"
 
 class GameManager {
 
@@ -59,12 +64,16 @@ public:
 
 public:
 	GameStates*		GetStates();
+	JobSystem*		GetJobSystem();
 
 public:
 	unsigned int	GetFramesPerSecond() const;
 	float			GetCurrentFrameTime() const;
 	int				GetMainframePercentage();
 	float			GetDeltaTime() const;
+	float			GetInterpolation() const;
+	unsigned int	GetTick() const;
+	bool			IsTicking() const;
 
 private:
 	void LoadAudio();
@@ -91,6 +100,7 @@ private:
 	Timer				m_gameTimer;
 	Timestep			m_timestep;
 	MainframeTracker	m_mainframeTracker;
+	JobSystem			m_jobSystem;
 	bool				m_hasLoaded;
 };
 
@@ -26,9 +26,9 @@ void ResourceManager::Shutdown()
 /*******************************************************************************************************************
 	A function that adds a new font to our font cache and relevant buffers needed to the buffer cache
 *******************************************************************************************************************/
-void ResourceManager::AddFont(const std::string& tag, const std::map<GLchar, FontCache::Character>& characters)
+void ResourceManager::AddFont(const std::string& tag, const FontCache::Font& font)
 {
-	m_fontCache.AddFont(tag, characters);
+	m_fontCache.AddFont(tag, font);
 
 	//--- Fonts in this program will always have just 2 buffers - vertices and UV's - and won't be drawn indexed
 	m_bufferCache.AddBuffers(tag, false, true);
@@ -71,6 +71,15 @@ FontCache::Character* ResourceManager::GetFontCharacter(const std::string& tag,
 }
 
 
+/*******************************************************************************************************************
+	A function that returns the atlas texture of a font already in our font cache
+*******************************************************************************************************************/
+GLuint ResourceManager::GetFontAtlas(const std::string& tag)
+{
+	return m_fontCache.GetAtlas(tag);
+}
+
+
 /*******************************************************************************************************************
 	A function that returns an OpenGL texture ID already in memory
 *******************************************************************************************************************/
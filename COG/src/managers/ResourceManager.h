@@ -43,7 +43,7 @@ public:
 	void Shutdown();
 
 public:
-	void AddFont(const std::string& tag, const std::map<GLchar, FontCache::Character>& glyphs);
+	void AddFont(const std::string& tag, const FontCache::Font& font);
 	void AddTexture(const std::string& tag, GLuint id);
 
 public:
@@ -62,6 +62,7 @@ public:
 
 public:
 	FontCache::Character*	GetFontCharacter(const std::string& tag, GLchar character);
+	GLuint					GetFontAtlas(const std::string& tag);
 	const GLuint&			GetTexture(const std::string& tag);
 
 public:
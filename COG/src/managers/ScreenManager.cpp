@@ -4,6 +4,7 @@
 #include "ScreenManager.h"
 #include "managers/InputManager.h"
 #include "utilities/Log.h"
+#include "cache/StateCache.h"
 
 /*******************************************************************************************************************
 	Constructor with initializer list to set default values of data members
@@ -177,6 +178,8 @@ void ScreenManager::InitializeOrthographic()
 *******************************************************************************************************************/
 void ScreenManager::PerspectiveView(bool perspective, bool useDefault)
 {
+	std::lock_guard<std::mutex> lock(m_perspectiveLock);
+
 	(perspective)	? (useDefault) ? m_projection = m_defaultPerspective	: m_projection = m_perspective
 																			: m_projection = m_orthographic;
 }
@@ -198,6 +201,23 @@ void ScreenManager::BeginScene(float r, float g, float b)
 void ScreenManager::EndScene()
 {
 	SDL_GL_SwapWindow(m_window);
+
+	GLState::Instance()->EndFrame();
+}
+
+
+/*******************************************************************************************************************
+	Function that makes the OpenGL context current on (or releases it from) the calling thread - a context can only
+	be current on one thread at a time, so it must be released before another thread takes it
+*******************************************************************************************************************/
+bool ScreenManager::MakeContextCurrent(bool isCurrent)
+{
+	if (SDL_GL_MakeCurrent(m_window, isCurrent ? m_context : nullptr) != 0) {
+		COG_LOG("[SCREEN] OpenGL context could not be made current: ", SDL_GetError(), LOG_ERROR);
+		return false;
+	}
+
+	return true;
 }
 
 
@@ -379,6 +399,7 @@ float ScreenManager::GetWidth() const						{ return (float)m_width; }
 float ScreenManager::GetHeight() const						{ return (float)m_height; }
 float ScreenManager::GetFieldOfView() const					{ return m_fieldOfView; }
 const glm::mat4& ScreenManager::GetProjectionMatrix() const	{ return m_projection; }
+glm::mat4 ScreenManager::GetPerspectiveMatrix() const		{ std::lock_guard<std::mutex> lock(m_perspectiveLock); return m_perspective; }
 float ScreenManager::GetAnisotropy() const					{ return m_anisotropy; }
 bool ScreenManager::IsAnisotropySupported() const			{ return m_isAnisotropySupported; }
 
@@ -390,5 +411,7 @@ void ScreenManager::SetFieldOfView(float fieldOfView)
 {
 	using namespace screen_constants;
 
+	std::lock_guard<std::mutex> lock(m_perspectiveLock);
+
 	m_perspective = glm::perspective(m_fieldOfView += fieldOfView, GetAspectRatio(), NEAR_VIEW, FAR_VIEW);
 }
\ No newline at end of file
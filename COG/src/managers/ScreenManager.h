@@ -13,19 +13,23 @@
 	Supports anisotropy filtering.
 	Supports perspective and orthographic screen projections (plus default perspective for when using minimaps)
 	Simple functions to toggle different graphical settings on/off.
+	The OpenGL context can be handed over to another thread (MakeContextCurrent()), e.g. the render thread.
 
 	[Upcoming]
 	Ability to toggle fullscreen/windowed mode on/off within the game.
 	Multiple resolution support (reading the resolution from the users PC, as opposed to hard-coding it)
 
 	[Side Notes]
-	Nothing at present.
+	GetProjectionMatrix() is whichever projection was last chosen with PerspectiveView(), so it belongs to whichever
+	thread is rendering. Anything else (e.g. the frustum and mouse ray) should use GetPerspectiveMatrix(), which is
+	safe to call while another thread renders.
 
 *******************************************************************************************************************/
 #include <pretty_sdl/sdl.h>
 #include <pretty_opengl/glew.h>
 #include <pretty_glm/glm.hpp>
 #include <string>
+#include <mutex>
 
 #include "utilities/Singleton.h"
 
@@ -59,6 +63,7 @@ public:
 public:
 	void BeginScene(float r, float g, float b);
 	void EndScene();
+	bool MakeContextCurrent(bool isCurrent);
 
 public:
 	SDL_Window*			GetWindow() const;
@@ -67,6 +72,7 @@ public:
 	float				GetHeight() const;
 	float				GetFieldOfView() const;
 	const glm::mat4&	GetProjectionMatrix() const;
+	glm::mat4			GetPerspectiveMatrix() const;
 	float				GetAnisotropy() const;
 	bool				IsAnisotropySupported() const;
 
@@ -122,6 +128,9 @@ private:
 	glm::mat4		m_orthographic;
 
 	glm::mat4		m_defaultPerspective;
+
+	//--- Guards the perspective matrix, as the camera zooms on the update thread while the render thread uses it
+	mutable std::mutex	m_perspectiveLock;
 };
 
 typedef Singleton<ScreenManager> Screen;
\ No newline at end of file
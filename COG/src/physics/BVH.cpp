@@ -0,0 +1,331 @@
+#include <algorithm>
+#include "BVH.h"
+#include "utilities/Simd.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+BVH::BVH()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+BVH::~BVH()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an object - it won't be hit by any rays until Build() is called
+*******************************************************************************************************************/
+void BVH::Add(unsigned int ID, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	m_objects.push_back({ minimum, maximum, (minimum + maximum) * 0.5f, ID });
+}
+
+
+/*******************************************************************************************************************
+	Function that removes every object and node
+*******************************************************************************************************************/
+void BVH::Clear()
+{
+	m_objects.clear();
+	m_nodes.clear();
+}
+
+
+/*******************************************************************************************************************
+	Function that builds the hierarchy from the objects added so far, replacing any previous hierarchy
+*******************************************************************************************************************/
+void BVH::Build()
+{
+	m_nodes.clear();
+
+	if (m_objects.empty()) { return; }
+
+	//--- A binary tree with n leaves never has more than 2n - 1 nodes, so the node array never has to grow mid-build
+	m_nodes.reserve(m_objects.size() * 2);
+	m_nodes.emplace_back();
+
+	BuildNode(0, 0, (unsigned int)m_objects.size());
+}
+
+
+/*******************************************************************************************************************
+	Function that sets the bounds of a node, then splits it in two at the median object along its longest axis
+*******************************************************************************************************************/
+void BVH::BuildNode(unsigned int node, unsigned int first, unsigned int count)
+{
+	glm::vec3 minimum		= m_objects[first].minimum;
+	glm::vec3 maximum		= m_objects[first].maximum;
+	glm::vec3 minimumCenter	= m_objects[first].center;
+	glm::vec3 maximumCenter	= m_objects[first].center;
+
+	for (unsigned int i = first + 1; i < first + count; i++) {
+		minimum			= glm::min(minimum, m_objects[i].minimum);
+		maximum			= glm::max(maximum, m_objects[i].maximum);
+		minimumCenter	= glm::min(minimumCenter, m_objects[i].center);
+		maximumCenter	= glm::max(maximumCenter, m_objects[i].center);
+	}
+
+	m_nodes[node].minimum	= minimum;
+	m_nodes[node].maximum	= maximum;
+	m_nodes[node].first		= first;
+	m_nodes[node].count		= count;
+	m_nodes[node].axis		= 0;
+
+	//--- Split along whichever axis the object centers are most spread out on
+	glm::vec3 extent	= maximumCenter - minimumCenter;
+	unsigned int axis	= (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z) ? 1 : 2;
+
+	//--- Stop at small nodes, or if every object has the same center (no split would separate them)
+	if (count <= s_maxLeafObjects || extent[axis] <= 0.0f) { return; }
+
+	unsigned int middle = first + count / 2;
+
+	std::nth_element(m_objects.begin() + first, m_objects.begin() + middle, m_objects.begin() + first + count,
+					 [axis](const Object& a, const Object& b) { return a.center[axis] < b.center[axis]; });
+
+	unsigned int children = (unsigned int)m_nodes.size();
+	m_nodes.emplace_back();
+	m_nodes.emplace_back();
+
+	m_nodes[node].first = children;
+	m_nodes[node].count = 0;
+	m_nodes[node].axis	= axis;
+
+	BuildNode(children, first, middle - first);
+	BuildNode(children + 1, middle, first + count - middle);
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the nearest object hit by a ray, within its range
+*******************************************************************************************************************/
+bool BVH::Raycast(const Ray& ray, Hit& hit) const
+{
+	hit = { 0, ray.range, false };
+
+	if (m_nodes.empty()) { return false; }
+
+	//--- Inverse the direction once, so every slab test can multiply instead of divide
+	glm::vec3 inverseDirection = 1.0f / ray.direction;
+
+	//--- Median splits keep the tree balanced, so 64 entries is far more than the stack will ever need
+	unsigned int stack[64];
+	unsigned int top = 0;
+
+	stack[top++] = 0;
+
+	while (top > 0) {
+
+		const Node& node = m_nodes[stack[--top]];
+
+		float entry, exit;
+
+		//--- Skip the node if the ray misses it, or if it is further away than the nearest hit so far
+		if (!IsIntersecting(ray.origin, inverseDirection, node.minimum, node.maximum, entry, exit) ||
+			std::max(entry, 0.0f) > std::min(exit, hit.distance)) { continue; }
+
+		if (node.count > 0) {
+
+			for (unsigned int i = node.first; i < node.first + node.count; i++) {
+
+				const Object& object = m_objects[i];
+
+				//--- An entry behind the origin means the ray starts inside the object (or it is behind us), so it doesn't count
+				if (IsIntersecting(ray.origin, inverseDirection, object.minimum, object.maximum, entry, exit) &&
+					entry >= 0.0f && entry < hit.distance) {
+					hit = { object.ID, entry, true };
+				}
+			}
+		}
+		else {
+
+			//--- The first child holds the objects with the smaller centers along the split axis, so if the ray is
+			//--- heading along the positive axis it is usually the nearer child, and gets pushed last so it's visited first
+			if (ray.direction[node.axis] >= 0.0f)	{ stack[top++] = node.first + 1; stack[top++] = node.first; }
+			else									{ stack[top++] = node.first; stack[top++] = node.first + 1; }
+		}
+	}
+
+	return hit.isHit;
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the nearest object hit by each ray in a batch, setting hits[i] for rays[i]
+*******************************************************************************************************************/
+void BVH::Raycast(const std::vector<Ray>& rays, std::vector<Hit>& hits) const
+{
+	hits.resize(rays.size());
+
+	unsigned int count = (unsigned int)rays.size();
+	unsigned int index = 0;
+
+	if (m_nodes.empty()) {
+		for (; index < count; index++) { hits[index] = { 0, rays[index].range, false }; }
+		return;
+	}
+
+#if COG_SIMD == 1
+	//--- Trace 4 rays at once through the hierarchy, with the last packet padded out if needed
+	for (; index < count; index += 4) {
+		RaycastPacket(&rays[index], &hits[index], std::min(count - index, 4u));
+	}
+#endif
+
+	//--- Without SSE, every ray is traced one at a time
+	for (; index < count; index++) { Raycast(rays[index], hits[index]); }
+}
+
+
+/*******************************************************************************************************************
+	Function that traces a packet of up to 4 rays through the hierarchy together, using SSE slab tests
+*******************************************************************************************************************/
+void BVH::RaycastPacket(const Ray* rays, Hit* hits, unsigned int count) const
+{
+#if COG_SIMD == 1
+	//--- NOTE
+	// Each SSE lane holds one ray. A node is visited if any of the rays could still hit something nearer inside it,
+	// and each lane keeps its own nearest hit. Unused lanes have a negative range, so they can never hit anything.
+	// The traversal order comes from the first ray - rays in a batch (e.g. touches, or AI sensors) tend to point the
+	// same way, and even if they don't, the results are still correct, just not as quick.
+	//---
+
+	alignas(16) float originX[4], originY[4], originZ[4];
+	alignas(16) float inverseX[4], inverseY[4], inverseZ[4];
+	alignas(16) float range[4];
+
+	for (unsigned int i = 0; i < 4; i++) {
+
+		const Ray& ray = rays[std::min(i, count - 1)];
+
+		originX[i]	= ray.origin.x;
+		originY[i]	= ray.origin.y;
+		originZ[i]	= ray.origin.z;
+		inverseX[i]	= 1.0f / ray.direction.x;
+		inverseY[i]	= 1.0f / ray.direction.y;
+		inverseZ[i]	= 1.0f / ray.direction.z;
+		range[i]	= (i < count) ? ray.range : -1.0f;
+	}
+
+	const __m128 zero		= _mm_setzero_ps();
+	const __m128 rayX		= _mm_load_ps(originX);
+	const __m128 rayY		= _mm_load_ps(originY);
+	const __m128 rayZ		= _mm_load_ps(originZ);
+	const __m128 inverseDX	= _mm_load_ps(inverseX);
+	const __m128 inverseDY	= _mm_load_ps(inverseY);
+	const __m128 inverseDZ	= _mm_load_ps(inverseZ);
+
+	__m128	nearest	= _mm_load_ps(range);
+	__m128	isHit	= zero;
+	__m128i	IDs		= _mm_setzero_si128();
+
+	//--- Works out where each ray enters and exits a box, exactly like IsIntersecting() but for all 4 rays
+	auto slab = [&](const glm::vec3& minimum, const glm::vec3& maximum, __m128& entry, __m128& exit) {
+
+		__m128 nearX = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(minimum.x), rayX), inverseDX);
+		__m128 farX	 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(maximum.x), rayX), inverseDX);
+		__m128 nearY = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(minimum.y), rayY), inverseDY);
+		__m128 farY	 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(maximum.y), rayY), inverseDY);
+		__m128 nearZ = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(minimum.z), rayZ), inverseDZ);
+		__m128 farZ	 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(maximum.z), rayZ), inverseDZ);
+
+		entry	= _mm_max_ps(_mm_max_ps(_mm_min_ps(nearX, farX), _mm_min_ps(nearY, farY)), _mm_min_ps(nearZ, farZ));
+		exit	= _mm_min_ps(_mm_min_ps(_mm_max_ps(nearX, farX), _mm_max_ps(nearY, farY)), _mm_max_ps(nearZ, farZ));
+	};
+
+	unsigned int stack[64];
+	unsigned int top = 0;
+
+	stack[top++] = 0;
+
+	while (top > 0) {
+
+		const Node& node = m_nodes[stack[--top]];
+
+		__m128 entry, exit;
+		slab(node.minimum, node.maximum, entry, exit);
+
+		//--- Skip the node if every ray misses it, or it is further away than each ray's nearest hit so far
+		if (_mm_movemask_ps(_mm_cmple_ps(_mm_max_ps(entry, zero), _mm_min_ps(exit, nearest))) == 0) { continue; }
+
+		if (node.count > 0) {
+
+			for (unsigned int i = node.first; i < node.first + node.count; i++) {
+
+				const Object& object = m_objects[i];
+				slab(object.minimum, object.maximum, entry, exit);
+
+				__m128 isNearer = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(entry, zero), _mm_cmple_ps(entry, exit)),
+											 _mm_cmplt_ps(entry, nearest));
+
+				//--- Only the lanes that hit something nearer take the new distance and ID
+				nearest = _mm_or_ps(_mm_and_ps(isNearer, entry), _mm_andnot_ps(isNearer, nearest));
+				IDs		= _mm_or_si128(_mm_and_si128(_mm_castps_si128(isNearer), _mm_set1_epi32((int)object.ID)),
+									   _mm_andnot_si128(_mm_castps_si128(isNearer), IDs));
+				isHit	= _mm_or_ps(isHit, isNearer);
+			}
+		}
+		else {
+			if (rays[0].direction[node.axis] >= 0.0f)	{ stack[top++] = node.first + 1; stack[top++] = node.first; }
+			else										{ stack[top++] = node.first; stack[top++] = node.first + 1; }
+		}
+	}
+
+	alignas(16) float distances[4];
+	alignas(16) unsigned int hitIDs[4];
+
+	_mm_store_ps(distances, nearest);
+	_mm_store_si128((__m128i*)hitIDs, IDs);
+
+	int hitMask = _mm_movemask_ps(isHit);
+
+	for (unsigned int i = 0; i < count; i++) {
+		hits[i] = { hitIDs[i], distances[i], (hitMask & (1 << i)) != 0 };
+	}
+#else
+	for (unsigned int i = 0; i < count; i++) { Raycast(rays[i], hits[i]); }
+#endif
+}
+
+
+/*******************************************************************************************************************
+	A function which checks if a ray (line) hits a box, and where along the ray it enters and exits the box
+	References:
+	https://gamedev.stackexchange.com/questions/18436/most-efficient-aabb-vs-ray-collision-algorithms
+	http://www.realtimerendering.com/intersections.html
+*******************************************************************************************************************/
+bool BVH::IsIntersecting(const glm::vec3& origin, const glm::vec3& inverseDirection,
+						 const glm::vec3& minimum, const glm::vec3& maximum, float& entry, float& exit)
+{
+	glm::vec3 nearest	= (minimum - origin) * inverseDirection;
+	glm::vec3 furthest	= (maximum - origin) * inverseDirection;
+
+	glm::vec3 lower	= glm::min(nearest, furthest);
+	glm::vec3 upper	= glm::max(nearest, furthest);
+
+	entry	= std::max(std::max(lower.x, lower.y), lower.z);
+	exit	= std::min(std::min(upper.x, upper.y), upper.z);
+
+	return entry <= exit;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+unsigned int BVH::GetCount() const		{ return (unsigned int)m_objects.size(); }
+unsigned int BVH::GetNodeCount() const	{ return (unsigned int)m_nodes.size(); }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const unsigned int BVH::s_maxLeafObjects = 4;
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+/*******************************************************************************************************************
+	BVH.h, BVH.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A bounding volume hierarchy over axis aligned bounding boxes, used to find the nearest object a ray hits
+	without testing the ray against every object in the scene.
+
+	[Features]
+	Built top down, splitting each node at the median object along its longest axis.
+	Nearest hit queries - returns which object was hit first and how far along the ray it was.
+	Near child first traversal, so branches further away than the nearest hit so far are skipped.
+	Batches of rays are traced 4 at a time with SSE slab tests (falls back to one ray at a time without SSE).
+
+	[Upcoming]
+	Refitting the node bounds when objects move, rather than a full re-build.
+	Surface area heuristic splits, if we ever have scenes big enough for it to matter.
+
+	[Side Notes]
+	Objects are identified by an ID of your choosing, which is what a hit contains.
+	Add() and Clear() only change the list of objects - call Build() before tracing any rays.
+	Ray directions should be normalized, so that the hit distance (and the range) is in world units.
+	Objects that contain the ray's origin are ignored (you can't pick the box you are standing in).
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <vector>
+
+class BVH {
+
+public:
+	struct Ray {
+		glm::vec3	origin;
+		glm::vec3	direction;
+		float		range;
+	};
+
+	struct Hit {
+		unsigned int	ID;
+		float			distance;
+		bool			isHit;
+	};
+
+private:
+	//--- A leaf has a count and its objects start at first, otherwise its children are at first and first + 1
+	struct Node {
+		glm::vec3		minimum, maximum;
+		unsigned int	first;
+		unsigned int	count;
+		unsigned int	axis;
+	};
+
+	struct Object {
+		glm::vec3		minimum, maximum;
+		glm::vec3		center;
+		unsigned int	ID;
+	};
+
+public:
+	BVH();
+	~BVH();
+
+public:
+	void Add(unsigned int ID, const glm::vec3& minimum, const glm::vec3& maximum);
+	void Clear();
+	void Build();
+
+public:
+	bool Raycast(const Ray& ray, Hit& hit) const;
+	void Raycast(const std::vector<Ray>& rays, std::vector<Hit>& hits) const;
+
+public:
+	unsigned int GetCount() const;
+	unsigned int GetNodeCount() const;
+
+private:
+	BVH(const BVH&)				= delete;
+	BVH& operator=(const BVH&)	= delete;
+
+private:
+	void BuildNode(unsigned int node, unsigned int first, unsigned int count);
+	void RaycastPacket(const Ray* rays, Hit* hits, unsigned int count) const;
+
+private:
+	static bool IsIntersecting(const glm::vec3& origin, const glm::vec3& inverseDirection,
+							   const glm::vec3& minimum, const glm::vec3& maximum, float& entry, float& exit);
+
+private:
+	std::vector<Node>	m_nodes;
+	std::vector<Object>	m_objects;
+
+private:
+	static const unsigned int s_maxLeafObjects;
+};
\ No newline at end of file
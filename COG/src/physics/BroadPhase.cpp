@@ -0,0 +1,261 @@
+#include <algorithm>
+#include "BroadPhase.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+BroadPhase::BroadPhase()
+	:	m_count(0),
+		m_addedCount(0)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+BroadPhase::~BroadPhase()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that removes every object and pair
+*******************************************************************************************************************/
+void BroadPhase::Clear()
+{
+	m_objects.clear();
+	m_freeObjects.clear();
+	m_pairs.clear();
+	m_count			= 0;
+	m_addedCount	= 0;
+
+	for (auto& endpoints : m_endpoints) { endpoints.clear(); }
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an object and returns the handle used to update or remove it
+*******************************************************************************************************************/
+BroadPhase::Handle BroadPhase::Add(unsigned int ID, const glm::vec3& minimum, const glm::vec3& maximum, unsigned int layer, unsigned int mask)
+{
+	Handle handle;
+
+	//--- Re-use the slot of a removed object if we have one, so handles stay small
+	if (!m_freeObjects.empty())	{ handle = m_freeObjects.back(); m_freeObjects.pop_back(); }
+	else						{ handle = (Handle)m_objects.size(); m_objects.emplace_back(); }
+
+	m_objects[handle] = { minimum, maximum, ID, layer, mask, true };
+	m_count++;
+	m_addedCount++;
+
+	//--- NOTE
+	// The new endpoints go on the end of each axis and get sorted into place by the next FindPairs().
+	// As the min endpoint slides left past the max endpoint of any object it overlaps, the pair gets picked up
+	// exactly the same way as when two objects move into each other. If a lot of objects were added at once
+	// (e.g. when a level loads) the insertion sort would be slow, so FindPairs() rebuilds everything instead.
+	//---
+
+	m_endpoints[AXIS_X].push_back({ minimum.x, handle });
+	m_endpoints[AXIS_X].push_back({ maximum.x, handle | s_maxFlag });
+	m_endpoints[AXIS_Z].push_back({ minimum.z, handle });
+	m_endpoints[AXIS_Z].push_back({ maximum.z, handle | s_maxFlag });
+
+	return handle;
+}
+
+
+/*******************************************************************************************************************
+	Function that moves an object - the endpoints are only re-sorted when FindPairs() is called
+*******************************************************************************************************************/
+void BroadPhase::Update(Handle handle, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	m_objects[handle].minimum = minimum;
+	m_objects[handle].maximum = maximum;
+}
+
+
+/*******************************************************************************************************************
+	Function that removes an object and any pairs it was part of. The handle must not be used again
+*******************************************************************************************************************/
+void BroadPhase::Remove(Handle handle)
+{
+	for (auto& endpoints : m_endpoints) {
+		endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+						[handle](const Endpoint& endpoint) { return (endpoint.data & ~s_maxFlag) == handle; }), endpoints.end());
+	}
+
+	for (auto pair = m_pairs.begin(); pair != m_pairs.end();) {
+		if ((Handle)(*pair >> 32) == handle || (Handle)(*pair & 0xFFFFFFFF) == handle)	{ pair = m_pairs.erase(pair); }
+		else																			{ ++pair; }
+	}
+
+	m_objects[handle].isActive = false;
+	m_freeObjects.push_back(handle);
+	m_count--;
+}
+
+
+/*******************************************************************************************************************
+	Function that sorts the endpoints and returns the ID of both objects for every overlapping pair
+*******************************************************************************************************************/
+void BroadPhase::FindPairs(std::vector<Pair>& pairs)
+{
+	if (m_addedCount > m_count / s_rebuildFraction)	{ Rebuild(); }
+	else											{ SortAxis(AXIS_X); SortAxis(AXIS_Z); }
+
+	m_addedCount = 0;
+
+	pairs.clear();
+
+	//--- The pairs overlap on X and Z, so we only need to check the Y axis before reporting them
+	for (auto key : m_pairs) {
+
+		Handle first	= (Handle)(key >> 32);
+		Handle second	= (Handle)(key & 0xFFFFFFFF);
+
+		if (IsOverlapping(first, second, true)) { pairs.push_back({ m_objects[first].ID, m_objects[second].ID }); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that updates and insertion sorts the endpoints on one axis, adding/removing pairs as endpoints swap
+*******************************************************************************************************************/
+void BroadPhase::SortAxis(AxisType axis)
+{
+	std::vector<Endpoint>& endpoints = m_endpoints[axis];
+
+	//--- Pull the latest positions into the endpoints first
+	for (auto& endpoint : endpoints) {
+
+		const Object& object = m_objects[endpoint.data & ~s_maxFlag];
+
+		if (endpoint.data & s_maxFlag)	{ endpoint.value = (axis == AXIS_X) ? object.maximum.x : object.maximum.z; }
+		else							{ endpoint.value = (axis == AXIS_X) ? object.minimum.x : object.minimum.z; }
+	}
+
+	//--- NOTE
+	// When an endpoint moves left past another, the only swaps that matter are a min and a max:
+	// A min moving left past another object's max means they may have just started overlapping, so we check them.
+	// A max moving left past another object's min means they have just separated on this axis, so the pair is removed.
+	// Min past min, or max past max, doesn't change whether the two objects overlap.
+	// On equal values, mins sort before maxes - so boxes that are just touching count as overlapping (like AABounds3D).
+	//---
+
+	for (size_t i = 1; i < endpoints.size(); i++) {
+
+		Endpoint endpoint	= endpoints[i];
+		Handle handle		= endpoint.data & ~s_maxFlag;
+		bool isMax			= (endpoint.data & s_maxFlag) != 0;
+		size_t j			= i;
+
+		for (; j > 0 && (endpoints[j - 1].value > endpoint.value ||
+						 (endpoints[j - 1].value == endpoint.value && !isMax && (endpoints[j - 1].data & s_maxFlag))); j--) {
+
+			const Endpoint& other	= endpoints[j - 1];
+			Handle otherHandle		= other.data & ~s_maxFlag;
+			bool isOtherMax			= (other.data & s_maxFlag) != 0;
+
+			if (!isMax && isOtherMax) {
+				if (CanCollide(handle, otherHandle) && IsOverlapping(handle, otherHandle, false)) { m_pairs.insert(GetKey(handle, otherHandle)); }
+			}
+			else if (isMax && !isOtherMax) {
+				m_pairs.erase(GetKey(handle, otherHandle));
+			}
+
+			endpoints[j] = other;
+		}
+
+		endpoints[j] = endpoint;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that fully sorts both axes and finds every pair from scratch, with a single sweep along the X axis
+*******************************************************************************************************************/
+void BroadPhase::Rebuild()
+{
+	for (unsigned int axis = 0; axis < MAX_AXES; axis++) {
+
+		for (auto& endpoint : m_endpoints[axis]) {
+
+			const Object& object = m_objects[endpoint.data & ~s_maxFlag];
+
+			if (endpoint.data & s_maxFlag)	{ endpoint.value = (axis == AXIS_X) ? object.maximum.x : object.maximum.z; }
+			else							{ endpoint.value = (axis == AXIS_X) ? object.minimum.x : object.minimum.z; }
+		}
+
+		//--- Same order as the insertion sort - on equal values, mins go before maxes
+		std::sort(m_endpoints[axis].begin(), m_endpoints[axis].end(), [](const Endpoint& a, const Endpoint& b) {
+			if (a.value != b.value) { return a.value < b.value; }
+			return (a.data & s_maxFlag) < (b.data & s_maxFlag);
+		});
+	}
+
+	m_pairs.clear();
+
+	//--- Every object between its min and max on the X axis overlaps it on X, so only those need checking on Z
+	std::vector<Handle> active;
+
+	for (const auto& endpoint : m_endpoints[AXIS_X]) {
+
+		Handle handle = endpoint.data & ~s_maxFlag;
+
+		if (endpoint.data & s_maxFlag) {
+			active.erase(std::find(active.begin(), active.end(), handle));
+		}
+		else {
+			for (auto other : active) {
+				if (CanCollide(handle, other) && IsOverlapping(handle, other, false)) { m_pairs.insert(GetKey(handle, other)); }
+			}
+			active.push_back(handle);
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that checks if each object's layer is within the other object's collision mask
+*******************************************************************************************************************/
+bool BroadPhase::CanCollide(Handle first, Handle second) const
+{
+	return first != second && (m_objects[first].layer & m_objects[second].mask) && (m_objects[second].layer & m_objects[first].mask);
+}
+
+
+/*******************************************************************************************************************
+	Function that checks if the bounds of two objects overlap on the X and Z axes (and optionally the Y axis)
+*******************************************************************************************************************/
+bool BroadPhase::IsOverlapping(Handle first, Handle second, bool includeY) const
+{
+	const Object& a = m_objects[first];
+	const Object& b = m_objects[second];
+
+	return	(a.minimum.x <= b.maximum.x && b.minimum.x <= a.maximum.x) &&
+			(a.minimum.z <= b.maximum.z && b.minimum.z <= a.maximum.z) &&
+			(!includeY || (a.minimum.y <= b.maximum.y && b.minimum.y <= a.maximum.y));
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+unsigned int BroadPhase::GetCount() const { return m_count; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const unsigned int BroadPhase::s_maxFlag			= 0x80000000;
+const unsigned int BroadPhase::s_rebuildFraction	= 4;
+
+uint64_t BroadPhase::GetKey(Handle first, Handle second)
+{
+	//--- Always put the smaller handle first, so both orders give the same key
+	if (first > second) { std::swap(first, second); }
+	return ((uint64_t)first << 32) | second;
+}
\ No newline at end of file
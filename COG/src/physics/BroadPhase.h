@@ -0,0 +1,97 @@
+#pragma once
+
+/*******************************************************************************************************************
+	BroadPhase.h, BroadPhase.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A sweep and prune collision broad phase - finds every pair of bounding boxes that overlap, without testing every
+	box against every other box.
+
+	[Features]
+	Sorted endpoint (min/max) arrays on the X and Z axes, kept sorted with an insertion sort every frame.
+	As objects barely move between frames the arrays are nearly sorted, so the sort is close to linear.
+	A full sort and sweep is used instead when a lot of objects are added at once (e.g. on level load).
+	Overlapping pairs are tracked as endpoints swap, so only pairs that start/stop overlapping cost anything.
+	Collision layers - a pair is only reported if each object's layer is in the other object's collision mask.
+
+	[Upcoming]
+	Re-using a sorted axis for ray and range queries.
+
+	[Side Notes]
+	Objects are identified by an ID of your choosing (e.g. an index into your entity container), which is what the
+	pairs contain. Add() returns a handle, which is what you pass to Update() and Remove().
+	The Y axis isn't sorted (most of our objects sit on the terrain), but reported pairs always overlap on all 3 axes.
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+class BroadPhase {
+
+public:
+	typedef unsigned int Handle;
+
+	struct Pair {
+		unsigned int first, second;
+	};
+
+private:
+	enum AxisType { AXIS_X, AXIS_Z, MAX_AXES };
+
+	struct Object {
+		glm::vec3		minimum, maximum;
+		unsigned int	ID;
+		unsigned int	layer, mask;
+		bool			isActive;
+	};
+
+	//--- The handle is packed with a flag for whether this is the min or max of the object
+	struct Endpoint {
+		float			value;
+		unsigned int	data;
+	};
+
+public:
+	BroadPhase();
+	~BroadPhase();
+
+public:
+	Handle	Add(unsigned int ID, const glm::vec3& minimum, const glm::vec3& maximum, unsigned int layer = 1, unsigned int mask = ~0u);
+	void	Update(Handle handle, const glm::vec3& minimum, const glm::vec3& maximum);
+	void	Remove(Handle handle);
+	void	Clear();
+
+public:
+	void FindPairs(std::vector<Pair>& pairs);
+
+public:
+	unsigned int GetCount() const;
+
+private:
+	BroadPhase(const BroadPhase&)				= delete;
+	BroadPhase& operator=(const BroadPhase&)	= delete;
+
+private:
+	void SortAxis(AxisType axis);
+	void Rebuild();
+	bool CanCollide(Handle first, Handle second) const;
+	bool IsOverlapping(Handle first, Handle second, bool includeY) const;
+
+private:
+	static uint64_t GetKey(Handle first, Handle second);
+
+private:
+	std::vector<Object>			m_objects;
+	std::vector<Handle>			m_freeObjects;
+	std::vector<Endpoint>		m_endpoints[MAX_AXES];
+	std::unordered_set<uint64_t> m_pairs;
+	unsigned int				m_count;
+	unsigned int				m_addedCount;
+
+private:
+	static const unsigned int s_maxFlag;
+	static const unsigned int s_rebuildFraction;
+};
\ No newline at end of file
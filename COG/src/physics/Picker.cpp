@@ -11,7 +11,9 @@ Picker::Picker(Camera* camera)
 		m_origin(0.0f),
 		m_margin(0.0f),
 		m_direction(0.0f),
-		m_camera(camera)
+		m_inverseDirection(0.0f),
+		m_camera(camera),
+		m_isHierarchyDirty(false)
 {
 
 }
@@ -43,6 +45,9 @@ void Picker::Update()
 
 		m_margin	= (m_origin + m_ray);
 		m_direction = (m_margin - m_origin);
+
+		//--- Inverse the direction so we can multiply instead of divide (only when it changes, rather than every check)
+		m_inverseDirection = (1.0f / m_direction);
 	}
 }
 
@@ -56,14 +61,13 @@ void Picker::Update()
 *******************************************************************************************************************/
 bool Picker::IsColliding(const AABounds3D& bounds, float range)
 {
-	//--- Get an average distance to the origin based on the bounds min/max values
-	float distanceToOrigin = glm::distance(m_origin, (bounds.GetMin() + bounds.GetMax()) / 2.0f);
+	//--- Get an average distance to the origin based on the bounds min/max values (squared, to save a square root)
+	glm::vec3 offset = ((bounds.GetMin() + bounds.GetMax()) / 2.0f) - m_origin;
 
 	//--- We only perform collision checks if we are within range of the object
-	if (distanceToOrigin > range) { return false; }
+	if (glm::dot(offset, offset) > range * range) { return false; }
 	
-	//--- Inverse the direction so we can multiply instead of divide
-	glm::vec3 direction	= (1.0f / m_direction);
+	const glm::vec3& direction = m_inverseDirection;
 	glm::vec3 minimum	= glm::vec3(0.0f);
 	glm::vec3 maximum	= glm::vec3(0.0f);
 
@@ -98,10 +102,11 @@ bool Picker::IsColliding(const AABounds3D& bounds, float range)
 	//--- No collision
 	if ((minimum.x > maximum.z) || (minimum.z > maximum.x)) { return false; }
 
-	//--- Create a temporary bound for the origin of the ray and return false if the origin is inside the AABB
-	AABounds3D originBound(m_origin, glm::vec3(0.1f), glm::vec3(1.0f), true);
+	//--- Return false if the origin of the ray (padded out to a tiny 0.1 box) is inside the AABB
+	glm::vec3 padding = glm::vec3(0.05f);
 
-	if (originBound.IsColliding(bounds)) { return false; }
+	if (glm::all(glm::lessThanEqual(m_origin - padding, bounds.GetMax())) &&
+		glm::all(glm::lessThanEqual(bounds.GetMin(), m_origin + padding))) { return false; }
 	
 	//--- If the maximum values is less than or equal to 0
 	//--- The ray (line) is intersecting AABB, but the whole AABB is behind us, so return false
@@ -112,6 +117,51 @@ bool Picker::IsColliding(const AABounds3D& bounds, float range)
 }
 
 
+/*******************************************************************************************************************
+	A function which adds an object for Raycast() to check against - IDs are whatever the caller wants back in a hit
+*******************************************************************************************************************/
+void Picker::AddObject(unsigned int ID, const AABounds3D& bounds)
+{
+	m_hierarchy.Add(ID, bounds.GetMin(), bounds.GetMax());
+	m_isHierarchyDirty = true;
+}
+
+
+/*******************************************************************************************************************
+	A function which removes every object added for Raycast()
+*******************************************************************************************************************/
+void Picker::ClearObjects()
+{
+	m_hierarchy.Clear();
+	m_isHierarchyDirty = false;
+}
+
+
+/*******************************************************************************************************************
+	A function which finds the nearest object the mouse ray hits within range, and how far along the ray it is
+*******************************************************************************************************************/
+bool Picker::Raycast(float range, BVH::Hit& hit)
+{
+	if (m_isHierarchyDirty) { m_hierarchy.Build(); m_isHierarchyDirty = false; }
+
+	//--- The ray isn't normalized (see CalculateMouseRay), so normalize it here to get distances in world units
+	if (m_direction == glm::vec3(0.0f)) { hit = { 0, range, false }; return false; }
+
+	return m_hierarchy.Raycast({ m_origin, glm::normalize(m_direction), range }, hit);
+}
+
+
+/*******************************************************************************************************************
+	A function which finds the nearest object hit by each ray in a batch (directions should be normalized)
+*******************************************************************************************************************/
+void Picker::Raycast(const std::vector<BVH::Ray>& rays, std::vector<BVH::Hit>& hits)
+{
+	if (m_isHierarchyDirty) { m_hierarchy.Build(); m_isHierarchyDirty = false; }
+
+	m_hierarchy.Raycast(rays, hits);
+}
+
+
 /*******************************************************************************************************************
 	A function which calculates the 3D ray
 	Reference: http://antongerdelan.net/opengl/raycasting.html
@@ -157,9 +207,7 @@ glm::vec2 Picker::GetNormalizedDeviceCoordinates(const glm::vec2& mousePosition)
 *******************************************************************************************************************/
 glm::vec4 Picker::GetEyeSpaceCoordinates(const glm::vec4& clipCoordinates)
 {
-	Screen::Instance()->PerspectiveView(true);
-
-	glm::mat4 invertedProjection	= glm::inverse(Screen::Instance()->GetProjectionMatrix());
+	glm::mat4 invertedProjection	= glm::inverse(Screen::Instance()->GetPerspectiveMatrix());
 	glm::vec4 eyeCoordinates		= invertedProjection * clipCoordinates;
 
 	return glm::vec4(eyeCoordinates.x, eyeCoordinates.y, -1.0f, 0.0f);
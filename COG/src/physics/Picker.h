@@ -3,7 +3,7 @@
 /*******************************************************************************************************************
 	Picker.h, Picker.cpp
 	Created by Kim Kane
-	Last updated: 08/04/2018
+	Last updated: 18/10/2026
 
 	A picker class, which is used to cast a directional ray from a 2D point(x, y)
 	to a 3D position in world space.
@@ -11,17 +11,20 @@
 	[Features]
 	Supports mouse picking.
 	Only checks for collision's when object's are within range.
+	Raycasts against a BVH of scene objects, returning the nearest object hit and how far away it is.
+	Batches of rays (e.g. multiple touches, or AI line of sight checks) can be traced together.
 
 	[Upcoming]
 	Support for PS4 controller.
 
 	[Side Notes]
-	Nothing at present.
+	Objects added with AddObject() are picked up by the next Raycast() - the BVH is only re-built when they change.
 
 *******************************************************************************************************************/
 #include <pretty_glm/glm.hpp>
 #include "graphics/Camera.h"
 #include "physics/AABounds3D.h"
+#include "physics/BVH.h"
 
 class Picker {
 
@@ -38,6 +41,12 @@ public:
 public:
 	bool IsColliding(const AABounds3D& bounds, float range);
 
+public:
+	void AddObject(unsigned int ID, const AABounds3D& bounds);
+	void ClearObjects();
+	bool Raycast(float range, BVH::Hit& hit);
+	void Raycast(const std::vector<BVH::Ray>& rays, std::vector<BVH::Hit>& hits);
+
 private:
 	glm::vec3 CalculateMouseRay();
 	glm::vec2 GetNormalizedDeviceCoordinates(const glm::vec2& mousePosition);
@@ -49,7 +58,10 @@ private:
 	glm::vec3 m_origin;
 	glm::vec3 m_margin;
 	glm::vec3 m_direction;
+	glm::vec3 m_inverseDirection;
 	
 private:
 	Camera*		m_camera;
+	BVH			m_hierarchy;
+	bool		m_isHierarchyDirty;
 };
\ No newline at end of file
@@ -0,0 +1,427 @@
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include "QuadTree.h"
+#include "utilities/Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+QuadTree::QuadTree(const glm::vec3& minimum, const glm::vec3& maximum, unsigned int maxDepth)
+	:	m_minimum(minimum),
+		m_maximum(maximum),
+		m_maxDepth(maxDepth),
+		m_lastFrustumVersion(0),
+		m_isDirty(true)
+{
+	Clear();
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+QuadTree::~QuadTree()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that removes every object and node, leaving just the (square) root node covering the world bounds
+*******************************************************************************************************************/
+void QuadTree::Clear()
+{
+	m_nodes.clear();
+	m_items.clear();
+	m_freeItems.clear();
+	m_isDirty = true;
+
+	glm::vec2 center	= glm::vec2(m_minimum.x + m_maximum.x, m_minimum.z + m_maximum.z) * 0.5f;
+	float halfSize		= std::max(m_maximum.x - m_minimum.x, m_maximum.z - m_minimum.z) * 0.5f;
+
+	CreateNode(-1, center, std::max(halfSize, 1.0f));
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an object to the tree and returns the handle used to update or remove it
+*******************************************************************************************************************/
+QuadTree::Handle QuadTree::Insert(unsigned int ID, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	Handle handle;
+
+	//--- Re-use the slot of a removed object if we have one, so handles stay small and the item array doesn't grow
+	if (!m_freeItems.empty())	{ handle = m_freeItems.back(); m_freeItems.pop_back(); }
+	else						{ handle = (Handle)m_items.size(); m_items.emplace_back(); }
+
+	Item& item		= m_items[handle];
+	item.minimum	= minimum;
+	item.maximum	= maximum;
+	item.ID			= ID;
+	item.lastSide	= 0;
+
+	Link(handle, FindNode(minimum, maximum));
+
+	return handle;
+}
+
+
+/*******************************************************************************************************************
+	Function that moves an object - only re-linking it if it no longer belongs in the same node
+*******************************************************************************************************************/
+void QuadTree::Update(Handle handle, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	if (handle >= m_items.size() || m_items[handle].node < 0) {
+		COG_LOG("[QUAD TREE] Updating a handle that isn't in use: ", handle, LOG_ERROR); return;
+	}
+
+	Item& item = m_items[handle];
+
+	if (item.minimum == minimum && item.maximum == maximum) { return; }
+
+	item.minimum	= minimum;
+	item.maximum	= maximum;
+	m_isDirty		= true;
+
+	int node = FindNode(minimum, maximum);
+
+	if (node == item.node) {
+		GrowBounds(node, minimum, maximum);
+	}
+	else {
+		Unlink(handle);
+		Link(handle, node);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that removes an object from the tree. The handle must not be used again, unless returned by Insert()
+*******************************************************************************************************************/
+void QuadTree::Remove(Handle handle)
+{
+	//--- Removing a handle twice would put its slot on the free list twice, and two new objects would then share it
+	if (handle >= m_items.size() || m_items[handle].node < 0) {
+		COG_LOG("[QUAD TREE] Removing a handle that isn't in use: ", handle, LOG_ERROR); return;
+	}
+
+	Unlink(handle);
+	m_freeItems.push_back(handle);
+	m_isDirty = true;
+}
+
+
+/*******************************************************************************************************************
+	Function that finds (creating if needed) the deepest node an object fits into, from its size and center
+*******************************************************************************************************************/
+int QuadTree::FindNode(const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	//--- NOTE
+	// As the nodes are loose (their bounds reach half a node further out on each side), any object no bigger than a
+	// node fits inside the loose bounds of whichever node holds its center. So rather than testing bounds at every
+	// level, we just keep stepping down into the child holding the center while the object is no bigger than it.
+	//---
+
+	float size			= std::max(maximum.x - minimum.x, maximum.z - minimum.z);
+	glm::vec2 center	= glm::vec2(minimum.x + maximum.x, minimum.z + maximum.z) * 0.5f;
+	int node			= 0;
+
+	while (m_nodes[node].depth < m_maxDepth) {
+
+		float childHalfSize = m_nodes[node].halfSize * 0.5f;
+		if (size > childHalfSize * 2.0f) { break; }
+
+		int quadrant = ((center.x >= m_nodes[node].center.x) ? 1 : 0) | ((center.y >= m_nodes[node].center.y) ? 2 : 0);
+
+		if (m_nodes[node].children[quadrant] < 0) {
+			glm::vec2 childCenter = m_nodes[node].center + glm::vec2((quadrant & 1) ? childHalfSize : -childHalfSize,
+																	 (quadrant & 2) ? childHalfSize : -childHalfSize);
+
+			//--- Creating a node can move the node array, so only hold on to indices here
+			int child = CreateNode(node, childCenter, childHalfSize);
+			m_nodes[node].children[quadrant] = child;
+		}
+
+		node = m_nodes[node].children[quadrant];
+	}
+
+	return node;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds a new, empty node to the node array and returns its index
+*******************************************************************************************************************/
+int QuadTree::CreateNode(int parent, const glm::vec2& center, float halfSize)
+{
+	Node node;
+	node.center		= center;
+	node.halfSize	= halfSize;
+	node.depth		= (parent < 0) ? 0 : m_nodes[parent].depth + 1;
+	node.parent		= parent;
+	node.children[0] = node.children[1] = node.children[2] = node.children[3] = -1;
+	node.firstItem	= -1;
+	node.count		= 0;
+	node.lastSide	= 0;
+	node.minimum	= glm::vec3(std::numeric_limits<float>::max());
+	node.maximum	= glm::vec3(-std::numeric_limits<float>::max());
+
+	m_nodes.push_back(node);
+
+	return (int)m_nodes.size() - 1;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an object to the front of a node's object list
+*******************************************************************************************************************/
+void QuadTree::Link(Handle handle, int node)
+{
+	Item& item		= m_items[handle];
+	item.node		= node;
+	item.previous	= -1;
+	item.next		= m_nodes[node].firstItem;
+
+	if (item.next >= 0) { m_items[item.next].previous = (int)handle; }
+	m_nodes[node].firstItem = (int)handle;
+
+	for (int parent = node; parent >= 0; parent = m_nodes[parent].parent) { m_nodes[parent].count++; }
+
+	GrowBounds(node, item.minimum, item.maximum);
+	m_isDirty = true;
+}
+
+
+/*******************************************************************************************************************
+	Function that removes an object from its node's object list
+*******************************************************************************************************************/
+void QuadTree::Unlink(Handle handle)
+{
+	Item& item = m_items[handle];
+
+	if (item.previous >= 0)	{ m_items[item.previous].next = item.next; }
+	else					{ m_nodes[item.node].firstItem = item.next; }
+
+	if (item.next >= 0) { m_items[item.next].previous = item.previous; }
+
+	for (int parent = item.node; parent >= 0; parent = m_nodes[parent].parent) { m_nodes[parent].count--; }
+
+	item.node = -1;
+}
+
+
+/*******************************************************************************************************************
+	Function that grows the bounds of a node and all its parents, so they contain the bounds passed in
+*******************************************************************************************************************/
+void QuadTree::GrowBounds(int node, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	for (; node >= 0; node = m_nodes[node].parent) {
+
+		Node& current = m_nodes[node];
+
+		//--- Once a node already contains the bounds, so does every node above it
+		if (glm::all(glm::lessThanEqual(current.minimum, minimum)) && glm::all(glm::greaterThanEqual(current.maximum, maximum))) { break; }
+
+		current.minimum = glm::min(current.minimum, minimum);
+		current.maximum = glm::max(current.maximum, maximum);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the ID of every object inside the frustum
+*******************************************************************************************************************/
+void QuadTree::CullFrustum(const Frustum& frustum, std::vector<unsigned int>& results)
+{
+	//--- If the frustum hasn't moved (enough) and nothing in the tree has changed, the last results are still correct
+	if (!m_isDirty && frustum.GetVersion() == m_lastFrustumVersion) {
+		results = m_lastResults;
+		return;
+	}
+
+	results.clear();
+	CullNode(0, frustum, false, results);
+
+	m_lastResults			= results;
+	m_lastFrustumVersion	= frustum.GetVersion();
+	m_isDirty				= false;
+}
+
+
+/*******************************************************************************************************************
+	Recursive function that culls a node and its children against the frustum
+*******************************************************************************************************************/
+void QuadTree::CullNode(int node, const Frustum& frustum, bool isInside, std::vector<unsigned int>& results)
+{
+	Node& current = m_nodes[node];
+
+	if (current.count == 0) { return; }
+
+	//--- Once a node is fully inside the frustum, so is everything below it - no more tests needed
+	if (!isInside) {
+
+		Frustum::Intersection intersection = frustum.TestRectangle((current.minimum + current.maximum) * 0.5f,
+																   (current.maximum - current.minimum) * 0.5f,
+																   current.lastSide);
+
+		if (intersection == Frustum::OUTSIDE)	{ return; }
+		if (intersection == Frustum::INSIDE)	{ AddAll(node, results); return; }
+	}
+
+	for (int item = current.firstItem; item >= 0; item = m_items[item].next) {
+		if (frustum.IsRectangleInside((m_items[item].minimum + m_items[item].maximum) * 0.5f,
+									  (m_items[item].maximum - m_items[item].minimum) * 0.5f,
+									  m_items[item].lastSide)) {
+			results.push_back(m_items[item].ID);
+		}
+	}
+
+	for (int child : current.children) {
+		if (child >= 0) { CullNode(child, frustum, false, results); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Recursive function that adds every object in a node and its children, without any tests
+*******************************************************************************************************************/
+void QuadTree::AddAll(int node, std::vector<unsigned int>& results) const
+{
+	const Node& current = m_nodes[node];
+
+	if (current.count == 0) { return; }
+
+	for (int item = current.firstItem; item >= 0; item = m_items[item].next) { results.push_back(m_items[item].ID); }
+
+	for (int child : current.children) {
+		if (child >= 0) { AddAll(child, results); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the ID of every object whose bounds overlap the box passed in
+*******************************************************************************************************************/
+void QuadTree::QueryBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<unsigned int>& results) const
+{
+	results.clear();
+
+	std::vector<int> stack = { 0 };
+
+	while (!stack.empty()) {
+
+		const Node& current = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (current.count == 0 ||
+			glm::any(glm::lessThan(current.maximum, minimum)) || glm::any(glm::greaterThan(current.minimum, maximum))) {
+			continue;
+		}
+
+		for (int item = current.firstItem; item >= 0; item = m_items[item].next) {
+			if (glm::all(glm::lessThanEqual(m_items[item].minimum, maximum)) && glm::all(glm::greaterThanEqual(m_items[item].maximum, minimum))) {
+				results.push_back(m_items[item].ID);
+			}
+		}
+
+		for (int child : current.children) {
+			if (child >= 0) { stack.push_back(child); }
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the ID of every object whose bounds overlap the sphere passed in
+*******************************************************************************************************************/
+void QuadTree::QuerySphere(const glm::vec3& centerPosition, float radius, std::vector<unsigned int>& results) const
+{
+	results.clear();
+
+	float radiusSquared = radius * radius;
+	std::vector<int> stack = { 0 };
+
+	while (!stack.empty()) {
+
+		const Node& current = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (current.count == 0 || GetDistanceSquared(centerPosition, current.minimum, current.maximum) > radiusSquared) { continue; }
+
+		for (int item = current.firstItem; item >= 0; item = m_items[item].next) {
+			if (GetDistanceSquared(centerPosition, m_items[item].minimum, m_items[item].maximum) <= radiusSquared) {
+				results.push_back(m_items[item].ID);
+			}
+		}
+
+		for (int child : current.children) {
+			if (child >= 0) { stack.push_back(child); }
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that finds the object closest to a position (distance to its bounds), within the max distance
+*******************************************************************************************************************/
+bool QuadTree::FindNearest(const glm::vec3& position, float maxDistance, unsigned int& ID) const
+{
+	//--- NOTE
+	// Nodes are visited closest first, so as soon as the next node is further away than the best object found
+	// so far, nothing left can be any closer and we can stop.
+	//---
+
+	if (m_nodes[0].count == 0) { return false; }
+
+	typedef std::pair<float, int> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+	float best	= maxDistance * maxDistance;
+	bool found	= false;
+
+	queue.push({ GetDistanceSquared(position, m_nodes[0].minimum, m_nodes[0].maximum), 0 });
+
+	while (!queue.empty()) {
+
+		Entry entry = queue.top();
+		queue.pop();
+
+		if (entry.first > best) { break; }
+
+		const Node& current = m_nodes[entry.second];
+
+		for (int item = current.firstItem; item >= 0; item = m_items[item].next) {
+
+			float distance = GetDistanceSquared(position, m_items[item].minimum, m_items[item].maximum);
+
+			if (distance <= best) { best = distance; ID = m_items[item].ID; found = true; }
+		}
+
+		for (int child : current.children) {
+			if (child >= 0 && m_nodes[child].count > 0) {
+				queue.push({ GetDistanceSquared(position, m_nodes[child].minimum, m_nodes[child].maximum), child });
+			}
+		}
+	}
+
+	return found;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+unsigned int QuadTree::GetCount() const		{ return m_nodes[0].count; }
+unsigned int QuadTree::GetNodeCount() const	{ return (unsigned int)m_nodes.size(); }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+float QuadTree::GetDistanceSquared(const glm::vec3& position, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	//--- Clamping the position to the box gives the closest point of the box (the position itself, if inside)
+	glm::vec3 offset = position - glm::clamp(position, minimum, maximum);
+	return glm::dot(offset, offset);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+/*******************************************************************************************************************
+	QuadTree.h, QuadTree.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A loose quadtree spatial index over axis aligned bounding boxes, split in the terrain's XZ plane.
+	Used so the scene only pays for the objects near the camera or a query, rather than every object in the scene.
+
+	[Features]
+	Loose nodes (twice the size of the node) - an object is stored in the deepest node it fits, picked straight from
+	its size and center, so an object never sits at the root just because it crosses a split line.
+	Incremental updates - moving an object within its node is just a bounds update, otherwise it is re-linked.
+	Hierarchical frustum culling - whole nodes are skipped when outside, and accepted without tests when fully inside.
+	Box and sphere range queries, and nearest object queries.
+	Empty branches are skipped, as every node knows how many objects are below it.
+	Temporal coherence - every node and object remembers the frustum side that rejected it last time, and if neither
+	the frustum nor the tree has changed since the last cull, the last results are returned without any tests at all.
+
+	[Upcoming]
+	Shrinking node bounds when objects leave (bounds only grow at present, which is safe but less tight).
+	An octree version, if we ever have levels with a lot of vertical spread.
+
+	[Side Notes]
+	Objects are identified by an ID of your choosing (e.g. an index into your entity container), which is what
+	every query returns. Insert() returns a handle, which is what you pass to Update() and Remove(). Handles that
+	have been removed (or were never returned) are logged and ignored, rather than corrupting the tree.
+	Objects outside the world bounds passed in are still stored correctly (in the nearest edge node).
+	The Y axis isn't split, but every node keeps the Y range of what is inside it for the frustum tests.
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <vector>
+#include "graphics/Frustum.h"
+
+class QuadTree {
+
+public:
+	typedef unsigned int Handle;
+
+private:
+	struct Node {
+		glm::vec2		center;
+		float			halfSize;
+		unsigned int	depth;
+		int				parent;
+		int				children[4];
+		int				firstItem;
+		unsigned int	count;				//--- Objects in this node and every node below it
+		unsigned int	lastSide;			//--- Frustum side that rejected this node last time
+		glm::vec3		minimum, maximum;	//--- Bounds of everything that has been inserted below this node
+	};
+
+	struct Item {
+		glm::vec3		minimum, maximum;
+		unsigned int	ID;
+		int				node;
+		int				previous, next;
+		unsigned int	lastSide;
+	};
+
+public:
+	QuadTree(const glm::vec3& minimum, const glm::vec3& maximum, unsigned int maxDepth = 8);
+	~QuadTree();
+
+public:
+	Handle	Insert(unsigned int ID, const glm::vec3& minimum, const glm::vec3& maximum);
+	void	Update(Handle handle, const glm::vec3& minimum, const glm::vec3& maximum);
+	void	Remove(Handle handle);
+	void	Clear();
+
+public:
+	void CullFrustum(const Frustum& frustum, std::vector<unsigned int>& results);
+	void QueryBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<unsigned int>& results) const;
+	void QuerySphere(const glm::vec3& centerPosition, float radius, std::vector<unsigned int>& results) const;
+	bool FindNearest(const glm::vec3& position, float maxDistance, unsigned int& ID) const;
+
+public:
+	unsigned int GetCount() const;
+	unsigned int GetNodeCount() const;
+
+private:
+	QuadTree(const QuadTree&)				= delete;
+	QuadTree& operator=(const QuadTree&)	= delete;
+
+private:
+	int	 FindNode(const glm::vec3& minimum, const glm::vec3& maximum);
+	int	 CreateNode(int parent, const glm::vec2& center, float halfSize);
+	void Link(Handle handle, int node);
+	void Unlink(Handle handle);
+	void GrowBounds(int node, const glm::vec3& minimum, const glm::vec3& maximum);
+
+private:
+	void CullNode(int node, const Frustum& frustum, bool isInside, std::vector<unsigned int>& results);
+	void AddAll(int node, std::vector<unsigned int>& results) const;
+
+private:
+	static float GetDistanceSquared(const glm::vec3& position, const glm::vec3& minimum, const glm::vec3& maximum);
+
+private:
+	std::vector<Node>	m_nodes;
+	std::vector<Item>	m_items;
+	std::vector<Handle>	m_freeItems;
+	glm::vec3			m_minimum, m_maximum;
+	unsigned int		m_maxDepth;
+
+private:
+	std::vector<unsigned int>	m_lastResults;
+	unsigned int				m_lastFrustumVersion;
+	bool						m_isDirty;
+};
\ No newline at end of file
@@ -15,6 +15,7 @@ Transform::Transform(const glm::vec3& position, const glm::vec3& rotation, const
 		m_rotationMatrix(1.0f),
 		m_scaleMatrix(1.0f),
 		m_transformationMatrix(1.0f),
+		m_snapshotTick(s_noSnapshot),
 		m_isDirty(true)
 {
 	//--- Update the transformation matrix when an instance is first created
@@ -33,6 +34,7 @@ Transform::Transform(const glm::vec2& position, const glm::vec2& dimension)
 		m_rotationMatrix(1.0f),
 		m_scaleMatrix(1.0f),
 		m_transformationMatrix(1.0f),
+		m_snapshotTick(s_noSnapshot),
 		m_isDirty(true)
 {
 	//--- Update the transformation matrix when an instance is first created
@@ -48,6 +50,7 @@ Transform::Transform()
 		m_rotationMatrix(1.0f),
 		m_scaleMatrix(1.0f),
 		m_transformationMatrix(1.0f),
+		m_snapshotTick(s_noSnapshot),
 		m_isDirty(true)
 {
 	Update();
@@ -68,6 +71,8 @@ Transform::~Transform()
 *******************************************************************************************************************/
 void Transform::Move(const glm::vec3& direction, float amount)
 {
+	SaveSnapshot();
+
 	m_position += direction * amount * Game::Instance()->GetDeltaTime();
 	
 	m_isDirty = true;
@@ -79,6 +84,8 @@ void Transform::Move(const glm::vec3& direction, float amount)
 *******************************************************************************************************************/
 void Transform::Rotate(float pitch, float yaw, float roll)
 {
+	SaveSnapshot();
+
 	m_rotation.x += glm::radians(pitch) * Game::Instance()->GetDeltaTime();
 	m_rotation.y += glm::radians(yaw) * Game::Instance()->GetDeltaTime();
 	m_rotation.z += glm::radians(roll) * Game::Instance()->GetDeltaTime();
@@ -124,9 +131,7 @@ void Transform::UpdateTranslationMatrix()
 *******************************************************************************************************************/
 void Transform::UpdateRotationMatrix()
 {
-	m_rotationMatrix =	glm::rotate(m_rotation.z, glm::vec3(s_defaultForwardAxis)) *
-						glm::rotate(m_rotation.x, glm::vec3(s_defaultRightAxis)) *
-						glm::rotate(m_rotation.y, glm::vec3(s_defaultUpAxis));
+	m_rotationMatrix = CreateRotationMatrix(m_rotation);
 }
 
 
@@ -153,6 +158,44 @@ void Transform::UpdateTransformationMatrix()
 }
 
 
+/*******************************************************************************************************************
+	Function that keeps a copy of where the object is before its first change of each fixed update
+*******************************************************************************************************************/
+void Transform::SaveSnapshot()
+{
+	//--- Changes made outside of a fixed update aren't interpolated, the object is drawn exactly where it is
+	if (!Game::Instance()->IsTicking()) { m_snapshotTick = s_noSnapshot; return; }
+
+	unsigned int tick = Game::Instance()->GetTick();
+
+	//--- Only the first change keeps a copy, as that's where the object was when this update started
+	if (m_snapshotTick != tick) {
+		m_previousPosition	= m_position;
+		m_previousRotation	= m_rotation;
+		m_previousScale		= m_scale;
+		m_snapshotTick		= tick;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the matrix to render with - blended between where the object was before the last fixed
+	update and where it is now, by how far we are through the time until the next fixed update
+*******************************************************************************************************************/
+glm::mat4 Transform::GetRenderMatrix() const
+{
+	//--- If the object didn't change during the last fixed update, it's already where it should be drawn
+	//--- (Checked against the sentinel first, so objects that never move don't touch the game's tick at all)
+	if (m_snapshotTick == s_noSnapshot || m_snapshotTick != Game::Instance()->GetTick()) { return m_transformationMatrix; }
+
+	float interpolation = Game::Instance()->GetInterpolation();
+
+	return	glm::translate(glm::mix(m_previousPosition, m_position, interpolation)) *
+			CreateRotationMatrix(glm::mix(m_previousRotation, m_rotation, interpolation)) *
+			glm::scale(glm::mix(m_previousScale, m_scale, interpolation));
+}
+
+
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
@@ -171,16 +214,16 @@ const glm::mat4& Transform::GetTransformationMatrix() const	{ return m_transform
 /*******************************************************************************************************************
 	Modifier methods
 *******************************************************************************************************************/
-void Transform::SetScale(const glm::vec3& scale)		{ m_scale = scale; m_isDirty = true; }
-void Transform::SetPosition(const glm::vec3& position)	{ m_position = position; m_isDirty = true; }
-void Transform::SetRotation(const glm::vec3& rotation)	{ m_rotation = glm::radians(rotation); m_isDirty = true; }
+void Transform::SetScale(const glm::vec3& scale)		{ SaveSnapshot(); m_scale = scale; m_isDirty = true; }
+void Transform::SetPosition(const glm::vec3& position)	{ SaveSnapshot(); m_position = position; m_isDirty = true; }
+void Transform::SetRotation(const glm::vec3& rotation)	{ SaveSnapshot(); m_rotation = glm::radians(rotation); m_isDirty = true; }
 
-void Transform::SetDimensions(float width, float height)	{ m_scale = glm::vec3(width, height, 1.0f); m_isDirty = true; }
-void Transform::SetPosition(float x, float y)				{ m_position = glm::vec3(x, y, s_defaultForwardAxis.z); m_isDirty = true; }
+void Transform::SetDimensions(float width, float height)	{ SaveSnapshot(); m_scale = glm::vec3(width, height, 1.0f); m_isDirty = true; }
+void Transform::SetPosition(float x, float y)				{ SaveSnapshot(); m_position = glm::vec3(x, y, s_defaultForwardAxis.z); m_isDirty = true; }
 
-void Transform::SetX(float x) { m_position.x = x; m_isDirty = true; }
-void Transform::SetY(float y) { m_position.y = y; m_isDirty = true; }
-void Transform::SetZ(float z) { m_position.z = z; m_isDirty = true; }
+void Transform::SetX(float x) { SaveSnapshot(); m_position.x = x; m_isDirty = true; }
+void Transform::SetY(float y) { SaveSnapshot(); m_position.y = y; m_isDirty = true; }
+void Transform::SetZ(float z) { SaveSnapshot(); m_position.z = z; m_isDirty = true; }
 
 
 /*******************************************************************************************************************
@@ -190,6 +233,14 @@ glm::vec3 Transform::s_defaultUpAxis		= glm::vec3(0.0f, 1.0f, 0.0f);
 glm::vec3 Transform::s_defaultForwardAxis	= glm::vec3(0.0f, 0.0f, -1.0f);
 glm::vec3 Transform::s_defaultRightAxis		= glm::vec3(1.0f, 0.0f, 0.0f);
 glm::vec2 Transform::s_maxRotation			= glm::vec2(0.4f, 1.0f);
+const unsigned int Transform::s_noSnapshot	= ~0u;
+
+glm::mat4 Transform::CreateRotationMatrix(const glm::vec3& rotation)
+{
+	return	glm::rotate(rotation.z, glm::vec3(s_defaultForwardAxis)) *
+			glm::rotate(rotation.x, glm::vec3(s_defaultRightAxis)) *
+			glm::rotate(rotation.y, glm::vec3(s_defaultUpAxis));
+}
 
 
 /*******************************************************************************************************************
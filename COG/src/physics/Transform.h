@@ -11,12 +11,14 @@
 	Supports movement, rotation (using euler angles) and scaling of 2D and 3D objects.
 	The objects' transformation matrix is only updated when changes have happened - using an optimization technique known
 	as a dirty flag.
+	Render interpolation - the first change made during each fixed update keeps a copy of where the object was, and
+	GetRenderMatrix() blends between that and where it is now, so movement stays smooth whatever the frame rate.
 
 	[Upcoming]
 	Support for quaternion rotation.
 
 	[Side Notes]
-	Nothing at present.
+	Changes made outside of a fixed update (e.g. while rendering) aren't interpolated, the object just jumps there.
 
 *******************************************************************************************************************/
 #include <pretty_glm/glm.hpp>
@@ -55,6 +57,7 @@ public:
 
 public:
 	const glm::mat4&	GetTransformationMatrix() const;
+	glm::mat4			GetRenderMatrix() const;
 
 public:
 	void SetPosition(const glm::vec3& position);
@@ -87,6 +90,7 @@ private:
 
 private:
 	void UpdateTransformationMatrix();
+	void SaveSnapshot();
 
 private:
 	glm::vec3 m_position;
@@ -106,6 +110,12 @@ private:
 private:
 	glm::mat4 m_transformationMatrix;
 
+private:
+	glm::vec3		m_previousPosition;
+	glm::vec3		m_previousRotation;
+	glm::vec3		m_previousScale;
+	unsigned int	m_snapshotTick;
+
 private:
 	bool m_isDirty;
 
@@ -114,4 +124,8 @@ private:
 	static glm::vec3 s_defaultForwardAxis;
 	static glm::vec3 s_defaultRightAxis;
 	static glm::vec2 s_maxRotation;
+	static const unsigned int s_noSnapshot;
+
+private:
+	static glm::mat4 CreateRotationMatrix(const glm::vec3& rotation);
 };
\ No newline at end of file
@@ -0,0 +1,479 @@
+#include <algorithm>
+#include <cmath>
+#include "TransformStore.h"
+#include "utilities/Simd.h"
+#include "utilities/Log.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+TransformStore::TransformStore(JobSystem* jobSystem)
+	:	m_count(0),
+		m_slotCount(0),
+		m_capacity(0),
+		m_updatedCount(0),
+		m_jobSystem(jobSystem),
+		m_isHierarchyDirty(false)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+TransformStore::~TransformStore()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that adds an object and returns the handle used to move, rotate or scale it
+*******************************************************************************************************************/
+TransformStore::Handle TransformStore::Create(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+{
+	Handle handle;
+
+	//--- Re-use the slot of a destroyed object if we have one, otherwise take the next unused one
+	if (!m_freeHandles.empty())	{ handle = m_freeHandles.back(); m_freeHandles.pop_back(); }
+	else						{ handle = m_slotCount++; }
+
+	//--- NOTE
+	// Storage always grows by a whole group of 4, so the SSE update can load and store 4 objects at a time
+	// without ever going off the end of an array. Unused slots just hold an identity transform.
+	//---
+	if (m_slotCount > m_capacity) {
+
+		m_capacity += 4;
+
+		for (auto* values : { &m_positionX, &m_positionY, &m_positionZ, &m_rotationX, &m_rotationY, &m_rotationZ,
+							  &m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ,
+							  &m_minimumX, &m_minimumY, &m_minimumZ, &m_maximumX, &m_maximumY, &m_maximumZ }) {
+			values->resize(m_capacity, 0.0f);
+		}
+
+		for (auto* values : { &m_rotationW, &m_scaleX, &m_scaleY, &m_scaleZ }) { values->resize(m_capacity, 1.0f); }
+
+		m_worldMatrices.resize(m_capacity, glm::mat4(1.0f));
+		m_parents.resize(m_capacity, s_noParent);
+		m_isActive.resize(m_capacity, false);
+		m_dirtyBits.resize((m_capacity + 31) / 32, 0);
+		m_updatedBits.resize((m_capacity + 31) / 32, 0);
+	}
+
+	m_isActive[handle]	= true;
+	m_parents[handle]	= s_noParent;
+	m_count++;
+
+	SetPosition(handle, position);
+	SetRotation(handle, rotation);
+	SetScale(handle, scale);
+	SetLocalBounds(handle, glm::vec3(0.0f), glm::vec3(0.0f));
+
+	return handle;
+}
+
+
+/*******************************************************************************************************************
+	Function that removes an object - its children are kept, but become top level objects
+*******************************************************************************************************************/
+void TransformStore::Destroy(Handle handle)
+{
+	//--- Destroying a handle twice would put its slot on the free list twice, and two new objects would then share it
+	if (handle >= m_capacity || !m_isActive[handle]) {
+		COG_LOG("[TRANSFORM STORE] Destroying a handle that isn't in use: ", handle, LOG_ERROR); return;
+	}
+
+	//--- Make sure the list of children is up to date, so we don't miss any that were only just given a parent
+	if (m_isHierarchyDirty) { SortHierarchy(); }
+
+	for (auto child : m_children) {
+		if (m_parents[child] == handle) { ClearParent(child); }
+	}
+
+	if (m_parents[handle] != s_noParent) { m_isHierarchyDirty = true; }
+
+	m_isActive[handle]			= false;
+	m_parents[handle]			= s_noParent;
+	m_dirtyBits[handle / 32]	&= ~(1u << (handle % 32));
+	m_freeHandles.push_back(handle);
+	m_count--;
+}
+
+
+/*******************************************************************************************************************
+	Function that removes every object
+*******************************************************************************************************************/
+void TransformStore::Clear()
+{
+	for (auto* values : { &m_positionX, &m_positionY, &m_positionZ, &m_rotationX, &m_rotationY, &m_rotationZ, &m_rotationW,
+						  &m_scaleX, &m_scaleY, &m_scaleZ, &m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ,
+						  &m_minimumX, &m_minimumY, &m_minimumZ, &m_maximumX, &m_maximumY, &m_maximumZ }) {
+		values->clear();
+	}
+
+	m_worldMatrices.clear();
+	m_parents.clear();
+	m_children.clear();
+	m_freeHandles.clear();
+	m_dirtyBits.clear();
+	m_updatedBits.clear();
+	m_isActive.clear();
+
+	m_count				= 0;
+	m_slotCount			= 0;
+	m_capacity			= 0;
+	m_updatedCount		= 0;
+	m_isHierarchyDirty	= false;
+}
+
+
+/*******************************************************************************************************************
+	Called every frame, re-calculates the world matrix and world bounds of every object that has changed
+*******************************************************************************************************************/
+void TransformStore::Update()
+{
+	if (m_isHierarchyDirty) { SortHierarchy(); }
+
+	m_updatedCount = 0;
+
+	for (auto bits : m_dirtyBits) {
+		for (; bits; bits &= bits - 1) { m_updatedCount++; }
+	}
+
+	std::fill(m_updatedBits.begin(), m_updatedBits.end(), 0);
+
+	//--- NOTE
+	// Jobs are split on words of the dirty bits (32 objects each), so every job owns its own words of the updated
+	// bits and never writes to the same memory as another job. Small updates aren't worth splitting up at all.
+	//---
+	unsigned int words = (m_capacity + 31) / 32;
+
+	auto job = [this](unsigned int first, unsigned int last) { UpdateBlock(first * 32, std::min(last * 32, m_capacity)); };
+
+	if (m_jobSystem)	{ m_jobSystem->ParallelFor(words, s_minObjectsPerJob / 32, job); }
+	else				{ job(0, words); }
+
+	//--- Children are in hierarchy order, so a parent's world matrix is always final before its children use it
+	for (auto child : m_children) {
+
+		bool isUpdated			= (m_updatedBits[child / 32] >> (child % 32)) & 1;
+		bool isParentUpdated	= (m_updatedBits[m_parents[child] / 32] >> (m_parents[child] % 32)) & 1;
+
+		if (!isUpdated && !isParentUpdated) { continue; }
+		if (!IsDirty(child)) { m_updatedCount++; }
+
+		UpdateChild(child);
+	}
+
+	std::fill(m_dirtyBits.begin(), m_dirtyBits.end(), 0);
+}
+
+
+/*******************************************************************************************************************
+	Function that re-calculates the world matrices and bounds of the dirty objects in a block, as if they had no parent
+*******************************************************************************************************************/
+void TransformStore::UpdateBlock(unsigned int first, unsigned int last)
+{
+#if COG_SIMD == 1
+
+	const __m128 one		= _mm_set1_ps(1.0f);
+	const __m128 absolute	= _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	for (unsigned int i = first; i < last; i += 4) {
+
+		//--- Skip the whole group if none of its 4 objects have changed
+		uint32_t mask = (m_dirtyBits[i / 32] >> (i % 32)) & 0xF;
+
+		if (!mask) { continue; }
+
+		__m128 x = _mm_loadu_ps(&m_rotationX[i]);
+		__m128 y = _mm_loadu_ps(&m_rotationY[i]);
+		__m128 z = _mm_loadu_ps(&m_rotationZ[i]);
+		__m128 w = _mm_loadu_ps(&m_rotationW[i]);
+
+		__m128 x2 = _mm_add_ps(x, x);
+		__m128 y2 = _mm_add_ps(y, y);
+		__m128 z2 = _mm_add_ps(z, z);
+
+		__m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+		__m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+		__m128 wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+
+		__m128 scaleX = _mm_loadu_ps(&m_scaleX[i]);
+		__m128 scaleY = _mm_loadu_ps(&m_scaleY[i]);
+		__m128 scaleZ = _mm_loadu_ps(&m_scaleZ[i]);
+
+		//--- Rotation matrix from the quaternion, with each column multiplied by its scale (m[column][row])
+		__m128 m00 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), scaleX);
+		__m128 m01 = _mm_mul_ps(_mm_add_ps(xy, wz), scaleX);
+		__m128 m02 = _mm_mul_ps(_mm_sub_ps(xz, wy), scaleX);
+
+		__m128 m10 = _mm_mul_ps(_mm_sub_ps(xy, wz), scaleY);
+		__m128 m11 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), scaleY);
+		__m128 m12 = _mm_mul_ps(_mm_add_ps(yz, wx), scaleY);
+
+		__m128 m20 = _mm_mul_ps(_mm_add_ps(xz, wy), scaleZ);
+		__m128 m21 = _mm_mul_ps(_mm_sub_ps(yz, wx), scaleZ);
+		__m128 m22 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), scaleZ);
+
+		__m128 m30 = _mm_loadu_ps(&m_positionX[i]);
+		__m128 m31 = _mm_loadu_ps(&m_positionY[i]);
+		__m128 m32 = _mm_loadu_ps(&m_positionZ[i]);
+
+		//--- World bounds from the local bounds (a box's center moves with the matrix, its size grows with |matrix|)
+		__m128 centerX = _mm_loadu_ps(&m_centerX[i]);
+		__m128 centerY = _mm_loadu_ps(&m_centerY[i]);
+		__m128 centerZ = _mm_loadu_ps(&m_centerZ[i]);
+		__m128 extentX = _mm_loadu_ps(&m_extentX[i]);
+		__m128 extentY = _mm_loadu_ps(&m_extentY[i]);
+		__m128 extentZ = _mm_loadu_ps(&m_extentZ[i]);
+
+		__m128 worldCenterX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, centerX), _mm_mul_ps(m10, centerY)), _mm_add_ps(_mm_mul_ps(m20, centerZ), m30));
+		__m128 worldCenterY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, centerX), _mm_mul_ps(m11, centerY)), _mm_add_ps(_mm_mul_ps(m21, centerZ), m31));
+		__m128 worldCenterZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, centerX), _mm_mul_ps(m12, centerY)), _mm_add_ps(_mm_mul_ps(m22, centerZ), m32));
+
+		__m128 worldExtentX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(m00, absolute), extentX), _mm_mul_ps(_mm_and_ps(m10, absolute), extentY)),
+										 _mm_mul_ps(_mm_and_ps(m20, absolute), extentZ));
+		__m128 worldExtentY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(m01, absolute), extentX), _mm_mul_ps(_mm_and_ps(m11, absolute), extentY)),
+										 _mm_mul_ps(_mm_and_ps(m21, absolute), extentZ));
+		__m128 worldExtentZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(m02, absolute), extentX), _mm_mul_ps(_mm_and_ps(m12, absolute), extentY)),
+										 _mm_mul_ps(_mm_and_ps(m22, absolute), extentZ));
+
+		_mm_storeu_ps(&m_minimumX[i], _mm_sub_ps(worldCenterX, worldExtentX));
+		_mm_storeu_ps(&m_minimumY[i], _mm_sub_ps(worldCenterY, worldExtentY));
+		_mm_storeu_ps(&m_minimumZ[i], _mm_sub_ps(worldCenterZ, worldExtentZ));
+		_mm_storeu_ps(&m_maximumX[i], _mm_add_ps(worldCenterX, worldExtentX));
+		_mm_storeu_ps(&m_maximumY[i], _mm_add_ps(worldCenterY, worldExtentY));
+		_mm_storeu_ps(&m_maximumZ[i], _mm_add_ps(worldCenterZ, worldExtentZ));
+
+		//--- Each register holds one matrix element of 4 objects, so transpose them into one column of each object
+		__m128 zero	= _mm_setzero_ps();
+		__m128 m03	= zero, m13 = zero, m23 = zero, m33 = one;
+
+		_MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+		_MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+		_MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+		_MM_TRANSPOSE4_PS(m30, m31, m32, m33);
+
+		float* matrix = &m_worldMatrices[i][0][0];
+
+		_mm_storeu_ps(matrix +  0, m00); _mm_storeu_ps(matrix +  4, m10); _mm_storeu_ps(matrix +  8, m20); _mm_storeu_ps(matrix + 12, m30);
+		_mm_storeu_ps(matrix + 16, m01); _mm_storeu_ps(matrix + 20, m11); _mm_storeu_ps(matrix + 24, m21); _mm_storeu_ps(matrix + 28, m31);
+		_mm_storeu_ps(matrix + 32, m02); _mm_storeu_ps(matrix + 36, m12); _mm_storeu_ps(matrix + 40, m22); _mm_storeu_ps(matrix + 44, m32);
+		_mm_storeu_ps(matrix + 48, m03); _mm_storeu_ps(matrix + 52, m13); _mm_storeu_ps(matrix + 56, m23); _mm_storeu_ps(matrix + 60, m33);
+
+		//--- The whole group was written, so children in it must be re-calculated from their parent afterwards
+		m_updatedBits[i / 32] |= 0xFu << (i % 32);
+	}
+
+#else
+
+	for (unsigned int i = first; i < last; i++) {
+
+		if (!IsDirty(i)) { continue; }
+
+		m_worldMatrices[i] = GetLocalMatrix(i);
+		UpdateWorldBounds(i);
+
+		m_updatedBits[i / 32] |= 1u << (i % 32);
+	}
+
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Function that re-calculates the world matrix and bounds of an object from its parent's world matrix
+*******************************************************************************************************************/
+void TransformStore::UpdateChild(Handle handle)
+{
+	m_worldMatrices[handle] = m_worldMatrices[m_parents[handle]] * GetLocalMatrix(handle);
+	UpdateWorldBounds(handle);
+
+	m_updatedBits[handle / 32] |= 1u << (handle % 32);
+}
+
+
+/*******************************************************************************************************************
+	Function that puts every object with a parent in hierarchy order (parents before their children)
+*******************************************************************************************************************/
+void TransformStore::SortHierarchy()
+{
+	std::vector<std::pair<unsigned int, Handle>> depths;
+
+	for (Handle handle = 0; handle < m_capacity; handle++) {
+
+		if (!m_isActive[handle] || m_parents[handle] == s_noParent) { continue; }
+
+		unsigned int depth = 0;
+
+		for (Handle parent = m_parents[handle]; parent != s_noParent; parent = m_parents[parent]) { depth++; }
+
+		depths.push_back({ depth, handle });
+	}
+
+	std::sort(depths.begin(), depths.end());
+
+	m_children.clear();
+
+	for (const auto& depth : depths) { m_children.push_back(depth.second); }
+
+	m_isHierarchyDirty = false;
+}
+
+
+/*******************************************************************************************************************
+	Function that builds an object's matrix from its position, rotation and scale (translation * rotation * scale)
+*******************************************************************************************************************/
+glm::mat4 TransformStore::GetLocalMatrix(Handle handle) const
+{
+	float x = m_rotationX[handle], y = m_rotationY[handle], z = m_rotationZ[handle], w = m_rotationW[handle];
+
+	glm::mat4 matrix(1.0f);
+
+	matrix[0][0] = (1.0f - 2.0f * (y * y + z * z)) * m_scaleX[handle];
+	matrix[0][1] = (2.0f * (x * y + w * z)) * m_scaleX[handle];
+	matrix[0][2] = (2.0f * (x * z - w * y)) * m_scaleX[handle];
+
+	matrix[1][0] = (2.0f * (x * y - w * z)) * m_scaleY[handle];
+	matrix[1][1] = (1.0f - 2.0f * (x * x + z * z)) * m_scaleY[handle];
+	matrix[1][2] = (2.0f * (y * z + w * x)) * m_scaleY[handle];
+
+	matrix[2][0] = (2.0f * (x * z + w * y)) * m_scaleZ[handle];
+	matrix[2][1] = (2.0f * (y * z - w * x)) * m_scaleZ[handle];
+	matrix[2][2] = (1.0f - 2.0f * (x * x + y * y)) * m_scaleZ[handle];
+
+	matrix[3] = glm::vec4(m_positionX[handle], m_positionY[handle], m_positionZ[handle], 1.0f);
+
+	return matrix;
+}
+
+
+/*******************************************************************************************************************
+	Function that re-calculates an object's world bounds from its local bounds and world matrix
+*******************************************************************************************************************/
+void TransformStore::UpdateWorldBounds(Handle handle)
+{
+	const glm::mat4& matrix = m_worldMatrices[handle];
+
+	glm::vec3 center = glm::vec3(matrix * glm::vec4(m_centerX[handle], m_centerY[handle], m_centerZ[handle], 1.0f));
+	glm::vec3 extent;
+
+	for (unsigned int row = 0; row < 3; row++) {
+		extent[row] = std::abs(matrix[0][row]) * m_extentX[handle] +
+					  std::abs(matrix[1][row]) * m_extentY[handle] +
+					  std::abs(matrix[2][row]) * m_extentZ[handle];
+	}
+
+	m_minimumX[handle] = center.x - extent.x; m_minimumY[handle] = center.y - extent.y; m_minimumZ[handle] = center.z - extent.z;
+	m_maximumX[handle] = center.x + extent.x; m_maximumY[handle] = center.y + extent.y; m_maximumZ[handle] = center.z + extent.z;
+}
+
+
+/*******************************************************************************************************************
+	Function that makes an object a child of another, so it moves with it. Returns false if either handle isn't in
+	use, or if that would make a loop
+*******************************************************************************************************************/
+bool TransformStore::SetParent(Handle handle, Handle parent)
+{
+	if (handle >= m_capacity || !m_isActive[handle] || parent >= m_capacity || !m_isActive[parent]) {
+		COG_LOG("[TRANSFORM STORE] Parenting a handle that isn't in use: ", (handle >= m_capacity || !m_isActive[handle]) ? handle : parent, LOG_ERROR);
+		return false;
+	}
+
+	for (Handle ancestor = parent; ancestor != s_noParent; ancestor = m_parents[ancestor]) {
+		if (ancestor == handle) { return false; }
+	}
+
+	m_parents[handle]	= parent;
+	m_isHierarchyDirty	= true;
+	SetDirty(handle);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that turns a child back into a top level object (its position etc. are now relative to the world)
+*******************************************************************************************************************/
+void TransformStore::ClearParent(Handle handle)
+{
+	if (m_parents[handle] == s_noParent) { return; }
+
+	m_parents[handle]	= s_noParent;
+	m_isHierarchyDirty	= true;
+	SetDirty(handle);
+}
+
+
+/*******************************************************************************************************************
+	Function that converts euler angles (in degrees) to a quaternion, rotating in the same order as Transform
+*******************************************************************************************************************/
+void TransformStore::SetRotation(Handle handle, const glm::vec3& rotation)
+{
+	glm::vec3 radians = glm::radians(rotation);
+
+	//--- Roll around the forward axis (0, 0, -1), then pitch around the right axis, then yaw around the up axis
+	SetRotation(handle, glm::angleAxis(radians.z, glm::vec3(0.0f, 0.0f, -1.0f)) *
+						glm::angleAxis(radians.x, glm::vec3(1.0f, 0.0f, 0.0f)) *
+						glm::angleAxis(radians.y, glm::vec3(0.0f, 1.0f, 0.0f)));
+}
+
+
+/*******************************************************************************************************************
+	Modifier methods
+*******************************************************************************************************************/
+void TransformStore::SetPosition(Handle handle, const glm::vec3& position)
+{
+	m_positionX[handle] = position.x; m_positionY[handle] = position.y; m_positionZ[handle] = position.z;
+	SetDirty(handle);
+}
+
+void TransformStore::SetRotation(Handle handle, const glm::quat& rotation)
+{
+	glm::quat normalized = glm::normalize(rotation);
+
+	m_rotationX[handle] = normalized.x; m_rotationY[handle] = normalized.y; m_rotationZ[handle] = normalized.z; m_rotationW[handle] = normalized.w;
+	SetDirty(handle);
+}
+
+void TransformStore::SetScale(Handle handle, const glm::vec3& scale)
+{
+	m_scaleX[handle] = scale.x; m_scaleY[handle] = scale.y; m_scaleZ[handle] = scale.z;
+	SetDirty(handle);
+}
+
+void TransformStore::SetLocalBounds(Handle handle, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	glm::vec3 center = (minimum + maximum) * 0.5f;
+	glm::vec3 extent = (maximum - minimum) * 0.5f;
+
+	m_centerX[handle] = center.x; m_centerY[handle] = center.y; m_centerZ[handle] = center.z;
+	m_extentX[handle] = extent.x; m_extentY[handle] = extent.y; m_extentZ[handle] = extent.z;
+	SetDirty(handle);
+}
+
+void TransformStore::SetDirty(Handle handle) { m_dirtyBits[handle / 32] |= 1u << (handle % 32); }
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+glm::vec3 TransformStore::GetPosition(Handle handle) const			{ return glm::vec3(m_positionX[handle], m_positionY[handle], m_positionZ[handle]); }
+glm::quat TransformStore::GetRotation(Handle handle) const			{ return glm::quat(m_rotationW[handle], m_rotationX[handle], m_rotationY[handle], m_rotationZ[handle]); }
+glm::vec3 TransformStore::GetScale(Handle handle) const				{ return glm::vec3(m_scaleX[handle], m_scaleY[handle], m_scaleZ[handle]); }
+const glm::mat4& TransformStore::GetWorldMatrix(Handle handle) const	{ return m_worldMatrices[handle]; }
+glm::vec3 TransformStore::GetWorldMinimum(Handle handle) const		{ return glm::vec3(m_minimumX[handle], m_minimumY[handle], m_minimumZ[handle]); }
+glm::vec3 TransformStore::GetWorldMaximum(Handle handle) const		{ return glm::vec3(m_maximumX[handle], m_maximumY[handle], m_maximumZ[handle]); }
+unsigned int TransformStore::GetCount() const						{ return m_count; }
+unsigned int TransformStore::GetUpdatedCount() const				{ return m_updatedCount; }
+bool TransformStore::IsDirty(Handle handle) const					{ return (m_dirtyBits[handle / 32] >> (handle % 32)) & 1; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const TransformStore::Handle TransformStore::s_noParent				= ~0u;
+const unsigned int TransformStore::s_minObjectsPerJob				= 8192;
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+/*******************************************************************************************************************
+	TransformStore.h, TransformStore.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A data oriented home for the transforms of a large number of objects. Rather than every object owning a Transform
+	with its own matrices, the positions, rotations and scales of every object are kept side by side in flat arrays,
+	and all of the world matrices and world bounds are re-calculated together in one Update() call.
+
+	[Features]
+	Structure of arrays storage (one array per component), so the update streams through memory 4 objects at a time.
+	Quaternion rotations - no gimbal lock, and cheaper to turn into a matrix than 3 euler rotations.
+	Dirty bits - only objects that have changed (or whose parent has changed) are re-calculated.
+	Builds 4 world matrices at a time with SSE (falls back to one at a time without SSE).
+	World space bounding boxes, re-calculated alongside the matrices from each object's local bounds.
+	Big updates are split into jobs, each job taking its own block of objects.
+	Parenting - children are updated after their parents, in hierarchy order.
+
+	[Upcoming]
+	Moving Entity over from its own Transform and AABounds3D - nothing in the game uses the store yet.
+
+	[Side Notes]
+	World matrices are built the same way as Transform (translation * rotation * scale), and euler angles passed in
+	to SetRotation() are in degrees and applied in the same order as Transform, so the two can be swapped freely.
+	Call Update() once a frame after moving things and before reading any matrices or bounds back.
+	Handles of destroyed objects are re-used, so don't hold on to them (destroying a handle twice is caught, as long
+	as it hasn't been handed out again in between).
+	Without a job system, Update() does all of the work on the calling thread.
+
+*******************************************************************************************************************/
+#include <pretty_glm/glm.hpp>
+#include <pretty_glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <vector>
+#include "utilities/JobSystem.h"
+
+class TransformStore {
+
+public:
+	typedef unsigned int Handle;
+
+public:
+	TransformStore(JobSystem* jobSystem = nullptr);
+	~TransformStore();
+
+public:
+	Handle	Create(const glm::vec3& position = glm::vec3(0.0f), const glm::quat& rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+				   const glm::vec3& scale = glm::vec3(1.0f));
+	void	Destroy(Handle handle);
+	void	Clear();
+	void	Update();
+
+public:
+	void SetPosition(Handle handle, const glm::vec3& position);
+	void SetRotation(Handle handle, const glm::quat& rotation);
+	void SetRotation(Handle handle, const glm::vec3& rotation);
+	void SetScale(Handle handle, const glm::vec3& scale);
+	void SetLocalBounds(Handle handle, const glm::vec3& minimum, const glm::vec3& maximum);
+	bool SetParent(Handle handle, Handle parent);
+	void ClearParent(Handle handle);
+
+public:
+	glm::vec3			GetPosition(Handle handle) const;
+	glm::quat			GetRotation(Handle handle) const;
+	glm::vec3			GetScale(Handle handle) const;
+	const glm::mat4&	GetWorldMatrix(Handle handle) const;
+	glm::vec3			GetWorldMinimum(Handle handle) const;
+	glm::vec3			GetWorldMaximum(Handle handle) const;
+
+public:
+	unsigned int GetCount() const;
+	unsigned int GetUpdatedCount() const;
+
+private:
+	TransformStore(const TransformStore&)				= delete;
+	TransformStore& operator=(const TransformStore&)	= delete;
+
+private:
+	void SetDirty(Handle handle);
+	bool IsDirty(Handle handle) const;
+	void SortHierarchy();
+	void UpdateBlock(unsigned int first, unsigned int last);
+	void UpdateChild(Handle handle);
+
+private:
+	glm::mat4	GetLocalMatrix(Handle handle) const;
+	void		UpdateWorldBounds(Handle handle);
+
+private:
+	//--- Local transform, one array per component
+	std::vector<float> m_positionX, m_positionY, m_positionZ;
+	std::vector<float> m_rotationX, m_rotationY, m_rotationZ, m_rotationW;
+	std::vector<float> m_scaleX, m_scaleY, m_scaleZ;
+
+private:
+	//--- Local bounds are kept as a center and half size, which is what the world bounds are calculated from
+	std::vector<float> m_centerX, m_centerY, m_centerZ;
+	std::vector<float> m_extentX, m_extentY, m_extentZ;
+
+private:
+	std::vector<glm::mat4>	m_worldMatrices;
+	std::vector<float>		m_minimumX, m_minimumY, m_minimumZ;
+	std::vector<float>		m_maximumX, m_maximumY, m_maximumZ;
+
+private:
+	std::vector<Handle>		m_parents;
+	std::vector<Handle>		m_children;
+	std::vector<Handle>		m_freeHandles;
+	std::vector<uint32_t>	m_dirtyBits;
+	std::vector<uint32_t>	m_updatedBits;
+	std::vector<bool>		m_isActive;
+
+private:
+	unsigned int	m_count;
+	unsigned int	m_slotCount;
+	unsigned int	m_capacity;
+	unsigned int	m_updatedCount;
+	JobSystem*		m_jobSystem;
+	bool			m_isHierarchyDirty;
+
+private:
+	static const Handle			s_noParent;
+	static const unsigned int	s_minObjectsPerJob;
+};
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cmath>
+#include "DistanceField.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+DistanceField::DistanceField(JobSystem* jobSystem)
+	:	m_jobSystem(jobSystem)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+DistanceField::~DistanceField()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that generates the distance field of a coverage image, both the same size. The spread is how far
+	(in pixels) the field reaches either side of an edge before it is clamped
+*******************************************************************************************************************/
+void DistanceField::Generate(const std::vector<unsigned char>& coverage, int width, int height, int spread, std::vector<unsigned char>& field)
+{
+	size_t size = (size_t)width * (size_t)height;
+
+	field.assign(size, 0);
+
+	if (size == 0 || coverage.size() < size) { return; }
+
+	//--- Every inside pixel wants the distance to the nearest outside pixel, and the other way around, so each
+	//--- grid starts at zero on the pixels it measures to and 'infinity' everywhere else
+	m_inside.resize(size);
+	m_outside.resize(size);
+
+	for (size_t i = 0; i < size; i++) {
+		bool isInside	= coverage[i] >= 128;
+		m_inside[i]		= isInside ? s_infinity : 0.0f;
+		m_outside[i]	= isInside ? 0.0f : s_infinity;
+	}
+
+	TransformColumns(width, height);
+	TransformRows(width, height);
+
+	float scale = 1.0f / (2.0f * (float)std::max(spread, 1));
+
+	ParallelFor(height, [&](int first, int last) {
+		for (size_t i = (size_t)first * width; i < (size_t)last * width; i++) {
+
+			//--- The grids hold squared distances between pixel centres, and the edge is half a pixel before that
+			float distance = (coverage[i] >= 128) ? std::sqrt(m_inside[i]) - 0.5f : 0.5f - std::sqrt(m_outside[i]);
+			float value = std::min(std::max(0.5f + distance * scale, 0.0f), 1.0f);
+
+			field[i] = (unsigned char)(value * 255.0f + 0.5f);
+		}
+	});
+}
+
+
+/*******************************************************************************************************************
+	Function that runs the 1D transform down every column of both grids
+*******************************************************************************************************************/
+void DistanceField::TransformColumns(int width, int height)
+{
+	ParallelFor(width, [&](int first, int last) {
+
+		//--- Each block of columns has its own scratch space, so the blocks never share anything
+		std::vector<float> input(height), output(height), boundaries(height + 1);
+		std::vector<int> parabolas(height);
+
+		for (int x = first; x < last; x++) {
+			for (std::vector<float>* grid : { &m_inside, &m_outside }) {
+
+				for (int y = 0; y < height; y++) { input[y] = (*grid)[(size_t)y * width + x]; }
+
+				Transform(input.data(), output.data(), height, parabolas.data(), boundaries.data());
+
+				for (int y = 0; y < height; y++) { (*grid)[(size_t)y * width + x] = output[y]; }
+			}
+		}
+	});
+}
+
+
+/*******************************************************************************************************************
+	Function that runs the 1D transform along every row of both grids (after the columns, this gives the 2D result)
+*******************************************************************************************************************/
+void DistanceField::TransformRows(int width, int height)
+{
+	ParallelFor(height, [&](int first, int last) {
+
+		std::vector<float> output(width), boundaries(width + 1);
+		std::vector<int> parabolas(width);
+
+		for (int y = first; y < last; y++) {
+			for (std::vector<float>* grid : { &m_inside, &m_outside }) {
+
+				float* row = grid->data() + (size_t)y * width;
+
+				Transform(row, output.data(), width, parabolas.data(), boundaries.data());
+				std::copy(output.begin(), output.end(), row);
+			}
+		}
+	});
+}
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const float	DistanceField::s_infinity		= 1e20f;
+const int	DistanceField::s_minLinesPerJob	= 16;
+
+//--- NOTE
+// The 1D squared distance transform (Felzenszwalb & Huttenlocher). Every sample is a parabola rooted at its own
+// position and raised by its input value - the result at each point is the lowest parabola there. The lower
+// envelope of the parabolas is built in one pass (parabolas[] holds their roots, boundaries[] where each one
+// takes over from the last), then read back in a second pass. parabolas needs room for count values, boundaries
+// for count + 1.
+//---
+void DistanceField::Transform(const float* input, float* output, int count, int* parabolas, float* boundaries)
+{
+	if (count <= 0) { return; }
+
+	int envelope = 0;
+	parabolas[0]	= 0;
+	boundaries[0]	= -s_infinity;
+	boundaries[1]	= s_infinity;
+
+	for (int q = 1; q < count; q++) {
+
+		//--- Drop every parabola the new one hides completely (the first boundary is -infinity, so the first never is)
+		float intersection = GetIntersection(input, q, parabolas[envelope]);
+
+		while (intersection <= boundaries[envelope]) {
+			envelope--;
+			intersection = GetIntersection(input, q, parabolas[envelope]);
+		}
+
+		envelope++;
+		parabolas[envelope]		= q;
+		boundaries[envelope]		= intersection;
+		boundaries[envelope + 1]	= s_infinity;
+	}
+
+	envelope = 0;
+
+	for (int q = 0; q < count; q++) {
+		while (boundaries[envelope + 1] < (float)q) { envelope++; }
+
+		int p = parabolas[envelope];
+		output[q] = (float)((q - p) * (q - p)) + input[p];
+	}
+}
+
+//--- Where the parabolas rooted at q and p cross
+float DistanceField::GetIntersection(const float* input, int q, int p)
+{
+	return ((input[q] + (float)(q * q)) - (input[p] + (float)(p * p))) / (float)(2 * q - 2 * p);
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+/*******************************************************************************************************************
+	DistanceField.h, DistanceField.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Turns an 8 bit coverage image (e.g. a glyph atlas) into a signed distance field - each pixel holds how far it
+	is from the nearest edge, so the shape can be drawn sharply at any scale by thresholding the distance.
+
+	[Features]
+	Exact euclidean distance transform (Felzenszwalb & Huttenlocher) - a 1D transform down every column, then along
+	every row, so the cost is linear in the number of pixels however far the field spreads.
+	Inside and outside distances are found in the same passes, and the columns/rows are split across the job
+	system's workers when it is running.
+	Distances are clamped to the spread and stored as 8 bits - 128 is the edge, brighter is inside, darker is outside.
+
+	[Upcoming]
+	Multi-channel fields (MSDF) built from the glyph outlines, to keep sharp corners at very large scales.
+
+	[Side Notes]
+	Coverage is thresholded at half, so the edge is only as accurate as the pixel grid it was rendered on - render
+	the source a little larger than you need the field to be if you want smoother edges.
+	Shapes further apart than the spread can share one image (see FontBaker), as no pixel can see another shape's
+	edge within the spread.
+	This class doesn't depend on SDL, OpenGL or the engine singletons, so it can be used by the COGBake tool.
+
+*******************************************************************************************************************/
+#include <vector>
+#include "utilities/JobSystem.h"
+
+class DistanceField {
+
+public:
+	DistanceField(JobSystem* jobSystem = nullptr);
+	~DistanceField();
+
+public:
+	void Generate(const std::vector<unsigned char>& coverage, int width, int height, int spread, std::vector<unsigned char>& field);
+
+public:
+	static void Transform(const float* input, float* output, int count, int* parabolas, float* boundaries);
+
+private:
+	DistanceField(const DistanceField&)				= delete;
+	DistanceField& operator=(const DistanceField&)	= delete;
+
+private:
+	void TransformColumns(int width, int height);
+	void TransformRows(int width, int height);
+
+private:
+	static float GetIntersection(const float* input, int q, int p);
+
+private:
+	template <typename T> void ParallelFor(int count, T job);
+
+private:
+	JobSystem*			m_jobSystem;
+	std::vector<float>	m_inside;
+	std::vector<float>	m_outside;
+
+private:
+	static const float	s_infinity;
+	static const int	s_minLinesPerJob;
+};
+
+/*******************************************************************************************************************
+	Template function that runs job(first, last) over the lines [0, count) - across the job system's workers if it
+	is running, otherwise all at once on the calling thread
+*******************************************************************************************************************/
+template <typename T> void DistanceField::ParallelFor(int count, T job)
+{
+	if (m_jobSystem && m_jobSystem->IsRunning()) {
+		m_jobSystem->ParallelFor((unsigned int)count, (unsigned int)s_minLinesPerJob, [&job](unsigned int first, unsigned int last) { job((int)first, (int)last); });
+		return;
+	}
+
+	job(0, count);
+}
\ No newline at end of file
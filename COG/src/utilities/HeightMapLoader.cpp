@@ -0,0 +1,175 @@
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "HeightMapLoader.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+HeightMapLoader::HeightMapLoader()
+	:	m_format(FORMAT_NONE),
+		m_width(0),
+		m_height(0),
+		m_pixels(nullptr),
+		m_image(nullptr)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Cleanup all memory usage - frees any decoded image data and unmaps any raw file
+*******************************************************************************************************************/
+HeightMapLoader::~HeightMapLoader()
+{
+	Unload();
+}
+
+
+/*******************************************************************************************************************
+	A function that loads a heightmap - pass in the file location without an extension.
+	Raw files are preferred over PNG files, as they are faster to load and hold more precision. A raw file that isn't
+	valid is skipped over, so the next format (in the end the PNG) is still loaded.
+*******************************************************************************************************************/
+bool HeightMapLoader::Load(const std::string& fileLocation)
+{
+	Unload();
+	m_error.clear();
+
+	//--- Try each supported extension in order of preference, the first file that exists is the one we use
+	struct { const char* extension; Format format; } rawFormats[] = {
+		{ ".r16", FORMAT_RAW16 },
+		{ ".raw", FORMAT_RAW16 },
+		{ ".r32", FORMAT_RAW32 }
+	};
+
+	//--- Every raw file that was found but couldn't be used, so they aren't hidden behind the PNG's error
+	std::string rawErrors;
+
+	for (const auto& raw : rawFormats) {
+
+		if (!m_file.Open(fileLocation + raw.extension)) { continue; }
+		if (LoadRaw(fileLocation + raw.extension, raw.format)) { return true; }
+
+		rawErrors += m_error + ": " + fileLocation + raw.extension + " - ";
+		m_error.clear();
+	}
+
+	if (LoadPNG(fileLocation + ".png")) { return true; }
+
+	m_error = rawErrors + m_error;
+	return false;
+}
+
+
+/*******************************************************************************************************************
+	A function that releases all heightmap data
+*******************************************************************************************************************/
+void HeightMapLoader::Unload()
+{
+	if (m_image) { stbi_image_free(m_image); }
+	m_file.Close();
+
+	m_image		= nullptr;
+	m_pixels	= nullptr;
+	m_format	= FORMAT_NONE;
+	m_width		= 0;
+	m_height	= 0;
+}
+
+
+/*******************************************************************************************************************
+	A function that validates a raw heightmap which has already been memory mapped
+*******************************************************************************************************************/
+bool HeightMapLoader::LoadRaw(const std::string& fileLocation, Format format)
+{
+	m_fileLocation = fileLocation;
+
+	size_t sampleSize	= (format == FORMAT_RAW32) ? sizeof(float) : sizeof(uint16_t);
+	size_t samples		= m_file.GetSize() / sampleSize;
+
+	//--- Raw files have no header, so work out the dimensions from the file size (raw files must be square)
+	int side = 1;
+	while ((size_t)side * side < samples) { side <<= 1; }
+
+	if (m_file.GetSize() % sampleSize != 0 || (size_t)side * side != samples) {
+		return Fail("Raw heightmap file must be square and power of 2 dimensions");
+	}
+
+	m_format	= format;
+	m_width		= side;
+	m_height	= side;
+	m_pixels	= m_file.GetData();
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that decodes an 8-bit or 16-bit PNG heightmap, reading in a single (grayscale) channel only
+*******************************************************************************************************************/
+bool HeightMapLoader::LoadPNG(const std::string& fileLocation)
+{
+	m_fileLocation = fileLocation;
+
+	//--- Image must be flipped vertically, otherwise pixel data will be read in incorrectly
+	stbi_set_flip_vertically_on_load(true);
+
+	//--- We ask stb_image for 1 channel, so RGB heightmaps are converted to grayscale for us
+	//--- and we don't decode colour values we would only throw away
+	int channels = 0;
+
+	if (stbi_is_16_bit(fileLocation.c_str())) {
+		m_image		= stbi_load_16(fileLocation.c_str(), &m_width, &m_height, &channels, 1);
+		m_format	= FORMAT_PNG16;
+	}
+	else {
+		m_image		= stbi_load(fileLocation.c_str(), &m_width, &m_height, &channels, 1);
+		m_format	= FORMAT_PNG8;
+	}
+
+	//--- stb_image tells us why it failed - a missing file is just the one it couldn't open
+	if (!m_image) {
+		const char* reason = stbi_failure_reason();
+
+		if (!reason || std::strcmp(reason, "can't fopen") == 0) { return Fail("Heightmap file doesn't exist"); }
+		return Fail("Heightmap file couldn't be decoded (" + std::string(reason) + ")");
+	}
+
+	//--- Make sure the heightmap file has power of 2 dimensions, e.g. 128x128, 256x256, 512x512, etc.
+	if ((m_width & (m_width - 1)) != 0 || (m_height & (m_height - 1)) != 0) {
+		return Fail("Heightmap file is not power of 2 dimensions");
+	}
+
+	m_pixels = static_cast<const uint8_t*>(m_image);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that stores the reason a heightmap failed to load and releases any partially loaded data
+*******************************************************************************************************************/
+bool HeightMapLoader::Fail(const std::string& error)
+{
+	Unload();
+	m_error = error;
+
+	return false;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+int HeightMapLoader::GetWidth() const							{ return m_width; }
+int HeightMapLoader::GetHeight() const							{ return m_height; }
+HeightMapLoader::Format HeightMapLoader::GetFormat() const		{ return m_format; }
+const std::string& HeightMapLoader::GetFileLocation() const	{ return m_fileLocation; }
+const std::string& HeightMapLoader::GetError() const			{ return m_error; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+//--- Legacy heightmaps were 8-bit, so every format is scaled to the same 0 - 255 range
+const float HeightMapLoader::s_maxHeight = 255.0f;
\ No newline at end of file
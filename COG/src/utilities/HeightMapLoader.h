@@ -0,0 +1,136 @@
+#pragma once
+
+/*******************************************************************************************************************
+	HeightMapLoader.h, HeightMapLoader.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Loads in heightmap sample data from disk, in any of the formats the terrain supports.
+
+	[Features]
+	8-bit grayscale/RGB PNG files (legacy heightmaps).
+	16-bit grayscale PNG files.
+	Raw little-endian 16-bit (.r16 / .raw) and 32-bit float (.r32) files, memory mapped and converted in a single pass.
+
+	[Upcoming]
+	Rectangular raw files (would need a small header or sidecar file to store the dimensions).
+
+	[Side Notes]
+	Raw files have no header, so they must be square and power of 2 - the dimensions are worked out from the file size.
+	All samples are converted to the legacy 0 - 255 range, so that a terrain's level value behaves the same
+	no matter which format the heightmap was saved in. 16-bit and float files simply keep the fractional part.
+	Float files are expected to be normalized (0.0 - 1.0).
+
+	This class has no dependencies on OpenGL, SDL or the engine singletons, so the headless tools can use it too.
+	Call GetError() to find out why a heightmap failed to load. A raw file that is the wrong size doesn't stop the
+	other formats from being tried, so its error is only reported (along with theirs) if none of them load either.
+
+*******************************************************************************************************************/
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "utilities/MappedFile.h"
+
+class HeightMapLoader {
+
+public:
+	enum Format { FORMAT_NONE, FORMAT_PNG8, FORMAT_PNG16, FORMAT_RAW16, FORMAT_RAW32 };
+
+public:
+	HeightMapLoader();
+	~HeightMapLoader();
+
+public:
+	bool Load(const std::string& fileLocation);
+	void Unload();
+
+public:
+	template <typename T> void ForEachSample(T sink) const;
+
+public:
+	int					GetWidth() const;
+	int					GetHeight() const;
+	Format				GetFormat() const;
+	const std::string&	GetFileLocation() const;
+	const std::string&	GetError() const;
+
+private:
+	HeightMapLoader(const HeightMapLoader&)				= delete;
+	HeightMapLoader& operator=(const HeightMapLoader&)	= delete;
+
+private:
+	bool LoadRaw(const std::string& fileLocation, Format format);
+	bool LoadPNG(const std::string& fileLocation);
+	bool Fail(const std::string& error);
+
+private:
+	Format		m_format;
+	int			m_width, m_height;
+	std::string	m_fileLocation;
+	std::string	m_error;
+
+private:
+	MappedFile		m_file;
+	const uint8_t*	m_pixels;
+	void*			m_image;
+
+private:
+	static const float s_maxHeight;
+};
+
+/*******************************************************************************************************************
+	Template function that passes every sample to the sink as (column, row, height), row by row.
+	Rows are flipped so that row 0 is the bottom of the image, matching how the terrain has always read heightmaps.
+*******************************************************************************************************************/
+template <typename T> void HeightMapLoader::ForEachSample(T sink) const
+{
+	//--- NOTE
+	// We switch on the format once, outside the loops, so each conversion loop stays tight.
+	// stb_image has already flipped PNG data for us, raw files are stored top row first so we flip those here.
+	// Raw samples are assembled byte by byte, so the files read correctly on big-endian machines too.
+	//---
+
+	const float maxHeight16 = s_maxHeight / 65535.0f;
+
+	switch (m_format) {
+
+	case FORMAT_PNG8:
+		for (int row = 0; row < m_height; row++) {
+			const uint8_t* pixels = m_pixels + ((size_t)row * m_width);
+			for (int column = 0; column < m_width; column++) { sink(column, row, (float)pixels[column]); }
+		}
+		break;
+
+	case FORMAT_PNG16:
+		for (int row = 0; row < m_height; row++) {
+			const uint16_t* pixels = reinterpret_cast<const uint16_t*>(m_pixels) + ((size_t)row * m_width);
+			for (int column = 0; column < m_width; column++) { sink(column, row, (float)pixels[column] * maxHeight16); }
+		}
+		break;
+
+	case FORMAT_RAW16:
+		for (int row = 0; row < m_height; row++) {
+			const uint8_t* bytes = m_pixels + ((size_t)(m_height - 1 - row) * m_width * sizeof(uint16_t));
+			for (int column = 0; column < m_width; column++, bytes += sizeof(uint16_t)) {
+				uint16_t sample = (uint16_t)(bytes[0] | (bytes[1] << 8));
+				sink(column, row, (float)sample * maxHeight16);
+			}
+		}
+		break;
+
+	case FORMAT_RAW32:
+		for (int row = 0; row < m_height; row++) {
+			const uint8_t* bytes = m_pixels + ((size_t)(m_height - 1 - row) * m_width * sizeof(float));
+			for (int column = 0; column < m_width; column++, bytes += sizeof(float)) {
+				uint32_t bits = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+				float sample = 0.0f;
+				std::memcpy(&sample, &bits, sizeof(float));
+				sink(column, row, sample * s_maxHeight);
+			}
+		}
+		break;
+
+	default:
+		break;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,434 @@
+#include <algorithm>
+#include "JobSystem.h"
+
+/*******************************************************************************************************************
+	Counter constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+JobSystem::Counter::Counter()
+	:	m_count(0)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Counter default destructor
+*******************************************************************************************************************/
+JobSystem::Counter::~Counter()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that checks if every job using the counter has finished
+*******************************************************************************************************************/
+bool JobSystem::Counter::IsDone() const
+{
+	return m_count.load() == 0;
+}
+
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+JobSystem::JobSystem()
+	:	m_mainThreadID(std::this_thread::get_id()),
+		m_outsideWorker(),
+		m_pendingTasks(0),
+		m_schedulingThreads(0),
+		m_isRunning(false),
+		m_statsTime(std::chrono::steady_clock::now())
+{
+	//--- The main thread always has a queue, so jobs can be pushed before Start() and after Stop()
+	m_workers.emplace_back(new Worker());
+	m_stats.resize(1, { 0, 0, 0.0f, 0.0f });
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+JobSystem::~JobSystem()
+{
+	Stop();
+}
+
+
+/*******************************************************************************************************************
+	Function that starts the worker threads. A worker count of 0 means one worker per core (including the main thread)
+*******************************************************************************************************************/
+void JobSystem::Start(unsigned int workerCount)
+{
+	if (m_isRunning) { return; }
+
+	if (workerCount == 0) { workerCount = std::max(std::thread::hardware_concurrency(), 1u); }
+
+	m_mainThreadID	= std::this_thread::get_id();
+	m_isRunning		= true;
+
+	for (unsigned int i = 1; i < workerCount; i++) { m_workers.emplace_back(new Worker()); }
+	for (unsigned int i = 1; i < workerCount; i++) { m_workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i); }
+
+	m_stats.assign(workerCount, { 0, 0, 0.0f, 0.0f });
+	m_statsTime = std::chrono::steady_clock::now();
+}
+
+
+/*******************************************************************************************************************
+	Function that finishes every queued job, then stops the worker threads
+*******************************************************************************************************************/
+void JobSystem::Stop()
+{
+	if (!m_isRunning) { return; }
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepLock);
+		m_isRunning = false;
+	}
+
+	m_wakeUp.notify_all();
+
+	//--- A job queued from another thread may have seen the system running just before it stopped - let it finish queuing
+	while (m_schedulingThreads.load() > 0) { std::this_thread::yield(); }
+
+	//--- Workers only stop once the queues are empty, so help empty them rather than just waiting
+	while (RunNext(0)) {}
+
+	for (unsigned int i = 1; i < m_workers.size(); i++) { m_workers[i]->thread.join(); }
+
+	//--- Then run anything the last jobs queued before they saw the system had stopped, so nothing is lost with the workers
+	while (RunNext(0)) {}
+
+	m_workers.resize(1);
+	m_stats.resize(1);
+
+	RunMainThreadJobs();
+}
+
+
+/*******************************************************************************************************************
+	Function that queues a job on the calling thread's queue. The counter (if any) goes down by one when it's done
+*******************************************************************************************************************/
+void JobSystem::Run(Job job, Counter* counter)
+{
+	if (counter) { counter->m_count++; }
+
+	Schedule({ std::move(job), counter, false });
+}
+
+
+/*******************************************************************************************************************
+	Function that queues a job that only starts once every job using the dependency counter has finished
+*******************************************************************************************************************/
+void JobSystem::RunAfter(Counter& dependency, Job job, Counter* counter)
+{
+	if (counter) { counter->m_count++; }
+
+	Task task = { std::move(job), counter, false };
+
+	{
+		//--- Finish() empties the waiting list under the same lock, so the job is either queued now or by Finish()
+		std::lock_guard<std::mutex> lock(dependency.m_lock);
+
+		if (dependency.m_count.load() > 0) {
+			dependency.m_waiting.push_back(std::move(task));
+			return;
+		}
+	}
+
+	Schedule(std::move(task));
+}
+
+
+/*******************************************************************************************************************
+	Function that queues a job that has to run on the main thread (e.g. anything that calls OpenGL)
+*******************************************************************************************************************/
+void JobSystem::RunOnMainThread(Job job, Counter* counter)
+{
+	if (counter) { counter->m_count++; }
+
+	Schedule({ std::move(job), counter, true });
+}
+
+
+/*******************************************************************************************************************
+	Function that runs other jobs until every job using the counter has finished
+*******************************************************************************************************************/
+void JobSystem::Wait(Counter& counter)
+{
+	unsigned int worker	= GetWorkerIndex();
+	bool isMainThread	= IsMainThread();
+
+	while (!counter.IsDone()) {
+		if (isMainThread && RunNextMainThreadJob()) { continue; }
+		if (!RunNext(worker)) { std::this_thread::yield(); }
+	}
+
+	//--- The last job decrements the counter while holding its lock, so this waits for it to let go of the counter
+	std::lock_guard<std::mutex> lock(counter.m_lock);
+}
+
+
+/*******************************************************************************************************************
+	Function that splits [0, count) into batches of at least minimumBatch, runs function(first, last) on each batch
+	across the workers and returns once they have all finished. The calling thread takes the first batch
+*******************************************************************************************************************/
+void JobSystem::ParallelFor(unsigned int count, unsigned int minimumBatch, const std::function<void(unsigned int, unsigned int)>& function)
+{
+	if (count == 0) { return; }
+
+	//--- A few batches per worker, so a worker that finishes early can steal some of the work from a slow one
+	unsigned int batches	= std::min(GetWorkerCount() * s_batchesPerWorker, std::max(count / std::max(minimumBatch, 1u), 1u));
+	unsigned int batchSize	= (count + batches - 1) / batches;
+
+	Counter counter;
+
+	for (unsigned int first = batchSize; first < count; first += batchSize) {
+		unsigned int last = std::min(first + batchSize, count);
+		Run([&function, first, last]() { function(first, last); }, &counter);
+	}
+
+	function(0, std::min(batchSize, count));
+
+	Wait(counter);
+}
+
+
+/*******************************************************************************************************************
+	Function that runs every queued main thread job - called by the GameManager once a frame
+*******************************************************************************************************************/
+void JobSystem::RunMainThreadJobs()
+{
+	while (RunNextMainThreadJob()) {}
+}
+
+
+/*******************************************************************************************************************
+	Function that works out how busy each worker has been since the last time this was called
+*******************************************************************************************************************/
+void JobSystem::UpdateStats()
+{
+	auto now		= std::chrono::steady_clock::now();
+	double elapsed	= std::chrono::duration<double, std::milli>(now - m_statsTime).count();
+
+	m_statsTime = now;
+
+	for (unsigned int i = 0; i < m_workers.size(); i++) {
+
+		Worker& worker	= *m_workers[i];
+		float busyTime	= (float)(worker.busyTime.exchange(0) / 1000000.0);
+
+		m_stats[i].jobs			= worker.jobs.exchange(0);
+		m_stats[i].steals		= worker.steals.exchange(0);
+		m_stats[i].busyTime		= busyTime;
+		m_stats[i].utilization	= (elapsed > 0.0) ? std::min(busyTime / (float)elapsed, 1.0f) : 0.0f;
+	}
+}
+
+
+/*******************************************************************************************************************
+	Function that puts a job in the right queue and wakes a worker up to run it
+*******************************************************************************************************************/
+void JobSystem::Schedule(Task task)
+{
+	//--- Counted before checking m_isRunning, so Stop() can wait for anything that saw the system running to be queued
+	m_schedulingThreads++;
+
+	//--- With no workers running, just do the job now (off the main thread it counts as an outside job)
+	if (!m_isRunning) {
+		m_schedulingThreads--;
+		Execute(task, IsMainThread() ? *m_workers[0] : m_outsideWorker);
+		return;
+	}
+
+	if (task.isMainThread) {
+		{
+			std::lock_guard<std::mutex> lock(m_mainThreadLock);
+			m_mainThreadTasks.push_back(std::move(task));
+		}
+
+		m_schedulingThreads--;
+		return;
+	}
+
+	Worker& worker = GetWorker(GetWorkerIndex());
+
+	{
+		std::lock_guard<std::mutex> lock(worker.lock);
+		worker.tasks.push_back(std::move(task));
+	}
+
+	//--- NOTE
+	// Taking the sleep lock (even for nothing) makes sure a worker that has just checked for work, found none, and is
+	// about to go to sleep, is fully asleep before we notify - otherwise it could miss the wake up.
+	//---
+	m_pendingTasks++;
+	m_schedulingThreads--;
+
+	{ std::lock_guard<std::mutex> lock(m_sleepLock); }
+
+	m_wakeUp.notify_one();
+}
+
+
+/*******************************************************************************************************************
+	Function that runs a job, keeps track of how long it took and lets its counter know it's done
+*******************************************************************************************************************/
+void JobSystem::Execute(Task& task, Worker& worker)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	task.job();
+
+	worker.busyTime += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	worker.jobs++;
+
+	if (task.counter) { Finish(task.counter); }
+}
+
+
+/*******************************************************************************************************************
+	Function that decrements a counter and, if it has hit zero, queues every job that was waiting on it
+*******************************************************************************************************************/
+void JobSystem::Finish(Counter* counter)
+{
+	std::vector<Task> ready;
+
+	{
+		std::lock_guard<std::mutex> lock(counter->m_lock);
+		if (--counter->m_count == 0) { ready.swap(counter->m_waiting); }
+	}
+
+	for (auto& task : ready) { Schedule(std::move(task)); }
+}
+
+
+/*******************************************************************************************************************
+	Function that runs one job - the newest from the worker's own queue, otherwise the oldest from another queue
+	(the outside queue included)
+*******************************************************************************************************************/
+bool JobSystem::RunNext(unsigned int worker)
+{
+	Task task;
+	bool isFound	= false;
+	bool isStolen	= false;
+
+	Worker& own = GetWorker(worker);
+
+	{
+		std::lock_guard<std::mutex> lock(own.lock);
+
+		if (!own.tasks.empty()) {
+			task	= std::move(own.tasks.back());
+			isFound	= true;
+			own.tasks.pop_back();
+		}
+	}
+
+	//--- Steal from the front (the oldest jobs), which are usually the biggest pieces of work left
+	unsigned int queues = (unsigned int)m_workers.size() + 1;
+
+	for (unsigned int i = 1; i < queues && !isFound; i++) {
+
+		Worker& victim = GetWorker((worker + i) % queues);
+		std::lock_guard<std::mutex> lock(victim.lock);
+
+		if (!victim.tasks.empty()) {
+			task		= std::move(victim.tasks.front());
+			isFound		= true;
+			isStolen	= true;
+			victim.tasks.pop_front();
+		}
+	}
+
+	if (!isFound) { return false; }
+
+	m_pendingTasks--;
+
+	if (isStolen) { own.steals++; }
+
+	Execute(task, own);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that runs the oldest main thread job, if there is one
+*******************************************************************************************************************/
+bool JobSystem::RunNextMainThreadJob()
+{
+	Task task;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mainThreadLock);
+
+		if (m_mainThreadTasks.empty()) { return false; }
+
+		task = std::move(m_mainThreadTasks.front());
+		m_mainThreadTasks.pop_front();
+	}
+
+	Execute(task, *m_workers[0]);
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that returns the calling thread's queue - its own for a worker (or the main thread), otherwise the
+	outside queue shared by every other thread (which is one past the last worker)
+*******************************************************************************************************************/
+unsigned int JobSystem::GetWorkerIndex() const
+{
+	if (s_workerIndex < m_workers.size())	{ return s_workerIndex; }
+	if (IsMainThread())						{ return 0; }
+
+	return (unsigned int)m_workers.size();
+}
+
+
+/*******************************************************************************************************************
+	Function that returns a worker by index, where the index one past the last worker is the outside queue
+*******************************************************************************************************************/
+JobSystem::Worker& JobSystem::GetWorker(unsigned int worker)
+{
+	return (worker < m_workers.size()) ? *m_workers[worker] : m_outsideWorker;
+}
+
+
+/*******************************************************************************************************************
+	The loop each worker thread runs - run jobs while there are any, otherwise sleep until more are queued
+*******************************************************************************************************************/
+void JobSystem::WorkerLoop(unsigned int worker)
+{
+	s_workerIndex = worker;
+
+	while (true) {
+
+		if (RunNext(worker)) { continue; }
+
+		std::unique_lock<std::mutex> lock(m_sleepLock);
+		m_wakeUp.wait(lock, [this]() { return m_pendingTasks.load() > 0 || !m_isRunning; });
+
+		if (!m_isRunning && m_pendingTasks.load() == 0) { break; }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+const std::vector<JobSystem::WorkerStats>& JobSystem::GetStats() const	{ return m_stats; }
+unsigned int JobSystem::GetWorkerCount() const							{ return (unsigned int)m_workers.size(); }
+bool JobSystem::IsRunning() const										{ return m_isRunning; }
+bool JobSystem::IsMainThread() const									{ return std::this_thread::get_id() == m_mainThreadID; }
+
+
+/*******************************************************************************************************************
+	Static variables and functions
+*******************************************************************************************************************/
+const unsigned int JobSystem::s_noWorker			= ~0u;
+thread_local unsigned int JobSystem::s_workerIndex	= JobSystem::s_noWorker;
+const unsigned int JobSystem::s_batchesPerWorker	= 4;
\ No newline at end of file
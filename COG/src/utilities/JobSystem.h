@@ -0,0 +1,161 @@
+#pragma once
+
+/*******************************************************************************************************************
+	JobSystem.h, JobSystem.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	A work stealing job scheduler - one worker thread per core (the main thread counts as one), each with its own
+	queue of jobs. Workers run their own jobs first and steal from the other queues when they run out, so the work
+	spreads itself out without one shared queue that every thread fights over. Threads that aren't workers (e.g. the
+	render thread) share one more queue of their own, which the workers steal from as well.
+
+	[Features]
+	Counters - every job can decrement a counter when it's done, which can be waited on (Wait()) or used as a
+	dependency for other jobs (RunAfter()), so jobs only start once the jobs they need have finished.
+	ParallelFor() - splits a range into batches and runs them across every worker (the calling thread helps).
+	Main thread jobs (RunOnMainThread()) for anything that must happen on the thread that owns the OpenGL context.
+	Waiting threads run other jobs while they wait, rather than sitting idle.
+	Per-worker stats - jobs run, jobs stolen and how busy each worker was since the last UpdateStats().
+
+	[Upcoming]
+	Job priorities, so streaming and asset loading never hold up the frame.
+
+	[Side Notes]
+	Only uses the standard library, so it can be used by the tools as well as the game (e.g. TerrainBaker).
+	If the job system isn't running (Start() hasn't been called, or it has been stopped), jobs run straight away
+	on the calling thread - so code using it still works in the tools and when the game is shutting down.
+	Main thread jobs are run by RunMainThreadJobs() (called by the GameManager once a frame) or by Wait() when it's
+	called from the main thread. Never call Wait() on a worker thread for a counter that needs a main thread job.
+	A counter must outlive the jobs using it, so wait on it before it goes out of scope.
+	Stop() runs every job queued before it returns - anything queued once it has started stopping runs straight away
+	on the thread that queued it. Start() and Stop() must only be called from the main thread.
+
+*******************************************************************************************************************/
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem {
+
+public:
+	typedef std::function<void()> Job;
+
+	class Counter;
+
+private:
+	struct Task {
+		Job			job;
+		Counter*	counter;
+		bool		isMainThread;
+	};
+
+	//--- Worker 0 is the main thread, the rest each have their own thread (the outside worker has none of its own)
+	struct Worker {
+		std::deque<Task>			tasks;
+		std::mutex					lock;
+		std::thread					thread;
+		std::atomic<uint64_t>		busyTime;
+		std::atomic<unsigned int>	jobs;
+		std::atomic<unsigned int>	steals;
+	};
+
+public:
+	class Counter {
+
+	public:
+		Counter();
+		~Counter();
+
+	public:
+		bool IsDone() const;
+
+	private:
+		Counter(const Counter&)				= delete;
+		Counter& operator=(const Counter&)	= delete;
+
+	private:
+		friend class JobSystem;
+
+	private:
+		std::atomic<int>	m_count;
+		std::mutex			m_lock;
+		std::vector<Task>	m_waiting;
+	};
+
+	struct WorkerStats {
+		unsigned int	jobs;
+		unsigned int	steals;
+		float			busyTime;
+		float			utilization;
+	};
+
+public:
+	JobSystem();
+	~JobSystem();
+
+public:
+	void Start(unsigned int workerCount = 0);
+	void Stop();
+
+public:
+	void Run(Job job, Counter* counter = nullptr);
+	void RunAfter(Counter& dependency, Job job, Counter* counter = nullptr);
+	void RunOnMainThread(Job job, Counter* counter = nullptr);
+	void Wait(Counter& counter);
+	void ParallelFor(unsigned int count, unsigned int minimumBatch, const std::function<void(unsigned int, unsigned int)>& function);
+
+public:
+	void RunMainThreadJobs();
+	void UpdateStats();
+
+public:
+	const std::vector<WorkerStats>&	GetStats() const;
+	unsigned int					GetWorkerCount() const;
+	bool							IsRunning() const;
+	bool							IsMainThread() const;
+
+private:
+	JobSystem(const JobSystem&)				= delete;
+	JobSystem& operator=(const JobSystem&)	= delete;
+
+private:
+	void Schedule(Task task);
+	void Finish(Counter* counter);
+	void Execute(Task& task, Worker& worker);
+	bool RunNext(unsigned int worker);
+	unsigned int GetWorkerIndex() const;
+	Worker& GetWorker(unsigned int worker);
+	bool RunNextMainThreadJob();
+	void WorkerLoop(unsigned int worker);
+
+private:
+	std::vector<std::unique_ptr<Worker>>	m_workers;
+	Worker									m_outsideWorker;
+	std::deque<Task>						m_mainThreadTasks;
+	std::mutex								m_mainThreadLock;
+	std::thread::id							m_mainThreadID;
+
+private:
+	std::mutex					m_sleepLock;
+	std::condition_variable		m_wakeUp;
+	std::atomic<int>			m_pendingTasks;
+	std::atomic<int>			m_schedulingThreads;
+	std::atomic<bool>			m_isRunning;
+
+private:
+	std::vector<WorkerStats>				m_stats;
+	std::chrono::steady_clock::time_point	m_statsTime;
+
+private:
+	static thread_local unsigned int	s_workerIndex;
+	static const unsigned int			s_noWorker;
+	static const unsigned int			s_batchesPerWorker;
+};
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+MappedFile::MappedFile(const std::string& fileLocation)
+	:	m_data(nullptr),
+		m_size(0),
+		m_fileHandle(nullptr),
+		m_mappingHandle(nullptr),
+		m_fileDescriptor(-1)
+{
+	Open(fileLocation);
+}
+
+MappedFile::MappedFile()
+	:	m_data(nullptr),
+		m_size(0),
+		m_fileHandle(nullptr),
+		m_mappingHandle(nullptr),
+		m_fileDescriptor(-1)
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Cleanup all memory usage - unmaps the view and closes any handles we own
+*******************************************************************************************************************/
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+
+/*******************************************************************************************************************
+	A function that maps the whole file into read-only memory, returns false if the file couldn't be mapped
+*******************************************************************************************************************/
+bool MappedFile::Open(const std::string& fileLocation)
+{
+	//--- Release any previous mapping so the object can be re-used
+	Close();
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(fileLocation.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { return false; }
+
+	LARGE_INTEGER size = {};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return false; }
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) { CloseHandle(file); return false; }
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+
+	m_fileHandle	= file;
+	m_mappingHandle	= mapping;
+	m_data			= static_cast<const uint8_t*>(view);
+	m_size			= static_cast<size_t>(size.QuadPart);
+#else
+	int file = open(fileLocation.c_str(), O_RDONLY);
+	if (file < 0) { return false; }
+
+	struct stat status = {};
+	if (fstat(file, &status) != 0 || status.st_size == 0) { close(file); return false; }
+
+	void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	if (view == MAP_FAILED) { close(file); return false; }
+
+	//--- We read the data front to back in one pass, so let the kernel read ahead aggressively
+	madvise(view, (size_t)status.st_size, MADV_SEQUENTIAL);
+
+	m_fileDescriptor	= file;
+	m_data				= static_cast<const uint8_t*>(view);
+	m_size				= (size_t)status.st_size;
+#endif
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A function that unmaps the file and releases all handles
+*******************************************************************************************************************/
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+	if (m_data)				{ UnmapViewOfFile(m_data); }
+	if (m_mappingHandle)	{ CloseHandle((HANDLE)m_mappingHandle); }
+	if (m_fileHandle)		{ CloseHandle((HANDLE)m_fileHandle); }
+#else
+	if (m_data)					{ munmap((void*)m_data, m_size); }
+	if (m_fileDescriptor >= 0)	{ close(m_fileDescriptor); }
+#endif
+
+	m_data				= nullptr;
+	m_size				= 0;
+	m_fileHandle		= nullptr;
+	m_mappingHandle		= nullptr;
+	m_fileDescriptor	= -1;
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+bool MappedFile::IsOpen() const				{ return m_data != nullptr; }
+const uint8_t* MappedFile::GetData() const	{ return m_data; }
+size_t MappedFile::GetSize() const			{ return m_size; }
\ No newline at end of file
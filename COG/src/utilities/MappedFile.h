@@ -0,0 +1,54 @@
+#pragma once
+
+/*******************************************************************************************************************
+	MappedFile.h, MappedFile.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Maps a file on disk into read-only memory, so large binary files can be read without copying them into a buffer.
+
+	[Features]
+	Supports Windows (file mapping objects) and POSIX (mmap).
+	The mapping is released automatically when the object goes out of scope.
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	This class deliberately has no dependencies on the rest of the engine (no logging, no singletons), so it can be
+	used by the headless tools as well as the game itself. Check IsOpen() after construction/Open().
+
+*******************************************************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile {
+
+public:
+	MappedFile(const std::string& fileLocation);
+	MappedFile();
+	~MappedFile();
+
+public:
+	bool Open(const std::string& fileLocation);
+	void Close();
+
+public:
+	bool			IsOpen() const;
+	const uint8_t*	GetData() const;
+	size_t			GetSize() const;
+
+private:
+	MappedFile(const MappedFile&)				= delete;
+	MappedFile& operator=(const MappedFile&)	= delete;
+
+private:
+	const uint8_t*	m_data;
+	size_t			m_size;
+
+private:
+	void*	m_fileHandle;
+	void*	m_mappingHandle;
+	int		m_fileDescriptor;
+};
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+/*******************************************************************************************************************
+	Simd.h
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Decides once, for the whole engine, whether the SSE2 paths can be compiled (COG_SIMD), and includes the SSE2
+	intrinsics when they can.
+
+	[Features]
+	COG_SIMD is 1 when SSE2 can be used and 0 otherwise - code using it keeps a scalar path under #else.
+
+	[Upcoming]
+	Nothing at present.
+
+	[Side Notes]
+	SSE2 is always available on x64, so only 32-bit builds without /arch:SSE2 fall back to the scalar paths.
+
+*******************************************************************************************************************/
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define COG_SIMD 1
+	#include <emmintrin.h>
+#else
+	#define COG_SIMD 0
+#endif
\ No newline at end of file
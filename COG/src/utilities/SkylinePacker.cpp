@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <climits>
+#include "SkylinePacker.h"
+
+/*******************************************************************************************************************
+	Constructor with initializer list to set default values of data members
+*******************************************************************************************************************/
+SkylinePacker::SkylinePacker(int width, int height, int padding)
+	:	m_width(0),
+		m_height(0),
+		m_padding(0),
+		m_usedHeight(0),
+		m_usedArea(0)
+{
+	Reset(width, height, padding);
+}
+
+
+/*******************************************************************************************************************
+	Default destructor
+*******************************************************************************************************************/
+SkylinePacker::~SkylinePacker()
+{
+
+}
+
+
+/*******************************************************************************************************************
+	Function that empties the area, ready to pack a new set of rectangles into it
+*******************************************************************************************************************/
+void SkylinePacker::Reset(int width, int height, int padding)
+{
+	m_width			= width;
+	m_height		= height;
+	m_padding		= std::max(padding, 0);
+	m_usedHeight	= 0;
+	m_usedArea		= 0;
+
+	m_skyline.clear();
+
+	//--- One flat segment along the top of the area, inside the padding
+	if (m_width > m_padding) { m_skyline.push_back({ m_padding, m_padding, m_width - m_padding }); }
+}
+
+
+/*******************************************************************************************************************
+	Function that finds a place for a rectangle, returning its top left corner in x and y.
+	Returns false if there is no room left for it
+*******************************************************************************************************************/
+bool SkylinePacker::Insert(int width, int height, int& x, int& y)
+{
+	//--- Every rectangle takes its padding on the right and bottom, the area's own padding covers the top and left
+	int paddedWidth		= width + m_padding;
+	int paddedHeight	= height + m_padding;
+
+	int bestTop		= INT_MAX;
+	int bestWidth	= INT_MAX;
+	size_t bestIndex = m_skyline.size();
+
+	for (size_t i = 0; i < m_skyline.size(); i++) {
+
+		int top = 0;
+		if (!Fits(i, paddedWidth, paddedHeight, top)) { continue; }
+
+		//--- Lowest top edge wins, the narrowest segment breaks a tie (so small gaps are used up first)
+		if (top + paddedHeight < bestTop || (top + paddedHeight == bestTop && m_skyline[i].width < bestWidth)) {
+			bestTop		= top + paddedHeight;
+			bestWidth	= m_skyline[i].width;
+			bestIndex	= i;
+		}
+	}
+
+	if (bestIndex == m_skyline.size()) { return false; }
+
+	x = m_skyline[bestIndex].x;
+	y = bestTop - paddedHeight;
+
+	AddSegment(bestIndex, { x, bestTop, paddedWidth });
+
+	m_usedHeight	= std::max(m_usedHeight, bestTop);
+	m_usedArea		+= (size_t)width * (size_t)height;
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that checks whether a rectangle fits with its left edge at the start of a segment. The rectangle sits
+	on the highest segment it spans, which is returned in y
+*******************************************************************************************************************/
+bool SkylinePacker::Fits(size_t index, int width, int height, int& y) const
+{
+	if (m_skyline[index].x + width > m_width) { return false; }
+
+	y = 0;
+	int remaining = width;
+
+	//--- The segments always reach the right edge, so we can't run off the end of the skyline here
+	for (size_t i = index; remaining > 0; i++) {
+		y = std::max(y, m_skyline[i].y);
+		if (y + height > m_height) { return false; }
+		remaining -= m_skyline[i].width;
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Function that adds the top edge of a newly packed rectangle to the skyline, trimming away whatever it now covers
+*******************************************************************************************************************/
+void SkylinePacker::AddSegment(size_t index, const Segment& segment)
+{
+	m_skyline.insert(m_skyline.begin() + index, segment);
+
+	//--- Trim (or remove) the segments the new one overlaps
+	for (size_t i = index + 1; i < m_skyline.size();) {
+
+		const Segment& previous = m_skyline[i - 1];
+		int overlap = previous.x + previous.width - m_skyline[i].x;
+
+		if (overlap <= 0) { break; }
+
+		m_skyline[i].x		+= overlap;
+		m_skyline[i].width	-= overlap;
+
+		if (m_skyline[i].width > 0) { break; }
+
+		m_skyline.erase(m_skyline.begin() + i);
+	}
+
+	//--- Merge neighbours at the same height back into one segment
+	for (size_t i = 0; i + 1 < m_skyline.size();) {
+
+		if (m_skyline[i].y == m_skyline[i + 1].y) {
+			m_skyline[i].width += m_skyline[i + 1].width;
+			m_skyline.erase(m_skyline.begin() + i + 1);
+		}
+		else { i++; }
+	}
+}
+
+
+/*******************************************************************************************************************
+	Accessor methods
+*******************************************************************************************************************/
+int SkylinePacker::GetWidth() const			{ return m_width; }
+int SkylinePacker::GetHeight() const		{ return m_height; }
+int SkylinePacker::GetUsedHeight() const	{ return m_usedHeight; }
+
+
+/*******************************************************************************************************************
+	Function that returns how much of the used area (the full width, down to the lowest rectangle) is covered
+*******************************************************************************************************************/
+float SkylinePacker::GetOccupancy() const
+{
+	if (m_width <= 0 || m_usedHeight <= 0) { return 0.0f; }
+
+	return (float)m_usedArea / ((float)m_width * (float)m_usedHeight);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+/*******************************************************************************************************************
+	SkylinePacker.h, SkylinePacker.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Packs rectangles into a fixed size area (e.g. glyphs into a texture atlas), using the skyline bottom-left method.
+
+	[Features]
+	The packed area is tracked as a skyline - a list of horizontal segments, one for each height the top edge of
+	the packed rectangles is at. Each rectangle goes wherever its top edge ends up lowest (ties go to the narrowest
+	segment, so gaps get filled), and neighbouring segments at the same height are merged back together.
+	Optional padding between rectangles (and around the edge of the area), so filtering doesn't bleed neighbours in.
+	Occupancy - how much of the used area is covered by rectangles, for checking how well a set was packed.
+
+	[Upcoming]
+	A waste map, so the gaps trapped under the skyline can still be filled.
+
+	[Side Notes]
+	Rectangles pack best tallest first, so sort them before inserting if you can.
+	This class doesn't depend on SDL, OpenGL or the engine singletons, so it can be used by the COGBake tool.
+
+*******************************************************************************************************************/
+#include <cstddef>
+#include <vector>
+
+class SkylinePacker {
+
+public:
+	SkylinePacker(int width = 0, int height = 0, int padding = 0);
+	~SkylinePacker();
+
+public:
+	void Reset(int width, int height, int padding = 0);
+	bool Insert(int width, int height, int& x, int& y);
+
+public:
+	int		GetWidth() const;
+	int		GetHeight() const;
+	int		GetUsedHeight() const;
+	float	GetOccupancy() const;
+
+private:
+	struct Segment {
+		int x, y, width;
+	};
+
+private:
+	bool Fits(size_t index, int width, int height, int& y) const;
+	void AddSegment(size_t index, const Segment& segment);
+
+private:
+	std::vector<Segment>	m_skyline;
+	int						m_width;
+	int						m_height;
+	int						m_padding;
+	int						m_usedHeight;
+	size_t					m_usedArea;
+};
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <math.h>
 #include "Timestep.h"
 #include "Timer.h"
 
@@ -5,7 +6,12 @@
 	Constructor with initializer list to set default values of data members
 *******************************************************************************************************************/
 Timestep::Timestep(float initialTime)
-	: m_timestep(0.0f), m_previousTicks(initialTime)
+	:	m_timestep(0.0f),
+		m_previousTicks(initialTime),
+		m_accumulator(0.0f),
+		m_tick(0),
+		m_ticksThisFrame(0),
+		m_isTicking(false)
 {
 
 }
@@ -21,27 +27,53 @@ Timestep::~Timestep()
 
 
 /*******************************************************************************************************************
-	A function that updates the timestep and sets it to the (current time passed in - the last time registered)
+	A function that updates the timestep to (the current time passed in - the last time registered) and adds it on
+	to the time waiting to be used up by fixed updates. Called once per frame
 *******************************************************************************************************************/
 void Timestep::Update(float currentTicks)
 {
 	m_timestep		= (currentTicks - m_previousTicks);
 	m_previousTicks = currentTicks;
+
+	m_accumulator	+= m_timestep;
+	m_ticksThisFrame = 0;
 }
 
 
 /*******************************************************************************************************************
-	A function that calculates the delta time
+	A function that returns true if there is enough time left for another fixed update, e.g. while (Tick()) { ... }
 *******************************************************************************************************************/
-float Timestep::CalculateDeltaTime() const { return (m_timestep / Timer::GetDefaultFrameTime()); }
+bool Timestep::Tick()
+{
+	const float fixedStep = Timer::GetDefaultFrameTime();
+
+	//--- NOTE
+	// If updating takes longer than the time it simulates, every frame has more catching up to do than the last.
+	// Once we hit the cap, drop whole steps we're behind by (keeping the part step, so interpolation stays smooth).
+	//---
+	if (m_ticksThisFrame >= s_maxTicksPerFrame) { m_accumulator = fmodf(m_accumulator, fixedStep); }
+
+	m_isTicking = (m_accumulator >= fixedStep);
+
+	if (m_isTicking) {
+		m_accumulator -= fixedStep;
+		m_ticksThisFrame++;
+		m_tick++;
+	}
+
+	return m_isTicking;
+}
 
 
 /*******************************************************************************************************************
 	Accessor methods
 *******************************************************************************************************************/
-float Timestep::GetMilliseconds() const { return m_timestep; }
-float Timestep::GetSeconds() const		{ return m_timestep * s_secondPerMs; }
-float Timestep::GetDeltaTime() const	{ return min(CalculateDeltaTime(), Timer::GetMaxDeltaTime()); }
+float Timestep::GetMilliseconds() const			{ return m_timestep; }
+float Timestep::GetSeconds() const				{ return m_timestep * s_secondPerMs; }
+float Timestep::GetDeltaTime() const			{ return s_fixedDeltaTime; }
+float Timestep::GetInterpolation() const		{ return m_accumulator / Timer::GetDefaultFrameTime(); }
+unsigned int Timestep::GetTick() const			{ return m_tick; }
+bool Timestep::IsTicking() const				{ return m_isTicking; }
 
 
 /*******************************************************************************************************************
@@ -52,4 +84,6 @@ void Timestep::SetInitialTime(float initialTime) { m_previousTicks = initialTime
 /*******************************************************************************************************************
 	Static variables and functions
 *******************************************************************************************************************/
-const float Timestep::s_secondPerMs		= 0.001f;
\ No newline at end of file
+const float Timestep::s_secondPerMs				= 0.001f;
+const float Timestep::s_fixedDeltaTime			= 1.0f;
+const unsigned int Timestep::s_maxTicksPerFrame	= 5;
\ No newline at end of file
@@ -2,19 +2,23 @@
 /*******************************************************************************************************************
 	Timestep.h, Timestep.cpp
 	Created by Kim Kane
-	Last updated: 14/04/2018
+	Last updated: 18/10/2026
 	Class finalized: 14/04/2018
 
 	Keeps track of our in-game delta time. To be used in conjunction with the Timer class.
 
 	[Features]
-	Nothing at present.
+	Fixed timestep - the time each frame takes is added up, and the game is updated in fixed steps of (approx)16.6ms
+	(Tick()), as many as that time allows. The game runs at the same speed however long each frame takes to render.
+	The number of updates per frame is capped, so a slow update can't make the next frame slower and so on forever.
+	Interpolation amount - how far we are between the last two updates, so rendering can blend between them.
 
 	[Upcoming]
 	Nothing at present.
 
 	[Side Notes]
-	Nothing at present.
+	As every update is the same length, the delta time is always 1.0 (one default frame) during an update.
+	If the cap is hit, the time the game couldn't catch up on is dropped, so the game slows down rather than stalling.
 
 *******************************************************************************************************************/
 class Timestep {
@@ -25,20 +29,27 @@ public:
 
 public:
 	void Update(float currentTicks);
+	bool Tick();
 	void SetInitialTime(float initialTime);
 
 public:
-	float GetMilliseconds() const;
-	float GetSeconds()		const;
-	float GetDeltaTime()	const;
-
-private:
-	float CalculateDeltaTime()	const;
+	float			GetMilliseconds() const;
+	float			GetSeconds()		const;
+	float			GetDeltaTime()		const;
+	float			GetInterpolation()	const;
+	unsigned int	GetTick()			const;
+	bool			IsTicking()			const;
 
 private:
-	float m_timestep;
-	float m_previousTicks;
+	float			m_timestep;
+	float			m_previousTicks;
+	float			m_accumulator;
+	unsigned int	m_tick;
+	unsigned int	m_ticksThisFrame;
+	bool			m_isTicking;
 
 private:
-	static const float s_secondPerMs;
+	static const float			s_secondPerMs;
+	static const float			s_fixedDeltaTime;
+	static const unsigned int	s_maxTicksPerFrame;
 };
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "application/TerrainBaker.h"
+#include "graphics/FontBaker.h"
+
+/*******************************************************************************************************************
+	main.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	COGBake : a headless command-line tool that bakes a directory of heightmaps into terrain geometry files, or a
+	directory of fonts into glyph atlases.
+
+	Usage: COGBake <heightmap directory> <output directory> [level = 25] [jobs = all cores]
+	       COGBake --fonts <font directory> <output directory> [size = 32] [spread = 0]
+
+	Every heightmap (.png, .r16, .raw, .r32) in the input directory is baked to <output directory>/<name>.bake.
+	Copy the output to Assets/Terrain/Baked and the terrain editor will load these instead of re-baking the heightmaps.
+	Files are baked in parallel (one job per file), and each job splits its own rows across the remaining cores.
+
+	With --fonts, every font (.ttf, .otf) in the input directory is baked at the given pixel size to
+	<output directory>/<name>_<size>.bin. Copy the output to Assets/Fonts/Baked and the game will load these instead
+	of running FreeType. A spread bakes distance fields instead (<name>_<size>_sdf.bin) - the game's distance field
+	text uses size 48 and spread 6.
+
+	[Side Notes]
+	This tool only links the TerrainBaker, FontBaker, SkylinePacker, HeightMapLoader, MappedFile and JobSystem sources
+	(and FreeType) - no SDL, OpenGL or Windows, so it builds and runs on build machines that have no GPU or display.
+
+*******************************************************************************************************************/
+
+/*******************************************************************************************************************
+	Bakes every font in a directory into a glyph atlas and metrics table, at one pixel size
+*******************************************************************************************************************/
+static int BakeFonts(int argc, char *argv[])
+{
+	namespace fs = std::filesystem;
+
+	if (argc < 4) {
+		std::printf("Usage: COGBake --fonts <font directory> <output directory> [size = 32] [spread = 0]\n");
+		return EXIT_FAILURE;
+	}
+
+	fs::path inputDirectory		= argv[2];
+	fs::path outputDirectory	= argv[3];
+	int size					= (argc > 4) ? std::atoi(argv[4]) : 32;
+	int spread					= (argc > 5) ? std::atoi(argv[5]) : 0;
+
+	std::error_code error;
+	if (!fs::is_directory(inputDirectory, error)) {
+		std::printf("[BAKE] Font directory doesn't exist: %s\n", inputDirectory.string().c_str());
+		return EXIT_FAILURE;
+	}
+
+	if (size <= 0) {
+		std::printf("[BAKE] Size must be greater than 0\n");
+		return EXIT_FAILURE;
+	}
+
+	if (spread < 0) {
+		std::printf("[BAKE] Spread can't be negative\n");
+		return EXIT_FAILURE;
+	}
+
+	fs::create_directories(outputDirectory, error);
+
+	std::set<std::string> extensions = { ".ttf", ".otf" };
+	std::set<std::string> fonts;
+
+	for (const auto& entry : fs::directory_iterator(inputDirectory, error)) {
+		std::string extension = entry.path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		if (entry.is_regular_file() && extensions.count(extension)) { fonts.insert(entry.path().filename().string()); }
+	}
+
+	if (fonts.empty()) {
+		std::printf("[BAKE] No font files found in: %s\n", inputDirectory.string().c_str());
+		return EXIT_SUCCESS;
+	}
+
+	std::printf("[BAKE] Baking %zu font(s) at %d pixels, spread %d\n", fonts.size(), size, spread);
+	std::printf("%-24s %10s %8s %10s %10s %10s %10s %10s %12s\n", "name", "atlas", "glyphs", "raster ms", "pack ms", "field ms", "save ms", "occupancy", "output KiB");
+
+	int failures = 0;
+
+	//--- Fonts are quick to bake and there are only ever a handful of them, so they are baked one after another,
+	//--- and the job system's workers share out the distance transform of each one instead
+	JobSystem jobSystem;
+	if (spread > 0) { jobSystem.Start(); }
+
+	for (const auto& name : fonts) {
+
+		FontBaker baker(&jobSystem);
+		std::string bakedFilename = FontBaker::GetBakedFilename(name, (unsigned int)size, spread);
+
+		bool baked = baker.Bake(name, (inputDirectory / name).string(), (unsigned int)size, spread) &&
+					 baker.Save((outputDirectory / bakedFilename).string());
+
+		if (!baked) {
+			std::printf("%-24s FAILED: %s\n", name.c_str(), baker.GetError().c_str());
+			failures++;
+			continue;
+		}
+
+		const FontBaker::Stats& stats = baker.GetStats();
+		std::string atlas = std::to_string(baker.GetFont().width) + "x" + std::to_string(baker.GetFont().height);
+
+		std::printf("%-24s %10s %8zu %10.2f %10.2f %10.2f %10.2f %9.1f%% %12zu\n", name.c_str(), atlas.c_str(), baker.GetFont().glyphs.size(),
+					stats.rasterTime, stats.packTime, stats.distanceTime, stats.saveTime, stats.occupancy * 100.0f, stats.fileSize / 1024);
+	}
+
+	jobSystem.Stop();
+
+	std::printf("[BAKE] Finished - %zu baked, %d failed\n", fonts.size() - failures, failures);
+
+	return (failures > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+int main(int argc, char *argv[])
+{
+	namespace fs = std::filesystem;
+
+	if (argc > 1 && std::string(argv[1]) == "--fonts") { return BakeFonts(argc, argv); }
+
+	if (argc < 3) {
+		std::printf("Usage: COGBake <heightmap directory> <output directory> [level = 25] [jobs = all cores]\n");
+		std::printf("       COGBake --fonts <font directory> <output directory> [size = 32] [spread = 0]\n");
+		return EXIT_FAILURE;
+	}
+
+	fs::path inputDirectory		= argv[1];
+	fs::path outputDirectory	= argv[2];
+	float level					= (argc > 3) ? (float)std::atof(argv[3]) : 25.0f;
+	unsigned int jobs			= (argc > 4) ? (unsigned int)std::atoi(argv[4]) : TerrainBaker::GetMaxThreads();
+
+	std::error_code error;
+	if (!fs::is_directory(inputDirectory, error)) {
+		std::printf("[BAKE] Heightmap directory doesn't exist: %s\n", inputDirectory.string().c_str());
+		return EXIT_FAILURE;
+	}
+
+	if (level <= 0.0f) {
+		std::printf("[BAKE] Level must be greater than 0\n");
+		return EXIT_FAILURE;
+	}
+
+	fs::create_directories(outputDirectory, error);
+
+	//--- Collect the heightmap names - a heightmap saved in more than one format is only baked once,
+	//--- and the loader picks the most precise format available
+	std::set<std::string> extensions = { ".png", ".r16", ".raw", ".r32" };
+	std::set<std::string> names;
+
+	for (const auto& entry : fs::directory_iterator(inputDirectory, error)) {
+		std::string extension = entry.path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		if (entry.is_regular_file() && extensions.count(extension)) { names.insert(entry.path().stem().string()); }
+	}
+
+	std::vector<std::string> heightMaps(names.begin(), names.end());
+
+	if (heightMaps.empty()) {
+		std::printf("[BAKE] No heightmap files found in: %s\n", inputDirectory.string().c_str());
+		return EXIT_SUCCESS;
+	}
+
+	//--- One job per file, and whatever cores are left over are shared out between the rows of each file
+	if (jobs == 0)					{ jobs = 1; }
+	if (jobs > heightMaps.size())	{ jobs = (unsigned int)heightMaps.size(); }
+
+	unsigned int rowThreads = std::max(1u, TerrainBaker::GetMaxThreads() / jobs);
+
+	std::printf("[BAKE] Baking %zu heightmap(s) with %u job(s), %u thread(s) per job, level %.2f\n", heightMaps.size(), jobs, rowThreads, level);
+	std::printf("%-24s %10s %10s %10s %10s %10s %12s %12s %12s\n", "name", "size", "load ms", "level ms", "normals ms", "save ms", "input KiB", "memory KiB", "output KiB");
+
+	std::atomic<size_t> next	= 0;
+	std::atomic<int> failures	= 0;
+	std::mutex printLock;
+
+	auto start = std::chrono::steady_clock::now();
+
+	auto job = [&]() {
+		for (size_t file = next++; file < heightMaps.size(); file = next++) {
+
+			const std::string& name = heightMaps[file];
+			TerrainBaker baker(rowThreads);
+
+			bool baked = baker.Bake(name, (inputDirectory / name).string(), level) &&
+						 baker.Save((outputDirectory / (name + ".bake")).string());
+
+			const TerrainBaker::Stats& stats = baker.GetStats();
+			std::lock_guard<std::mutex> lock(printLock);
+
+			if (!baked) {
+				std::printf("%-24s FAILED: %s\n", name.c_str(), baker.GetError().c_str());
+				failures++;
+				continue;
+			}
+
+			std::string size = std::to_string(baker.GetGeometry().width) + "x" + std::to_string(baker.GetGeometry().height);
+
+			std::printf("%-24s %10s %10.2f %10.2f %10.2f %10.2f %12zu %12zu %12zu\n", name.c_str(), size.c_str(),
+						stats.loadTime, stats.levelTime, stats.normalsTime, stats.saveTime,
+						stats.heightMapSize / 1024, stats.geometrySize / 1024, stats.fileSize / 1024);
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < jobs; i++) { workers.emplace_back(job); }
+	job();
+	for (auto& worker : workers) { worker.join(); }
+
+	double totalTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("[BAKE] Finished in %.2f ms - %zu baked, %d failed\n", totalTime, heightMaps.size() - failures, failures.load());
+
+	return (failures > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
\ No newline at end of file
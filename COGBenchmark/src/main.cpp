@@ -0,0 +1,426 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "application/TerrainBaker.h"
+
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+	#include <psapi.h>
+	#pragma comment(lib, "psapi.lib")
+#else
+	#include <sys/resource.h>
+#endif
+
+/*******************************************************************************************************************
+	main.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	COGBenchmark : times each terrain stage in isolation, across a range of heightmap sizes.
+
+	Usage: COGBenchmark [--sizes 256,1024,4096,8192] [--iterations N] [--threads N] [--vertex-budget MiB] [--output file.json]
+
+	[Features]
+	Stages: PNG ingest, raw 16-bit ingest, LevelHeightMap, CalculateNormals, GenerateTerrain vertex build,
+	baked binary save/load and GetHeight.
+	Every stage reports min/median/mean time, bytes allocated, allocation count, peak heap bytes and peak RSS.
+	Results are written as JSON (to stdout, or to the --output file) so runs can be diffed by a script.
+
+	[Side Notes]
+	Heightmaps are generated (deterministic rolling hills), so results are comparable between machines and runs.
+	PNG files are written uncompressed, so the PNG ingest is decode-bound rather than inflate-bound.
+	The vertex build needs ~56 bytes * 6 vertices per grid square, so sizes that would exceed --vertex-budget
+	(default 4096 MiB) are reported as skipped, along with how much memory they would need.
+	Save/load uses the baked geometry file (TerrainBaker), which is the bulk of a terrain binary.
+	Peak RSS is the process high-water mark, so it only ever goes up - read it alongside peak heap bytes.
+
+*******************************************************************************************************************/
+
+//--- Heap tracking - every allocation made while the benchmark runs goes through these counters
+static std::atomic<uint64_t> s_bytesAllocated	= 0;
+static std::atomic<uint64_t> s_allocationCount	= 0;
+static std::atomic<uint64_t> s_currentBytes		= 0;
+static std::atomic<uint64_t> s_peakBytes		= 0;
+
+static const size_t s_headerSize = 16;
+
+void* operator new(size_t size)
+{
+	uint8_t* block = (uint8_t*)std::malloc(size + s_headerSize);
+	if (!block) { throw std::bad_alloc(); }
+
+	std::memcpy(block, &size, sizeof(size_t));
+
+	s_bytesAllocated += size;
+	s_allocationCount++;
+
+	uint64_t current	= s_currentBytes += size;
+	uint64_t peak		= s_peakBytes.load();
+	while (current > peak && !s_peakBytes.compare_exchange_weak(peak, current)) {}
+
+	return block + s_headerSize;
+}
+
+void operator delete(void* memory) noexcept
+{
+	if (!memory) { return; }
+
+	uint8_t* block	= (uint8_t*)memory - s_headerSize;
+	size_t size		= 0;
+	std::memcpy(&size, block, sizeof(size_t));
+
+	s_currentBytes -= size;
+	std::free(block);
+}
+
+void* operator new[](size_t size)						{ return operator new(size); }
+void operator delete[](void* memory) noexcept			{ operator delete(memory); }
+void operator delete(void* memory, size_t) noexcept		{ operator delete(memory); }
+void operator delete[](void* memory, size_t) noexcept	{ operator delete(memory); }
+
+
+/*******************************************************************************************************************
+	Returns the peak resident set size of the process, in bytes
+*******************************************************************************************************************/
+static uint64_t GetPeakRSS()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters = {};
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return (uint64_t)counters.PeakWorkingSetSize;
+#else
+	struct rusage usage = {};
+	getrusage(RUSAGE_SELF, &usage);
+	#if defined(__APPLE__)
+		return (uint64_t)usage.ru_maxrss;
+	#else
+		return (uint64_t)usage.ru_maxrss * 1024;
+	#endif
+#endif
+}
+
+
+/*******************************************************************************************************************
+	Writes an 8-bit grayscale PNG, using stored (uncompressed) deflate blocks so we don't need zlib
+*******************************************************************************************************************/
+static bool WritePNG(const std::string& fileLocation, int size, const std::vector<uint16_t>& samples)
+{
+	static uint32_t crcTable[256] = { 0 };
+	if (!crcTable[1]) {
+		for (uint32_t n = 0; n < 256; n++) {
+			uint32_t c = n;
+			for (int k = 0; k < 8; k++) { c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1; }
+			crcTable[n] = c;
+		}
+	}
+
+	auto bigEndian = [](std::vector<uint8_t>& out, uint32_t value) {
+		out.push_back((uint8_t)(value >> 24)); out.push_back((uint8_t)(value >> 16));
+		out.push_back((uint8_t)(value >> 8)); out.push_back((uint8_t)value);
+	};
+
+	std::ofstream stream(fileLocation, std::ios::binary);
+	if (!stream.is_open()) { return false; }
+
+	auto writeChunk = [&](const char* type, const std::vector<uint8_t>& data) {
+		std::vector<uint8_t> chunk;
+		bigEndian(chunk, (uint32_t)data.size());
+		chunk.insert(chunk.end(), type, type + 4);
+		chunk.insert(chunk.end(), data.begin(), data.end());
+
+		uint32_t crc = 0xFFFFFFFFu;
+		for (size_t i = 4; i < chunk.size(); i++) { crc = crcTable[(crc ^ chunk[i]) & 0xFF] ^ (crc >> 8); }
+		bigEndian(chunk, crc ^ 0xFFFFFFFFu);
+
+		stream.write((const char*)chunk.data(), chunk.size());
+	};
+
+	const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	stream.write((const char*)signature, sizeof(signature));
+
+	std::vector<uint8_t> header;
+	bigEndian(header, (uint32_t)size);
+	bigEndian(header, (uint32_t)size);
+	header.insert(header.end(), { 8, 0, 0, 0, 0 });
+	writeChunk("IHDR", header);
+
+	//--- Each row starts with a filter byte (0 = none), followed by the high byte of each sample
+	std::vector<uint8_t> pixels;
+	pixels.reserve((size_t)size * (size + 1));
+	for (int row = 0; row < size; row++) {
+		pixels.push_back(0);
+		for (int column = 0; column < size; column++) { pixels.push_back((uint8_t)(samples[(size_t)row * size + column] >> 8)); }
+	}
+
+	//--- zlib stream made of stored blocks, followed by the adler32 checksum
+	std::vector<uint8_t> compressed = { 0x78, 0x01 };
+	uint32_t a = 1, b = 0;
+	for (size_t offset = 0; offset < pixels.size(); offset += 65535) {
+		uint16_t length = (uint16_t)std::min<size_t>(65535, pixels.size() - offset);
+		compressed.push_back((offset + length >= pixels.size()) ? 1 : 0);
+		compressed.push_back((uint8_t)length); compressed.push_back((uint8_t)(length >> 8));
+		compressed.push_back((uint8_t)~length); compressed.push_back((uint8_t)(~length >> 8));
+		compressed.insert(compressed.end(), pixels.begin() + offset, pixels.begin() + offset + length);
+	}
+	for (uint8_t pixel : pixels) { a = (a + pixel) % 65521; b = (b + a) % 65521; }
+	bigEndian(compressed, (b << 16) | a);
+
+	writeChunk("IDAT", compressed);
+	writeChunk("IEND", {});
+
+	return stream.good();
+}
+
+
+/*******************************************************************************************************************
+	Generates a deterministic heightmap of rolling hills and writes it out as a PNG and a raw 16-bit file
+*******************************************************************************************************************/
+static bool GenerateHeightMaps(const std::filesystem::path& directory, int size)
+{
+	std::vector<uint16_t> samples((size_t)size * size);
+
+	for (int row = 0; row < size; row++) {
+		for (int column = 0; column < size; column++) {
+			float u = (float)column / size, v = (float)row / size;
+			float height = 0.5f + 0.25f * std::sin(u * 12.0f) * std::cos(v * 9.0f) + 0.125f * std::sin((u + v) * 37.0f);
+			samples[(size_t)row * size + column] = (uint16_t)(std::clamp(height, 0.0f, 1.0f) * 65535.0f);
+		}
+	}
+
+	std::ofstream raw(directory / ("bench_" + std::to_string(size) + "_raw.r16"), std::ios::binary);
+	for (uint16_t sample : samples) { raw.put((char)(sample & 0xFF)); raw.put((char)(sample >> 8)); }
+	if (!raw.good()) { return false; }
+
+	return WritePNG((directory / ("bench_" + std::to_string(size) + "_png.png")).string(), size, samples);
+}
+
+
+/*******************************************************************************************************************
+	The result of timing a single stage at a single size
+*******************************************************************************************************************/
+struct StageResult {
+	std::string stage;
+	int size;
+	bool skipped;	//--- Not run, or failed - see extra for the reason
+	std::vector<double> times;
+	uint64_t bytesAllocated, allocationCount, peakHeapBytes, peakRSS;
+	std::string extra;
+};
+
+
+/*******************************************************************************************************************
+	Runs a stage the given number of times. setup() runs before every iteration and isn't timed or counted.
+	A stage returns false if it failed, which stops the stage and marks it as failed in the results.
+*******************************************************************************************************************/
+template <typename Setup, typename Stage>
+static StageResult Run(const std::string& name, int size, int iterations, Setup setup, Stage stage)
+{
+	StageResult result = { name, size, false, {}, 0, 0, 0, 0, "" };
+
+	for (int i = 0; i < iterations; i++) {
+
+		setup();
+
+		uint64_t bytes		= s_bytesAllocated;
+		uint64_t count		= s_allocationCount;
+		uint64_t baseline	= s_currentBytes;
+		s_peakBytes			= baseline;
+
+		auto start		= std::chrono::steady_clock::now();
+		bool succeeded	= stage();
+		double time		= std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		result.bytesAllocated	= std::max(result.bytesAllocated, s_bytesAllocated - bytes);
+		result.allocationCount	= std::max(result.allocationCount, s_allocationCount - count);
+		result.peakHeapBytes	= std::max(result.peakHeapBytes, s_peakBytes - baseline);
+
+		if (!succeeded) { result.skipped = true; result.extra = ", \"failed\": true"; break; }
+
+		result.times.push_back(time);
+	}
+
+	result.peakRSS = GetPeakRSS();
+
+	return result;
+}
+
+
+/*******************************************************************************************************************
+	Writes all results out as JSON
+*******************************************************************************************************************/
+static void WriteJSON(FILE* file, const std::vector<StageResult>& results, unsigned int threads)
+{
+	std::fprintf(file, "{\n  \"threads\": %u,\n  \"results\": [\n", threads);
+
+	for (size_t i = 0; i < results.size(); i++) {
+
+		const StageResult& result = results[i];
+		std::fprintf(file, "    { \"stage\": \"%s\", \"size\": %d", result.stage.c_str(), result.size);
+
+		if (result.skipped) {
+			std::fprintf(file, ", \"skipped\": true%s }", result.extra.c_str());
+		}
+		else {
+			std::vector<double> sorted = result.times;
+			std::sort(sorted.begin(), sorted.end());
+
+			double mean = 0.0;
+			for (double time : sorted) { mean += time; }
+			mean /= sorted.size();
+
+			std::fprintf(file, ", \"iterations\": %zu, \"min_ms\": %.4f, \"median_ms\": %.4f, \"mean_ms\": %.4f, "
+							   "\"bytes_allocated\": %llu, \"allocations\": %llu, \"peak_heap_bytes\": %llu, \"peak_rss_bytes\": %llu%s }",
+						 sorted.size(), sorted.front(), sorted[sorted.size() / 2], mean,
+						 (unsigned long long)result.bytesAllocated, (unsigned long long)result.allocationCount,
+						 (unsigned long long)result.peakHeapBytes, (unsigned long long)result.peakRSS, result.extra.c_str());
+		}
+
+		std::fprintf(file, (i + 1 < results.size()) ? ",\n" : "\n");
+	}
+
+	std::fprintf(file, "  ]\n}\n");
+}
+
+
+int main(int argc, char *argv[])
+{
+	namespace fs = std::filesystem;
+
+	std::vector<int> sizes		= { 256, 1024, 4096, 8192 };
+	int iterations				= 5;
+	unsigned int threads		= TerrainBaker::GetMaxThreads();
+	uint64_t vertexBudget		= 4096ull * 1024 * 1024;
+	std::string output;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		std::string option = argv[i], value = argv[i + 1];
+
+		if (option == "--sizes") {
+			sizes.clear();
+			for (size_t start = 0, end = 0; start < value.size(); start = end + 1) {
+				end = value.find(',', start);
+				if (end == std::string::npos) { end = value.size(); }
+				sizes.push_back(std::atoi(value.substr(start, end - start).c_str()));
+			}
+		}
+		else if (option == "--iterations")		{ iterations = std::max(1, std::atoi(value.c_str())); }
+		else if (option == "--threads")			{ threads = std::max(1, std::atoi(value.c_str())); }
+		else if (option == "--vertex-budget")	{ vertexBudget = std::strtoull(value.c_str(), nullptr, 10) * 1024 * 1024; }
+		else if (option == "--output")			{ output = value; }
+		else {
+			std::fprintf(stderr, "Usage: COGBenchmark [--sizes 256,1024,4096,8192] [--iterations N] [--threads N] [--vertex-budget MiB] [--output file.json]\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::error_code error;
+	fs::path directory = fs::temp_directory_path(error) / "COGBenchmark";
+	fs::create_directories(directory, error);
+
+	std::vector<StageResult> results;
+	const float level = 25.0f;
+
+	for (int size : sizes) {
+
+		if (size < 2 || (size & (size - 1)) != 0) {
+			std::fprintf(stderr, "[BENCHMARK] Skipping %d - heightmaps must be power of 2\n", size);
+			continue;
+		}
+
+		std::fprintf(stderr, "[BENCHMARK] %d x %d\n", size, size);
+
+		if (!GenerateHeightMaps(directory, size)) {
+			std::fprintf(stderr, "[BENCHMARK] Could not write heightmaps to: %s\n", directory.string().c_str());
+			return EXIT_FAILURE;
+		}
+
+		std::string png		= (directory / ("bench_" + std::to_string(size) + "_png")).string();
+		std::string raw		= (directory / ("bench_" + std::to_string(size) + "_raw")).string();
+		std::string baked	= (directory / ("bench_" + std::to_string(size) + ".bake")).string();
+
+		//--- Larger sizes are far slower, so scale the iterations down to keep the run time sensible
+		int count = (size >= 4096) ? std::max(1, iterations / 4) : iterations;
+
+		TerrainBaker baker(threads);
+		TerrainBaker::Geometry source;
+		auto none = []() {};
+
+		results.push_back(Run("ingest_png8", size, count, none, [&]() { return baker.GenerateHeightMap(png); }));
+		results.push_back(Run("ingest_raw16", size, count, none, [&]() { return baker.GenerateHeightMap(raw); }));
+
+		//--- Keep an un-leveled copy, so every LevelHeightMap iteration starts from the same data
+		if (baker.GetGeometry().width != size) {
+			std::fprintf(stderr, "[BENCHMARK] Heightmap ingest failed: %s\n", baker.GetError().c_str());
+			continue;
+		}
+
+		source = baker.GetGeometry();
+
+		results.push_back(Run("level_heightmap", size, count, [&]() { baker.GetGeometry() = source; }, [&]() { baker.LevelHeightMap(level); return true; }));
+		results.push_back(Run("calculate_normals", size, count, none, [&]() { baker.CalculateNormals(); return true; }));
+
+		source = TerrainBaker::Geometry();
+
+		//--- Build the grid so the save/load and height query stages have complete data
+		baker.GetGeometry().grid = { 0, 0, (float)(size - 1), 1.0f };
+
+		uint64_t vertexBytes = (uint64_t)(size - 1) * (size - 1) * 6 * sizeof(PackedVertex);
+
+		if (vertexBytes <= vertexBudget) {
+			std::vector<PackedVertex> vertices;
+			results.push_back(Run("generate_vertices", size, count, [&]() { std::vector<PackedVertex>().swap(vertices); }, [&]() { baker.GenerateVertices(vertices); return true; }));
+		}
+		else {
+			results.push_back({ "generate_vertices", size, true, {}, 0, 0, 0, 0, ", \"estimated_bytes\": " + std::to_string(vertexBytes) });
+		}
+
+		results.push_back(Run("save_binary", size, count, none, [&]() { return baker.Save(baked); }));
+		results.back().extra = ", \"file_bytes\": " + std::to_string(baker.GetStats().fileSize);
+
+		TerrainBaker loader(threads);
+		results.push_back(Run("load_binary", size, count, [&]() { loader.GetGeometry() = TerrainBaker::Geometry(); }, [&]() { return loader.Load(baked); }));
+
+		//--- Query random positions across the whole terrain, the same way entities do every frame
+		const int queries = 1000000;
+		std::vector<glm::vec2> positions(queries);
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> distribution(0.0f, (float)(size - 1));
+		for (auto& position : positions) { position = glm::vec2(distribution(random), distribution(random)); }
+
+		volatile float sink = 0.0f;
+		TerrainBaker::Geometry& geometry = baker.GetGeometry();
+
+		results.push_back(Run("get_height", size, iterations, none, [&]() {
+			float total = 0.0f;
+			for (const auto& position : positions) { total += TerrainBaker::GetHeight(geometry.heights, geometry.grid, position.x, position.y); }
+			sink = total;
+			return true;
+		}));
+		results.back().extra = ", \"queries\": " + std::to_string(queries);
+
+		fs::remove(png + ".png", error);
+		fs::remove(raw + ".r16", error);
+		fs::remove(baked, error);
+	}
+
+	FILE* file = output.empty() ? stdout : std::fopen(output.c_str(), "w");
+	if (!file) { std::fprintf(stderr, "[BENCHMARK] Could not open output file: %s\n", output.c_str()); return EXIT_FAILURE; }
+
+	WriteJSON(file, results, threads);
+
+	if (file != stdout) { std::fclose(file); }
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cmath>
+#include "Test.h"
+#include "utilities/DistanceField.h"
+
+/*******************************************************************************************************************
+	DistanceFieldTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for DistanceField - the 1D transform and the whole field checked against brute force, the values either
+	side of an edge, and the same field whether or not the job system splits up the work.
+
+*******************************************************************************************************************/
+
+/*******************************************************************************************************************
+	Returns a coverage image with a disc and a rectangle in it, in pixels fully inside (255) or outside (0)
+*******************************************************************************************************************/
+static std::vector<unsigned char> GetShapes(int width, int height)
+{
+	std::vector<unsigned char> coverage((size_t)width * height, 0);
+
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+
+			float dx = x - width * 0.3f, dy = y - height * 0.5f;
+			bool isDisc			= dx * dx + dy * dy <= (height * 0.25f) * (height * 0.25f);
+			bool isRectangle	= x >= width * 0.6f && x < width * 0.85f && y >= height * 0.2f && y < height * 0.7f;
+
+			if (isDisc || isRectangle) { coverage[(size_t)y * width + x] = 255; }
+		}
+	}
+
+	return coverage;
+}
+
+
+/*******************************************************************************************************************
+	Returns the field of a coverage image the slow way - every pixel looks at every other pixel
+*******************************************************************************************************************/
+static std::vector<unsigned char> GetBruteForceField(const std::vector<unsigned char>& coverage, int width, int height, int spread)
+{
+	std::vector<unsigned char> field(coverage.size(), 0);
+	float scale = 1.0f / (2.0f * (float)spread);
+
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+
+			bool isInside = coverage[(size_t)y * width + x] >= 128;
+			float nearest = 1e20f;
+
+			//--- The nearest pixel on the other side of the edge
+			for (int v = 0; v < height; v++) {
+				for (int u = 0; u < width; u++) {
+					if ((coverage[(size_t)v * width + u] >= 128) != isInside) { nearest = std::min(nearest, (float)((u - x) * (u - x) + (v - y) * (v - y))); }
+				}
+			}
+
+			float distance	= isInside ? std::sqrt(nearest) - 0.5f : 0.5f - std::sqrt(nearest);
+			float value		= std::min(std::max(0.5f + distance * scale, 0.0f), 1.0f);
+
+			field[(size_t)y * width + x] = (unsigned char)(value * 255.0f + 0.5f);
+		}
+	}
+
+	return field;
+}
+
+
+/*******************************************************************************************************************
+	The 1D transform gives each sample the lowest (q - p)^2 + input[p] of every sample p
+*******************************************************************************************************************/
+COG_TEST(DistanceFieldTransformMatchesBruteForce)
+{
+	const int count = 23;
+
+	float input[count], output[count], boundaries[count + 1];
+	int parabolas[count];
+
+	//--- A mix of seeds (0), raised samples and empty samples ('infinity')
+	for (int i = 0; i < count; i++) { input[i] = (i % 7 == 3) ? 0.0f : (i % 5 == 0) ? (float)i : 1e20f; }
+
+	DistanceField::Transform(input, output, count, parabolas, boundaries);
+
+	for (int q = 0; q < count; q++) {
+
+		float expected = 1e20f;
+		for (int p = 0; p < count; p++) { expected = std::min(expected, (float)((q - p) * (q - p)) + input[p]); }
+
+		COG_CHECK_NEAR(output[q], expected, 1e-3);
+	}
+}
+
+
+/*******************************************************************************************************************
+	The whole field matches brute force, to within a step of rounding
+*******************************************************************************************************************/
+COG_TEST(DistanceFieldMatchesBruteForce)
+{
+	const int width = 40, height = 28, spread = 4;
+
+	std::vector<unsigned char> coverage = GetShapes(width, height);
+	std::vector<unsigned char> expected = GetBruteForceField(coverage, width, height, spread);
+	std::vector<unsigned char> field;
+
+	DistanceField().Generate(coverage, width, height, spread, field);
+
+	COG_CHECK(field.size() == expected.size());
+
+	int worst = 0;
+	for (size_t i = 0; i < field.size() && i < expected.size(); i++) { worst = std::max(worst, std::abs((int)field[i] - (int)expected[i])); }
+
+	COG_CHECK(worst <= 1);
+}
+
+
+/*******************************************************************************************************************
+	The edge sits at 128 - half a pixel either side of it is just above or below, and the field is clamped at the
+	spread
+*******************************************************************************************************************/
+COG_TEST(DistanceFieldEdgeValues)
+{
+	const int width = 16, height = 4, spread = 4;
+
+	//--- The left half is inside, the right half outside
+	std::vector<unsigned char> coverage((size_t)width * height, 0);
+	for (int y = 0; y < height; y++) { std::fill_n(coverage.begin() + (size_t)y * width, width / 2, (unsigned char)255); }
+
+	std::vector<unsigned char> field;
+	DistanceField().Generate(coverage, width, height, spread, field);
+
+	for (int y = 0; y < height; y++) {
+
+		const unsigned char* row = &field[(size_t)y * width];
+
+		//--- 0.5 +/- half a pixel over twice the spread
+		COG_CHECK(row[width / 2 - 1] == 143);
+		COG_CHECK(row[width / 2] == 112);
+
+		//--- Further than the spread from the edge is clamped
+		COG_CHECK(row[0] == 255);
+		COG_CHECK(row[width - 1] == 0);
+
+		//--- Brighter the further inside, darker the further outside
+		for (int x = 1; x < width; x++) { COG_CHECK(row[x] <= row[x - 1]); }
+	}
+
+	//--- An image with no edge at all is clamped everywhere
+	std::vector<unsigned char> empty((size_t)width * height, 0), full((size_t)width * height, 255);
+
+	DistanceField().Generate(empty, width, height, spread, field);
+	COG_CHECK(std::all_of(field.begin(), field.end(), [](unsigned char value) { return value == 0; }));
+
+	DistanceField().Generate(full, width, height, spread, field);
+	COG_CHECK(std::all_of(field.begin(), field.end(), [](unsigned char value) { return value == 255; }));
+
+	//--- Too little coverage for the size asked for gives a blank field, rather than reading past the end
+	DistanceField().Generate(std::vector<unsigned char>(4, 255), width, height, spread, field);
+	COG_CHECK(field.size() == (size_t)width * height);
+	COG_CHECK(std::all_of(field.begin(), field.end(), [](unsigned char value) { return value == 0; }));
+}
+
+
+/*******************************************************************************************************************
+	Splitting the columns and rows across the job system's workers gives exactly the same field
+*******************************************************************************************************************/
+COG_TEST(DistanceFieldIsTheSameOnTheJobSystem)
+{
+	const int width = 160, height = 96, spread = 6;
+
+	std::vector<unsigned char> coverage = GetShapes(width, height);
+	std::vector<unsigned char> single, parallel;
+
+	DistanceField().Generate(coverage, width, height, spread, single);
+
+	JobSystem jobSystem;
+	jobSystem.Start(4);
+
+	DistanceField(&jobSystem).Generate(coverage, width, height, spread, parallel);
+
+	jobSystem.Stop();
+
+	COG_CHECK(single == parallel);
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <random>
+#include <thread>
+#include <vector>
+#include <pretty_glm/gtc/matrix_transform.hpp>
+#include "Test.h"
+#include "graphics/Frustum.h"
+
+/*******************************************************************************************************************
+	FrustumTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for Frustum - the batched box culling (with and without last sides) agreeing with the one box at a time
+	tests, last sides that aren't a side being treated as the first, and the counters adding up exactly when several
+	threads cull at once.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	const unsigned int s_boxCount		= 1003;
+	const unsigned int s_threadCount	= 4;
+	const unsigned int s_passes			= 50;
+}
+
+
+/*******************************************************************************************************************
+	Returns the projection the frustums are made from
+*******************************************************************************************************************/
+static glm::mat4 GetProjection()
+{
+	return glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+}
+
+
+/*******************************************************************************************************************
+	Returns a view looking out across the boxes scattered around it, so some are inside, some cross and some are outside
+*******************************************************************************************************************/
+static glm::mat4 GetView()
+{
+	return glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(50.0f, 5.0f, 30.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+
+/*******************************************************************************************************************
+	Returns a list of random boxes around the frustum's camera
+*******************************************************************************************************************/
+static Frustum::BoxList GetBoxes(unsigned int seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> position(-250.0f, 250.0f), size(0.1f, 20.0f);
+
+	Frustum::BoxList boxes;
+	for (unsigned int i = 0; i < s_boxCount; i++) {
+		boxes.Add(glm::vec3(position(random), position(random) * 0.1f, position(random)), glm::vec3(size(random), size(random), size(random)));
+	}
+
+	return boxes;
+}
+
+
+/*******************************************************************************************************************
+	Returns true if the visibility mask has the same bits as testing every box one at a time
+*******************************************************************************************************************/
+static bool IsSameAsOneByOne(const Frustum& frustum, const Frustum::BoxList& boxes, const std::vector<unsigned int>& visibility)
+{
+	for (size_t i = 0; i < boxes.GetSize(); i++) {
+
+		bool isInside = frustum.IsRectangleInside(glm::vec3(boxes.x[i], boxes.y[i], boxes.z[i]), glm::vec3(boxes.halfX[i], boxes.halfY[i], boxes.halfZ[i]));
+
+		if (Frustum::IsVisible(visibility, i) != isInside) { return false; }
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Both batched box culls give the same boxes as testing one box at a time - including the odd boxes at the end
+*******************************************************************************************************************/
+COG_TEST(FrustumCullBoxesMatchesOneByOne)
+{
+	Frustum frustum(GetProjection(), GetView());
+	Frustum::BoxList boxes = GetBoxes(7);
+
+	std::vector<unsigned int> visibility, lastSides;
+
+	frustum.CullBoxes(boxes, visibility);
+	COG_CHECK(IsSameAsOneByOne(frustum, boxes, visibility));
+
+	//--- Twice with last sides, so the second time tests the sides remembered the first time first
+	frustum.CullBoxes(boxes, visibility, lastSides);
+	COG_CHECK(IsSameAsOneByOne(frustum, boxes, visibility));
+
+	frustum.CullBoxes(boxes, visibility, lastSides);
+	COG_CHECK(IsSameAsOneByOne(frustum, boxes, visibility));
+	COG_CHECK(frustum.GetCounters().cacheHits > 0);
+}
+
+
+/*******************************************************************************************************************
+	Last sides that aren't a side (uninitialized, or from something else) are tested from the first side - giving the
+	right answer, and only ever being replaced by a real side
+*******************************************************************************************************************/
+COG_TEST(FrustumBadLastSides)
+{
+	Frustum frustum(GetProjection(), GetView());
+	Frustum::BoxList boxes = GetBoxes(8);
+
+	std::vector<unsigned int> visibility;
+	std::vector<unsigned int> lastSides(s_boxCount);
+
+	for (unsigned int i = 0; i < s_boxCount; i++) { lastSides[i] = (i % 3 == 0) ? 0xFFFFFFFFu : 6 + i; }
+
+	frustum.CullBoxes(boxes, visibility, lastSides);
+	COG_CHECK(IsSameAsOneByOne(frustum, boxes, visibility));
+
+	//--- And one box at a time, every test function
+	bool isSame = true;
+
+	for (unsigned int i = 0; i < s_boxCount; i++) {
+
+		glm::vec3 center(boxes.x[i], boxes.y[i], boxes.z[i]), half(boxes.halfX[i], boxes.halfY[i], boxes.halfZ[i]);
+		unsigned int boxSide = 1000 + i, sphereSide = 0xFFFFFFFFu;
+
+		isSame = isSame && frustum.TestRectangle(center, half, boxSide) == frustum.TestRectangle(center, half);
+		isSame = isSame && frustum.IsSphereInside(center, half.x, sphereSide) == frustum.IsSphereInside(center, half.x);
+		isSame = isSame && (boxSide == 1000 + i || boxSide < 6) && (sphereSide == 0xFFFFFFFFu || sphereSide < 6);
+	}
+
+	COG_CHECK(isSame);
+}
+
+
+/*******************************************************************************************************************
+	Culling the same boxes from several threads at once adds up to exactly the work of each thread on its own
+*******************************************************************************************************************/
+COG_TEST(FrustumCountersFromSeveralThreads)
+{
+	Frustum frustum(GetProjection(), GetView());
+	Frustum::BoxList boxes = GetBoxes(9);
+
+	//--- First, what one pass costs on its own
+	std::vector<unsigned int> visibility;
+	frustum.CullBoxes(boxes, visibility);
+	for (unsigned int i = 0; i < s_boxCount; i++) { frustum.IsRectangleInside(glm::vec3(boxes.x[i], boxes.y[i], boxes.z[i]), glm::vec3(1.0f)); }
+
+	Frustum::Counters single = frustum.GetCounters();
+
+	//--- The same view again, so the planes are kept and only the counters start again
+	frustum.Update(GetProjection(), GetView());
+
+	COG_CHECK(frustum.GetCounters().objectTests == 0);
+
+	//--- Then the same pass, many times over on 4 threads at once
+	std::vector<std::thread> threads;
+
+	for (unsigned int t = 0; t < s_threadCount; t++) {
+		threads.emplace_back([&frustum, &boxes]() {
+			std::vector<unsigned int> visibility;
+			for (unsigned int pass = 0; pass < s_passes; pass++) {
+				frustum.CullBoxes(boxes, visibility);
+				for (unsigned int i = 0; i < s_boxCount; i++) { frustum.IsRectangleInside(glm::vec3(boxes.x[i], boxes.y[i], boxes.z[i]), glm::vec3(1.0f)); }
+			}
+		});
+	}
+
+	for (auto& thread : threads) { thread.join(); }
+
+	Frustum::Counters total = frustum.GetCounters();
+
+	COG_CHECK(total.objectTests == single.objectTests * s_threadCount * s_passes);
+	COG_CHECK(total.planeTests == single.planeTests * s_threadCount * s_passes);
+	COG_CHECK(total.isReused);
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <pretty_glm/gtc/matrix_transform.hpp>
+#include "Test.h"
+#include "graphics/InstanceBatcher.h"
+
+/*******************************************************************************************************************
+	InstanceBatcherTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for InstanceBatcher - grouping by shader, material and model, the split at the instance cap and the order
+	of the batches and instances.
+
+	[Side Notes]
+	Each mesh's shininess is set to its draw index, so every instance can be traced back to the mesh it came from.
+
+*******************************************************************************************************************/
+
+/*******************************************************************************************************************
+	Adds a mesh to the list and its command to the queue, the same way FramePacket::AddMesh() does (but with the
+	material and model IDs passed in, rather than read from a material and model)
+*******************************************************************************************************************/
+static void AddMesh(std::vector<FramePacket::MeshDraw>& meshes, RenderQueue& queue, unsigned int material, unsigned int model,
+					float distance)
+{
+	glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -distance));
+
+	queue.Push(RenderQueue::MakeKey(RenderQueue::PASS_OPAQUE, FramePacket::SHADER_ENTITY, material, model, distance),
+			   (unsigned int)meshes.size());
+
+	meshes.push_back({ nullptr, nullptr, world, (float)meshes.size() });
+}
+
+
+/*******************************************************************************************************************
+	Returns which mesh an instance came from
+*******************************************************************************************************************/
+static unsigned int GetDraw(const PackedInstance& instance)
+{
+	return (unsigned int)instance.shininess;
+}
+
+
+/*******************************************************************************************************************
+	Meshes sharing a material and model end up in the same batch, however they were added
+*******************************************************************************************************************/
+COG_TEST(InstanceBatcherGroupsByMaterialAndModel)
+{
+	std::vector<FramePacket::MeshDraw> meshes;
+	RenderQueue queue;
+
+	//--- Material/model pairs, added mixed up: (1, 1) three times, (2, 1) twice and (1, 2) twice
+	unsigned int pairs[][2] = { { 1, 1 }, { 2, 1 }, { 1, 2 }, { 1, 1 }, { 2, 1 }, { 1, 2 }, { 1, 1 } };
+	for (auto& pair : pairs) { AddMesh(meshes, queue, pair[0], pair[1], 10.0f); }
+
+	queue.Sort();
+
+	InstanceBatcher batcher;
+	batcher.Build(queue, meshes);
+
+	const auto& batches		= batcher.GetBatches();
+	const auto& instances	= batcher.GetInstances();
+
+	COG_CHECK(batches.size() == 3);
+	COG_CHECK(instances.size() == meshes.size());
+
+	if (batches.size() != 3) { return; }
+
+	//--- The queue sorts on the material before the model
+	unsigned int expected[][3] = { { 1, 1, 3 }, { 1, 2, 2 }, { 2, 1, 2 } };
+
+	for (unsigned int i = 0; i < batches.size(); i++) {
+
+		COG_CHECK(batches[i].shader == FramePacket::SHADER_ENTITY);
+		COG_CHECK(batches[i].count == expected[i][2]);
+
+		//--- Every instance of a batch came from a mesh with the batch's material and model
+		for (unsigned int j = batches[i].first; j < batches[i].first + batches[i].count; j++) {
+			unsigned int draw = GetDraw(instances[j]);
+			COG_CHECK(pairs[draw][0] == expected[i][0] && pairs[draw][1] == expected[i][1]);
+		}
+
+		COG_CHECK(pairs[batches[i].draw][0] == expected[i][0] && pairs[batches[i].draw][1] == expected[i][1]);
+	}
+}
+
+
+/*******************************************************************************************************************
+	A run longer than the cap is split into full batches plus whatever is left over
+*******************************************************************************************************************/
+COG_TEST(InstanceBatcherSplitsAtTheCap)
+{
+	std::vector<FramePacket::MeshDraw> meshes;
+	RenderQueue queue;
+
+	for (unsigned int i = 0; i < 5; i++) { AddMesh(meshes, queue, 1, 1, 1.0f + i); }
+
+	queue.Sort();
+
+	InstanceBatcher batcher(2);
+	batcher.Build(queue, meshes);
+
+	const auto& batches = batcher.GetBatches();
+
+	COG_CHECK(batches.size() == 3);
+	COG_CHECK(batcher.GetInstances().size() == 5);
+
+	if (batches.size() != 3) { return; }
+
+	COG_CHECK(batches[0].first == 0 && batches[0].count == 2);
+	COG_CHECK(batches[1].first == 2 && batches[1].count == 2);
+	COG_CHECK(batches[2].first == 4 && batches[2].count == 1);
+
+	//--- A split batch starts at the mesh it was split on
+	for (const auto& batch : batches) { COG_CHECK(batch.draw == GetDraw(batcher.GetInstances()[batch.first])); }
+
+	//--- Exactly the cap is still one batch
+	InstanceBatcher exact(5);
+	exact.Build(queue, meshes);
+
+	COG_CHECK(exact.GetBatches().size() == 1);
+}
+
+
+/*******************************************************************************************************************
+	Instances are laid out batch after batch, and drawn front to back within a batch
+*******************************************************************************************************************/
+COG_TEST(InstanceBatcherKeepsTheQueueOrder)
+{
+	std::vector<FramePacket::MeshDraw> meshes;
+	RenderQueue queue;
+
+	AddMesh(meshes, queue, 2, 1, 30.0f);
+	AddMesh(meshes, queue, 1, 1, 20.0f);
+	AddMesh(meshes, queue, 2, 1, 10.0f);
+	AddMesh(meshes, queue, 1, 1, 40.0f);
+	AddMesh(meshes, queue, 1, 1, 5.0f);
+
+	queue.Sort();
+
+	InstanceBatcher batcher;
+	batcher.Build(queue, meshes);
+
+	const auto& batches		= batcher.GetBatches();
+	const auto& instances	= batcher.GetInstances();
+
+	COG_CHECK(batches.size() == 2);
+
+	//--- The instances follow the queue's commands one for one
+	const auto& commands = queue.GetCommands();
+
+	COG_CHECK(commands.size() == instances.size());
+
+	for (unsigned int i = 0; i < commands.size() && i < instances.size(); i++) { COG_CHECK(commands[i].draw == GetDraw(instances[i])); }
+
+	//--- Each batch starts where the one before it ended
+	unsigned int first = 0;
+
+	for (const auto& batch : batches) {
+
+		COG_CHECK(batch.first == first);
+
+		for (unsigned int i = batch.first + 1; i < batch.first + batch.count; i++) {
+			COG_CHECK(-instances[i - 1].world[3].z <= -instances[i].world[3].z);
+		}
+
+		first += batch.count;
+	}
+
+	//--- Re-building starts from scratch
+	RenderQueue empty;
+	batcher.Build(empty, meshes);
+
+	COG_CHECK(batcher.GetBatches().empty());
+	COG_CHECK(batcher.GetInstances().empty());
+}
+
+
+/*******************************************************************************************************************
+	The normal matrix is the inverse transpose of the world matrix's rotation and scale
+*******************************************************************************************************************/
+COG_TEST(InstanceBatcherBuildsNormalMatrices)
+{
+	std::vector<FramePacket::MeshDraw> meshes;
+	RenderQueue queue;
+
+	AddMesh(meshes, queue, 1, 1, 1.0f);
+	meshes[0].world = glm::scale(meshes[0].world, glm::vec3(2.0f, 4.0f, 1.0f));
+
+	queue.Sort();
+
+	InstanceBatcher batcher;
+	batcher.Build(queue, meshes);
+
+	COG_CHECK(batcher.GetInstances().size() == 1);
+
+	if (batcher.GetInstances().empty()) { return; }
+
+	const glm::mat3& normal = batcher.GetInstances()[0].normal;
+
+	COG_CHECK_NEAR(normal[0][0], 0.5f, 1e-5);
+	COG_CHECK_NEAR(normal[1][1], 0.25f, 1e-5);
+	COG_CHECK_NEAR(normal[2][2], 1.0f, 1e-5);
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Test.h"
+#include "utilities/JobSystem.h"
+
+/*******************************************************************************************************************
+	JobSystemTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for JobSystem - waiting on counters, jobs that only start once their dependency has finished, ParallelFor()
+	covering every index exactly once, threads that aren't workers queuing and waiting on jobs, and Stop() running
+	every job it was given, even ones queued while it was stopping.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	const unsigned int s_workerCount		= 4;
+	const unsigned int s_outsideThreads	= 3;
+}
+
+
+/*******************************************************************************************************************
+	Queues a job that queues more jobs of its own, depth levels deep, each one counting itself as queued and run
+*******************************************************************************************************************/
+static void RunTree(JobSystem& jobSystem, unsigned int depth, std::atomic<int>& queued, std::atomic<int>& run)
+{
+	queued++;
+
+	jobSystem.Run([&jobSystem, depth, &queued, &run]() {
+		run++;
+		for (unsigned int i = 0; depth > 0 && i < 2; i++) { RunTree(jobSystem, depth - 1, queued, run); }
+	});
+}
+
+
+/*******************************************************************************************************************
+	Wait() only returns once every job using the counter has finished, and a counter nothing has used is already done
+*******************************************************************************************************************/
+COG_TEST(JobSystemCounterWait)
+{
+	JobSystem jobSystem;
+	jobSystem.Start(s_workerCount);
+
+	JobSystem::Counter counter;
+	COG_CHECK(counter.IsDone());
+
+	std::atomic<int> sum(0);
+	for (int i = 1; i <= 1000; i++) { jobSystem.Run([&sum, i]() { sum += i; }, &counter); }
+
+	jobSystem.Wait(counter);
+
+	COG_CHECK(counter.IsDone());
+	COG_CHECK(sum.load() == 500500);
+
+	//--- The same counter can be used again once it's done
+	for (int i = 0; i < 100; i++) { jobSystem.Run([&sum]() { sum--; }, &counter); }
+	jobSystem.Wait(counter);
+
+	COG_CHECK(sum.load() == 500400);
+
+	jobSystem.Stop();
+}
+
+
+/*******************************************************************************************************************
+	RunAfter() jobs only start once every job of their dependency has finished, along a chain of stages, and start
+	straight away on a dependency that's already done
+*******************************************************************************************************************/
+COG_TEST(JobSystemRunAfter)
+{
+	JobSystem jobSystem;
+	jobSystem.Start(s_workerCount);
+
+	std::vector<std::atomic<int>> written(200), checked(10);
+	for (auto& value : written) { value = 0; }
+	for (auto& value : checked) { value = 0; }
+
+	std::atomic<bool> isFirstComplete(true), isSecondComplete(true);
+	JobSystem::Counter first, second, third;
+
+	for (unsigned int i = 0; i < written.size(); i++) {
+		jobSystem.Run([&written, i]() { std::this_thread::sleep_for(std::chrono::microseconds(i % 7)); written[i] = 1; }, &first);
+	}
+
+	//--- Every job of the second stage sees all of the first stage's writes
+	for (unsigned int i = 0; i < checked.size(); i++) {
+		jobSystem.RunAfter(first, [&written, &checked, &isFirstComplete, i]() {
+			for (const auto& value : written) { if (value.load() != 1) { isFirstComplete = false; } }
+			checked[i] = 1;
+		}, &second);
+	}
+
+	//--- And the third stage sees all of the second's
+	jobSystem.RunAfter(second, [&checked, &isSecondComplete]() {
+		for (const auto& value : checked) { if (value.load() != 1) { isSecondComplete = false; } }
+	}, &third);
+
+	jobSystem.Wait(third);
+
+	COG_CHECK(isFirstComplete.load());
+	COG_CHECK(isSecondComplete.load());
+	COG_CHECK(first.IsDone() && second.IsDone() && third.IsDone());
+
+	//--- A dependency that's already done doesn't hold the job back
+	JobSystem::Counter done, after;
+	std::atomic<bool> isRun(false);
+
+	jobSystem.RunAfter(done, [&isRun]() { isRun = true; }, &after);
+	jobSystem.Wait(after);
+
+	COG_CHECK(isRun.load());
+
+	jobSystem.Stop();
+}
+
+
+/*******************************************************************************************************************
+	ParallelFor() hands every index to exactly one batch, each batch inside the range and at least the minimum size
+	(but for the last one), for all sorts of counts and batch sizes
+*******************************************************************************************************************/
+COG_TEST(JobSystemParallelForCoverage)
+{
+	JobSystem jobSystem;
+	jobSystem.Start(s_workerCount);
+
+	bool isCovered		= true;
+	bool isInRange		= true;
+	bool isBigEnough	= true;
+
+	for (unsigned int count : { 1u, 2u, 7u, 16u, 100u, 1000u, 4097u, 100000u }) {
+		for (unsigned int minimumBatch : { 0u, 1u, 3u, 64u, 5000u }) {
+
+			std::vector<std::atomic<int>> visits(count);
+			for (auto& value : visits) { value = 0; }
+
+			std::atomic<bool> isOutOfRange(false), isTooSmall(false);
+
+			jobSystem.ParallelFor(count, minimumBatch, [&](unsigned int first, unsigned int last) {
+				if (first >= last || last > count)								{ isOutOfRange = true; return; }
+				if (last != count && last - first < std::min(minimumBatch, count))	{ isTooSmall = true; }
+				for (unsigned int i = first; i < last; i++) { visits[i]++; }
+			});
+
+			for (const auto& value : visits) { if (value.load() != 1) { isCovered = false; } }
+
+			isInRange	= isInRange && !isOutOfRange.load();
+			isBigEnough	= isBigEnough && !isTooSmall.load();
+		}
+	}
+
+	COG_CHECK(isCovered);
+	COG_CHECK(isInRange);
+	COG_CHECK(isBigEnough);
+
+	//--- Nothing to do means the function is never called
+	bool isCalled = false;
+	jobSystem.ParallelFor(0, 1, [&isCalled](unsigned int, unsigned int) { isCalled = true; });
+
+	COG_CHECK(!isCalled);
+
+	jobSystem.Stop();
+}
+
+
+/*******************************************************************************************************************
+	Threads that aren't workers (like the render thread) can queue jobs and wait on them - including ParallelFor() -
+	while the main thread is busy with its own
+*******************************************************************************************************************/
+COG_TEST(JobSystemOutsideThreads)
+{
+	JobSystem jobSystem;
+	jobSystem.Start(s_workerCount);
+
+	std::atomic<unsigned int> outsideSum(0), mainSum(0);
+
+	std::thread outside([&jobSystem, &outsideSum]() {
+		for (int i = 0; i < 20; i++) {
+			jobSystem.ParallelFor(1000, 10, [&outsideSum](unsigned int first, unsigned int last) { outsideSum += last - first; });
+		}
+
+		JobSystem::Counter counter;
+		for (int i = 0; i < 500; i++) { jobSystem.Run([&outsideSum]() { outsideSum++; }, &counter); }
+		jobSystem.Wait(counter);
+	});
+
+	for (int i = 0; i < 20; i++) {
+		jobSystem.ParallelFor(1000, 10, [&mainSum](unsigned int first, unsigned int last) { mainSum += last - first; });
+	}
+
+	outside.join();
+
+	COG_CHECK(outsideSum.load() == 20500);
+	COG_CHECK(mainSum.load() == 20000);
+
+	jobSystem.Stop();
+}
+
+
+/*******************************************************************************************************************
+	Stop() under load - with jobs queuing more jobs and another thread queuing jobs while it stops, every job queued
+	is run, and the job system still runs jobs (straight away) once it has stopped
+*******************************************************************************************************************/
+COG_TEST(JobSystemStopUnderLoad)
+{
+	for (int round = 0; round < 50; round++) {
+
+		JobSystem jobSystem;
+		jobSystem.Start(s_workerCount);
+
+		std::atomic<int> queued(0), run(0), started(0);
+		std::atomic<bool> isStopped(false);
+
+		for (int i = 0; i < 8; i++) { RunTree(jobSystem, 8, queued, run); }
+
+		std::vector<std::thread> outside;
+
+		for (unsigned int i = 0; i < s_outsideThreads; i++) {
+			outside.emplace_back([&]() {
+				started++;
+				while (!isStopped.load()) { RunTree(jobSystem, 2, queued, run); }
+			});
+		}
+
+		while (started.load() < (int)s_outsideThreads) { std::this_thread::yield(); }
+
+		jobSystem.Stop();
+		isStopped = true;
+
+		for (auto& thread : outside) { thread.join(); }
+
+		COG_CHECK(!jobSystem.IsRunning());
+		COG_CHECK(queued.load() == run.load());
+
+		//--- Once stopped, jobs are run as soon as they're queued
+		int before = run.load();
+		jobSystem.Run([&run]() { run++; });
+
+		COG_CHECK(run.load() == before + 1);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <pretty_glm/gtc/matrix_transform.hpp>
+#include "Test.h"
+#include "graphics/LightClusters.h"
+
+/*******************************************************************************************************************
+	LightClustersTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for LightClusters - 600 point and spot lights binned into clusters, checked against brute force (every
+	light against every cluster, and every light against points all over the view), along with the skipped,
+	directional and visible lights.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	const unsigned int	s_tilesX		= 16;
+	const unsigned int	s_tilesY		= 9;
+	const unsigned int	s_slices		= 24;
+	const unsigned int	s_lightCount	= 600;
+
+	const float s_fieldOfView	= glm::radians(60.0f);
+	const float s_aspectRatio	= 16.0f / 9.0f;
+	const float s_nearPlane		= 0.1f;
+	const float s_farPlane		= 200.0f;
+
+	//--- The view space bounds of a cluster, worked out from the corners of its piece of the frustum
+	struct ReferenceCluster {
+		glm::vec3 minimum, maximum;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns a camera standing at the edge of the lights, looking across them
+*******************************************************************************************************************/
+static glm::mat4 GetView()
+{
+	return glm::lookAt(glm::vec3(-20.0f, 8.0f, 30.0f), glm::vec3(10.0f, 0.0f, -40.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+
+/*******************************************************************************************************************
+	Returns 600 lights scattered around (and behind) the camera - mostly point lights, every fifth a spot light, a
+	few disabled or with no range, and a couple of directional lights
+*******************************************************************************************************************/
+static std::vector<Light> GetLights()
+{
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-120.0f, 120.0f), range(0.5f, 25.0f), unit(-1.0f, 1.0f), angle(5.0f, 60.0f);
+
+	std::vector<Light> lights;
+	lights.reserve(s_lightCount);
+
+	Ambient ambient(0.1f, 0.1f, 0.1f); Diffuse diffuse(1.0f, 1.0f, 1.0f); Specular specular(1.0f, 1.0f, 1.0f);
+	Attenuation attenuation(1.0f, 0.09f, 0.032f);
+
+	for (unsigned int i = 0; i < s_lightCount; i++) {
+
+		Position center(position(random), position(random) * 0.25f, position(random));
+		Direction direction(unit(random), unit(random), unit(random));
+		float outer = angle(random);
+
+		if (i % 97 == 0)		{ lights.push_back(Light(Direction(direction.x, -1.0f, direction.z), ambient, diffuse, specular)); }
+		else if (i % 5 == 0)	{ lights.push_back(Light(center, direction, ambient, diffuse, specular, attenuation, Angle(outer * 0.8f, outer), range(random))); }
+		else					{ lights.push_back(Light(center, ambient, diffuse, specular, attenuation, range(random))); }
+
+		if (i % 41 == 7)		{ lights.back().SetEnabled(false); }
+		if (i % 53 == 11)		{ lights.back().SetMargin(0.0f); }
+	}
+
+	return lights;
+}
+
+
+/*******************************************************************************************************************
+	Returns the depth where the clusters go from one slice to the next, found by bisecting GetSlice(), so the
+	reference doesn't need to know how the slices are spaced
+*******************************************************************************************************************/
+static std::vector<float> GetSliceDepths(const LightClusters& clusters)
+{
+	std::vector<float> depths(s_slices + 1);
+	depths[0]			= s_nearPlane;
+	depths[s_slices]	= s_farPlane;
+
+	for (unsigned int slice = 1; slice < s_slices; slice++) {
+
+		float nearDepth = s_nearPlane, farDepth = s_farPlane;
+
+		for (int i = 0; i < 64; i++) {
+			float depth = (nearDepth + farDepth) * 0.5f;
+			if (clusters.GetSlice(depth) < slice)	{ nearDepth = depth; }
+			else									{ farDepth = depth; }
+		}
+
+		depths[slice] = farDepth;
+	}
+
+	return depths;
+}
+
+
+/*******************************************************************************************************************
+	Returns the view space bounds of every cluster, from the 8 corners of its piece of the frustum
+*******************************************************************************************************************/
+static std::vector<ReferenceCluster> GetReferenceClusters(const LightClusters& clusters)
+{
+	std::vector<float> depths = GetSliceDepths(clusters);
+	std::vector<ReferenceCluster> references(s_tilesX * s_tilesY * s_slices);
+
+	float tanY = std::tan(s_fieldOfView * 0.5f), tanX = tanY * s_aspectRatio;
+
+	for (unsigned int slice = 0; slice < s_slices; slice++) {
+		for (unsigned int y = 0; y < s_tilesY; y++) {
+			for (unsigned int x = 0; x < s_tilesX; x++) {
+
+				ReferenceCluster& reference = references[clusters.GetClusterIndex(x, y, slice)];
+				reference.minimum = glm::vec3(1e30f);
+				reference.maximum = glm::vec3(-1e30f);
+
+				for (int corner = 0; corner < 8; corner++) {
+					float depth	= depths[slice + (corner & 1)];
+					float ndcX	= -1.0f + 2.0f * (x + ((corner >> 1) & 1)) / s_tilesX;
+					float ndcY	= -1.0f + 2.0f * (y + ((corner >> 2) & 1)) / s_tilesY;
+
+					glm::vec3 point(ndcX * tanX * depth, ndcY * tanY * depth, -depth);
+					reference.minimum = glm::min(reference.minimum, point);
+					reference.maximum = glm::max(reference.maximum, point);
+				}
+			}
+		}
+	}
+
+	return references;
+}
+
+
+/*******************************************************************************************************************
+	Returns how far a sphere's center is from a box, less the sphere's radius (so zero or less means they touch)
+*******************************************************************************************************************/
+static float GetGap(const glm::vec3& center, float radius, const ReferenceCluster& cluster)
+{
+	glm::vec3 closest = glm::clamp(center, cluster.minimum, cluster.maximum);
+	return glm::length(closest - center) - radius;
+}
+
+
+/*******************************************************************************************************************
+	Returns true if a light actually lights a view space point (within range, and inside the cone of a spot light)
+*******************************************************************************************************************/
+static bool IsLit(const Light& light, const glm::mat4& view, const glm::vec3& point)
+{
+	glm::vec3 center = glm::vec3(view * glm::vec4(glm::vec3(light.GetPosition()), 1.0f));
+	glm::vec3 offset = point - center;
+
+	if (glm::dot(offset, offset) > light.GetMargin() * light.GetMargin()) { return false; }
+	if (!light.IsOfType(Light::LIGHT_SPOT) || glm::dot(offset, offset) == 0.0f) { return true; }
+
+	glm::vec3 direction = glm::normalize(glm::vec3(view * glm::vec4(glm::vec3(light.GetDirection()), 0.0f)));
+	return glm::dot(glm::normalize(offset), direction) >= light.GetOuterCutOff();
+}
+
+
+/*******************************************************************************************************************
+	Sets up the clusters with the test's projection, and bins every light into them
+*******************************************************************************************************************/
+static void Build(LightClusters& clusters, std::vector<Light>& lights, std::vector<Light*>& pointers)
+{
+	pointers.clear();
+	for (auto& light : lights) { pointers.push_back(&light); }
+
+	clusters.SetProjection(s_fieldOfView, s_aspectRatio, s_nearPlane, s_farPlane);
+	clusters.Update(GetView(), pointers);
+}
+
+
+/*******************************************************************************************************************
+	Every point light is in exactly the clusters its sphere touches, and a spot light is in no cluster its sphere
+	doesn't touch (the cone only ever removes clusters) - allowing for rounding when a sphere only just touches
+*******************************************************************************************************************/
+COG_TEST(LightClustersMatchBruteForce)
+{
+	std::vector<Light> lights = GetLights();
+	std::vector<Light*> pointers;
+	LightClusters clusters(s_tilesX, s_tilesY, s_slices);
+	Build(clusters, lights, pointers);
+
+	std::vector<ReferenceCluster> references = GetReferenceClusters(clusters);
+	const auto& lists	= clusters.GetClusters();
+	const auto& indices	= clusters.GetLightIndices();
+
+	COG_CHECK(lists.size() == references.size());
+
+	unsigned int mismatches = 0, touching = 0;
+
+	for (unsigned int cluster = 0; cluster < lists.size(); cluster++) {
+
+		std::set<unsigned int> listed(indices.begin() + lists[cluster].offset, indices.begin() + lists[cluster].offset + lists[cluster].count);
+		COG_CHECK(listed.size() == lists[cluster].count);
+
+		for (unsigned int i = 0; i < lights.size(); i++) {
+
+			const Light& light	= lights[i];
+			bool isListed		= listed.count(i) > 0;
+
+			if (light.IsOfType(Light::LIGHT_DIRECTION) || !light.IsEnabled() || light.GetMargin() <= 0.0f) {
+				COG_CHECK(!isListed);
+				continue;
+			}
+
+			glm::vec3 center	= glm::vec3(GetView() * glm::vec4(glm::vec3(light.GetPosition()), 1.0f));
+			float gap			= GetGap(center, light.GetMargin(), references[cluster]);
+			bool isTouching		= gap <= 0.0f;
+
+			//--- Only count it as wrong if the sphere is clearly in (or clearly out of) the cluster
+			if (std::fabs(gap) < 1e-3f * (1.0f + light.GetMargin()))	{ continue; }
+			if (isTouching) { touching++; }
+
+			if (light.IsOfType(Light::LIGHT_POINT) && isListed != isTouching)	{ mismatches++; }
+			if (light.IsOfType(Light::LIGHT_SPOT) && isListed && !isTouching)	{ mismatches++; }
+		}
+	}
+
+	COG_CHECK(mismatches == 0);
+	COG_CHECK(touching > 1000);
+}
+
+
+/*******************************************************************************************************************
+	Any point in view that a light actually lights has that light in its cluster's list - the check that matters for
+	shading, as it's what the fragment shader will rely on
+*******************************************************************************************************************/
+COG_TEST(LightClustersNeverMissALitPoint)
+{
+	std::vector<Light> lights = GetLights();
+	std::vector<Light*> pointers;
+	LightClusters clusters(s_tilesX, s_tilesY, s_slices);
+	Build(clusters, lights, pointers);
+
+	const auto& lists	= clusters.GetClusters();
+	const auto& indices	= clusters.GetLightIndices();
+
+	std::mt19937 random(99);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f), depth(std::log(s_nearPlane), std::log(s_farPlane));
+
+	float tanY = std::tan(s_fieldOfView * 0.5f), tanX = tanY * s_aspectRatio;
+	unsigned int misses = 0, lit = 0;
+
+	for (int sample = 0; sample < 5000; sample++) {
+
+		float z = std::exp(depth(random));
+		glm::vec3 point(unit(random) * tanX * z, unit(random) * tanY * z, -z);
+
+		const LightClusters::Cluster& cluster = lists[clusters.GetClusterIndex(point)];
+		auto first = indices.begin() + cluster.offset, last = first + cluster.count;
+
+		for (unsigned int i = 0; i < lights.size(); i++) {
+
+			if (!lights[i].IsEnabled() || lights[i].IsOfType(Light::LIGHT_DIRECTION) || !IsLit(lights[i], GetView(), point)) { continue; }
+
+			lit++;
+			if (!std::binary_search(first, last, i)) { misses++; }
+		}
+	}
+
+	COG_CHECK(misses == 0);
+	COG_CHECK(lit > 500);
+}
+
+
+/*******************************************************************************************************************
+	The per-cluster lists are packed back to back, sorted by light index, and the largest is reported correctly
+*******************************************************************************************************************/
+COG_TEST(LightClustersListsArePacked)
+{
+	std::vector<Light> lights = GetLights();
+	std::vector<Light*> pointers;
+	LightClusters clusters(s_tilesX, s_tilesY, s_slices);
+	Build(clusters, lights, pointers);
+
+	const auto& lists	= clusters.GetClusters();
+	const auto& indices	= clusters.GetLightIndices();
+
+	unsigned int offset = 0, largest = 0;
+	bool isSorted = true;
+
+	for (const auto& cluster : lists) {
+		COG_CHECK(cluster.offset == offset);
+		isSorted	= isSorted && std::is_sorted(indices.begin() + cluster.offset, indices.begin() + cluster.offset + cluster.count);
+		offset		+= cluster.count;
+		largest		= std::max(largest, cluster.count);
+	}
+
+	COG_CHECK(isSorted);
+	COG_CHECK(offset == indices.size());
+	COG_CHECK(largest == clusters.GetMaxLightsPerCluster());
+	COG_CHECK(largest > 0);
+}
+
+
+/*******************************************************************************************************************
+	Directional lights go in their own list, and the visible lights are exactly the lights in at least one cluster
+*******************************************************************************************************************/
+COG_TEST(LightClustersVisibleAndDirectionalLights)
+{
+	std::vector<Light> lights = GetLights();
+	std::vector<Light*> pointers;
+	LightClusters clusters(s_tilesX, s_tilesY, s_slices);
+	Build(clusters, lights, pointers);
+
+	std::vector<unsigned int> directional;
+	for (unsigned int i = 0; i < lights.size(); i++) {
+		if (lights[i].IsEnabled() && lights[i].IsOfType(Light::LIGHT_DIRECTION)) { directional.push_back(i); }
+	}
+
+	COG_CHECK(!directional.empty());
+	COG_CHECK(clusters.GetDirectionalLights() == directional);
+
+	std::set<unsigned int> inClusters(clusters.GetLightIndices().begin(), clusters.GetLightIndices().end());
+	std::vector<unsigned int> visible(inClusters.begin(), inClusters.end());
+
+	COG_CHECK(clusters.GetVisibleLights() == visible);
+	COG_CHECK(visible.size() > 10 && visible.size() < lights.size() / 2);
+
+	//--- Disabling a light takes it out of everything on the next update, and a null light is skipped
+	lights[visible.front()].SetEnabled(false);
+	pointers.push_back(nullptr);
+	clusters.Update(GetView(), pointers);
+
+	COG_CHECK(clusters.GetVisibleLights().size() == visible.size() - 1);
+	COG_CHECK(std::find(clusters.GetLightIndices().begin(), clusters.GetLightIndices().end(), visible.front()) == clusters.GetLightIndices().end());
+}
\ No newline at end of file
@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <pretty_glm/gtc/matrix_transform.hpp>
+#include "Test.h"
+#include "graphics/OcclusionBuffer.h"
+
+/*******************************************************************************************************************
+	OcclusionBufferTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for OcclusionBuffer - the (SSE) depth buffer checked against a plain scalar reference, the hierarchy
+	holding the furthest depth of the texels below it, boxes crossing the near plane, and pixels an occluder only
+	partly covers at its silhouette never hiding anything.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	const int s_width	= 64;
+	const int s_height	= 32;
+
+	//--- A screen space triangle, wound anti-clockwise
+	struct ReferenceTriangle {
+		glm::vec3 a, b, c;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns a camera looking down on the origin from above and behind, with a near plane of 1 and far of 100
+*******************************************************************************************************************/
+static glm::mat4 GetViewProjection(const glm::vec3& eye = glm::vec3(0.3f, 7.0f, 5.0f), const glm::vec3& target = glm::vec3(0.1f, -1.0f, -5.0f))
+{
+	return glm::perspective(glm::radians(60.0f), 2.0f, 1.0f, 100.0f) * glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+
+/*******************************************************************************************************************
+	Returns a bumpy grid mesh (sharing its vertices), like the terrain's occluder mesh
+*******************************************************************************************************************/
+static void GetHills(std::vector<glm::vec3>& vertices, std::vector<unsigned int>& indices)
+{
+	const int squares = 6;
+
+	for (int row = 0; row <= squares; row++) {
+		for (int column = 0; column <= squares; column++) {
+			float height = 1.5f * std::sin(column * 1.3f) * std::cos(row * 0.7f) - 1.0f;
+			vertices.push_back(glm::vec3(-7.0f + column * 2.3f, height, -4.0f - row * 2.1f));
+		}
+	}
+
+	for (int row = 0; row < squares; row++) {
+		for (int column = 0; column < squares; column++) {
+			unsigned int bottomLeft = row * (squares + 1) + column, topLeft = bottomLeft + squares + 1;
+			indices.insert(indices.end(), { bottomLeft, bottomLeft + 1, topLeft, bottomLeft + 1, topLeft + 1, topLeft });
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	Returns the depth buffer the slow way - every pixel looks at every triangle (and silhouette edge) of every
+	occluder, testing the corners of the pixel rather than its center
+*******************************************************************************************************************/
+static std::vector<float> GetReferenceDepths(const glm::mat4& viewProjection, const std::vector<std::vector<glm::vec3>>& meshes,
+											 const std::vector<std::vector<unsigned int>>& meshIndices)
+{
+	const float margin = 1.0f / 1024.0f;
+
+	std::vector<float> depths((size_t)s_width * s_height, 1.0f);
+
+	for (size_t mesh = 0; mesh < meshes.size(); mesh++) {
+
+		//--- Project, keeping triangles wholly in front of the near plane with some area
+		std::vector<glm::vec3> screen(meshes[mesh].size());
+		std::vector<bool> isInFront(meshes[mesh].size());
+
+		for (size_t i = 0; i < screen.size(); i++) {
+			glm::vec4 clip = viewProjection * glm::vec4(meshes[mesh][i], 1.0f);
+			isInFront[i] = clip.w > 0.0f && clip.z >= -clip.w;
+			screen[i] = glm::vec3((clip.x / clip.w * 0.5f + 0.5f) * s_width, (clip.y / clip.w * 0.5f + 0.5f) * s_height, clip.z / clip.w);
+		}
+
+		std::vector<ReferenceTriangle> triangles;
+		std::map<std::pair<unsigned int, unsigned int>, std::vector<float>> sides;
+
+		const std::vector<unsigned int>& indices = meshIndices[mesh];
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+
+			unsigned int t[3] = { indices[i], indices[i + 1], indices[i + 2] };
+
+			if (!isInFront[t[0]] || !isInFront[t[1]] || !isInFront[t[2]]) { continue; }
+
+			glm::vec3 a = screen[t[0]], b = screen[t[1]], c = screen[t[2]];
+			float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+			if (area == 0.0f) { continue; }
+			if (std::max(std::max(a.x, b.x), c.x) < 0.0f || std::max(std::max(a.y, b.y), c.y) < 0.0f ||
+				std::min(std::min(a.x, b.x), c.x) > s_width || std::min(std::min(a.y, b.y), c.y) > s_height) { continue; }
+
+			triangles.push_back(area > 0.0f ? ReferenceTriangle{ a, b, c } : ReferenceTriangle{ a, c, b });
+
+			for (int e = 0; e < 3; e++) {
+				unsigned int first = std::min(t[e], t[(e + 1) % 3]), second = std::max(t[e], t[(e + 1) % 3]);
+				glm::vec3 start = screen[first], end = screen[second], other = screen[t[(e + 2) % 3]];
+				sides[{ first, second }].push_back((end.x - start.x) * (other.y - start.y) - (end.y - start.y) * (other.x - start.x));
+			}
+		}
+
+		std::vector<std::pair<glm::vec2, glm::vec2>> silhouette;
+
+		for (const auto& edge : sides) {
+			const std::vector<float>& side = edge.second;
+			if (side.size() == 2 && ((side[0] > 0.0f && side[1] < 0.0f) || (side[0] < 0.0f && side[1] > 0.0f))) { continue; }
+			silhouette.push_back({ glm::vec2(screen[edge.first.first].x, screen[edge.first.first].y),
+								   glm::vec2(screen[edge.first.second].x, screen[edge.first.second].y) });
+		}
+
+		for (int y = 0; y < s_height; y++) {
+			for (int x = 0; x < s_width; x++) {
+
+				const glm::vec2 corners[4] = { glm::vec2((float)x, (float)y), glm::vec2(x + 1.0f, (float)y),
+											   glm::vec2((float)x, y + 1.0f), glm::vec2(x + 1.0f, y + 1.0f) };
+
+				//--- Any silhouette edge touching the pixel (with the same margin) means the occluder can't cover it
+				bool isSilhouette = false;
+
+				for (const auto& edge : silhouette) {
+
+					glm::vec2 a = edge.first, b = edge.second;
+
+					if (std::max(a.x, b.x) + margin < x || std::min(a.x, b.x) - margin > x + 1.0f ||
+						std::max(a.y, b.y) + margin < y || std::min(a.y, b.y) - margin > y + 1.0f) { continue; }
+
+					float lowest = FLT_MAX, highest = -FLT_MAX;
+					for (const auto& corner : corners) {
+						float side = (b.x - a.x) * (corner.y - a.y) - (b.y - a.y) * (corner.x - a.x);
+						lowest = std::min(lowest, side); highest = std::max(highest, side);
+					}
+
+					if (lowest <= 0.0f && highest >= 0.0f) { isSilhouette = true; break; }
+				}
+
+				if (isSilhouette) { continue; }
+
+				//--- The furthest depth of every triangle touching the pixel
+				float layer = -FLT_MAX;
+
+				for (const auto& triangle : triangles) {
+
+					glm::vec3 a = triangle.a, b = triangle.b, c = triangle.c;
+
+					if (std::max(std::max(a.x, b.x), c.x) < x || std::min(std::min(a.x, b.x), c.x) > x + 1.0f ||
+						std::max(std::max(a.y, b.y), c.y) < y || std::min(std::min(a.y, b.y), c.y) > y + 1.0f) { continue; }
+
+					const glm::vec3 points[3] = { a, b, c };
+					bool isTouching = true;
+
+					for (int e = 0; e < 3 && isTouching; e++) {
+						glm::vec3 start = points[e], end = points[(e + 1) % 3];
+						float highest = -FLT_MAX;
+						for (const auto& corner : corners) {
+							highest = std::max(highest, (end.x - start.x) * (corner.y - start.y) - (end.y - start.y) * (corner.x - start.x));
+						}
+						isTouching = highest >= 0.0f;
+					}
+
+					if (!isTouching) { continue; }
+
+					float area		= (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+					float depthX	= ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+					float depthY	= ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+					float furthest	= -FLT_MAX;
+
+					for (const auto& corner : corners) { furthest = std::max(furthest, a.z + depthX * (corner.x - a.x) + depthY * (corner.y - a.y)); }
+
+					layer = std::max(layer, std::min(furthest, std::max(std::max(a.z, b.z), c.z)));
+				}
+
+				if (layer != -FLT_MAX) { depths[(size_t)y * s_width + x] = std::min(depths[(size_t)y * s_width + x], layer); }
+			}
+		}
+	}
+
+	return depths;
+}
+
+
+/*******************************************************************************************************************
+	The buffer matches the scalar reference - the same pixels are covered, at the same depths (to rounding)
+*******************************************************************************************************************/
+COG_TEST(OcclusionBufferMatchesScalarReference)
+{
+	std::vector<std::vector<glm::vec3>> meshes(3);
+	std::vector<std::vector<unsigned int>> indices(3);
+
+	GetHills(meshes[0], indices[0]);
+
+	//--- Two boxes, built the same way AddOccluder() builds them
+	const glm::vec3 boxes[2][2] = { { glm::vec3(-2.0f, -1.0f, -1.0f), glm::vec3(0.5f, 1.5f, 0.7f) },
+									{ glm::vec3(1.2f, -0.5f, 2.0f), glm::vec3(2.9f, 2.5f, 3.1f) } };
+
+	for (int box = 0; box < 2; box++) {
+		for (unsigned int i = 0; i < 8; i++) {
+			meshes[box + 1].push_back(glm::vec3((i & 1) ? boxes[box][1].x : boxes[box][0].x, (i & 2) ? boxes[box][1].y : boxes[box][0].y,
+												(i & 4) ? boxes[box][1].z : boxes[box][0].z));
+		}
+		indices[box + 1] = { 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3, 0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6, 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5 };
+	}
+
+	OcclusionBuffer buffer(s_width, s_height);
+
+	buffer.Begin(GetViewProjection());
+	buffer.AddOccluder(meshes[0], indices[0]);
+	buffer.AddOccluder(boxes[0][0], boxes[0][1]);
+	buffer.AddOccluder(boxes[1][0], boxes[1][1]);
+	buffer.Render();
+
+	std::vector<float> expected = GetReferenceDepths(GetViewProjection(), meshes, indices);
+
+	int covered = 0, mismatched = 0;
+
+	for (int y = 0; y < s_height; y++) {
+		for (int x = 0; x < s_width; x++) {
+
+			float depth = buffer.GetDepth(x, y), reference = expected[(size_t)y * s_width + x];
+
+			if (reference < 1.0f) { covered++; }
+			if (std::fabs(depth - reference) > 1e-4f) { mismatched++; }
+		}
+	}
+
+	//--- Something was drawn, and the two only ever disagree on a pixel an edge passes exactly by
+	COG_CHECK(covered > s_width * s_height / 8);
+	COG_CHECK(mismatched <= 2);
+}
+
+
+/*******************************************************************************************************************
+	Each level of the hierarchy holds the furthest depth of the 2 x 2 texels below it
+*******************************************************************************************************************/
+COG_TEST(OcclusionBufferHierarchyHoldsFurthestDepth)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<unsigned int> indices;
+	GetHills(vertices, indices);
+
+	OcclusionBuffer buffer(s_width, s_height);
+
+	buffer.Begin(GetViewProjection());
+	buffer.AddOccluder(vertices, indices);
+	buffer.AddOccluder(glm::vec3(-2.0f, -1.0f, -1.0f), glm::vec3(0.5f, 1.5f, 0.7f));
+	buffer.Render();
+
+	COG_CHECK(buffer.GetLevelCount() > 3);
+
+	for (unsigned int level = 1; level < buffer.GetLevelCount(); level++) {
+
+		unsigned int width = s_width >> level, height = s_height >> level;
+
+		for (unsigned int y = 0; y < height; y++) {
+			for (unsigned int x = 0; x < width; x++) {
+
+				float furthest = -FLT_MAX;
+
+				for (unsigned int i = 0; i < 4; i++) {
+					float below = buffer.GetDepth(x * 2 + (i & 1), y * 2 + (i >> 1), level - 1);
+					COG_CHECK(buffer.GetDepth(x, y, level) >= below);
+					furthest = std::max(furthest, below);
+				}
+
+				COG_CHECK(buffer.GetDepth(x, y, level) == furthest);
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************************************************
+	A box crossing the near plane is always visible, and an occluder crossing it only draws the part in front
+*******************************************************************************************************************/
+COG_TEST(OcclusionBufferNearPlane)
+{
+	OcclusionBuffer buffer(s_width, s_height);
+
+	const glm::mat4 viewProjection = GetViewProjection(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f));
+
+	//--- A wall filling the screen just in front of the camera hides a box well behind it...
+	buffer.Begin(viewProjection);
+	buffer.AddOccluder(glm::vec3(-3.0f, -2.0f, 7.0f), glm::vec3(3.0f, 2.0f, 7.5f));
+	buffer.Render();
+
+	COG_CHECK(!buffer.IsVisible(glm::vec3(-0.5f, -0.5f, -5.0f), glm::vec3(0.5f, 0.5f, -4.0f)));
+
+	//--- ...but not one reaching behind the camera, through the near plane
+	COG_CHECK(buffer.IsVisible(glm::vec3(-0.5f, -0.5f, -5.0f), glm::vec3(0.5f, 0.5f, 20.0f)));
+
+	//--- An occluder through the near plane keeps none of its triangles that cross it, and still culls nothing it shouldn't
+	buffer.Begin(viewProjection);
+	buffer.AddOccluder(glm::vec3(-1.0f, -1.0f, -3.0f), glm::vec3(1.0f, 1.0f, 30.0f));
+	buffer.Render();
+
+	COG_CHECK(buffer.IsVisible(glm::vec3(3.0f, -0.5f, -5.0f), glm::vec3(4.0f, 0.5f, -4.0f)));
+
+	for (int y = 0; y < s_height; y++) {
+		for (int x = 0; x < s_width; x++) { COG_CHECK(buffer.GetDepth(x, y) >= -1.0f); }
+	}
+}
+
+
+/*******************************************************************************************************************
+	A pixel an occluder only partly covers is never given its depth, so a box seen through the uncovered part of a
+	pixel at the occluder's silhouette stays visible. Pixels wholly covered are, even along the edges between the
+	occluder's own triangles
+*******************************************************************************************************************/
+COG_TEST(OcclusionBufferSilhouettePixels)
+{
+	//--- With no camera at all, x and y map straight to pixels: x = (x + 1) * 32, y = (y + 1) * 16
+	OcclusionBuffer buffer(s_width, s_height);
+
+	const float edge = 40.5f / 32.0f - 1.0f;
+
+	buffer.Begin(glm::mat4(1.0f));
+	buffer.AddOccluder(glm::vec3(-1.0f, -0.5f, 0.0f), glm::vec3(edge, 0.5f, 0.2f));
+	buffer.Render();
+
+	//--- Pixel 40 is only half covered, pixel 39 is covered all the way
+	COG_CHECK(buffer.GetDepth(40, 16) == 1.0f);
+	COG_CHECK(buffer.GetDepth(39, 16) < 1.0f);
+
+	//--- The furthest depth of the box in a covered pixel (its back face), never its front
+	COG_CHECK_NEAR(buffer.GetDepth(20, 16), 0.2f, 1e-6);
+
+	//--- The diagonals splitting each face into two triangles leave no gaps
+	for (int y = 9; y < 23; y++) {
+		for (int x = 1; x < 39; x++) { COG_CHECK(buffer.GetDepth(x, y) < 1.0f); }
+	}
+
+	//--- A box behind the occluder, but only in the uncovered part of pixel 40, is visible
+	float left = 40.6f / 32.0f - 1.0f, right = 40.9f / 32.0f - 1.0f;
+
+	COG_CHECK(buffer.IsVisible(glm::vec3(left, -0.1f, 0.5f), glm::vec3(right, 0.1f, 0.6f)));
+
+	//--- A box behind the covered part is hidden, and one in front of it isn't
+	COG_CHECK(!buffer.IsVisible(glm::vec3(-0.6f, -0.1f, 0.5f), glm::vec3(-0.4f, 0.1f, 0.6f)));
+	COG_CHECK(buffer.IsVisible(glm::vec3(-0.6f, -0.1f, -0.5f), glm::vec3(-0.4f, 0.1f, -0.4f)));
+}
+
+
+/*******************************************************************************************************************
+	Drawing the bands as jobs gives the same buffer as drawing it all on one thread
+*******************************************************************************************************************/
+COG_TEST(OcclusionBufferIsTheSameOnTheJobSystem)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<unsigned int> indices;
+	GetHills(vertices, indices);
+
+	JobSystem jobSystem;
+	jobSystem.Start(4);
+
+	OcclusionBuffer single(256, 128), jobs(256, 128, &jobSystem);
+
+	for (OcclusionBuffer* buffer : { &single, &jobs }) {
+		buffer->Begin(GetViewProjection());
+		buffer->AddOccluder(vertices, indices);
+		buffer->AddOccluder(glm::vec3(-2.0f, -1.0f, -1.0f), glm::vec3(0.5f, 1.5f, 0.7f));
+		buffer->Render();
+	}
+
+	jobSystem.Stop();
+
+	bool isSame = true;
+
+	for (unsigned int y = 0; y < 128; y++) {
+		for (unsigned int x = 0; x < 256; x++) { isSame = isSame && single.GetDepth(x, y) == jobs.GetDepth(x, y); }
+	}
+
+	COG_CHECK(isSame);
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <pretty_glm/gtc/matrix_transform.hpp>
+#include "Test.h"
+#include "physics/QuadTree.h"
+
+/*******************************************************************************************************************
+	QuadTreeTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for QuadTree - frustum culling and box queries giving the same objects as testing every object one by one
+	(as objects move and are removed), and handles that are removed twice or used after being removed being ignored.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	struct Box {
+		glm::vec3 minimum, maximum;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns a random box inside the world (-500 to 500 in X and Z), from tiny up to a fifth of the world wide
+*******************************************************************************************************************/
+static Box GetRandomBox(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f), height(0.0f, 50.0f), size(0.5f, 100.0f);
+
+	glm::vec3 minimum(position(random), height(random), position(random));
+
+	return { minimum, minimum + glm::vec3(size(random), size(random) * 0.2f, size(random)) };
+}
+
+
+/*******************************************************************************************************************
+	Returns the IDs of the boxes inside the frustum, testing every box one by one (removed ones are skipped)
+*******************************************************************************************************************/
+static std::vector<unsigned int> CullEveryBox(const Frustum& frustum, const std::vector<Box>& boxes, const std::vector<bool>& isRemoved)
+{
+	std::vector<unsigned int> results;
+
+	for (unsigned int i = 0; i < boxes.size(); i++) {
+		if (!isRemoved[i] && frustum.IsRectangleInside((boxes[i].minimum + boxes[i].maximum) * 0.5f, (boxes[i].maximum - boxes[i].minimum) * 0.5f)) {
+			results.push_back(i);
+		}
+	}
+
+	return results;
+}
+
+
+/*******************************************************************************************************************
+	Returns the results sorted, as the tree returns them in node order
+*******************************************************************************************************************/
+static std::vector<unsigned int> Sort(std::vector<unsigned int> results)
+{
+	std::sort(results.begin(), results.end());
+	return results;
+}
+
+
+/*******************************************************************************************************************
+	Culling gives exactly the objects that are inside the frustum when tested one by one - from several views, after
+	objects move (some far enough to change node) and after some are removed
+*******************************************************************************************************************/
+COG_TEST(QuadTreeCullMatchesEveryObjectTest)
+{
+	std::mt19937 random(21);
+
+	QuadTree tree(glm::vec3(-500.0f, 0.0f, -500.0f), glm::vec3(500.0f, 50.0f, 500.0f));
+	std::vector<Box> boxes;
+	std::vector<bool> isRemoved(2000, false);
+	std::vector<QuadTree::Handle> handles;
+
+	for (unsigned int i = 0; i < 2000; i++) {
+		boxes.push_back(GetRandomBox(random));
+		handles.push_back(tree.Insert(i, boxes[i].minimum, boxes[i].maximum));
+	}
+
+	glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f);
+	Frustum frustum(projection, glm::mat4(1.0f));
+
+	std::vector<unsigned int> results;
+	bool isSame = true;
+
+	for (int view = 0; view < 12; view++) {
+
+		float angle = view * 0.5f;
+		frustum.Update(projection, glm::lookAt(glm::vec3(0.0f, 40.0f, 0.0f), glm::vec3(std::cos(angle), 0.7f, std::sin(angle)) * 100.0f, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+		tree.CullFrustum(frustum, results);
+		isSame = isSame && Sort(results) == CullEveryBox(frustum, boxes, isRemoved);
+
+		//--- Then move some objects and remove others, for the next view
+		for (unsigned int i = view; i < boxes.size(); i += 37) {
+			if (isRemoved[i]) { continue; }
+			boxes[i] = (i % 2) ? GetRandomBox(random) : Box{ boxes[i].minimum + 0.1f, boxes[i].maximum + 0.1f };
+			tree.Update(handles[i], boxes[i].minimum, boxes[i].maximum);
+		}
+
+		for (unsigned int i = view * 5; i < boxes.size(); i += 101) {
+			if (!isRemoved[i]) { tree.Remove(handles[i]); isRemoved[i] = true; }
+		}
+	}
+
+	COG_CHECK(isSame);
+	COG_CHECK(tree.GetCount() == (unsigned int)std::count(isRemoved.begin(), isRemoved.end(), false));
+}
+
+
+/*******************************************************************************************************************
+	Box queries give exactly the objects whose bounds overlap the box
+*******************************************************************************************************************/
+COG_TEST(QuadTreeQueryBoxMatchesEveryObjectTest)
+{
+	std::mt19937 random(4);
+
+	QuadTree tree(glm::vec3(-500.0f, 0.0f, -500.0f), glm::vec3(500.0f, 50.0f, 500.0f));
+	std::vector<Box> boxes;
+
+	for (unsigned int i = 0; i < 1000; i++) {
+		boxes.push_back(GetRandomBox(random));
+		tree.Insert(i, boxes[i].minimum, boxes[i].maximum);
+	}
+
+	bool isSame = true;
+	std::vector<unsigned int> results;
+
+	for (int query = 0; query < 50; query++) {
+
+		Box area = GetRandomBox(random);
+		std::vector<unsigned int> expected;
+
+		for (unsigned int i = 0; i < boxes.size(); i++) {
+			if (glm::all(glm::lessThanEqual(boxes[i].minimum, area.maximum)) && glm::all(glm::lessThanEqual(area.minimum, boxes[i].maximum))) {
+				expected.push_back(i);
+			}
+		}
+
+		results.clear();
+		tree.QueryBox(area.minimum, area.maximum, results);
+		isSame = isSame && Sort(results) == expected;
+	}
+
+	COG_CHECK(isSame);
+}
+
+
+/*******************************************************************************************************************
+	Removing a handle twice, or updating one that has been removed, is ignored - the slot is still only handed out
+	once, and the tree's count and results stay correct
+*******************************************************************************************************************/
+COG_TEST(QuadTreeRefusesRemovedHandles)
+{
+	QuadTree tree(glm::vec3(-100.0f), glm::vec3(100.0f));
+
+	QuadTree::Handle a = tree.Insert(0, glm::vec3(-1.0f), glm::vec3(1.0f));
+	QuadTree::Handle b = tree.Insert(1, glm::vec3(10.0f), glm::vec3(12.0f));
+
+	tree.Remove(a);
+	tree.Remove(a);
+	tree.Update(a, glm::vec3(20.0f), glm::vec3(21.0f));
+
+	//--- Handles that were never returned are ignored too
+	tree.Remove(100);
+	tree.Update(100, glm::vec3(0.0f), glm::vec3(1.0f));
+
+	COG_CHECK(tree.GetCount() == 1);
+
+	QuadTree::Handle first = tree.Insert(2, glm::vec3(-1.0f), glm::vec3(1.0f));
+	QuadTree::Handle second = tree.Insert(3, glm::vec3(-1.0f), glm::vec3(1.0f));
+
+	COG_CHECK(first == a);
+	COG_CHECK(second != a && second != b);
+	COG_CHECK(tree.GetCount() == 3);
+
+	std::vector<unsigned int> results;
+	tree.QueryBox(glm::vec3(-100.0f), glm::vec3(100.0f), results);
+
+	COG_CHECK(Sort(results) == std::vector<unsigned int>({ 1, 2, 3 }));
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include <map>
+#include <random>
+#include <string>
+#include "Test.h"
+#include "application/Registry.h"
+
+/*******************************************************************************************************************
+	RegistryTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for Registry - adding and removing components (and the archetype moves they cause), entities keeping their
+	data when others are swapped into their row, stale handles, ForEach() with exclusions, and a random mix of all of
+	it checked against a plain map of what every entity should have.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	struct Position	{ float x, y; };
+	struct Health	{ int value; };
+	struct Name		{ std::string value; };
+	struct Hidden	{};
+}
+
+
+/*******************************************************************************************************************
+	Adding and removing components moves an entity between archetypes, keeping the components it still has
+*******************************************************************************************************************/
+COG_TEST(RegistryAddAndRemove)
+{
+	Registry registry;
+
+	Registry::Handle entity = registry.Create();
+
+	COG_CHECK(registry.IsAlive(entity));
+	COG_CHECK(!registry.Has<Position>(entity));
+	COG_CHECK(registry.Get<Position>(entity) == nullptr);
+
+	Position* position = registry.Add(entity, Position{ 1.0f, 2.0f });
+
+	COG_CHECK(position && position->x == 1.0f && position->y == 2.0f);
+	COG_CHECK(registry.Has<Position>(entity));
+
+	registry.Add(entity, Health{ 10 });
+	registry.Add(entity, Name{ "Tree" });
+
+	COG_CHECK(registry.Get<Position>(entity)->y == 2.0f);
+	COG_CHECK(registry.Get<Health>(entity)->value == 10);
+	COG_CHECK(registry.Get<Name>(entity)->value == "Tree");
+
+	//--- Adding a component the entity already has replaces it, without moving archetype
+	unsigned int archetypes = registry.GetArchetypeCount();
+	registry.Add(entity, Health{ 5 });
+
+	COG_CHECK(registry.Get<Health>(entity)->value == 5);
+	COG_CHECK(registry.GetArchetypeCount() == archetypes);
+
+	registry.Remove<Health>(entity);
+
+	COG_CHECK(!registry.Has<Health>(entity));
+	COG_CHECK(registry.Get<Position>(entity)->x == 1.0f);
+	COG_CHECK(registry.Get<Name>(entity)->value == "Tree");
+
+	//--- Removing a component it doesn't have does nothing
+	registry.Remove<Health>(entity);
+	COG_CHECK(registry.Get<Name>(entity)->value == "Tree");
+}
+
+
+/*******************************************************************************************************************
+	Archetypes are shared by entities with the same components, however they got them, and the way back from an
+	archetype is remembered, so it isn't created twice
+*******************************************************************************************************************/
+COG_TEST(RegistryArchetypeMoves)
+{
+	Registry registry;
+
+	Registry::Handle first	= registry.Create(Position{ 0.0f, 0.0f }, Health{ 1 });
+	Registry::Handle second	= registry.Create();
+
+	registry.Add(second, Health{ 2 });
+	registry.Add(second, Position{ 1.0f, 1.0f });
+
+	//--- Empty, {Health}, {Position, Health}
+	COG_CHECK(registry.GetArchetypeCount() == 3);
+
+	registry.Remove<Position>(first);
+	registry.Remove<Health>(first);
+	registry.Add(first, Health{ 3 });
+
+	COG_CHECK(registry.GetArchetypeCount() == 3);
+	COG_CHECK(registry.Get<Health>(first)->value == 3);
+	COG_CHECK(registry.Get<Health>(second)->value == 2);
+	COG_CHECK(registry.Get<Position>(second)->x == 1.0f);
+}
+
+
+/*******************************************************************************************************************
+	Moving an entity out of an archetype swaps the last entity into its row - that entity must keep its own data
+*******************************************************************************************************************/
+COG_TEST(RegistrySwapKeepsOtherEntities)
+{
+	Registry registry;
+
+	std::vector<Registry::Handle> entities;
+	for (int i = 0; i < 5; i++) { entities.push_back(registry.Create(Position{ (float)i, 0.0f }, Health{ i })); }
+
+	registry.Remove<Health>(entities[1]);
+	registry.Destroy(entities[2]);
+
+	COG_CHECK(registry.GetCount() == 4);
+	COG_CHECK(!registry.Has<Health>(entities[1]));
+	COG_CHECK(registry.Get<Position>(entities[1])->x == 1.0f);
+
+	for (int i : { 0, 3, 4 }) {
+		COG_CHECK(registry.Get<Health>(entities[i])->value == i);
+		COG_CHECK(registry.Get<Position>(entities[i])->x == (float)i);
+	}
+}
+
+
+/*******************************************************************************************************************
+	A destroyed entity's handle stays dead, even once its slot has been re-used by a new entity
+*******************************************************************************************************************/
+COG_TEST(RegistryStaleHandles)
+{
+	Registry registry;
+
+	Registry::Handle old = registry.Create(Health{ 1 });
+	registry.Destroy(old);
+
+	Registry::Handle reused = registry.Create(Health{ 2 });
+
+	COG_CHECK(reused.index == old.index);
+	COG_CHECK(reused != old);
+	COG_CHECK(!registry.IsAlive(old));
+	COG_CHECK(registry.IsAlive(reused));
+
+	//--- Nothing done through the old handle reaches the new entity
+	COG_CHECK(registry.Get<Health>(old) == nullptr);
+	COG_CHECK(!registry.Has<Health>(old));
+	COG_CHECK(registry.Add(old, Health{ 3 }) == nullptr);
+
+	registry.Remove<Health>(old);
+	registry.Destroy(old);
+
+	COG_CHECK(registry.Get<Health>(reused)->value == 2);
+	COG_CHECK(registry.GetCount() == 1);
+
+	//--- And a handle from past the end of the records is just dead
+	COG_CHECK(!registry.IsAlive({ 100, 0 }));
+
+	registry.Clear();
+
+	COG_CHECK(registry.GetCount() == 0);
+	COG_CHECK(!registry.IsAlive(reused));
+}
+
+
+/*******************************************************************************************************************
+	ForEach() visits every entity with all of the components, and none of the excluded ones
+*******************************************************************************************************************/
+COG_TEST(RegistryForEach)
+{
+	Registry registry;
+
+	registry.Create(Position{ 1.0f, 0.0f }, Health{ 1 });
+	registry.Create(Position{ 2.0f, 0.0f });
+	registry.Create(Position{ 4.0f, 0.0f }, Health{ 2 }, Hidden{});
+	registry.Create(Health{ 4 });
+
+	float sum = 0.0f;
+	registry.ForEach<Position>([&sum](Position& position) { sum += position.x; });
+	COG_CHECK(sum == 7.0f);
+
+	int health = 0;
+	registry.ForEach<Position, Health>([&health](Position&, Health& value) { health += value.value; });
+	COG_CHECK(health == 3);
+
+	health = 0;
+	registry.ForEach<Health>([&health](Health& value) { health += value.value; }, Registry::GetSignature<Hidden>());
+	COG_CHECK(health == 5);
+
+	//--- ForEachSpan() hands over each archetype's arrays along with the handles of its entities
+	unsigned int count = 0;
+	registry.ForEachSpan<Health>([&registry, &count](unsigned int size, const Registry::Handle* handles, Health* values) {
+		for (unsigned int i = 0; i < size; i++) { COG_CHECK(registry.Get<Health>(handles[i]) == &values[i]); }
+		count += size;
+	});
+	COG_CHECK(count == 3);
+}
+
+
+/*******************************************************************************************************************
+	A random mix of creating, destroying, adding and removing, checked against a map of what each entity should have
+*******************************************************************************************************************/
+COG_TEST(RegistryMatchesReference)
+{
+	struct Expected {
+		bool	hasPosition, hasHealth;
+		float	x;
+		int		health;
+	};
+
+	Registry registry;
+	std::map<unsigned int, std::pair<Registry::Handle, Expected>> reference;
+	std::vector<Registry::Handle> dead;
+
+	std::mt19937 random(7);
+
+	for (int step = 0; step < 5000; step++) {
+
+		unsigned int action = random() % 6;
+
+		if (reference.empty() || action == 0) {
+			Registry::Handle handle = registry.Create();
+			reference[handle.index] = { handle, { false, false, 0.0f, 0 } };
+			continue;
+		}
+
+		auto iterator = reference.begin();
+		std::advance(iterator, random() % reference.size());
+
+		Registry::Handle handle	= iterator->second.first;
+		Expected& expected		= iterator->second.second;
+
+		switch (action) {
+			case 1: registry.Destroy(handle); dead.push_back(handle); reference.erase(iterator); break;
+			case 2: expected.x = (float)step; expected.hasPosition = true; registry.Add(handle, Position{ expected.x, 0.0f }); break;
+			case 3: expected.health = step; expected.hasHealth = true; registry.Add(handle, Health{ step }); break;
+			case 4: expected.hasPosition = false; registry.Remove<Position>(handle); break;
+			case 5: expected.hasHealth = false; registry.Remove<Health>(handle); break;
+		}
+	}
+
+	COG_CHECK(registry.GetCount() == reference.size());
+
+	unsigned int mismatches = 0;
+
+	for (const auto& entry : reference) {
+
+		Registry::Handle handle		= entry.second.first;
+		const Expected& expected	= entry.second.second;
+
+		if (registry.Has<Position>(handle) != expected.hasPosition || registry.Has<Health>(handle) != expected.hasHealth) { mismatches++; continue; }
+		if (expected.hasPosition && registry.Get<Position>(handle)->x != expected.x)		{ mismatches++; }
+		if (expected.hasHealth && registry.Get<Health>(handle)->value != expected.health)	{ mismatches++; }
+	}
+
+	COG_CHECK(mismatches == 0);
+
+	for (const auto& handle : dead) { COG_CHECK(!registry.IsAlive(handle)); }
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include "Test.h"
+#include "graphics/RenderQueue.h"
+
+/*******************************************************************************************************************
+	RenderQueueTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for RenderQueue, through its RecordingBackend - the sort keys (including material and mesh IDs cut down to
+	16 bits), the radix sort being stable, binds being skipped when nothing has changed, and a sorted queue binding
+	less than the same draws in the order they were pushed.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	struct Draw {
+		unsigned int	shader, material, mesh;
+		float			distance;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns a random scene - a few shaders, more materials and even more meshes, in no particular order
+*******************************************************************************************************************/
+static std::vector<Draw> GetScene(unsigned int count, unsigned int seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> distance(0.0f, 900.0f);
+
+	std::vector<Draw> draws(count);
+	for (auto& draw : draws) { draw = { (unsigned int)random() % 3, (unsigned int)random() % 10, (unsigned int)random() % 20, distance(random) }; }
+
+	return draws;
+}
+
+
+/*******************************************************************************************************************
+	Pushes every draw of a scene onto a queue, in order
+*******************************************************************************************************************/
+static void Push(RenderQueue& queue, const std::vector<Draw>& draws)
+{
+	for (unsigned int i = 0; i < draws.size(); i++) {
+		queue.Push(RenderQueue::MakeKey(RenderQueue::PASS_OPAQUE, draws[i].shader, draws[i].material, draws[i].mesh, draws[i].distance), i);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Every field comes back out of the key as it went in, and nothing spills over into the field next to it
+*******************************************************************************************************************/
+COG_TEST(RenderQueueKeyPacking)
+{
+	uint64_t key = RenderQueue::MakeKey(3, 200, 40000, 1234, 500.0f);
+
+	COG_CHECK(RenderQueue::GetPass(key) == 3);
+	COG_CHECK(RenderQueue::GetShader(key) == 200);
+	COG_CHECK(RenderQueue::GetMaterial(key) == 40000);
+	COG_CHECK(RenderQueue::GetMesh(key) == 1234);
+
+	//--- Fields are ordered pass, shader, material, mesh, depth - the more significant always wins
+	COG_CHECK(RenderQueue::MakeKey(0, 1, 0, 0, 0.0f) > RenderQueue::MakeKey(0, 0, 0xFFFF, 0xFFFF, 1000.0f));
+	COG_CHECK(RenderQueue::MakeKey(0, 0, 1, 0, 0.0f) > RenderQueue::MakeKey(0, 0, 0, 0xFFFF, 1000.0f));
+	COG_CHECK(RenderQueue::MakeKey(0, 0, 0, 1, 0.0f) > RenderQueue::MakeKey(0, 0, 0, 0, 1000.0f));
+	COG_CHECK(RenderQueue::MakeKey(1, 0, 0, 0, 0.0f) > RenderQueue::MakeKey(0, 0xFF, 0xFFFF, 0xFFFF, 1000.0f));
+
+	//--- Nearer draws sort first, and distances out of range are clamped rather than spilling into the mesh
+	COG_CHECK(RenderQueue::MakeKey(0, 0, 0, 5, 10.0f) < RenderQueue::MakeKey(0, 0, 0, 5, 20.0f));
+	COG_CHECK(RenderQueue::MakeKey(0, 0, 0, 5, -50.0f) == RenderQueue::MakeKey(0, 0, 0, 5, 0.0f));
+	COG_CHECK(RenderQueue::MakeKey(0, 0, 0, 5, 1e9f) == RenderQueue::MakeKey(0, 0, 0, 5, 1000.0f));
+	COG_CHECK(RenderQueue::GetMesh(RenderQueue::MakeKey(0, 0, 0, 5, 1e9f)) == 5);
+}
+
+
+/*******************************************************************************************************************
+	IDs too big for their field only keep their low bits - they never change the fields around them
+*******************************************************************************************************************/
+COG_TEST(RenderQueueKeyTruncation)
+{
+	uint64_t key = RenderQueue::MakeKey(0x13, 0x1AB, 0x12345, 0x3FFFF, 0.0f);
+
+	COG_CHECK(RenderQueue::GetPass(key) == 0x3);
+	COG_CHECK(RenderQueue::GetShader(key) == 0xAB);
+	COG_CHECK(RenderQueue::GetMaterial(key) == 0x2345);
+	COG_CHECK(RenderQueue::GetMesh(key) == 0xFFFF);
+
+	//--- So materials (or meshes) 65536 apart get the same key, and the second one's bind is skipped
+	COG_CHECK(RenderQueue::MakeKey(0, 0, 7, 0, 0.0f) == RenderQueue::MakeKey(0, 0, 7 + 0x10000, 0, 0.0f));
+	COG_CHECK(RenderQueue::MakeKey(0, 0, 0, 7, 0.0f) == RenderQueue::MakeKey(0, 0, 0, 7 + 0x10000, 0.0f));
+
+	RenderQueue queue;
+	queue.Push(RenderQueue::MakeKey(0, 0, 7, 0, 0.0f), 0);
+	queue.Push(RenderQueue::MakeKey(0, 0, 7 + 0x10000, 0, 0.0f), 1);
+	queue.Sort();
+
+	RenderQueue::RecordingBackend backend;
+	queue.Execute(backend);
+
+	COG_CHECK(backend.GetMaterialBinds() == 1);
+}
+
+
+/*******************************************************************************************************************
+	Commands with the same key keep the order they were pushed in, whichever bytes of the keys differ
+*******************************************************************************************************************/
+COG_TEST(RenderQueueSortIsStable)
+{
+	std::mt19937 random(21);
+
+	//--- A handful of keys, differing in the low, middle and top bytes, so several radix passes run
+	std::vector<uint64_t> keys = { 0, 0xFF, 0x1234'0000'0000ull, 0x1234'0000'00FFull, 0xF000'0000'0000'0000ull, 0x0100'0000'0000'0001ull };
+
+	RenderQueue queue;
+	std::vector<RenderQueue::Command> expected;
+
+	for (unsigned int i = 0; i < 1000; i++) {
+		uint64_t key = keys[random() % keys.size()];
+		queue.Push(key, i);
+		expected.push_back({ key, i });
+	}
+
+	queue.Sort();
+	std::stable_sort(expected.begin(), expected.end(), [](const RenderQueue::Command& a, const RenderQueue::Command& b) { return a.key < b.key; });
+
+	const auto& commands = queue.GetCommands();
+	bool isSame = commands.size() == expected.size();
+
+	for (unsigned int i = 0; isSame && i < commands.size(); i++) {
+		isSame = commands[i].key == expected[i].key && commands[i].draw == expected[i].draw;
+	}
+
+	COG_CHECK(isSame);
+
+	//--- Sorting again changes nothing, and nor does sorting one (or no) command
+	queue.Sort();
+	COG_CHECK(queue.GetCommands()[0].draw == expected[0].draw && queue.GetCommands().back().draw == expected.back().draw);
+
+	RenderQueue single;
+	single.Sort();
+	single.Push(42, 7);
+	single.Sort();
+	COG_CHECK(single.GetCount() == 1 && single.GetCommands()[0].draw == 7);
+}
+
+
+/*******************************************************************************************************************
+	Execute() only binds what has changed since the last draw - a new shader rebinds the material and mesh as well,
+	but a new material doesn't rebind the mesh (or the other way round)
+*******************************************************************************************************************/
+COG_TEST(RenderQueueSkipsUnchangedBinds)
+{
+	RenderQueue queue;
+
+	queue.Push(RenderQueue::MakeKey(0, 0, 1, 1, 1.0f), 0);
+	queue.Push(RenderQueue::MakeKey(0, 0, 1, 1, 2.0f), 1);	//--- Same everything, just a draw
+	queue.Push(RenderQueue::MakeKey(0, 0, 1, 2, 1.0f), 2);	//--- New mesh
+	queue.Push(RenderQueue::MakeKey(0, 0, 2, 2, 1.0f), 3);	//--- New material, same mesh
+	queue.Push(RenderQueue::MakeKey(0, 1, 2, 2, 1.0f), 4);	//--- New shader, material and mesh again too
+	queue.Push(RenderQueue::MakeKey(1, 1, 2, 2, 1.0f), 5);	//--- New pass
+	queue.Sort();
+
+	RenderQueue::RecordingBackend backend;
+	queue.Execute(backend);
+
+	COG_CHECK(backend.GetDraws() == std::vector<unsigned int>({ 0, 1, 2, 3, 4, 5 }));
+	COG_CHECK(backend.GetPassCount() == 2);
+	COG_CHECK(backend.GetShaderBinds() == 3);
+	COG_CHECK(backend.GetMaterialBinds() == 4);
+	COG_CHECK(backend.GetMeshBinds() == 4);
+	COG_CHECK(backend.GetStateChanges() == 11);
+
+	//--- An empty queue doesn't even start a pass
+	backend.Reset();
+	RenderQueue().Execute(backend);
+
+	COG_CHECK(backend.GetPassCount() == 0 && backend.GetStateChanges() == 0 && backend.GetDraws().empty());
+}
+
+
+/*******************************************************************************************************************
+	A sorted queue draws everything exactly once, grouped by shader, material and mesh (nearest first within a mesh),
+	with far fewer binds than the same draws in the order they were pushed
+*******************************************************************************************************************/
+COG_TEST(RenderQueueSortingSavesBinds)
+{
+	std::vector<Draw> draws = GetScene(500, 5);
+
+	RenderQueue unsorted;
+	Push(unsorted, draws);
+
+	RenderQueue sorted;
+	Push(sorted, draws);
+	sorted.Sort();
+
+	RenderQueue::RecordingBackend unsortedBackend, sortedBackend;
+	unsorted.Execute(unsortedBackend);
+	sorted.Execute(sortedBackend);
+
+	std::vector<unsigned int> drawn = sortedBackend.GetDraws();
+	std::sort(drawn.begin(), drawn.end());
+
+	bool isEveryDraw = drawn.size() == draws.size();
+	for (unsigned int i = 0; isEveryDraw && i < drawn.size(); i++) { isEveryDraw = drawn[i] == i; }
+
+	COG_CHECK(isEveryDraw);
+
+	//--- Sorted, each shader is bound once, and each material and mesh once per shader (or material) they're used in
+	std::set<unsigned int> shaders;
+	std::set<std::pair<unsigned int, unsigned int>> materials;
+
+	for (const auto& draw : draws) { shaders.insert(draw.shader); materials.insert({ draw.shader, draw.material }); }
+
+	COG_CHECK(sortedBackend.GetShaderBinds() == shaders.size());
+	COG_CHECK(sortedBackend.GetMaterialBinds() == materials.size());
+	COG_CHECK(sortedBackend.GetStateChanges() * 2 < unsortedBackend.GetStateChanges());
+
+	//--- And within a run of the same mesh, the nearest is drawn first
+	const auto& order	= sortedBackend.GetDraws();
+	bool isFrontToBack	= true;
+
+	for (unsigned int i = 1; i < order.size(); i++) {
+		const Draw& previous = draws[order[i - 1]], &current = draws[order[i]];
+		bool isSameMesh = previous.shader == current.shader && previous.material == current.material && previous.mesh == current.mesh;
+		if (isSameMesh && current.distance < previous.distance) { isFrontToBack = false; }
+	}
+
+	COG_CHECK(isFrontToBack);
+}
\ No newline at end of file
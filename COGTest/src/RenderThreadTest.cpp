@@ -0,0 +1,195 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Test.h"
+#include "graphics/RenderThread.h"
+
+/*******************************************************************************************************************
+	RenderThreadTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for RenderThread, through backends that draw nothing - every packet is drawn exactly once and in order,
+	the update thread never writes to the packet being drawn, drawing happens on the render thread only while it's
+	running, and Stop() draws the last frame before handing the backend back.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	const unsigned int s_frameCount = 500;
+
+	//--- Remembers every frame it was given, and checks nothing in the packet changes while it's being drawn
+	class CheckingBackend : public RenderThread::Backend {
+
+	public:
+		CheckingBackend() : mainThreadID(std::this_thread::get_id()) {}
+
+	public:
+		virtual void Attach() override { attaches++; }
+		virtual void Detach() override { detaches++; }
+
+		virtual void Render(const FramePacket& packet) override
+		{
+			reading = &packet;
+
+			bool isSame = IsFilled(packet);
+
+			//--- Give the update thread plenty of time to build the next frame while this one is "drawn"
+			if (packet.frame % 3 == 0) { std::this_thread::sleep_for(std::chrono::microseconds(200)); }
+
+			isSame = isSame && IsFilled(packet);
+
+			reading = nullptr;
+
+			if (!isSame) { changedPackets++; }
+			if (std::this_thread::get_id() == mainThreadID) { mainThreadFrames++; }
+
+			frames.push_back(packet.frame);
+		}
+
+	public:
+		static void Fill(FramePacket& packet)
+		{
+			for (unsigned int i = 0; i < 1 + packet.frame % 5; i++) {
+				packet.labels.push_back({ std::to_string(packet.frame), glm::vec2((float)i), glm::vec2(1.0f), glm::vec4(1.0f) });
+			}
+		}
+
+		static bool IsFilled(const FramePacket& packet)
+		{
+			if (packet.labels.size() != 1 + packet.frame % 5) { return false; }
+			for (const auto& label : packet.labels) { if (label.text != std::to_string(packet.frame)) { return false; } }
+			return true;
+		}
+
+	public:
+		std::vector<unsigned int>		frames;
+		std::atomic<const FramePacket*>	reading		= { nullptr };
+		std::atomic<int>				attaches	= { 0 };
+		std::atomic<int>				detaches	= { 0 };
+		std::atomic<int>				changedPackets		= { 0 };
+		std::atomic<int>				mainThreadFrames	= { 0 };
+		const std::thread::id			mainThreadID;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns true if the frames are 1, 2, 3 ... count - each one exactly once and in order
+*******************************************************************************************************************/
+static bool IsEveryFrameInOrder(const std::vector<unsigned int>& frames, unsigned int count)
+{
+	if (frames.size() != count) { return false; }
+
+	for (unsigned int i = 0; i < count; i++) { if (frames[i] != i + 1) { return false; } }
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Without the thread running, every packet is drawn straight away on the calling thread
+*******************************************************************************************************************/
+COG_TEST(RenderThreadNotRunning)
+{
+	RenderThread::NullBackend backend;
+	RenderThread renderThread(&backend);
+
+	for (unsigned int i = 0; i < 10; i++) {
+		FramePacket& packet = renderThread.BeginFrame();
+		packet.labels.push_back({ "label", glm::vec2(0.0f), glm::vec2(1.0f), glm::vec4(1.0f) });
+		renderThread.SubmitFrame();
+
+		COG_CHECK(backend.GetFrameCount() == i + 1);
+		COG_CHECK(backend.GetLastFrame() == i + 1);
+	}
+
+	COG_CHECK(!renderThread.IsRunning());
+	COG_CHECK(backend.GetDrawCount() == 10);
+	COG_CHECK(renderThread.GetFramesRendered() == 10);
+}
+
+
+/*******************************************************************************************************************
+	With the thread running, every packet submitted is drawn exactly once, in order, on the render thread - and
+	never while the update thread is writing to it
+*******************************************************************************************************************/
+COG_TEST(RenderThreadDeliversEveryFrameOnce)
+{
+	CheckingBackend backend;
+	RenderThread renderThread(&backend);
+
+	renderThread.Start();
+
+	COG_CHECK(renderThread.IsRunning());
+
+	unsigned int writesWhileReading = 0;
+
+	for (unsigned int i = 0; i < s_frameCount; i++) {
+
+		FramePacket& packet = renderThread.BeginFrame();
+
+		if (backend.reading.load() == &packet) { writesWhileReading++; }
+
+		CheckingBackend::Fill(packet);
+
+		if (backend.reading.load() == &packet) { writesWhileReading++; }
+
+		renderThread.SubmitFrame();
+	}
+
+	renderThread.Stop();
+
+	COG_CHECK(!renderThread.IsRunning());
+	COG_CHECK(writesWhileReading == 0);
+	COG_CHECK(backend.changedPackets.load() == 0);
+	COG_CHECK(IsEveryFrameInOrder(backend.frames, s_frameCount));
+	COG_CHECK(renderThread.GetFramesRendered() == s_frameCount);
+	COG_CHECK(backend.mainThreadFrames.load() == 0);
+
+	//--- The backend was let go of by this thread, taken by the render thread, then handed back
+	COG_CHECK(backend.attaches.load() == 2);
+	COG_CHECK(backend.detaches.load() == 2);
+}
+
+
+/*******************************************************************************************************************
+	Drawing happens on the render thread while it's running, and back on the calling thread once it has stopped -
+	and stopping straight after a submit still draws that last frame
+*******************************************************************************************************************/
+COG_TEST(RenderThreadStopDrawsLastFrame)
+{
+	CheckingBackend backend;
+	RenderThread renderThread(&backend);
+
+	for (int round = 0; round < 20; round++) {
+
+		backend.frames.clear();
+
+		//--- Not running, so drawn here
+		CheckingBackend::Fill(renderThread.BeginFrame());
+		renderThread.SubmitFrame();
+
+		COG_CHECK(backend.frames.size() == 1);
+		COG_CHECK(backend.mainThreadFrames.load() == round + 1);
+
+		//--- Running, so never drawn here
+		renderThread.Start();
+
+		CheckingBackend::Fill(renderThread.BeginFrame());
+		renderThread.SubmitFrame();
+		CheckingBackend::Fill(renderThread.BeginFrame());
+		renderThread.SubmitFrame();
+
+		renderThread.Stop();
+
+		COG_CHECK(backend.frames.size() == 3);
+		COG_CHECK(backend.frames.back() == backend.frames.front() + 2);
+		COG_CHECK(backend.mainThreadFrames.load() == round + 1);
+	}
+
+	COG_CHECK(backend.changedPackets.load() == 0);
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "Test.h"
+#include "graphics/buffers/RingRegions.h"
+
+/*******************************************************************************************************************
+	RingRegionsTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for RingRegions (the bookkeeping behind UniformRingBuffer) - the order regions are used in, regions
+	starting on the offset alignment, growing, and fences being kept until the region is waited on.
+
+*******************************************************************************************************************/
+
+/*******************************************************************************************************************
+	Regions are used in turn, starting from the first and wrapping back round to it
+*******************************************************************************************************************/
+COG_TEST(RingRegionsWrap)
+{
+	RingRegions regions(3, 256, 1024);
+
+	const unsigned int expected[] = { 0, 1, 2, 0, 1 };
+
+	for (unsigned int region : expected) {
+		regions.Advance(100);
+		COG_CHECK(regions.GetRegion() == region);
+		COG_CHECK(regions.GetStart() == region * regions.GetRegionSize());
+	}
+}
+
+
+/*******************************************************************************************************************
+	Growing doubles from the minimum size until the upload fits, and every region starts on the offset alignment
+*******************************************************************************************************************/
+COG_TEST(RingRegionsGrow)
+{
+	RingRegions regions(3, 256, 1024);
+
+	COG_CHECK(regions.Advance(100));
+	COG_CHECK(regions.GetRegionSize() == 1024);
+	COG_CHECK(regions.GetSize() == 3 * 1024);
+
+	COG_CHECK(!regions.Advance(1024));
+	COG_CHECK(regions.Advance(1025));
+	COG_CHECK(regions.GetRegionSize() == 2048);
+
+	COG_CHECK(regions.Advance(5000));
+	COG_CHECK(regions.GetRegionSize() == 8192);
+}
+
+
+/*******************************************************************************************************************
+	An alignment that isn't a power of two still puts every region's start on it
+*******************************************************************************************************************/
+COG_TEST(RingRegionsStartAligned)
+{
+	RingRegions regions(3, 48, 100);
+
+	regions.Advance(100);
+	COG_CHECK(regions.GetRegionSize() % 48 == 0);
+
+	for (int i = 0; i < 3; i++) {
+		regions.Advance(100);
+		COG_CHECK(regions.GetStart() % 48 == 0);
+	}
+}
+
+
+/*******************************************************************************************************************
+	A fenced region stays fenced until it's unfenced, so wrapping back round to it means waiting on it first
+*******************************************************************************************************************/
+COG_TEST(RingRegionsFence)
+{
+	RingRegions regions(3, 256, 1024);
+
+	for (int i = 0; i < 3; i++) {
+		regions.Advance(100);
+		COG_CHECK(!regions.IsFenced(regions.GetRegion()));
+		regions.Fence();
+	}
+
+	//--- Back at the first region, which the GPU may still be reading
+	regions.Advance(100);
+	COG_CHECK(regions.GetRegion() == 0);
+	COG_CHECK(regions.IsFenced(0));
+	COG_CHECK(regions.IsFenced(1) && regions.IsFenced(2));
+
+	regions.Unfence(0);
+	COG_CHECK(!regions.IsFenced(0));
+	COG_CHECK(regions.IsFenced(1));
+
+	COG_CHECK(!regions.IsFenced(3));
+}
+
+
+/*******************************************************************************************************************
+	Growing gives the buffer new storage, so every fence is dropped
+*******************************************************************************************************************/
+COG_TEST(RingRegionsGrowDropsFences)
+{
+	RingRegions regions(3, 256, 1024);
+
+	regions.Advance(100);
+	regions.Fence();
+	regions.Advance(100);
+	regions.Fence();
+
+	COG_CHECK(regions.Advance(4096));
+	COG_CHECK(regions.GetRegion() == 2);
+
+	for (unsigned int i = 0; i < regions.GetCount(); i++) { COG_CHECK(!regions.IsFenced(i)); }
+}
\ No newline at end of file
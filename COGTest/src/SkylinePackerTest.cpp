@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "Test.h"
+#include "utilities/SkylinePacker.h"
+
+/*******************************************************************************************************************
+	SkylinePackerTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for SkylinePacker - packed rectangles never overlapping or leaving the area, the padding kept between them
+	(and around the edge), a full area refusing more, the atlas size FontBaker ends up with when it grows the area
+	until everything fits, and the occupancy figure.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	struct Rectangle {
+		int x, y, width, height;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns random glyph sized rectangles, tallest first (as FontBaker sorts them)
+*******************************************************************************************************************/
+static std::vector<Rectangle> GetRectangles(unsigned int count, unsigned int seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<int> size(1, 40);
+
+	std::vector<Rectangle> rectangles(count);
+	for (auto& rectangle : rectangles) { rectangle = { 0, 0, size(random), size(random) }; }
+
+	std::stable_sort(rectangles.begin(), rectangles.end(), [](const Rectangle& a, const Rectangle& b) { return a.height > b.height; });
+
+	return rectangles;
+}
+
+
+/*******************************************************************************************************************
+	Packs as many of the rectangles as fit, returning how many did
+*******************************************************************************************************************/
+static unsigned int Pack(SkylinePacker& packer, std::vector<Rectangle>& rectangles)
+{
+	for (unsigned int i = 0; i < rectangles.size(); i++) {
+		if (!packer.Insert(rectangles[i].width, rectangles[i].height, rectangles[i].x, rectangles[i].y)) { return i; }
+	}
+
+	return (unsigned int)rectangles.size();
+}
+
+
+/*******************************************************************************************************************
+	Returns true if the first count rectangles are inside the area (by at least the padding) and at least the padding
+	apart from each other
+*******************************************************************************************************************/
+static bool IsPackingValid(const std::vector<Rectangle>& rectangles, unsigned int count, int width, int height, int padding)
+{
+	for (unsigned int i = 0; i < count; i++) {
+
+		const Rectangle& a = rectangles[i];
+
+		if (a.x < padding || a.y < padding || a.x + a.width + padding > width || a.y + a.height + padding > height) { return false; }
+
+		for (unsigned int j = i + 1; j < count; j++) {
+
+			const Rectangle& b = rectangles[j];
+
+			//--- Grown by the padding on one side, two rectangles still mustn't touch
+			bool isApart = a.x + a.width + padding <= b.x || b.x + b.width + padding <= a.x ||
+						   a.y + a.height + padding <= b.y || b.y + b.height + padding <= a.y;
+
+			if (!isApart) { return false; }
+		}
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Returns the atlas size the rectangles end up in, growing it the way FontBaker::Pack() does - start at 64 x 64,
+	double the shorter side until everything fits, then trim the height to the smallest power of two that holds it
+*******************************************************************************************************************/
+static bool GetAtlasSize(std::vector<Rectangle> rectangles, int padding, int& width, int& height)
+{
+	SkylinePacker packer;
+
+	for (width = 64, height = 64; width <= 4096 && height <= 4096;) {
+
+		packer.Reset(width, height, padding);
+
+		if (Pack(packer, rectangles) == rectangles.size()) {
+			height = 1;
+			while (height < packer.GetUsedHeight()) { height <<= 1; }
+			return true;
+		}
+
+		if (width <= height)	{ width <<= 1; }
+		else					{ height <<= 1; }
+	}
+
+	return false;
+}
+
+
+/*******************************************************************************************************************
+	Hundreds of random rectangles, with and without padding, never overlap or leave the area
+*******************************************************************************************************************/
+COG_TEST(SkylinePackerNoOverlaps)
+{
+	for (int padding : { 0, 1, 3 }) {
+
+		std::vector<Rectangle> rectangles = GetRectangles(600, 5 + padding);
+
+		SkylinePacker packer(512, 512, padding);
+		unsigned int count = Pack(packer, rectangles);
+
+		COG_CHECK(count > 100);
+		COG_CHECK(IsPackingValid(rectangles, count, 512, 512, padding));
+		COG_CHECK(packer.GetUsedHeight() <= 512);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Padding goes between rectangles and around the top and left of the area - the right and bottom get theirs from
+	each rectangle's own
+*******************************************************************************************************************/
+COG_TEST(SkylinePackerPadding)
+{
+	SkylinePacker packer(30, 30, 2);
+	int x = -1, y = -1;
+
+	COG_CHECK(packer.Insert(10, 10, x, y) && x == 2 && y == 2);
+	COG_CHECK(packer.Insert(10, 10, x, y) && x == 14 && y == 2);
+
+	//--- A third doesn't fit on the same row (26 + 10 + 2 > 30), so it goes underneath the first
+	COG_CHECK(packer.Insert(10, 10, x, y) && x == 2 && y == 14);
+	COG_CHECK(packer.GetUsedHeight() == 26);
+
+	//--- And nothing fits that would take the padding past the edge
+	COG_CHECK(!packer.Insert(17, 5, x, y));
+	COG_CHECK(packer.Insert(14, 2, x, y) && x == 14 && y == 14);
+}
+
+
+/*******************************************************************************************************************
+	A set that exactly fills the area is packed with no gaps, and one more rectangle is refused without changing
+	anything - so the area has to grow, to the size FontBaker would pick
+*******************************************************************************************************************/
+COG_TEST(SkylinePackerFullAreaAndGrowth)
+{
+	std::vector<Rectangle> squares(64, { 0, 0, 16, 16 });
+
+	SkylinePacker packer(128, 128);
+
+	COG_CHECK(Pack(packer, squares) == 64);
+	COG_CHECK(IsPackingValid(squares, 64, 128, 128, 0));
+	COG_CHECK_NEAR(packer.GetOccupancy(), 1.0f, 1e-6f);
+
+	int x = 0, y = 0;
+	COG_CHECK(!packer.Insert(16, 16, x, y));
+	COG_CHECK(!packer.Insert(1, 1, x, y));
+	COG_CHECK(packer.GetUsedHeight() == 128);
+	COG_CHECK_NEAR(packer.GetOccupancy(), 1.0f, 1e-6f);
+
+	//--- 65 squares don't fit in 128 x 128, so the atlas grows to 256 x 128 - and is then trimmed to the 5 rows used
+	squares.push_back({ 0, 0, 16, 16 });
+
+	int width = 0, height = 0;
+
+	COG_CHECK(GetAtlasSize(squares, 0, width, height));
+	COG_CHECK(width == 256 && height == 128);
+
+	//--- Something that fits nowhere (even in the biggest atlas) is refused outright
+	COG_CHECK(!GetAtlasSize({ { 0, 0, 5000, 1 } }, 0, width, height));
+}
+
+
+/*******************************************************************************************************************
+	Occupancy is the area of the rectangles over the used area (the full width, down to the lowest rectangle) - and
+	0 before anything has been packed
+*******************************************************************************************************************/
+COG_TEST(SkylinePackerOccupancy)
+{
+	SkylinePacker packer(256, 256, 1);
+
+	COG_CHECK(packer.GetOccupancy() == 0.0f);
+
+	std::vector<Rectangle> rectangles = GetRectangles(120, 13);
+	unsigned int count = Pack(packer, rectangles);
+
+	double area = 0.0;
+	for (unsigned int i = 0; i < count; i++) { area += (double)rectangles[i].width * rectangles[i].height; }
+
+	COG_CHECK(count > 0);
+	COG_CHECK_NEAR(packer.GetOccupancy(), (float)(area / (256.0 * packer.GetUsedHeight())), 1e-5f);
+
+	//--- Tallest first, a random set should still cover most of the used area
+	COG_CHECK(packer.GetOccupancy() > 0.6f);
+
+	//--- Reset() empties the area again
+	packer.Reset(64, 64);
+
+	COG_CHECK(packer.GetOccupancy() == 0.0f && packer.GetUsedHeight() == 0);
+}
\ No newline at end of file
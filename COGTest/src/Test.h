@@ -0,0 +1,50 @@
+#pragma once
+
+/*******************************************************************************************************************
+	Test.h, main.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	The smallest test harness that does the job - tests register themselves with COG_TEST, check things with
+	COG_CHECK, and main() runs every one of them.
+
+	[Features]
+	A failed check reports the condition, file and line, and carries on with the rest of the test.
+	The run ends with a count of the tests that failed, and a non-zero exit code if any did (for scripts and CI).
+
+	[Upcoming]
+	Running a single test by name.
+
+	[Side Notes]
+	Only code that never touches OpenGL (or a window) can be tested here, so the things worth testing are kept in
+	headless classes (InstanceBatcher, UniformArena, DistanceField etc.).
+	Tests run in the order their files are linked, so a test must never rely on another having run first.
+
+*******************************************************************************************************************/
+#include <cmath>
+#include <vector>
+
+#define COG_TEST(name)	static void name(); \
+						static test::Registration name##Registration(#name, name); \
+						static void name()
+
+#define COG_CHECK(x)	if (!(x)) { test::Fail(#x, __FILE__, __LINE__); }
+
+#define COG_CHECK_NEAR(a, b, epsilon) if (std::fabs((double)(a) - (double)(b)) > (epsilon)) { test::Fail(#a " == " #b, __FILE__, __LINE__); }
+
+namespace test {
+
+	typedef void (*Function)();
+
+	struct Case {
+		const char*	name;
+		Function	function;
+	};
+
+	std::vector<Case>&	GetCases();
+	void				Fail(const char* condition, const char* file, int line);
+
+	struct Registration {
+		Registration(const char* name, Function function) { GetCases().push_back({ name, function }); }
+	};
+}
\ No newline at end of file
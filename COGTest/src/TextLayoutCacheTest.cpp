@@ -0,0 +1,228 @@
+#include <string>
+#include <vector>
+#include "Test.h"
+#include "graphics/TextLayoutCache.h"
+
+/*******************************************************************************************************************
+	TextLayoutCacheTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for TextLayoutCache - hits and misses, blank strings, dropping the strings not drawn this frame when the
+	block is full (and growing it when every string was), and which vertices are asked to be uploaded before and
+	after a compaction.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	//--- A made up layout - every float of vertex i is (id * 1000 + i), so moved vertices can be checked
+	struct Vertices {
+		std::vector<float> positions;
+		std::vector<float> textureCoords;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns count made up vertices for a string (6 per character, as Text builds them)
+*******************************************************************************************************************/
+static Vertices GetVertices(unsigned int id, unsigned int count)
+{
+	Vertices vertices;
+
+	for (unsigned int i = 0; i < count; i++) {
+		float value = (float)(id * 1000 + i);
+		vertices.positions.insert(vertices.positions.end(), { value, value, value });
+		vertices.textureCoords.insert(vertices.textureCoords.end(), { value, value });
+	}
+
+	return vertices;
+}
+
+
+/*******************************************************************************************************************
+	Adds a string's made up vertices to the cache
+*******************************************************************************************************************/
+static const TextLayoutCache::Layout* Add(TextLayoutCache& cache, const std::string& text, unsigned int id, unsigned int count)
+{
+	Vertices vertices = GetVertices(id, count);
+	return cache.Add(text, vertices.positions, vertices.textureCoords);
+}
+
+
+/*******************************************************************************************************************
+	Returns true if the block holds the made up vertices of a layout, wherever the layout now is
+*******************************************************************************************************************/
+static bool IsLayoutIntact(const TextLayoutCache& cache, const TextLayoutCache::Layout& layout, unsigned int id)
+{
+	for (unsigned int i = 0; i < layout.count; i++) {
+
+		float value = (float)(id * 1000 + i);
+		unsigned int vertex = layout.first + i;
+
+		if (cache.GetPositions()[vertex * 3] != value || cache.GetPositions()[vertex * 3 + 2] != value)	{ return false; }
+		if (cache.GetTextureCoords()[vertex * 2] != value || cache.GetTextureCoords()[vertex * 2 + 1] != value)	{ return false; }
+	}
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	A string is a miss until it has been added, then a hit, with its vertices where the layout says they are
+*******************************************************************************************************************/
+COG_TEST(TextLayoutCacheHitsAndMisses)
+{
+	TextLayoutCache cache(64);
+
+	COG_CHECK(cache.Find("Score") == nullptr);
+
+	const TextLayoutCache::Layout* added = Add(cache, "Score", 1, 30);
+
+	COG_CHECK(added && added->first == 0 && added->count == 30);
+
+	Add(cache, "Lives", 2, 30);
+
+	const TextLayoutCache::Layout* score = cache.Find("Score");
+	const TextLayoutCache::Layout* lives = cache.Find("Lives");
+
+	COG_CHECK(score && lives);
+	COG_CHECK(lives->first == 30 && lives->count == 30);
+	COG_CHECK(IsLayoutIntact(cache, *score, 1));
+	COG_CHECK(IsLayoutIntact(cache, *lives, 2));
+
+	COG_CHECK(cache.GetHits() == 2);
+	COG_CHECK(cache.GetMisses() == 1);
+	COG_CHECK(cache.GetLayoutCount() == 2);
+	COG_CHECK(cache.GetVertexCount() == 60);
+	COG_CHECK(cache.GetCompactions() == 0);
+}
+
+
+/*******************************************************************************************************************
+	Blank strings are remembered with no vertices, so they're hits from then on without taking up any of the block
+*******************************************************************************************************************/
+COG_TEST(TextLayoutCacheBlankStrings)
+{
+	TextLayoutCache cache(16);
+
+	Add(cache, "Name", 1, 12);
+
+	const TextLayoutCache::Layout* blank = cache.Add("   ", {}, {});
+
+	COG_CHECK(blank && blank->count == 0);
+	COG_CHECK(cache.GetVertexCount() == 12);
+
+	COG_CHECK(cache.Find("   ") != nullptr);
+	COG_CHECK(cache.GetHits() == 1);
+
+	//--- And a blank string never makes a full block compact or grow
+	Add(cache, "Time", 2, 4);
+	cache.Add("", {}, {});
+
+	COG_CHECK(cache.GetCompactions() == 0);
+	COG_CHECK(cache.GetCapacity() == 16);
+}
+
+
+/*******************************************************************************************************************
+	When the block is full, the strings not drawn this frame are dropped and the ones that were move down to the
+	front, keeping their vertices - the block only grows when the strings drawn this frame don't fit on their own
+*******************************************************************************************************************/
+COG_TEST(TextLayoutCacheCompaction)
+{
+	TextLayoutCache cache(24);
+
+	Add(cache, "Old", 1, 6);
+	Add(cache, "Kept", 2, 12);
+	cache.EndFrame();
+
+	//--- Only "Kept" is drawn this frame, so "Old" goes to make room for "New"
+	COG_CHECK(cache.Find("Kept") != nullptr);
+
+	const TextLayoutCache::Layout* added = Add(cache, "New", 3, 12);
+
+	COG_CHECK(cache.GetCompactions() == 1);
+	COG_CHECK(cache.GetCapacity() == 24);
+	COG_CHECK(cache.GetLayoutCount() == 2);
+	COG_CHECK(cache.GetVertexCount() == 24);
+	COG_CHECK(added->first == 12);
+	COG_CHECK(IsLayoutIntact(cache, *added, 3));
+
+	const TextLayoutCache::Layout* kept = cache.Find("Kept");
+
+	COG_CHECK(kept && kept->first == 0);
+	COG_CHECK(IsLayoutIntact(cache, *kept, 2));
+	COG_CHECK(cache.Find("Old") == nullptr);
+
+	//--- Next frame everything is still in use, so the block has to grow rather than drop anything
+	cache.EndFrame();
+	cache.Find("Kept");
+	cache.Find("New");
+	Add(cache, "Bigger", 4, 30);
+
+	COG_CHECK(cache.GetCompactions() == 2);
+	COG_CHECK(cache.GetCapacity() == 96);
+	COG_CHECK(cache.GetLayoutCount() == 3);
+	COG_CHECK(IsLayoutIntact(cache, *cache.Find("Kept"), 2));
+	COG_CHECK(IsLayoutIntact(cache, *cache.Find("New"), 3));
+	COG_CHECK(IsLayoutIntact(cache, *cache.Find("Bigger"), 4));
+}
+
+
+/*******************************************************************************************************************
+	Only the vertices added since the last upload are asked for, unless the block has been moved (compacted) or
+	resized, in which case all of it is
+*******************************************************************************************************************/
+COG_TEST(TextLayoutCacheUploadRanges)
+{
+	TextLayoutCache cache(24);
+
+	unsigned int first = 0, count = 0;
+
+	//--- A new cache has never been uploaded, so the vertex buffers need all of it
+	COG_CHECK(cache.NeedsFullUpload());
+	COG_CHECK(cache.GetUpload(first, count) && first == 0 && count == 24);
+
+	Add(cache, "One", 1, 6);
+	cache.MarkUploaded();
+
+	COG_CHECK(!cache.NeedsFullUpload());
+	COG_CHECK(!cache.GetUpload(first, count));
+
+	Add(cache, "Two", 2, 6);
+	Add(cache, "Three", 3, 6);
+
+	COG_CHECK(cache.GetUpload(first, count) && first == 6 && count == 12);
+
+	cache.MarkUploaded();
+	cache.EndFrame();
+
+	//--- "One" and "Two" are dropped and "Three" moves down, so the whole block is asked for once
+	cache.Find("Three");
+	Add(cache, "Four", 4, 12);
+
+	COG_CHECK(cache.GetCompactions() == 1);
+	COG_CHECK(cache.NeedsFullUpload());
+	COG_CHECK(cache.GetUpload(first, count) && first == 0 && count == 24);
+
+	cache.MarkUploaded();
+
+	//--- Then back to just what's new, counted from the end of the compacted block
+	COG_CHECK(!cache.GetUpload(first, count));
+
+	cache.EndFrame();
+	cache.Find("Three");
+	cache.Find("Four");
+	Add(cache, "Five", 5, 8);
+
+	//--- Growing the block asks for all of it too
+	COG_CHECK(cache.GetCapacity() == 48);
+	COG_CHECK(cache.GetUpload(first, count) && first == 0 && count == 48);
+
+	cache.MarkUploaded();
+	Add(cache, "Six", 6, 3);
+
+	COG_CHECK(cache.GetUpload(first, count) && first == 26 && count == 3);
+}
\ No newline at end of file
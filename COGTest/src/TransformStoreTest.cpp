@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <pretty_glm/gtc/matrix_transform.hpp>
+#include <pretty_glm/gtc/quaternion.hpp>
+#include "Test.h"
+#include "physics/TransformStore.h"
+
+/*******************************************************************************************************************
+	TransformStoreTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for TransformStore - the (SSE) world matrices and bounds checked against plain scalar glm, parents updated
+	before their children even when the child was created first, only changed objects being updated, bad handles
+	being refused, and the same results on the job system.
+
+*******************************************************************************************************************/
+
+namespace {
+
+	struct Reference {
+		glm::vec3	position;
+		glm::quat	rotation;
+		glm::vec3	scale;
+		glm::vec3	minimum, maximum;
+	};
+}
+
+
+/*******************************************************************************************************************
+	Returns a random position, rotation, scale and local bounds
+*******************************************************************************************************************/
+static Reference GetRandomTransform(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> position(-50.0f, 50.0f), unit(-1.0f, 1.0f), scale(0.2f, 3.0f);
+
+	Reference reference;
+	reference.position	= glm::vec3(position(random), position(random), position(random));
+	reference.rotation	= glm::normalize(glm::quat(unit(random), unit(random), unit(random), unit(random) + 1.5f));
+	reference.scale		= glm::vec3(scale(random), scale(random), scale(random));
+	reference.minimum	= glm::vec3(unit(random), unit(random), unit(random)) - glm::vec3(1.0f);
+	reference.maximum	= glm::vec3(unit(random), unit(random), unit(random)) + glm::vec3(1.0f);
+
+	return reference;
+}
+
+
+/*******************************************************************************************************************
+	Returns an object's local matrix the plain glm way (translation * rotation * scale), as Transform builds it
+*******************************************************************************************************************/
+static glm::mat4 GetLocalMatrix(const Reference& reference)
+{
+	return glm::scale(glm::translate(glm::mat4(1.0f), reference.position) * glm::mat4_cast(reference.rotation), reference.scale);
+}
+
+
+/*******************************************************************************************************************
+	Returns the largest difference between two matrices
+*******************************************************************************************************************/
+static float GetDifference(const glm::mat4& a, const glm::mat4& b)
+{
+	float difference = 0.0f;
+
+	for (int column = 0; column < 4; column++) {
+		for (int row = 0; row < 4; row++) { difference = std::max(difference, std::fabs(a[column][row] - b[column][row])); }
+	}
+
+	return difference;
+}
+
+
+/*******************************************************************************************************************
+	Returns true if the store's world bounds are the box around all 8 corners of the local bounds, in world space
+*******************************************************************************************************************/
+static bool IsBoundsCorrect(const TransformStore& store, TransformStore::Handle handle, const glm::mat4& world, const Reference& reference)
+{
+	glm::vec3 minimum(1e30f), maximum(-1e30f);
+
+	for (int corner = 0; corner < 8; corner++) {
+		glm::vec3 local((corner & 1) ? reference.maximum.x : reference.minimum.x,
+						(corner & 2) ? reference.maximum.y : reference.minimum.y,
+						(corner & 4) ? reference.maximum.z : reference.minimum.z);
+
+		glm::vec3 point = glm::vec3(world * glm::vec4(local, 1.0f));
+		minimum = glm::min(minimum, point);
+		maximum = glm::max(maximum, point);
+	}
+
+	glm::vec3 tolerance(1e-3f * (1.0f + glm::length(maximum - minimum)));
+
+	return glm::all(glm::lessThan(glm::abs(store.GetWorldMinimum(handle) - minimum), tolerance)) &&
+		   glm::all(glm::lessThan(glm::abs(store.GetWorldMaximum(handle) - maximum), tolerance));
+}
+
+
+/*******************************************************************************************************************
+	Returns a store of random objects (with their references), ready to be updated
+*******************************************************************************************************************/
+static void Fill(TransformStore& store, std::vector<Reference>& references, unsigned int count, unsigned int seed)
+{
+	std::mt19937 random(seed);
+
+	for (unsigned int i = 0; i < count; i++) {
+
+		references.push_back(GetRandomTransform(random));
+
+		TransformStore::Handle handle = store.Create(references.back().position, references.back().rotation, references.back().scale);
+		store.SetLocalBounds(handle, references.back().minimum, references.back().maximum);
+	}
+}
+
+
+/*******************************************************************************************************************
+	Every world matrix and world bounds match plain scalar glm - including the odd objects at the end of the last
+	group of 4
+*******************************************************************************************************************/
+COG_TEST(TransformStoreMatchesScalarReference)
+{
+	TransformStore store;
+	std::vector<Reference> references;
+	Fill(store, references, 103, 3);
+
+	store.Update();
+
+	COG_CHECK(store.GetUpdatedCount() == 103);
+
+	float difference	= 0.0f;
+	bool isBoundsCorrect	= true;
+
+	for (TransformStore::Handle i = 0; i < references.size(); i++) {
+		glm::mat4 expected	= GetLocalMatrix(references[i]);
+		difference			= std::max(difference, GetDifference(store.GetWorldMatrix(i), expected));
+		isBoundsCorrect		= isBoundsCorrect && IsBoundsCorrect(store, i, expected, references[i]);
+	}
+
+	COG_CHECK(difference < 1e-4f);
+	COG_CHECK(isBoundsCorrect);
+}
+
+
+/*******************************************************************************************************************
+	Children are updated after their parents, even when the child has the lower handle (and so comes first in the
+	arrays), and moving only the parent still moves every child below it
+*******************************************************************************************************************/
+COG_TEST(TransformStoreParentAfterChild)
+{
+	std::mt19937 random(11);
+	Reference grandchild = GetRandomTransform(random), child = GetRandomTransform(random), parent = GetRandomTransform(random);
+
+	TransformStore store;
+
+	//--- Created in reverse, so each one's parent has a higher handle (and lives in a later group of 4)
+	TransformStore::Handle grandchildHandle = store.Create(grandchild.position, grandchild.rotation, grandchild.scale);
+	for (int i = 0; i < 4; i++) { store.Create(); }
+	TransformStore::Handle childHandle = store.Create(child.position, child.rotation, child.scale);
+	for (int i = 0; i < 4; i++) { store.Create(); }
+	TransformStore::Handle parentHandle = store.Create(parent.position, parent.rotation, parent.scale);
+
+	store.SetLocalBounds(grandchildHandle, grandchild.minimum, grandchild.maximum);
+
+	COG_CHECK(store.SetParent(childHandle, parentHandle));
+	COG_CHECK(store.SetParent(grandchildHandle, childHandle));
+
+	store.Update();
+
+	glm::mat4 expected = GetLocalMatrix(parent) * GetLocalMatrix(child) * GetLocalMatrix(grandchild);
+
+	COG_CHECK(GetDifference(store.GetWorldMatrix(grandchildHandle), expected) < 1e-3f);
+	COG_CHECK(IsBoundsCorrect(store, grandchildHandle, expected, grandchild));
+
+	//--- Now only the parent moves - the child and grandchild aren't dirty, but still have to follow it
+	parent.position += glm::vec3(5.0f, -2.0f, 1.0f);
+	store.SetPosition(parentHandle, parent.position);
+	store.Update();
+
+	expected = GetLocalMatrix(parent) * GetLocalMatrix(child) * GetLocalMatrix(grandchild);
+
+	COG_CHECK(GetDifference(store.GetWorldMatrix(grandchildHandle), expected) < 1e-3f);
+	COG_CHECK(GetDifference(store.GetWorldMatrix(childHandle), GetLocalMatrix(parent) * GetLocalMatrix(child)) < 1e-3f);
+	COG_CHECK(store.GetUpdatedCount() == 3);
+
+	//--- Destroying the middle one makes the grandchild a top level object again
+	store.Destroy(childHandle);
+	store.Update();
+
+	COG_CHECK(GetDifference(store.GetWorldMatrix(grandchildHandle), GetLocalMatrix(grandchild)) < 1e-4f);
+}
+
+
+/*******************************************************************************************************************
+	Only objects that have changed since the last update are updated
+*******************************************************************************************************************/
+COG_TEST(TransformStoreOnlyUpdatesChanges)
+{
+	TransformStore store;
+	std::vector<Reference> references;
+	Fill(store, references, 40, 5);
+
+	store.Update();
+	store.Update();
+
+	COG_CHECK(store.GetUpdatedCount() == 0);
+
+	store.SetScale(7, glm::vec3(2.0f));
+	store.SetRotation(33, glm::vec3(0.0f, 90.0f, 0.0f));
+	store.Update();
+
+	COG_CHECK(store.GetUpdatedCount() == 2);
+
+	references[7].scale = glm::vec3(2.0f);
+	COG_CHECK(GetDifference(store.GetWorldMatrix(7), GetLocalMatrix(references[7])) < 1e-4f);
+
+	//--- A yaw of 90 degrees turns the forward axis (0, 0, -1) to face down -X, as Transform does
+	glm::vec3 forward = glm::vec3(store.GetWorldMatrix(33) * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f)) / references[33].scale.z;
+	COG_CHECK_NEAR(forward.x, -1.0f, 1e-4f);
+	COG_CHECK_NEAR(forward.z, 0.0f, 1e-4f);
+}
+
+
+/*******************************************************************************************************************
+	SetParent() refuses loops and handles that aren't in use - on either side - and Destroy() catches a second destroy
+*******************************************************************************************************************/
+COG_TEST(TransformStoreRefusesBadHandles)
+{
+	TransformStore store;
+
+	TransformStore::Handle a = store.Create(), b = store.Create(), c = store.Create();
+
+	COG_CHECK(store.SetParent(b, a));
+	COG_CHECK(store.SetParent(c, b));
+	COG_CHECK(!store.SetParent(a, c));
+	COG_CHECK(!store.SetParent(a, a));
+
+	//--- Handles past the end, or destroyed, can't be a parent or a child
+	COG_CHECK(!store.SetParent(100, a));
+	COG_CHECK(!store.SetParent(a, 100));
+
+	store.Destroy(c);
+
+	COG_CHECK(!store.SetParent(c, a));
+	COG_CHECK(!store.SetParent(a, c));
+
+	store.Destroy(c);
+
+	COG_CHECK(store.GetCount() == 2);
+
+	//--- The slot is only handed out once, even though it was destroyed twice
+	TransformStore::Handle first = store.Create(), second = store.Create();
+
+	COG_CHECK(first == c);
+	COG_CHECK(second != c);
+}
+
+
+/*******************************************************************************************************************
+	A big update split into jobs gives the same matrices and bounds as doing it all on one thread
+*******************************************************************************************************************/
+COG_TEST(TransformStoreIsTheSameOnTheJobSystem)
+{
+	JobSystem jobSystem;
+	jobSystem.Start(4);
+
+	TransformStore serial, parallel(&jobSystem);
+	std::vector<Reference> references;
+
+	Fill(serial, references, 20000, 9);
+	references.clear();
+	Fill(parallel, references, 20000, 9);
+
+	for (TransformStore::Handle i = 1; i < 20000; i += 97) {
+		serial.SetParent(i, i - 1);
+		parallel.SetParent(i, i - 1);
+	}
+
+	serial.Update();
+	parallel.Update();
+
+	COG_CHECK(parallel.GetUpdatedCount() == serial.GetUpdatedCount());
+
+	bool isSame = true;
+
+	for (TransformStore::Handle i = 0; isSame && i < 20000; i++) {
+		isSame = GetDifference(serial.GetWorldMatrix(i), parallel.GetWorldMatrix(i)) == 0.0f &&
+				 serial.GetWorldMinimum(i) == parallel.GetWorldMinimum(i) && serial.GetWorldMaximum(i) == parallel.GetWorldMaximum(i);
+	}
+
+	COG_CHECK(isSame);
+
+	jobSystem.Stop();
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <cstring>
+#include "Test.h"
+#include "graphics/UniformArena.h"
+
+/*******************************************************************************************************************
+	UniformArenaTest.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	Tests for UniformArena - block offsets on the GPU's offset alignment (including one that isn't a power of two),
+	blocks rounded up to whole vec4's, zeroed padding and clearing between frames.
+
+*******************************************************************************************************************/
+
+//--- A block that isn't a whole number of vec4's, so it needs rounding up
+struct OddBlock { float values[5]; };
+
+
+/*******************************************************************************************************************
+	Returns true if every byte from 'first' up to (but not including) 'last' is zero
+*******************************************************************************************************************/
+static bool IsZeroed(const UniformArena& arena, size_t first, size_t last)
+{
+	for (size_t i = first; i < last; i++) { if (arena.GetData()[i] != 0) { return false; } }
+
+	return true;
+}
+
+
+/*******************************************************************************************************************
+	Blocks are rounded up to whole vec4's, as std140 blocks are
+*******************************************************************************************************************/
+COG_TEST(UniformArenaBlockSizeRounding)
+{
+	COG_CHECK(UniformArena::GetBlockSize(0) == 0);
+	COG_CHECK(UniformArena::GetBlockSize(4) == 16);
+	COG_CHECK(UniformArena::GetBlockSize(16) == 16);
+	COG_CHECK(UniformArena::GetBlockSize(17) == 32);
+	COG_CHECK(UniformArena::GetBlockSize(sizeof(OddBlock)) == 32);
+}
+
+
+/*******************************************************************************************************************
+	Every block starts on the offset alignment (256 is the most OpenGL allows), and the padding is zeroed
+*******************************************************************************************************************/
+COG_TEST(UniformArenaOffsetsAreAligned)
+{
+	UniformArena arena(256);
+
+	OddBlock block;
+	for (int i = 0; i < 5; i++) { block.values[i] = 1.0f + i; }
+
+	size_t first	= arena.Append(block);
+	size_t second	= arena.Append(block);
+	size_t third	= arena.Append(&block, 4);
+
+	COG_CHECK(first == 0);
+	COG_CHECK(second == 256);
+	COG_CHECK(third == 512);
+	COG_CHECK(arena.GetSize() == 512 + 16);
+	COG_CHECK(arena.GetBlockCount() == 3);
+
+	COG_CHECK(std::memcmp(arena.GetData() + second, &block, sizeof(block)) == 0);
+	COG_CHECK(IsZeroed(arena, sizeof(block), second));
+	COG_CHECK(IsZeroed(arena, second + sizeof(block), third));
+	COG_CHECK(IsZeroed(arena, third + 4, arena.GetSize()));
+}
+
+
+/*******************************************************************************************************************
+	An alignment that isn't a power of two (or a multiple of a vec4) becomes a multiple of both it and a vec4
+*******************************************************************************************************************/
+COG_TEST(UniformArenaNonPowerOfTwoAlignment)
+{
+	UniformArena arena(24);
+
+	COG_CHECK(arena.GetAlignment() == 48);
+
+	OddBlock block = {};
+
+	for (int i = 0; i < 4; i++) {
+		size_t offset = arena.Append(block);
+		COG_CHECK(offset == (size_t)i * 48);
+		COG_CHECK(offset % 24 == 0 && offset % 16 == 0);
+	}
+
+	arena.SetAlignment(0);
+	COG_CHECK(arena.GetAlignment() == 16);
+}
+
+
+/*******************************************************************************************************************
+	Clearing starts the next frame from an offset of zero
+*******************************************************************************************************************/
+COG_TEST(UniformArenaClear)
+{
+	UniformArena arena(64);
+
+	OddBlock block = {};
+	arena.Append(block);
+	arena.Append(block);
+
+	arena.Clear();
+
+	COG_CHECK(arena.GetSize() == 0);
+	COG_CHECK(arena.GetBlockCount() == 0);
+	COG_CHECK(arena.Append(block) == 0);
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <cstdlib>
+#include "Test.h"
+
+/*******************************************************************************************************************
+	main.cpp
+	Created by Kim Kane
+	Last updated: 18/10/2026
+
+	COGTest : runs every test registered with COG_TEST (see Test.h).
+
+	Usage: COGTest
+
+*******************************************************************************************************************/
+
+//--- Checks failed by the test that is running
+static unsigned int s_failedChecks = 0;
+
+
+/*******************************************************************************************************************
+	Returns every registered test - a function static, so it exists before any test file registers with it
+*******************************************************************************************************************/
+std::vector<test::Case>& test::GetCases()
+{
+	static std::vector<Case> cases;
+	return cases;
+}
+
+
+/*******************************************************************************************************************
+	Reports a failed check
+*******************************************************************************************************************/
+void test::Fail(const char* condition, const char* file, int line)
+{
+	std::printf("    Check failed: [%s] in file: %s line: %d\n", condition, file, line);
+	s_failedChecks++;
+}
+
+
+/*******************************************************************************************************************
+	Runs every test, and returns EXIT_FAILURE if any of them failed
+*******************************************************************************************************************/
+int main()
+{
+	unsigned int failedTests = 0;
+
+	for (const auto& test : test::GetCases()) {
+
+		s_failedChecks = 0;
+		test.function();
+
+		std::printf("[%s] %s\n", s_failedChecks ? "FAIL" : "PASS", test.name);
+		if (s_failedChecks) { failedTests++; }
+	}
+
+	std::printf("\n%u of %u tests failed\n", failedTests, (unsigned int)test::GetCases().size());
+
+	return failedTests ? EXIT_FAILURE : EXIT_SUCCESS;
+}
\ No newline at end of file